@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+
+"""
+Compare two results of tests/bench, e.g. of two commits:
+
+  bench_compare.py old/bench.json new/bench.json
+
+The median of each benchmark is compared. A change that is smaller than
+the spread of the samples of both runs is marked as noise.
+"""
+
+import json, sys
+
+def load(path):
+	with open(path) as f:
+		res = json.load(f)
+	return res, dict((b['name'], b) for b in res['benchmarks'])
+
+if len(sys.argv) != 3:
+	sys.stderr.write("usage: %s OLD.json NEW.json\n" % sys.argv[0])
+	sys.exit(2)
+
+old_res, old = load(sys.argv[1])
+new_res, new = load(sys.argv[2])
+
+print("%-24s %12s %12s %9s" % ("benchmark", old_res['label'] or "old",
+	new_res['label'] or "new", "change"))
+for b in new_res['benchmarks']:
+	name = b['name']
+	if name not in old:
+		print("%-24s %12s %12.1f" % (name, "-", b['median_ns']))
+		continue
+	o = old[name]
+	change = (b['median_ns'] - o['median_ns']) / o['median_ns'] * 100
+	noise = abs(b['median_ns'] - o['median_ns']) < \
+		max(o['stddev_ns'], b['stddev_ns'])
+	print("%-24s %12.1f %12.1f %+8.1f%%%s" % (name, o['median_ns'],
+		b['median_ns'], change, " (noise)" if noise else ""))
@@ -16,7 +16,8 @@ struct ipabis_link {
 	struct gsm_bts_trx	*trx;	/* set, if RSL link */
 	struct osmo_fd		bfd;
 	struct osmo_timer_list	timer;
-	struct msgb		*rx_msg;
+	uint8_t			*rx_buf;	/* received, not yet parsed */
+	unsigned int		rx_len;
 	struct llist_head	tx_queue;
 	int			ping, pong, id_resp;
 	uint32_t		ip;
@@ -25,6 +25,9 @@ uint8_t *bts_sysinfo_get(struct gsm_bts *bts, struct gsm_time *g_time);
 uint8_t *lchan_sacch_get(struct gsm_lchan *lchan, struct gsm_time *g_time);
 int lchan_init_lapdm(struct gsm_lchan *lchan);
 
+/* the private state of 'lchan' in the BTS, NULL if out of memory */
+struct lchan_priv *bts_lchan_priv(struct gsm_lchan *lchan);
+
 void load_timer_start(struct gsm_bts *bts);
 
 struct gsm_time *get_time(struct gsm_bts *bts);
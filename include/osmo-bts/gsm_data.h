@@ -1,11 +1,14 @@
 #ifndef _GSM_DATA_H
 #define _GSM_DATA_H
 
+#include <time.h>
+
 #include <osmocom/core/timer.h>
 #include <osmocom/core/linuxlist.h>
 #include <osmocom/gsm/lapdm.h>
 
 #include <osmo-bts/paging.h>
+#include <osmo-bts/rach_adm.h>
 
 struct pcu_sock_state;
 
@@ -16,6 +19,45 @@ struct gsm_network {
 	struct pcu_sock_state *pcu_state;
 };
 
+/* maximum number of SACCH periods the uplink results are averaged over */
+#define MEAS_AVG_PERIODS_MAX	8
+
+/* Measurement state of each lchan, see measurement.c.  The samples of the
+ * current SACCH period are only summed up, the results of the last periods
+ * are kept in a ring together with their sums, so that averaging over
+ * several periods does not need to walk the history. */
+struct meas_period {
+	uint32_t ber_full;
+	uint32_t irssi_full;
+	uint32_t ber_sub;
+	uint32_t irssi_sub;
+};
+
+struct lchan_meas_state {
+	/* current period */
+	uint32_t ber_full_sum;
+	uint32_t irssi_full_sum;
+	uint32_t ber_sub_sum;
+	uint32_t irssi_sub_sum;
+	int32_t taqb_sum;
+	uint16_t num_meas;
+	uint16_t num_meas_sub;
+
+	/* results of the previous periods */
+	struct meas_period hist[MEAS_AVG_PERIODS_MAX];
+	struct meas_period hist_sum;
+	uint8_t hist_head;
+	uint8_t hist_num;
+};
+
+/* State of the BTS for each lchan, which is not part of struct gsm_lchan,
+ * as that structure is shared with OpenBSC */
+struct lchan_priv {
+	struct lchan_meas_state meas;
+	struct timespec act_started;	/* reception of the CHAN ACT */
+	uint8_t dtx;			/* RSL_CMOD_DTXu/d of the chan mode */
+};
+
 /* data structure for BTS related data specific to the BTS role */
 struct gsm_bts_role_bts {
 	struct {
@@ -46,6 +88,24 @@ struct gsm_bts_role_bts {
 			unsigned int access;	/* access bursts */
 		} rach;
 	} load;
+	struct {
+		/* number of SACCH periods the uplink results are averaged
+		 * over before they are reported */
+		uint8_t avg_periods;
+	} meas;
+	/* private state of each lchan of all TRX, see bts_lchan_priv() */
+	struct lchan_priv *lchan_priv;
+	unsigned int lchan_priv_num_trx;
+	struct {
+		/* latency from CHAN ACT to CHAN ACT ACK */
+		uint32_t acked;
+		uint32_t nacked;
+		uint64_t sum_us;
+		uint32_t min_us;
+		uint32_t max_us;
+	} chan_act;
+	/* admission of access bursts, see rach_adm.c */
+	struct rach_adm rach_adm;
 	uint8_t ny1;
 	uint8_t max_ta;
 	struct llist_head agch_queue;
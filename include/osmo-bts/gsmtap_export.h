@@ -0,0 +1,32 @@
+#ifndef OSMO_BTS_GSMTAP_EXPORT_H
+#define OSMO_BTS_GSMTAP_EXPORT_H
+
+#include <stdint.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/bits.h>
+
+struct gsmtap_export_stats {
+	uint32_t queued;	/* messages accepted into the queue */
+	uint32_t sent;		/* messages handed to the kernel */
+	uint32_t dropped;	/* messages dropped since the queue was full */
+	uint32_t flushes;	/* number of sendmmsg() calls */
+};
+
+extern struct gsmtap_export_stats gsmtap_export_stats;
+
+/* send raw burst bits of the TRX scheduler, too (osmo-bts-trx only) */
+extern int gsmtap_bursts;
+
+/* queue a complete GSMTAP message, ownership of msg is taken */
+int gsmtap_export_msg(struct msgb *msg);
+
+/* queue a GSMTAP burst message of the given soft bits (uplink) or hard
+ * bits (downlink), 'sub_type' is one of GSMTAP_BURST_* */
+int gsmtap_export_burst(uint16_t arfcn, uint8_t tn, uint32_t fn,
+	uint8_t sub_type, int8_t signal_dbm, const uint8_t *bits,
+	unsigned int len);
+
+/* send all queued messages, called once per TDMA frame */
+void gsmtap_export_flush(void);
+
+#endif /* OSMO_BTS_GSMTAP_EXPORT_H */
@@ -55,6 +55,10 @@ int l1sap_pdch_req(struct gsm_bts_trx_ts *ts, int is_ptcch, uint32_t fn,
 void l1sap_rtp_rx_cb(struct osmo_rtp_socket *rs, const uint8_t *rtp_pl,
 	unsigned int rtp_pl_len);
 
+/* queue a downlink TCH frame received from the network */
+void l1sap_rtp_rx_frame(struct gsm_lchan *lchan, const uint8_t *rtp_pl,
+	unsigned int rtp_pl_len);
+
 /* channel control */
 int l1sap_chan_act(struct gsm_bts_trx *trx, uint8_t chan_nr);
 int l1sap_chan_rel(struct gsm_bts_trx *trx, uint8_t chan_nr);
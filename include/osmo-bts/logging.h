@@ -1,6 +1,8 @@
 #ifndef _LOGGING_H
 #define _LOGGING_H
 
+#include <stdint.h>
+
 #define DEBUG
 #include <osmocom/core/logging.h>
 
@@ -25,6 +27,23 @@ enum {
 
 extern const struct log_info bts_log_info;
 
+/* lowest level at which any log target would print a category, refreshed
+ * from the log target configuration by bts_log_cache_update() */
+extern uint8_t bts_log_min_level[DSUM];
+
+/* cheap variants of LOGP/DEBUGP for per-burst and per-frame code paths:
+ * the arguments are not even evaluated unless some target wants them */
+#define LOGP_HOT(ss, level, fmt, args...) \
+	do { \
+		if ((level) >= bts_log_min_level[ss]) \
+			LOGP(ss, level, fmt, ## args); \
+	} while (0)
+#define DEBUGP_HOT(ss, fmt, args...) \
+	LOGP_HOT(ss, LOGL_DEBUG, fmt, ## args)
+
+#define bts_log_enabled(ss, level) ((level) >= bts_log_min_level[ss])
+
 int bts_log_init(const char *category_mask);
+void bts_log_cache_update(void);
 
 #endif /* _LOGGING_H */
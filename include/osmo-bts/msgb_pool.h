@@ -0,0 +1,50 @@
+#ifndef OSMO_BTS_MSGB_POOL_H
+#define OSMO_BTS_MSGB_POOL_H
+
+#include <stdint.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/linuxlist.h>
+
+struct msgb_pool_stats {
+	uint32_t allocated;	/* msgbs allocated from the heap */
+	uint32_t recycled;	/* msgbs taken from the free list */
+	uint32_t released;	/* msgbs given back to the heap */
+	uint32_t failed;	/* allocations that failed */
+};
+
+/* msgbs of one size class, which are kept for reuse after bts_msgb_free() */
+struct msgb_pool {
+	uint16_t size;			/* data size of each msgb */
+	unsigned int max_free;		/* most msgbs kept on the free list */
+	struct llist_head free;		/* free msgbs */
+	unsigned int num_free;		/* msgbs on the free list */
+	unsigned int num_used;		/* msgbs currently in use */
+	unsigned int high_watermark;	/* most msgbs in use at once */
+	struct msgb_pool_stats stats;
+};
+
+#define MSGB_POOL_MAX	6
+
+extern struct msgb_pool msgb_pools[MSGB_POOL_MAX];
+extern unsigned int msgb_pools_num;
+
+/* add a pool of 'size' byte msgbs, e.g. for the primitives of a L1, and
+ * fill its free list with 'prealloc' msgbs */
+int msgb_pool_add(uint16_t size, unsigned int max_free,
+	unsigned int prealloc);
+
+/* same as msgb_alloc_headroom()/msgb_alloc(), but the msgb is taken from
+ * the smallest pool that fits 'size' and is returned to it by
+ * bts_msgb_free(). Larger messages are allocated from the heap. */
+struct msgb *bts_msgb_alloc_headroom(uint16_t size, uint16_t headroom,
+	const char *name);
+
+/* put a msgb of a pool back on its free list, any other msgb is freed */
+void bts_msgb_free(struct msgb *msg);
+
+static inline struct msgb *bts_msgb_alloc(uint16_t size, const char *name)
+{
+	return bts_msgb_alloc_headroom(size, 0, name);
+}
+
+#endif /* OSMO_BTS_MSGB_POOL_H */
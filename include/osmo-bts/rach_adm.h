@@ -0,0 +1,84 @@
+#ifndef OSMO_BTS_RACH_ADM_H
+#define OSMO_BTS_RACH_ADM_H
+
+#include <stdint.h>
+
+struct gsm_bts;
+struct vty;
+
+/* number of recent access bursts remembered for duplicate suppression */
+#define RACH_ADM_HIST		32
+
+/* highest barring level, each level bars two more of the access classes
+ * 0..9, so that at least two classes are never barred */
+#define RACH_ADM_MAX_LEVEL	4
+
+/* number of seconds the load must stay below the low threshold, before
+ * the barring level is lowered */
+#define RACH_ADM_HOLD		5
+
+enum rach_adm_result {
+	RACH_ADM_ACCEPT,
+	RACH_ADM_DUPLICATE,	/* same RA received within the window */
+	RACH_ADM_RATE_LIMIT,	/* above the configured CHAN RQD rate */
+};
+
+struct rach_adm_stats {
+	uint32_t received;	/* access bursts for RR access */
+	uint32_t admitted;	/* forwarded to the BSC */
+	uint32_t duplicate;	/* dropped as repetition */
+	uint32_t rate_limited;	/* dropped above the rate limit */
+	uint32_t emergency;	/* emergency calls, always admitted */
+	uint32_t bar_changes;	/* changes of the barring level */
+};
+
+struct rach_adm {
+	/* configuration, 0 disables the respective function */
+	unsigned int rate_limit;	/* CHAN RQD per second */
+	unsigned int dup_window;	/* TDMA frames */
+	unsigned int bar_high;		/* access bursts per second */
+	unsigned int bar_low;
+
+	/* internal state, all timing is derived from the frame number */
+	int running;
+	uint32_t last_fn;
+	uint32_t credit;	/* token bucket, 26000 per CHAN RQD */
+	uint32_t period;	/* time within the current second */
+	unsigned int offered;	/* requests within the current second */
+	unsigned int load;	/* requests of the last second */
+	unsigned int hold;	/* seconds below the low threshold */
+	uint8_t level;		/* current barring level */
+	struct {
+		uint32_t fn;
+		uint8_t ra;
+		uint8_t valid;
+	} hist[RACH_ADM_HIST];
+	unsigned int hist_next;
+
+	/* RACH control parameters T2/T3 of SI1..SI4 as sent by the BSC */
+	uint8_t si_orig[4][2];
+	uint8_t si_known;
+
+	struct rach_adm_stats stats;
+};
+
+/* decide about the access burst 'ra' for RR access received in frame 'fn' */
+enum rach_adm_result rach_adm_check(struct gsm_bts *bts, uint8_t ra,
+	uint32_t fn);
+
+/* advance the rate limit and the barring to frame 'fn', called once per
+ * TDMA frame */
+void rach_adm_tick(struct gsm_bts *bts, uint32_t fn);
+
+/* the BSC has sent a new system information 'si' (enum osmo_sysinfo_type),
+ * apply the current barring to it */
+void rach_adm_si_update(struct gsm_bts *bts, int si);
+
+/* access classes 0..15 barred in addition to those barred by the BSC */
+uint16_t rach_adm_barred(struct gsm_bts *bts);
+
+const char *rach_adm_result_name(enum rach_adm_result res);
+
+void rach_adm_dump_vty(struct vty *vty, struct gsm_bts *bts);
+
+#endif /* OSMO_BTS_RACH_ADM_H */
@@ -25,5 +25,8 @@ int rsl_tx_ccch_load_ind_rach(struct gsm_bts *bts, uint16_t total,
 
 struct gsm_lchan *rsl_lchan_lookup(struct gsm_bts_trx *trx, uint8_t chan_nr);
 
+/* DTX enabled by the BSC (RSL_CMOD_DTXu, RSL_CMOD_DTXd) for 'lchan' */
+uint8_t rsl_lchan_dtx(struct gsm_lchan *lchan);
+
 #endif // _RSL_H */
 
@@ -0,0 +1,35 @@
+#ifndef OSMO_BTS_RTP_CONN_H
+#define OSMO_BTS_RTP_CONN_H
+
+#include <stdint.h>
+
+struct gsm_lchan;
+struct vty;
+
+struct rtp_conn_stats {
+	uint32_t tx_packets;	/* uplink frames sent */
+	uint32_t tx_bytes;	/* payload bytes of them */
+	uint32_t tx_dropped;	/* uplink frames that could not be sent */
+	uint32_t tx_skipped;	/* uplink frames not transmitted by the MS */
+	uint32_t rx_packets;	/* downlink frames received */
+	uint32_t rx_bytes;	/* payload bytes of them */
+};
+
+/* send an uplink frame of the call on 'lchan' */
+int rtp_conn_send(struct gsm_lchan *lchan, const uint8_t *payload,
+	unsigned int len, unsigned int duration);
+
+/* the MS did not transmit an uplink frame (DTX): nothing is sent, but the
+ * RTP timestamp keeps running, so the next frame starts a talkspurt */
+void rtp_conn_skip(struct gsm_lchan *lchan, unsigned int duration);
+
+/* account a downlink frame of the call on 'lchan' */
+void rtp_conn_rx(struct gsm_lchan *lchan, unsigned int len);
+
+/* the RTP socket of 'lchan' is closed, forget the call */
+void rtp_conn_del(struct gsm_lchan *lchan);
+
+/* print the statistics of all calls */
+void rtp_conn_dump_vty(struct vty *vty);
+
+#endif /* OSMO_BTS_RTP_CONN_H */
@@ -0,0 +1,51 @@
+#ifndef OSMO_BTS_RTP_TRUNK_H
+#define OSMO_BTS_RTP_TRUNK_H
+
+#include <stdint.h>
+
+struct gsm_lchan;
+struct vty;
+
+/* version in the first octet of each trunk packet */
+#define RTP_TRUNK_VERSION	1
+
+/* length of the trunk header and of the header of each frame */
+#define RTP_TRUNK_HDR_LEN	2
+#define RTP_TRUNK_FRAME_HDR_LEN	4
+
+struct rtp_trunk_stats {
+	uint32_t tx_packets;	/* trunk packets sent */
+	uint32_t tx_frames;	/* frames sent in them */
+	uint32_t tx_dropped;	/* frames that could not be sent */
+	uint32_t rx_packets;	/* trunk packets received */
+	uint32_t rx_frames;	/* frames received in them */
+	uint32_t rx_errors;	/* malformed packets and unknown CIDs */
+};
+
+/* number of TDMA frames, whose voice frames are sent in one packet */
+extern unsigned int rtp_trunk_batch;
+
+/* carry the voice frames of the call on 'lchan' with the given CID over
+ * the trunk to the peer (IP address and port in host byte order), without
+ * IP address or port, the call only keeps the CID until they are known */
+int rtp_trunk_call_add(struct gsm_lchan *lchan, uint32_t remote_ip,
+	uint16_t remote_port, uint8_t cid);
+
+/* remove the call on 'lchan' from its trunk */
+void rtp_trunk_call_del(struct gsm_lchan *lchan);
+
+/* CID of the call on 'lchan', or -ENODEV if it is not multiplexed */
+int rtp_trunk_call_cid(const struct gsm_lchan *lchan);
+
+/* queue an uplink frame of the call on 'lchan', an empty frame is not
+ * transmitted (DTX), returns -ENODEV if the call is not multiplexed */
+int rtp_trunk_send(struct gsm_lchan *lchan, const uint8_t *payload,
+	unsigned int len);
+
+/* send the queued frames, called once per TDMA frame */
+void rtp_trunk_flush(void);
+
+/* print the statistics of all trunks */
+void rtp_trunk_dump_vty(struct vty *vty);
+
+#endif /* OSMO_BTS_RTP_TRUNK_H */
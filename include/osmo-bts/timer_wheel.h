@@ -0,0 +1,43 @@
+#ifndef OSMO_BTS_TIMER_WHEEL_H
+#define OSMO_BTS_TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/core/timer.h>
+
+/* number of slots, a power of two */
+#define TIMER_WHEEL_SLOTS	64
+
+/* a timeout on a wheel, embedded in the structure it belongs to */
+struct timer_wheel_entry {
+	struct llist_head list;
+	uint32_t expires;	/* tick at which the entry expires */
+	int active;
+	void (*cb)(void *data);
+	void *data;
+};
+
+/* many timeouts of the same granularity, driven by one osmo_timer that
+ * only runs while an entry is pending */
+struct timer_wheel {
+	struct llist_head slots[TIMER_WHEEL_SLOTS];
+	struct osmo_timer_list timer;
+	unsigned int tick_ms;	/* duration of one tick */
+	uint32_t now;		/* ticks elapsed */
+	unsigned int pending;	/* entries on the wheel */
+};
+
+void timer_wheel_init(struct timer_wheel *tw, unsigned int tick_ms);
+
+/* (re)schedule 'e' to expire after 'ticks' ticks */
+void timer_wheel_add(struct timer_wheel *tw, struct timer_wheel_entry *e,
+	unsigned int ticks);
+
+/* remove 'e' from the wheel, if it is pending */
+void timer_wheel_del(struct timer_wheel *tw, struct timer_wheel_entry *e);
+
+/* advance the wheel by one tick and run the expired entries, this is
+ * called by the timer of the wheel */
+void timer_wheel_tick(struct timer_wheel *tw);
+
+#endif /* OSMO_BTS_TIMER_WHEEL_H */
@@ -30,10 +30,12 @@
 #include <errno.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/uio.h>
 
 #include <osmocom/core/select.h>
 #include <osmocom/core/timer.h>
 #include <osmocom/core/msgb.h>
+#include <osmocom/core/talloc.h>
 #include <osmocom/gsm/protocol/ipaccess.h>
 
 #include <osmo-bts/logging.h>
@@ -52,6 +54,12 @@ extern uint8_t abis_mac[6];
 
 #define ABIS_ALLOC_SIZE	900
 
+/* size of the receive buffer, we read as much as fits with one recv() */
+#define ABIS_RX_BUF_SIZE	4096
+
+/* maximum number of queued messages written with one writev() */
+#define ABIS_TX_IOV_MAX		64
+
 /* send message to BSC */
 int abis_tx(struct ipabis_link *link, struct msgb *msg)
 {
@@ -345,11 +353,123 @@ static void abis_timeout(void *arg)
 	}	
 }
 
-static int abis_sock_cb(struct osmo_fd *bfd, unsigned int what)
+/* Read as much as the socket has and slice all complete IPA messages out
+ * of it, so that a burst of RSL messages costs one recv() instead of two
+ * per message.  A partial message at the end is kept for the next read. */
+static int abis_sock_read(struct ipabis_link *link)
 {
-	struct ipabis_link *link = bfd->data;
 	struct ipaccess_head *hh;
 	struct msgb *msg;
+	unsigned int pos = 0, len;
+	int fd = link->bfd.fd;
+	int ret;
+
+	if (!link->rx_buf) {
+		link->rx_buf = talloc_size(link, ABIS_RX_BUF_SIZE);
+		if (!link->rx_buf)
+			return -ENOMEM;
+		link->rx_len = 0;
+	}
+
+	ret = recv(fd, link->rx_buf + link->rx_len,
+		ABIS_RX_BUF_SIZE - link->rx_len, 0);
+	if (ret == 0)
+		return -EIO;
+	if (ret < 0) {
+		if (errno == EAGAIN)
+			return 0;
+		return -EIO;
+	}
+	link->rx_len += ret;
+
+	while (link->rx_len - pos >= sizeof(*hh)) {
+		hh = (struct ipaccess_head *) (link->rx_buf + pos);
+		len = sizeof(*hh) + ntohs(hh->len);
+		if (len > ABIS_ALLOC_SIZE) {
+			LOGP(DABIS, LOGL_NOTICE, "Received packet from "
+				"Abis socket too large.\n");
+			return -EIO;
+		}
+		/* message not complete yet */
+		if (link->rx_len - pos < len)
+			break;
+
+		/* the message handlers take ownership and may reuse the
+		 * headroom for their response, so each gets its own msgb */
+		msg = abis_msgb_alloc(128);
+		if (!msg)
+			return -ENOMEM;
+		memcpy(msgb_put(msg, len), hh, len);
+		msg->l2h = msg->data + sizeof(*hh);
+		pos += len;
+
+		LOGP_HOT(DABIS, LOGL_DEBUG, "Received messages from Abis "
+			"socket.\n");
+		abis_rx(link, msg);
+
+		/* the handler may have closed the link */
+		if (link->bfd.fd != fd || !link->rx_len)
+			return 0;
+	}
+
+	if (pos) {
+		link->rx_len -= pos;
+		memmove(link->rx_buf, link->rx_buf + pos, link->rx_len);
+	}
+
+	return 0;
+}
+
+/* Write as much of the transmit queue as possible with one writev().  A
+ * message that was only sent partially keeps its remaining part at the
+ * head of the queue. */
+static int abis_sock_write(struct ipabis_link *link)
+{
+	struct iovec iov[ABIS_TX_IOV_MAX];
+	struct msgb *msg, *msg2;
+	ssize_t ret;
+	int n = 0;
+
+	llist_for_each_entry(msg, &link->tx_queue, list) {
+		if (n == ABIS_TX_IOV_MAX)
+			break;
+		iov[n].iov_base = msg->data;
+		iov[n].iov_len = msg->len;
+		n++;
+	}
+	if (!n) {
+		link->bfd.when &= ~BSC_FD_WRITE;
+		return 0;
+	}
+
+	LOGP_HOT(DABIS, LOGL_DEBUG, "Sending %d messages to Abis socket.\n",
+		n);
+	ret = writev(link->bfd.fd, iov, n);
+	if (ret < 0) {
+		if (errno == EAGAIN)
+			return 0;
+		return -EIO;
+	}
+
+	llist_for_each_entry_safe(msg, msg2, &link->tx_queue, list) {
+		if (ret < msg->len) {
+			msgb_pull(msg, ret);
+			break;
+		}
+		ret -= msg->len;
+		llist_del(&msg->list);
+		msgb_free(msg);
+	}
+
+	if (llist_empty(&link->tx_queue))
+		link->bfd.when &= ~BSC_FD_WRITE;
+
+	return 0;
+}
+
+static int abis_sock_cb(struct osmo_fd *bfd, unsigned int what)
+{
+	struct ipabis_link *link = bfd->data;
 	int ret = 0;
 
 	if ((what & BSC_FD_WRITE) && link->state == LINK_STATE_CONNECTING) {
@@ -367,51 +487,14 @@ static int abis_sock_cb(struct osmo_fd *bfd, unsigned int what)
 //printf("what %d\n", what);
 
 	if ((what & BSC_FD_READ)) {
-		if (!link->rx_msg) {
-			link->rx_msg = abis_msgb_alloc(128);
-			if (!link->rx_msg)
-				return -ENOMEM;
-		}
-		msg = link->rx_msg;
-		hh = (struct ipaccess_head *) msg->data;
-		if (msg->len < sizeof(*hh)) {
-			ret = recv(link->bfd.fd, msg->data, sizeof(*hh), 0);
-			if (ret <= 0) {
-				goto close;
-			}
-			msgb_put(msg, ret);
-			if (msg->len < sizeof(*hh))
-				return 0;
-			msg->l2h = msg->data + sizeof(*hh);
-			if (ntohs(hh->len) > msgb_tailroom(msg)) {
-				LOGP(DABIS, LOGL_DEBUG, "Received packet from "
-					"Abis socket too large.\n");
-				goto close;
-			}
-		}
-		ret = recv(link->bfd.fd, msg->tail,
-			ntohs(hh->len) + sizeof(*hh) - msg->len, 0);
-		if (ret == 0)
+		ret = abis_sock_read(link);
+		if (ret < 0)
 			goto close;
-		if (ret < 0 && errno != EAGAIN)
-			goto close;
-		msgb_put(msg, ret);
-		if (ntohs(hh->len) + sizeof(*hh) > msg->len)
-			return 0;
-		link->rx_msg = NULL;
-		LOGP(DABIS, LOGL_DEBUG, "Received messages from Abis socket.\n");
-		ret = abis_rx(link, msg);
 	}
-	if ((what & BSC_FD_WRITE)) {
-		msg = msgb_dequeue(&link->tx_queue);
-		if (msg) {
-			LOGP(DABIS, LOGL_DEBUG, "Sending messages to Abis socket.\n");
-			ret = send(link->bfd.fd, msg->data, msg->len, 0);
-			msgb_free(msg);
-			if (ret < 0)
-				goto close;
-		} else
-			link->bfd.when &= ~BSC_FD_WRITE;
+	if ((what & BSC_FD_WRITE) && link->state == LINK_STATE_CONNECT) {
+		ret = abis_sock_write(link);
+		if (ret < 0)
+			goto close;
 	}
 	if ((what & BSC_FD_EXCEPT)) {
 		LOGP(DABIS, LOGL_NOTICE, "Abis socket received exception\n");
@@ -500,10 +583,8 @@ void abis_close(struct ipabis_link *link)
 	
 	LOGP(DABIS, LOGL_NOTICE, "Abis socket closed.\n");
 
-	if (link->rx_msg) {
-		msgb_free(link->rx_msg);
-		link->rx_msg = NULL;
-	}
+	/* drop any partial message */
+	link->rx_len = 0;
 
 	while ((msg = msgb_dequeue(&link->tx_queue)))
 		msgb_free(msg);
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -76,6 +77,7 @@ int bts_init(struct gsm_bts *bts)
 	btsb->max_ta = 63;
 	btsb->ny1 = 4;
 	btsb->t3105_ms = 300;
+	btsb->meas.avg_periods = 1;
 
 	/* default RADIO_LINK_TIMEOUT */
 	btsb->radio_link_timeout = 32;
@@ -212,6 +214,33 @@ int lchan_init_lapdm(struct gsm_lchan *lchan)
 	return 0;
 }
 
+struct lchan_priv *bts_lchan_priv(struct gsm_lchan *lchan)
+{
+	struct gsm_bts_trx *trx = lchan->ts->trx;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(trx->bts);
+	unsigned int per_trx = ARRAY_SIZE(trx->ts)
+					* ARRAY_SIZE(trx->ts[0].lchan);
+
+	/* the table grows with the TRX, which may be added after bts_init() */
+	if (trx->nr >= btsb->lchan_priv_num_trx) {
+		struct lchan_priv *priv;
+		unsigned int num_trx = trx->nr + 1;
+
+		priv = talloc_realloc(btsb, btsb->lchan_priv, struct lchan_priv,
+			num_trx * per_trx);
+		if (!priv)
+			return NULL;
+		memset(priv + btsb->lchan_priv_num_trx * per_trx, 0,
+			(num_trx - btsb->lchan_priv_num_trx) * per_trx
+				* sizeof(*priv));
+		btsb->lchan_priv = priv;
+		btsb->lchan_priv_num_trx = num_trx;
+	}
+
+	return &btsb->lchan_priv[trx->nr * per_trx
+		+ lchan->ts->nr * ARRAY_SIZE(trx->ts[0].lchan) + lchan->nr];
+}
+
 int bts_agch_enqueue(struct gsm_bts *bts, struct msgb *msg)
 {
 	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
@@ -0,0 +1,159 @@
+/* Batched GSMTAP export */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <arpa/inet.h>
+
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/core/gsmtap.h>
+#include <osmocom/core/gsmtap_util.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/l1sap.h>
+#include <osmo-bts/gsmtap_export.h>
+
+/* Messages are not written one by one, but collected during a TDMA frame
+ * and written with a single sendmmsg() at the next frame tick.  If the
+ * socket cannot keep up, the queue fills up to GSMTAP_QUEUE_MAX and any
+ * further message is dropped and counted. */
+#define GSMTAP_QUEUE_MAX	512
+#define GSMTAP_BATCH_MAX	64
+
+struct gsmtap_export_stats gsmtap_export_stats;
+int gsmtap_bursts = 0;
+
+static LLIST_HEAD(gsmtap_queue);
+static unsigned int gsmtap_queue_len = 0;
+
+int gsmtap_export_msg(struct msgb *msg)
+{
+	if (!gsmtap) {
+		msgb_free(msg);
+		return 0;
+	}
+
+	if (gsmtap_queue_len >= GSMTAP_QUEUE_MAX) {
+		gsmtap_export_stats.dropped++;
+		msgb_free(msg);
+		return -ENOBUFS;
+	}
+
+	msgb_enqueue(&gsmtap_queue, msg);
+	gsmtap_queue_len++;
+	gsmtap_export_stats.queued++;
+
+	return 0;
+}
+
+int gsmtap_export_burst(uint16_t arfcn, uint8_t tn, uint32_t fn,
+	uint8_t sub_type, int8_t signal_dbm, const uint8_t *bits,
+	unsigned int len)
+{
+	struct gsmtap_hdr *gh;
+	struct msgb *msg;
+
+	if (!gsmtap)
+		return 0;
+
+	/* don't even allocate, if it would be dropped anyway */
+	if (gsmtap_queue_len >= GSMTAP_QUEUE_MAX) {
+		gsmtap_export_stats.dropped++;
+		return -ENOBUFS;
+	}
+
+	msg = msgb_alloc(sizeof(*gh) + len, "gsmtap_burst");
+	if (!msg)
+		return -ENOMEM;
+
+	gh = (struct gsmtap_hdr *) msgb_put(msg, sizeof(*gh));
+	memset(gh, 0, sizeof(*gh));
+	gh->version = GSMTAP_VERSION;
+	gh->hdr_len = sizeof(*gh) / 4;
+	gh->type = GSMTAP_TYPE_UM_BURST;
+	gh->timeslot = tn;
+	gh->sub_type = sub_type;
+	gh->arfcn = htons(arfcn);
+	gh->signal_dbm = signal_dbm;
+	gh->frame_number = htonl(fn);
+	memcpy(msgb_put(msg, len), bits, len);
+
+	return gsmtap_export_msg(msg);
+}
+
+void gsmtap_export_flush(void)
+{
+	struct mmsghdr mmsg[GSMTAP_BATCH_MAX];
+	struct iovec iov[GSMTAP_BATCH_MAX];
+	struct msgb *msgs[GSMTAP_BATCH_MAX];
+	struct msgb *msg;
+	int fd, n, rc, i;
+
+	if (!gsmtap)
+		return;
+
+	fd = gsmtap_inst_fd(gsmtap);
+
+	while (!llist_empty(&gsmtap_queue)) {
+		n = 0;
+		llist_for_each_entry(msg, &gsmtap_queue, list) {
+			if (n == GSMTAP_BATCH_MAX)
+				break;
+			iov[n].iov_base = msg->data;
+			iov[n].iov_len = msg->len;
+			memset(&mmsg[n], 0, sizeof(mmsg[n]));
+			mmsg[n].msg_hdr.msg_iov = &iov[n];
+			mmsg[n].msg_hdr.msg_iovlen = 1;
+			msgs[n++] = msg;
+		}
+
+		rc = sendmmsg(fd, mmsg, n, MSG_DONTWAIT);
+		gsmtap_export_stats.flushes++;
+		if (rc < 0) {
+			/* socket buffer is full, try again next frame */
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+			/* any other error (e.g. nobody listening) belongs
+			 * to the first message, drop it and go on */
+			LOGP_HOT(DL1P, LOGL_DEBUG, "GSMTAP send failed: %s\n",
+				strerror(errno));
+			gsmtap_export_stats.dropped++;
+			llist_del(&msgs[0]->list);
+			msgb_free(msgs[0]);
+			gsmtap_queue_len--;
+			continue;
+		}
+
+		for (i = 0; i < rc; i++) {
+			llist_del(&msgs[i]->list);
+			msgb_free(msgs[i]);
+		}
+		gsmtap_queue_len -= rc;
+		gsmtap_export_stats.sent += rc;
+
+		/* partial write, the socket buffer is full */
+		if (rc < n)
+			break;
+	}
+}
@@ -46,6 +46,11 @@
 #include <osmo-bts/abis.h>
 #include <osmo-bts/bts_model.h>
 #include <osmo-bts/handover.h>
+#include <osmo-bts/gsmtap_export.h>
+#include <osmo-bts/msgb_pool.h>
+#include <osmo-bts/rtp_conn.h>
+#include <osmo-bts/rtp_trunk.h>
+#include <osmo-bts/rach_adm.h>
 
 static int l1sap_down(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap);
 
@@ -58,7 +63,7 @@ static const uint8_t fill_frame[GSM_MACBLOCK_LEN] = {
 /* allocate a msgb containing a osmo_phsap_prim + optional l2 data */
 struct msgb *l1sap_msgb_alloc(unsigned int l2_len)
 {
-	struct msgb *msg = msgb_alloc(sizeof(struct osmo_phsap_prim) + l2_len,
+	struct msgb *msg = bts_msgb_alloc(sizeof(struct osmo_phsap_prim) + l2_len,
 		"l1sap_prim");
 
 	if (!msg)
@@ -138,9 +143,55 @@ const struct value_string gsmtap_sapi_names[] = {
 	{ 0, NULL }
 };
 
+/* GSMTAP channel type and sub-slot of each chan_nr, so that classifying a
+ * message does not need to walk the L1SAP_IS_CHAN_* chain every time. */
+#define GSMTAP_CHAN_F_PDCH	0x01	/* PACCH/PTCCH if TS is PDCH */
+#define GSMTAP_CHAN_F_CCCH	0x02	/* AGCH or PCH, depending on fn */
+
+struct gsmtap_chan_desc {
+	uint8_t chan_type;
+	uint8_t ss;
+	uint8_t flags;
+};
+
+static struct gsmtap_chan_desc gsmtap_chan_tbl[256];
+static int gsmtap_chan_tbl_valid = 0;
+
+static void gsmtap_chan_tbl_init(void)
+{
+	struct gsmtap_chan_desc *desc;
+	int chan_nr;
+
+	for (chan_nr = 0; chan_nr < 256; chan_nr++) {
+		desc = &gsmtap_chan_tbl[chan_nr];
+		if (L1SAP_IS_CHAN_TCHF(chan_nr)) {
+			desc->chan_type = GSMTAP_CHANNEL_TCH_F;
+			desc->flags = GSMTAP_CHAN_F_PDCH;
+		} else if (L1SAP_IS_CHAN_TCHH(chan_nr)) {
+			desc->ss = L1SAP_CHAN2SS_TCHH(chan_nr);
+			desc->chan_type = GSMTAP_CHANNEL_TCH_H;
+		} else if (L1SAP_IS_CHAN_SDCCH4(chan_nr)) {
+			desc->ss = L1SAP_CHAN2SS_SDCCH4(chan_nr);
+			desc->chan_type = GSMTAP_CHANNEL_SDCCH;
+		} else if (L1SAP_IS_CHAN_SDCCH8(chan_nr)) {
+			desc->ss = L1SAP_CHAN2SS_SDCCH8(chan_nr);
+			desc->chan_type = GSMTAP_CHANNEL_SDCCH;
+		} else if (L1SAP_IS_CHAN_BCCH(chan_nr)) {
+			desc->chan_type = GSMTAP_CHANNEL_BCCH;
+		} else if (L1SAP_IS_CHAN_AGCH_PCH(chan_nr)) {
+			desc->chan_type = GSMTAP_CHANNEL_PCH;
+			desc->flags = GSMTAP_CHAN_F_CCCH;
+		}
+	}
+
+	gsmtap_chan_tbl_valid = 1;
+}
+
 static int to_gsmtap(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 {
 	struct msgb *msg = l1sap->oph.msg;
+	const struct gsmtap_chan_desc *desc;
+	struct msgb *gsmtap_msg;
 	uint8_t *data;
 	int len;
 	uint8_t chan_type = 0, tn = 0, ss = 0;
@@ -148,9 +199,12 @@ static int to_gsmtap(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 	uint8_t chan_nr, link_id;
 	uint16_t uplink = GSMTAP_ARFCN_F_UPLINK;
 
-	if (!gsmtap)
+	if (!gsmtap || (!gsmtap_sapi_mask && !gsmtap_sapi_acch))
 		return 0;
 
+	if (!gsmtap_chan_tbl_valid)
+		gsmtap_chan_tbl_init();
+
 	switch (OSMO_PRIM_HDR(&l1sap->oph)) {
 	case OSMO_PRIM(PRIM_PH_DATA, PRIM_OP_REQUEST):
 		uplink = 0;
@@ -159,38 +213,28 @@ static int to_gsmtap(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 		data = msg->data + sizeof(struct osmo_phsap_prim);
 		len = msg->len - sizeof(struct osmo_phsap_prim);
 		fn = l1sap->u.data.fn;
-		tn = L1SAP_CHAN2TS(l1sap->u.data.chan_nr);
 		chan_nr = l1sap->u.data.chan_nr;
 		link_id = l1sap->u.data.link_id;
-		if (L1SAP_IS_CHAN_TCHF(chan_nr)) {
-			if (trx->ts[tn].pchan == GSM_PCHAN_PDCH) {
-				if (L1SAP_IS_PTCCH(fn)) {
-					chan_type = GSMTAP_CHANNEL_PTCCH;
-					ss = L1SAP_FN2PTCCHBLOCK(fn);
-					if (l1sap->oph.primitive
-							== PRIM_OP_INDICATION) {
-						if (data[0] == 7)
-							return -EINVAL;
-						data++;
-						len--;
-					}
-				} else {
-					chan_type = GSMTAP_CHANNEL_PACCH;
+		tn = L1SAP_CHAN2TS(chan_nr);
+		desc = &gsmtap_chan_tbl[chan_nr];
+		chan_type = desc->chan_type;
+		ss = desc->ss;
+		if ((desc->flags & GSMTAP_CHAN_F_PDCH)
+		 && trx->ts[tn].pchan == GSM_PCHAN_PDCH) {
+			if (L1SAP_IS_PTCCH(fn)) {
+				chan_type = GSMTAP_CHANNEL_PTCCH;
+				ss = L1SAP_FN2PTCCHBLOCK(fn);
+				if (l1sap->oph.primitive
+						== PRIM_OP_INDICATION) {
+					if (data[0] == 7)
+						return -EINVAL;
+					data++;
+					len--;
 				}
-			} else
-				chan_type = GSMTAP_CHANNEL_TCH_F;
-		} else if (L1SAP_IS_CHAN_TCHH(chan_nr)) {
-			ss = L1SAP_CHAN2SS_TCHH(chan_nr);
-			chan_type = GSMTAP_CHANNEL_TCH_H;
-		} else if (L1SAP_IS_CHAN_SDCCH4(chan_nr)) {
-			ss = L1SAP_CHAN2SS_SDCCH4(chan_nr);
-			chan_type = GSMTAP_CHANNEL_SDCCH;
-		} else if (L1SAP_IS_CHAN_SDCCH8(chan_nr)) {
-			ss = L1SAP_CHAN2SS_SDCCH8(chan_nr);
-			chan_type = GSMTAP_CHANNEL_SDCCH;
-		} else if (L1SAP_IS_CHAN_BCCH(chan_nr)) {
-			chan_type = GSMTAP_CHANNEL_BCCH;
-		} else if (L1SAP_IS_CHAN_AGCH_PCH(chan_nr)) {
+			} else {
+				chan_type = GSMTAP_CHANNEL_PACCH;
+			}
+		} else if ((desc->flags & GSMTAP_CHAN_F_CCCH)) {
 #warning Set BS_AG_BLKS_RES
 			/* The sapi depends on DSP configuration, not
 			 * on the actual SYSTEM INFORMATION 3. */
@@ -205,14 +249,9 @@ static int to_gsmtap(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 	case OSMO_PRIM(PRIM_PH_RACH, PRIM_OP_INDICATION):
 		chan_type = GSMTAP_CHANNEL_RACH;
 		fn = l1sap->u.rach_ind.fn;
-		tn = L1SAP_CHAN2TS(l1sap->u.rach_ind.chan_nr);
 		chan_nr = l1sap->u.rach_ind.chan_nr;
-		if (L1SAP_IS_CHAN_TCHH(chan_nr))
-			ss = L1SAP_CHAN2SS_TCHH(chan_nr);
-		else if (L1SAP_IS_CHAN_SDCCH4(chan_nr))
-			ss = L1SAP_CHAN2SS_SDCCH4(chan_nr);
-		else if (L1SAP_IS_CHAN_SDCCH8(chan_nr))
-			ss = L1SAP_CHAN2SS_SDCCH8(chan_nr);
+		tn = L1SAP_CHAN2TS(chan_nr);
+		ss = gsmtap_chan_tbl[chan_nr].ss;
 		data = &l1sap->u.rach_ind.ra;
 		len = 1;
 		break;
@@ -230,10 +269,12 @@ static int to_gsmtap(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 			return 0;
 	}
 
-	gsmtap_send(gsmtap, trx->arfcn | uplink, tn, chan_type, ss, fn, 0, 0,
-		data, len);
+	gsmtap_msg = gsmtap_makemsg(trx->arfcn | uplink, tn, chan_type, ss, fn,
+		0, 0, data, len);
+	if (!gsmtap_msg)
+		return -ENOMEM;
 
-	return 0;
+	return gsmtap_export_msg(gsmtap_msg);
 }
 
 /* time information received from bts model */
@@ -244,7 +285,7 @@ static int l1sap_info_time_ind(struct gsm_bts *bts,
 	struct gsm_bts_trx *trx;
 	struct gsm_bts_role_bts *btsb = bts->role;
 
-	DEBUGP(DL1P, "MPH_INFO time ind %u\n", info_time_ind->fn);
+	DEBUGP_HOT(DL1P, "MPH_INFO time ind %u\n", info_time_ind->fn);
 
 	/* Update our data structures with the current GSM time */
 	gsm_fn2gsmtime(&btsb->gsm_time, info_time_ind->fn);
@@ -252,6 +293,11 @@ static int l1sap_info_time_ind(struct gsm_bts *bts,
 	/* Update time on PCU interface */
 	pcu_tx_time_ind(info_time_ind->fn);
 
+	/* send GSMTAP messages and RTP frames collected during the last
+	 * frame */
+	gsmtap_export_flush();
+	rtp_trunk_flush();
+
 	/* check if the measurement period of some lchan has ended
 	 * and pre-compute the respective measurement */
 	llist_for_each_entry(trx, &bts->trx_list, list)
@@ -262,6 +308,8 @@ static int l1sap_info_time_ind(struct gsm_bts *bts,
 	 || (info_time_ind->fn % 51) < 27)
 		btsb->load.rach.total++;
 
+	rach_adm_tick(bts, info_time_ind->fn);
+
 	return 0;
 }
 
@@ -399,7 +447,7 @@ static int l1sap_ph_rts_ind(struct gsm_bts_trx *trx,
 
 	gsm_fn2gsmtime(&g_time, fn);
 
-	DEBUGP(DL1P, "Rx PH-RTS.ind %02u/%02u/%02u chan_nr=%d link_id=%d\n",
+	DEBUGP_HOT(DL1P, "Rx PH-RTS.ind %02u/%02u/%02u chan_nr=%d link_id=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr, link_id);
 
 	if (trx->ts[tn].pchan == GSM_PCHAN_PDCH) {
@@ -502,7 +550,7 @@ static int l1sap_ph_rts_ind(struct gsm_bts_trx *trx,
 		}
 	}
 
-	DEBUGP(DL1P, "Tx PH-DATA.req %02u/%02u/%02u chan_nr=%d link_id=%d\n",
+	DEBUGP_HOT(DL1P, "Tx PH-DATA.req %02u/%02u/%02u chan_nr=%d link_id=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr, link_id);
 
 	l1sap_down(trx, l1sap);
@@ -517,7 +565,7 @@ static int l1sap_tch_rts_ind(struct gsm_bts_trx *trx,
 {
 	struct msgb *resp_msg;
 	struct osmo_phsap_prim *resp_l1sap, empty_l1sap;
-	struct gsm_time g_time;
+	struct gsm_time g_time = { 0 };
 	struct gsm_lchan *lchan;
 	uint8_t chan_nr;
 	uint8_t tn, ss;
@@ -527,9 +575,10 @@ static int l1sap_tch_rts_ind(struct gsm_bts_trx *trx,
 	fn = rts_ind->fn;
 	tn = L1SAP_CHAN2TS(chan_nr);
 
-	gsm_fn2gsmtime(&g_time, fn);
+	if (bts_log_enabled(DL1P, LOGL_DEBUG))
+		gsm_fn2gsmtime(&g_time, fn);
 
-	DEBUGP(DL1P, "Rx TCH-RTS.ind %02u/%02u/%02u chan_nr=%d\n",
+	DEBUGP_HOT(DL1P, "Rx TCH-RTS.ind %02u/%02u/%02u chan_nr=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr);
 
 	/* get timeslot and subslot */
@@ -569,7 +618,7 @@ static int l1sap_tch_rts_ind(struct gsm_bts_trx *trx,
 	resp_l1sap->u.tch.chan_nr = chan_nr;
 	resp_l1sap->u.tch.fn = fn;
 
-	DEBUGP(DL1P, "Tx TCH.req %02u/%02u/%02u chan_nr=%d\n",
+	DEBUGP_HOT(DL1P, "Tx TCH.req %02u/%02u/%02u chan_nr=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr);
 
 	l1sap_down(trx, resp_l1sap);
@@ -582,7 +631,7 @@ static int l1sap_ph_data_ind(struct gsm_bts_trx *trx,
 	 struct osmo_phsap_prim *l1sap, struct ph_data_param *data_ind)
 {
 	struct msgb *msg = l1sap->oph.msg;
-	struct gsm_time g_time;
+	struct gsm_time g_time = { 0 };
 	struct gsm_lchan *lchan;
 	struct lapdm_entity *le;
 	uint8_t *data = msg->l2h;
@@ -599,9 +648,10 @@ static int l1sap_ph_data_ind(struct gsm_bts_trx *trx,
 	tn = L1SAP_CHAN2TS(chan_nr);
 	ss = l1sap_chan2ss(chan_nr);
 
-	gsm_fn2gsmtime(&g_time, fn);
+	if (bts_log_enabled(DL1P, LOGL_DEBUG))
+		gsm_fn2gsmtime(&g_time, fn);
 
-	DEBUGP(DL1P, "Rx PH-DATA.ind %02u/%02u/%02u chan_nr=%d link_id=%d\n",
+	DEBUGP_HOT(DL1P, "Rx PH-DATA.ind %02u/%02u/%02u chan_nr=%d link_id=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr, link_id);
 
 	if (trx->ts[tn].pchan == GSM_PCHAN_PDCH) {
@@ -699,7 +749,7 @@ static int l1sap_tch_ind(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap,
 	struct ph_tch_param *tch_ind)
 {
 	struct msgb *msg = l1sap->oph.msg;
-	struct gsm_time g_time;
+	struct gsm_time g_time = { 0 };
 	struct gsm_lchan *lchan;
 	uint8_t tn, ss, chan_nr;
 	uint32_t fn;
@@ -713,17 +763,29 @@ static int l1sap_tch_ind(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap,
 		ss = 0;
 	lchan = &trx->ts[tn].lchan[ss];
 
-	gsm_fn2gsmtime(&g_time, fn);
+	if (bts_log_enabled(DL1P, LOGL_DEBUG))
+		gsm_fn2gsmtime(&g_time, fn);
 
-	DEBUGP(DL1P, "Rx TCH.ind %02u/%02u/%02u chan_nr=%d\n",
+	DEBUGP_HOT(DL1P, "Rx TCH.ind %02u/%02u/%02u chan_nr=%d\n",
 		g_time.t1, g_time.t2, g_time.t3, chan_nr);
 
 	msgb_pull(msg, sizeof(*l1sap));
 
+	/* an empty frame was not transmitted by the MS (DTX), so nothing is
+	 * sent, but the RTP timestamp must keep running */
+	if (!msg->len) {
+		if (lchan->abis_ip.rtp_socket)
+			rtp_conn_skip(lchan, GSM_RTP_DURATION);
+		else
+			rtp_trunk_send(lchan, NULL, 0);
+		return 0;
+	}
+
 	/* hand msg to RTP code for transmission */
 	if (lchan->abis_ip.rtp_socket)
-		osmo_rtp_send_frame(lchan->abis_ip.rtp_socket,
-			msg->data, msg->len, 160);
+		rtp_conn_send(lchan, msg->data, msg->len, GSM_RTP_DURATION);
+	else
+		rtp_trunk_send(lchan, msg->data, msg->len);
 
 	/* if loopback is enabled, also queue received RTP data */
 	if (lchan->loopback) {
@@ -735,7 +797,7 @@ static int l1sap_tch_ind(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap,
 		count++;
 		while (count >= 1) {
 			tmp = msgb_dequeue(&lchan->dl_tch_queue);
-			msgb_free(tmp);
+			bts_msgb_free(tmp);
 			count--;
 		}
 
@@ -771,6 +833,7 @@ static int l1sap_ph_rach_ind(struct gsm_bts_trx *trx,
 	struct gsm_bts *bts = trx->bts;
 	struct gsm_bts_role_bts *btsb = bts->role;
 	struct lapdm_channel *lc;
+	enum rach_adm_result adm;
 
 	DEBUGP(DL1P, "Rx PH-RA.ind");
 
@@ -791,6 +854,8 @@ static int l1sap_ph_rach_ind(struct gsm_bts_trx *trx,
 	if (rach_ind->chan_nr != 0x88)
 		return l1sap_handover_rach(trx, l1sap, rach_ind);
 
+	btsb->load.rach.access++;
+
 	/* check for packet access */
 	if (trx == bts->c0
 	 && L1SAP_IS_PACKET_RACH(rach_ind->ra)) {
@@ -801,6 +866,14 @@ static int l1sap_ph_rach_ind(struct gsm_bts_trx *trx,
 		return 0;
 	}
 
+	adm = rach_adm_check(bts, rach_ind->ra, rach_ind->fn);
+	if (adm != RACH_ADM_ACCEPT) {
+		LOGP_HOT(DL1P, LOGL_INFO, "RACH for RR access (toa=%d, ra=%d) "
+			"%s\n", rach_ind->acc_delay, rach_ind->ra,
+			rach_adm_result_name(adm));
+		return 0;
+	}
+
 	LOGP(DL1P, LOGL_INFO, "RACH for RR access (toa=%d, ra=%d)\n",
 		rach_ind->acc_delay, rach_ind->ra);
 	lapdm_phsap_up(&l1sap->oph, &lc->lapdm_dcch);
@@ -846,7 +919,7 @@ int l1sap_up(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 
 	/* Special return value '1' means: do not free */
 	if (rc != 1 && msg)
-		msgb_free(msg);
+		bts_msgb_free(msg);
 
 	return rc;
 }
@@ -893,6 +966,15 @@ void l1sap_rtp_rx_cb(struct osmo_rtp_socket *rs, const uint8_t *rtp_pl,
                          unsigned int rtp_pl_len)
 {
 	struct gsm_lchan *lchan = rs->priv;
+
+	rtp_conn_rx(lchan, rtp_pl_len);
+	l1sap_rtp_rx_frame(lchan, rtp_pl, rtp_pl_len);
+}
+
+/*! \brief queue a downlink TCH frame received from the network */
+void l1sap_rtp_rx_frame(struct gsm_lchan *lchan, const uint8_t *rtp_pl,
+	unsigned int rtp_pl_len)
+{
 	struct msgb *msg, *tmp;
 	struct osmo_phsap_prim *l1sap;
 	int count = 0;
@@ -909,7 +991,7 @@ void l1sap_rtp_rx_cb(struct osmo_rtp_socket *rs, const uint8_t *rtp_pl,
 	count++;
 	while (count >= 2) {
 		tmp = msgb_dequeue(&lchan->dl_tch_queue);
-		msgb_free(tmp);
+		bts_msgb_free(tmp);
 		count--;
 	}
 
@@ -26,6 +26,10 @@
 #include <osmocom/core/logging.h>
 #include <osmocom/core/application.h>
 #include <osmocom/core/utils.h>
+#include <osmocom/core/signal.h>
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/vty/vty.h>
+#include <osmocom/vty/telnet_interface.h>
 
 #include <osmo-bts/bts.h>
 #include <osmo-bts/logging.h>
@@ -144,6 +148,64 @@ const struct log_info bts_log_info = {
 	.num_cat = ARRAY_SIZE(bts_log_info_cat),
 };
 
+/* log target configuration may only change through the VTY, so the cached
+ * levels are refreshed after each command read from a VTY connection and
+ * when a connection, maybe with its own log target, is closed */
+uint8_t bts_log_min_level[DSUM];
+
+/* compute the cache over all targets except 'skip' */
+static void log_cache_compute(const struct log_target *skip)
+{
+	struct log_target *tar;
+	uint8_t level;
+	int i;
+
+	for (i = 0; i < DSUM; i++)
+		bts_log_min_level[i] = 0xff;
+
+	llist_for_each_entry(tar, &osmo_log_target_list, entry) {
+		if (tar == skip)
+			continue;
+		for (i = 0; i < DSUM; i++) {
+			if (!tar->categories[i].enabled)
+				continue;
+			/* the global level of a target overrides the one of
+			 * each category, zero means 'everything' */
+			if (tar->loglevel)
+				level = tar->loglevel;
+			else
+				level = tar->categories[i].loglevel;
+			if (level < bts_log_min_level[i])
+				bts_log_min_level[i] = level;
+		}
+	}
+}
+
+void bts_log_cache_update(void)
+{
+	log_cache_compute(NULL);
+}
+
+static int log_vty_signal_cb(unsigned int subsys, unsigned int signal,
+	void *handler_data, void *signal_data)
+{
+	struct vty_signal_data *sig = signal_data;
+	struct telnet_connection *conn;
+
+	if (subsys != SS_L_VTY || signal != S_VTY_EVENT)
+		return 0;
+
+	/* the log target of a closing connection is only deleted after
+	 * the signal */
+	if (sig->event == VTY_CLOSED && sig->vty && sig->vty->priv) {
+		conn = sig->vty->priv;
+		log_cache_compute(conn->dbg);
+	} else
+		log_cache_compute(NULL);
+
+	return 0;
+}
+
 int bts_log_init(const char *category_mask)
 {
 	osmo_init_logging(&bts_log_info);
@@ -151,5 +213,8 @@ int bts_log_init(const char *category_mask)
 	if (category_mask)
 		log_parse_category_mask(osmo_stderr_target, category_mask);
 
+	bts_log_cache_update();
+	osmo_signal_register_handler(SS_L_VTY, log_vty_signal_cb, NULL);
+
 	return 0;
 }
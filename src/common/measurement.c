@@ -1,10 +1,12 @@
 
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 
 #include <osmocom/gsm/gsm_utils.h>
 
 #include <osmo-bts/gsm_data.h>
+#include <osmo-bts/bts.h>
 #include <osmo-bts/logging.h>
 #include <osmo-bts/measurement.h>
 
@@ -41,54 +43,50 @@ static const uint8_t tchh1_meas_rep_fn104[] = {
 	[7] =	90,
 };
 
-/* determine if a measurement period ends at the given frame number */
-static int is_meas_complete(enum gsm_phys_chan_config pchan, unsigned int ts,
-			    unsigned int subch, uint32_t fn)
+/* Per-fn schedule of the measurement period ends, so that only those
+ * lchans are visited, whose SACCH period ends at the given frame:
+ * bits 0..7 are TCH/F on TS 0..7, bits 8..15 TCH/H subchannel 0 and
+ * bits 16..23 TCH/H subchannel 1. SDCCH periods end at fn % 102 == 11
+ * (SDCCH/8) or 36 (SDCCH/4) on all timeslots. */
+#define MEAS_SCHED_TCHH0(ts)	(1 << (8 + (ts)))
+#define MEAS_SCHED_TCHH1(ts)	(1 << (16 + (ts)))
+#define MEAS_SDCCH8_FN102	11
+#define MEAS_SDCCH4_FN102	36
+
+static uint32_t meas_sched_fn104[104];
+static int meas_sched_valid = 0;
+
+static void meas_sched_init(void)
 {
-	unsigned int fn_mod;
-	const uint8_t *tbl;
-	int rc = 0;
-
-	if (ts >= 8)
-		return -EINVAL;
-	if (pchan >= _GSM_PCHAN_MAX)
-		return -EINVAL;
-
-	switch (pchan) {
-	case GSM_PCHAN_TCH_F:
-		fn_mod = fn % 104;
-		if (tchf_meas_rep_fn104[ts] == fn_mod)
-			rc = 1;
-		break;
-	case GSM_PCHAN_TCH_H:
-		fn_mod = fn % 104;
-		if (subch == 0)	
-			tbl = tchh0_meas_rep_fn104;
-		else
-			tbl = tchh1_meas_rep_fn104;
-		if (tbl[ts] == fn_mod)
-			rc = 1;
-		break;
-	case GSM_PCHAN_SDCCH8_SACCH8C:
-		fn_mod = fn % 102;
-		if (fn_mod == 11)
-			rc = 1;
-		break;
-	case GSM_PCHAN_CCCH_SDCCH4:
-		fn_mod = fn % 102;
-		if (fn_mod == 36)
-			rc = 1;
-		break;
-	default:
-		rc = 0;
-		break;
+	int ts;
+
+	for (ts = 0; ts < 8; ts++) {
+		meas_sched_fn104[tchf_meas_rep_fn104[ts]] |= (1 << ts);
+		meas_sched_fn104[tchh0_meas_rep_fn104[ts]] |=
+			MEAS_SCHED_TCHH0(ts);
+		meas_sched_fn104[tchh1_meas_rep_fn104[ts]] |=
+			MEAS_SCHED_TCHH1(ts);
 	}
-	return rc;
+
+	meas_sched_valid = 1;
+}
+
+/* reset the measurement state, when an lchan is activated */
+void lchan_meas_reset(struct gsm_lchan *lchan)
+{
+	struct lchan_priv *priv = bts_lchan_priv(lchan);
+
+	if (priv)
+		memset(&priv->meas, 0, sizeof(priv->meas));
+	lchan->meas.num_ul_meas = 0;
 }
 
 /* receive a L1 uplink measurement from L1 */
 int lchan_new_ul_meas(struct gsm_lchan *lchan, struct bts_ul_meas *ulm)
 {
+	struct lchan_priv *priv;
+	struct lchan_meas_state *st;
+
 	/* in the GPRS case we are not interested in measurement
 	 * processing.  The PCU will take care of it */
 	if (lchan->type == GSM_LCHAN_PDTCH)
@@ -102,18 +100,53 @@ int lchan_new_ul_meas(struct gsm_lchan *lchan, struct bts_ul_meas *ulm)
 			gsm_lchan_name(lchan), gsm_lchans_name(lchan->state));
 	}
 
-	if (lchan->meas.num_ul_meas >= ARRAY_SIZE(lchan->meas.uplink)) {
-		LOGP(DMEAS, LOGL_NOTICE, "%s no space for uplink measurement\n",
-			gsm_lchan_name(lchan));
-		return -ENOSPC;
+	priv = bts_lchan_priv(lchan);
+	if (!priv)
+		return -ENOMEM;
+	st = &priv->meas;
+
+	st->ber_full_sum += ulm->ber10k;
+	st->irssi_full_sum += ulm->inv_rssi;
+	st->taqb_sum += ulm->ta_offs_qbits;
+	st->num_meas++;
+
+	if (ulm->is_sub) {
+		st->ber_sub_sum += ulm->ber10k;
+		st->irssi_sub_sum += ulm->inv_rssi;
+		st->num_meas_sub++;
 	}
 
-	memcpy(&lchan->meas.uplink[lchan->meas.num_ul_meas++], ulm,
-		sizeof(*ulm));
+	lchan->meas.num_ul_meas = st->num_meas;
 
 	return 0;
 }
 
+/* store the result of a period in the ring, drop the oldest results that
+ * are out of the averaging window */
+static void meas_hist_push(struct lchan_meas_state *st,
+	const struct meas_period *p, unsigned int window)
+{
+	struct meas_period *old;
+
+	while (st->hist_num && st->hist_num >= window) {
+		old = &st->hist[(st->hist_head + MEAS_AVG_PERIODS_MAX
+			- st->hist_num) % MEAS_AVG_PERIODS_MAX];
+		st->hist_sum.ber_full -= old->ber_full;
+		st->hist_sum.irssi_full -= old->irssi_full;
+		st->hist_sum.ber_sub -= old->ber_sub;
+		st->hist_sum.irssi_sub -= old->irssi_sub;
+		st->hist_num--;
+	}
+
+	st->hist[st->hist_head] = *p;
+	st->hist_sum.ber_full += p->ber_full;
+	st->hist_sum.irssi_full += p->irssi_full;
+	st->hist_sum.ber_sub += p->ber_sub;
+	st->hist_sum.irssi_sub += p->irssi_sub;
+	st->hist_head = (st->hist_head + 1) % MEAS_AVG_PERIODS_MAX;
+	st->hist_num++;
+}
+
 /* input: BER in steps of .01%, i.e. percent/100 */
 static uint8_t ber10k_to_rxqual(uint32_t ber10k)
 {
@@ -135,65 +168,70 @@ static uint8_t ber10k_to_rxqual(uint32_t ber10k)
 	return 7;
 }
 
-static int lchan_meas_check_compute(struct gsm_lchan *lchan, uint32_t fn)
+static int lchan_meas_compute(struct gsm_lchan *lchan)
 {
-	uint32_t ber_full_sum = 0;
-	uint32_t irssi_full_sum = 0;
-	uint32_t ber_sub_sum = 0;
-	uint32_t irssi_sub_sum = 0;
-	int32_t taqb_sum = 0;
-	unsigned int num_meas_sub = 0;
-	int i;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(lchan->ts->trx->bts);
+	struct lchan_priv *priv;
+	struct lchan_meas_state *st;
+	struct meas_period p;
+	int32_t taqb;
+
+	switch (lchan->type) {
+	case GSM_LCHAN_SDCCH:
+	case GSM_LCHAN_TCH_F:
+	case GSM_LCHAN_TCH_H:
+		break;
+	default:
+		return 0;
+	}
 
-	/* if measurement period is not complete, abort */
-	if (!is_meas_complete(lchan->ts->pchan, lchan->ts->nr,
-			      lchan->nr, fn))
+	priv = bts_lchan_priv(lchan);
+	if (!priv)
 		return 0;
+	st = &priv->meas;
 
 	/* if there are no measurements, skip computation */
-	if (lchan->meas.num_ul_meas == 0)
+	if (st->num_meas == 0)
 		return 0;
 
-	/* compute the actual measurements */
-
-	/* step 1: add up */
-	for (i = 0; i < lchan->meas.num_ul_meas; i++) {
-		struct bts_ul_meas *m = &lchan->meas.uplink[i];
-
-		ber_full_sum += m->ber10k;
-		irssi_full_sum += m->inv_rssi;
-		taqb_sum += m->ta_offs_qbits;
-
-		if (m->is_sub) {
-			num_meas_sub++;
-			ber_sub_sum += m->ber10k;
-			irssi_sub_sum += m->inv_rssi;
-		}
-	}
-
-	/* step 2: divide */
-	ber_full_sum = ber_full_sum / lchan->meas.num_ul_meas;
-	irssi_full_sum = irssi_full_sum / lchan->meas.num_ul_meas;
-	taqb_sum = taqb_sum / lchan->meas.num_ul_meas;
-
-	if (num_meas_sub) {
-		ber_sub_sum = ber_sub_sum / num_meas_sub;
-		irssi_sub_sum = irssi_sub_sum / num_meas_sub;
+	/* compute the actual measurements of this period */
+	p.ber_full = st->ber_full_sum / st->num_meas;
+	p.irssi_full = st->irssi_full_sum / st->num_meas;
+	taqb = st->taqb_sum / st->num_meas;
+	if (st->num_meas_sub) {
+		p.ber_sub = st->ber_sub_sum / st->num_meas_sub;
+		p.irssi_sub = st->irssi_sub_sum / st->num_meas_sub;
+	} else {
+		p.ber_sub = 0;
+		p.irssi_sub = 0;
 	}
 
 	DEBUGP(DMEAS, "%s Computed TA(% 4dqb) BER-FULL(%2u.%02u%%), RSSI-FULL(-%3udBm), "
 		"BER-SUB(%2u.%02u%%), RSSI-SUB(-%3udBm)\n", gsm_lchan_name(lchan),
-		taqb_sum, ber_full_sum/100,
-		ber_full_sum%100, irssi_full_sum, ber_sub_sum/100, ber_sub_sum%100,
-		irssi_sub_sum);
+		taqb, p.ber_full/100,
+		p.ber_full%100, p.irssi_full, p.ber_sub/100, p.ber_sub%100,
+		p.irssi_sub);
+
+	/* average over the configured number of periods */
+	meas_hist_push(st, &p, btsb->meas.avg_periods);
+	p.ber_full = st->hist_sum.ber_full / st->hist_num;
+	p.irssi_full = st->hist_sum.irssi_full / st->hist_num;
+	p.ber_sub = st->hist_sum.ber_sub / st->hist_num;
+	p.irssi_sub = st->hist_sum.irssi_sub / st->hist_num;
 
 	/* store results */
-	lchan->meas.res.rxlev_full = dbm2rxlev((int)irssi_full_sum * -1);
-	lchan->meas.res.rxlev_sub = dbm2rxlev((int)irssi_sub_sum * -1);
-	lchan->meas.res.rxqual_full = ber10k_to_rxqual(ber_full_sum);
-	lchan->meas.res.rxqual_sub = ber10k_to_rxqual(ber_sub_sum);
+	lchan->meas.res.rxlev_full = dbm2rxlev((int)p.irssi_full * -1);
+	lchan->meas.res.rxlev_sub = dbm2rxlev((int)p.irssi_sub * -1);
+	lchan->meas.res.rxqual_full = ber10k_to_rxqual(p.ber_full);
+	lchan->meas.res.rxqual_sub = ber10k_to_rxqual(p.ber_sub);
 
 	lchan->meas.flags |= LC_UL_M_F_RES_VALID;
+
+	/* start the next period */
+	st->ber_full_sum = st->irssi_full_sum = 0;
+	st->ber_sub_sum = st->irssi_sub_sum = 0;
+	st->taqb_sum = 0;
+	st->num_meas = st->num_meas_sub = 0;
 	lchan->meas.num_ul_meas = 0;
 
 	/* send a signal indicating computation is complete */
@@ -212,38 +250,62 @@ int lchan_build_rsl_ul_meas(struct gsm_lchan *lchan, uint8_t *buf)
 	return 3;
 }
 
-static int ts_meas_check_compute(struct gsm_bts_trx_ts *ts, uint32_t fn)
+static void ts_meas_compute(struct gsm_bts_trx_ts *ts, unsigned int first,
+	unsigned int num)
 {
-	int i;
+	unsigned int i;
 
-	for (i = 0; i < ARRAY_SIZE(ts->lchan); i++) {
+	for (i = first; i < first + num; i++) {
 		struct gsm_lchan *lchan = &ts->lchan[i];
 
 		if (lchan->state != LCHAN_S_ACTIVE)
 			continue;
 
-		switch (lchan->type) {
-		case GSM_LCHAN_SDCCH:
-		case GSM_LCHAN_TCH_F:
-		case GSM_LCHAN_TCH_H:
-		case GSM_LCHAN_PDTCH:
-			lchan_meas_check_compute(lchan, fn);
-			break;
-		default:
-			break;
-		}
+		lchan_meas_compute(lchan);
 	}
-	return 0;
 }
 
 /* needs to be called once every TDMA frame ! */
 int trx_meas_check_compute(struct gsm_bts_trx *trx, uint32_t fn)
 {
+	unsigned int fn102 = fn % 102;
+	uint32_t sched;
 	int i;
 
+	if (!meas_sched_valid)
+		meas_sched_init();
+
+	/* most frames don't end any measurement period */
+	sched = meas_sched_fn104[fn % 104];
+	if (!sched && fn102 != MEAS_SDCCH8_FN102
+	 && fn102 != MEAS_SDCCH4_FN102)
+		return 0;
+
 	for (i = 0; i < ARRAY_SIZE(trx->ts); i++) {
 		struct gsm_bts_trx_ts *ts = &trx->ts[i];
-		ts_meas_check_compute(ts, fn);
+
+		switch (ts->pchan) {
+		case GSM_PCHAN_TCH_F:
+			if (sched & (1 << i))
+				ts_meas_compute(ts, 0, 1);
+			break;
+		case GSM_PCHAN_TCH_H:
+			if (sched & MEAS_SCHED_TCHH0(i))
+				ts_meas_compute(ts, 0, 1);
+			if (sched & MEAS_SCHED_TCHH1(i))
+				ts_meas_compute(ts, 1, 1);
+			break;
+		case GSM_PCHAN_SDCCH8_SACCH8C:
+			if (fn102 == MEAS_SDCCH8_FN102)
+				ts_meas_compute(ts, 0, 8);
+			break;
+		case GSM_PCHAN_CCCH_SDCCH4:
+			if (fn102 == MEAS_SDCCH4_FN102)
+				ts_meas_compute(ts, 0, 4);
+			break;
+		default:
+			break;
+		}
 	}
 	return 0;
 }
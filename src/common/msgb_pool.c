@@ -0,0 +1,192 @@
+/* Pools of msgbs for the per frame primitives */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/linuxlist.h>
+
+#include <osmo-bts/msgb_pool.h>
+
+/* Every uplink block, TCH frame, RTP packet and PCU primitive needs a msgb,
+ * so instead of going through malloc()/free() for each of them, msgbs given
+ * back with bts_msgb_free() are kept on a free list of their size class.
+ * A msgb released with plain msgb_free() is simply freed. The msgbs of the
+ * pools are children of a "msgb_pool" talloc context, so they show up as
+ * such in a talloc report. osmo-bts is single threaded, so there is no
+ * locking. */
+struct msgb_pool msgb_pools[MSGB_POOL_MAX] = {
+	/* L1SAP primitives with L2 or TCH data */
+	{ .size = 256,	.max_free = 256,
+	  .free = LLIST_HEAD_INIT(msgb_pools[0].free) },
+	/* L1SAP RTS and PCU primitives */
+	{ .size = 512,	.max_free = 128,
+	  .free = LLIST_HEAD_INIT(msgb_pools[1].free) },
+};
+unsigned int msgb_pools_num = 2;
+
+static void *tall_msgb_pool_ctx;
+
+/* the smallest pool that fits, pools added later are not sorted */
+static struct msgb_pool *msgb_pool_find(uint16_t size)
+{
+	struct msgb_pool *pool = NULL;
+	int i;
+
+	for (i = 0; i < msgb_pools_num; i++) {
+		if (size > msgb_pools[i].size)
+			continue;
+		if (!pool || msgb_pools[i].size < pool->size)
+			pool = &msgb_pools[i];
+	}
+
+	return pool;
+}
+
+/* only keeps the books of a msgb in use, which is freed by msgb_free() */
+static int msgb_pool_destructor(struct msgb *msg)
+{
+	struct msgb_pool *pool = msgb_pool_find(msg->data_len);
+
+	if (pool) {
+		pool->num_used--;
+		pool->stats.released++;
+	}
+
+	return 0;
+}
+
+static struct msgb *msgb_pool_alloc(struct msgb_pool *pool, const char *name)
+{
+	struct msgb *msg;
+
+	msg = msgb_alloc(pool->size, name);
+	if (!msg) {
+		pool->stats.failed++;
+		return NULL;
+	}
+	pool->stats.allocated++;
+
+	if (!tall_msgb_pool_ctx)
+		tall_msgb_pool_ctx = talloc_named_const(talloc_parent(msg), 0,
+			"msgb_pool");
+	talloc_steal(tall_msgb_pool_ctx, msg);
+
+	return msg;
+}
+
+/* the whole msgb as msgb_alloc() returns it, except for the name */
+static void msgb_pool_reset(struct msgb *msg)
+{
+	uint16_t data_len = msg->data_len;
+
+	memset(msg, 0, sizeof(*msg));
+	msg->data_len = data_len;
+	msgb_reset(msg);
+	memset(msg->_data, 0, data_len);
+}
+
+struct msgb *bts_msgb_alloc_headroom(uint16_t size, uint16_t headroom,
+	const char *name)
+{
+	struct msgb_pool *pool = msgb_pool_find(size);
+	struct msgb *msg;
+
+	if (!pool)
+		return msgb_alloc_headroom(size, headroom, name);
+
+	if (!llist_empty(&pool->free)) {
+		msg = llist_entry(pool->free.next, struct msgb, list);
+		llist_del(&msg->list);
+		pool->num_free--;
+		pool->stats.recycled++;
+
+		talloc_set_name_const(msg, name);
+		msgb_pool_reset(msg);
+	} else {
+		msg = msgb_pool_alloc(pool, name);
+		if (!msg)
+			return NULL;
+	}
+	talloc_set_destructor(msg, msgb_pool_destructor);
+
+	pool->num_used++;
+	if (pool->num_used > pool->high_watermark)
+		pool->high_watermark = pool->num_used;
+
+	msgb_reserve(msg, headroom);
+
+	return msg;
+}
+
+void bts_msgb_free(struct msgb *msg)
+{
+	struct msgb_pool *pool;
+
+	if (!msg)
+		return;
+
+	/* not one of ours, or the free list is full */
+	pool = msgb_pool_find(msg->data_len);
+	if (!pool || pool->size != msg->data_len
+	 || talloc_parent(msg) != tall_msgb_pool_ctx
+	 || pool->num_free >= pool->max_free) {
+		msgb_free(msg);
+		return;
+	}
+
+	talloc_set_destructor(msg, NULL);
+	pool->num_used--;
+
+	/* put it in front, so that the next allocation gets a msgb, which
+	 * is still in the cache */
+	llist_add(&msg->list, &pool->free);
+	pool->num_free++;
+}
+
+int msgb_pool_add(uint16_t size, unsigned int max_free,
+	unsigned int prealloc)
+{
+	struct msgb_pool *pool = msgb_pool_find(size);
+	struct msgb *msg;
+
+	if (!pool || pool->size != size) {
+		if (msgb_pools_num >= MSGB_POOL_MAX)
+			return -ENOSPC;
+		pool = &msgb_pools[msgb_pools_num++];
+		memset(pool, 0, sizeof(*pool));
+		pool->size = size;
+		INIT_LLIST_HEAD(&pool->free);
+	}
+
+	if (max_free > pool->max_free)
+		pool->max_free = max_free;
+
+	while (prealloc-- && pool->num_free < pool->max_free) {
+		msg = msgb_pool_alloc(pool, "msgb_pool");
+		if (!msg)
+			return -ENOMEM;
+		llist_add(&msg->list, &pool->free);
+		pool->num_free++;
+	}
+
+	return 0;
+}
@@ -40,6 +40,7 @@
 #include <osmo-bts/rsl.h>
 #include <osmo-bts/signal.h>
 #include <osmo-bts/l1sap.h>
+#include <osmo-bts/msgb_pool.h>
 
 uint32_t trx_get_hlayer1(struct gsm_bts_trx *trx);
 
@@ -84,7 +85,7 @@ struct msgb *pcu_msgb_alloc(uint8_t msg_type, uint8_t bts_nr)
 	struct msgb *msg;
 	struct gsm_pcu_if *pcu_prim;
 
-	msg = msgb_alloc(sizeof(struct gsm_pcu_if), "pcu_sock_tx");
+	msg = bts_msgb_alloc(sizeof(struct gsm_pcu_if), "pcu_sock_tx");
 	if (!msg)
 		return NULL;
 	msgb_put(msg, sizeof(struct gsm_pcu_if));
@@ -595,7 +596,7 @@ static int pcu_sock_send(struct gsm_network *net, struct msgb *msg)
 		if (pcu_prim->msg_type != PCU_IF_MSG_TIME_IND)
 			LOGP(DPCU, LOGL_INFO, "PCU socket not created, "
 				"dropping message\n");
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		return -EINVAL;
 	}
 	conn_bfd = &state->conn_bfd;
@@ -603,7 +604,7 @@ static int pcu_sock_send(struct gsm_network *net, struct msgb *msg)
 		if (pcu_prim->msg_type != PCU_IF_MSG_TIME_IND)
 			LOGP(DPCU, LOGL_NOTICE, "PCU socket not connected, "
 				"dropping message\n");
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		return -EIO;
 	}
 	msgb_enqueue(&state->upqueue, msg);
@@ -655,7 +656,7 @@ static void pcu_sock_close(struct pcu_sock_state *state)
 	/* flush the queue */
 	while (!llist_empty(&state->upqueue)) {
 		struct msgb *msg = msgb_dequeue(&state->upqueue);
-		msgb_free(msg);
+		bts_msgb_free(msg);
 	}
 }
 
@@ -666,7 +667,7 @@ static int pcu_sock_read(struct osmo_fd *bfd)
 	struct msgb *msg;
 	int rc;
 
-	msg = msgb_alloc(sizeof(*pcu_prim), "pcu_sock_rx");
+	msg = bts_msgb_alloc(sizeof(*pcu_prim), "pcu_sock_rx");
 	if (!msg)
 		return -ENOMEM;
 
@@ -686,12 +687,12 @@ static int pcu_sock_read(struct osmo_fd *bfd)
 
 	/* as we always synchronously process the message in pcu_rx() and
 	 * its callbacks, we can free the message here. */
-	msgb_free(msg);
+	bts_msgb_free(msg);
 
 	return rc;
 
 close:
-	msgb_free(msg);
+	bts_msgb_free(msg);
 	pcu_sock_close(state);
 	return -1;
 }
@@ -734,7 +735,7 @@ dontsend:
 		/* _after_ we send it, we can deueue */
 		msg2 = msgb_dequeue(&state->upqueue);
 		assert(msg == msg2);
-		msgb_free(msg);
+		bts_msgb_free(msg);
 	}
 	return 0;
 
@@ -0,0 +1,258 @@
+/* Admission control of access bursts and access class barring */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <osmocom/core/signal.h>
+#include <osmocom/core/utils.h>
+#include <osmocom/gsm/sysinfo.h>
+#include <osmocom/gsm/protocol/gsm_04_08.h>
+#include <osmocom/vty/vty.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/signal.h>
+#include <osmo-bts/rach_adm.h>
+
+#define HYPERFRAME	2715648
+
+/* a TDMA frame lasts 120/26 ms, so time is counted in 1/26000 s */
+#define UNITS_FRAME	120
+#define UNITS_SEC	26000
+
+/* the RACH control parameters of the system information types */
+static const struct {
+	int si;
+	unsigned int offset;
+} si_rach[4] = {
+	{ SYSINFO_TYPE_1,
+	  offsetof(struct gsm48_system_information_type_1, rach_control) },
+	{ SYSINFO_TYPE_2,
+	  offsetof(struct gsm48_system_information_type_2, rach_control) },
+	{ SYSINFO_TYPE_3,
+	  offsetof(struct gsm48_system_information_type_3, rach_control) },
+	{ SYSINFO_TYPE_4,
+	  offsetof(struct gsm48_system_information_type_4, rach_control) },
+};
+
+static const struct value_string rach_adm_result_names[] = {
+	{ RACH_ADM_ACCEPT,	"accepted" },
+	{ RACH_ADM_DUPLICATE,	"duplicate" },
+	{ RACH_ADM_RATE_LIMIT,	"rate limited" },
+	{ 0, NULL }
+};
+
+const char *rach_adm_result_name(enum rach_adm_result res)
+{
+	return get_value_string(rach_adm_result_names, res);
+}
+
+uint16_t rach_adm_barred(struct gsm_bts *bts)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+
+	return (1 << (2 * adm->level)) - 1;
+}
+
+static struct gsm48_rach_control *si_rach_control(struct gsm_bts *bts, int i)
+{
+	return (struct gsm48_rach_control *)
+		(bts->si_buf[si_rach[i].si] + si_rach[i].offset);
+}
+
+/* write the barred classes of the current level into SI 'i' */
+static void si_apply(struct gsm_bts *bts, int i)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+	struct gsm48_rach_control *rc;
+	uint16_t barred = rach_adm_barred(bts);
+
+	if (!(adm->si_known & (1 << i)))
+		return;
+
+	/* the classes barred by the BSC stay barred */
+	rc = si_rach_control(bts, i);
+	rc->t2 = adm->si_orig[i][0] | (barred >> 8);
+	rc->t3 = adm->si_orig[i][1] | (barred & 0xff);
+}
+
+void rach_adm_si_update(struct gsm_bts *bts, int si)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+	struct gsm48_rach_control *rc;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(si_rach); i++) {
+		if (si_rach[i].si != si)
+			continue;
+		if (!(bts->si_valid & (1 << si))) {
+			adm->si_known &= ~(1 << i);
+			return;
+		}
+		rc = si_rach_control(bts, i);
+		adm->si_orig[i][0] = rc->t2;
+		adm->si_orig[i][1] = rc->t3;
+		adm->si_known |= (1 << i);
+		si_apply(bts, i);
+		return;
+	}
+}
+
+static void set_level(struct gsm_bts *bts, uint8_t level)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+	int i;
+
+	LOGP(DL1P, LOGL_NOTICE, "RACH load %u/s, barring level %u -> %u\n",
+		adm->load, adm->level, level);
+
+	adm->level = level;
+	adm->stats.bar_changes++;
+	for (i = 0; i < ARRAY_SIZE(si_rach); i++)
+		si_apply(bts, i);
+	osmo_signal_dispatch(SS_GLOBAL, S_NEW_SYSINFO, bts);
+}
+
+/* a second has passed, adapt the barring to the load */
+static void second_elapsed(struct gsm_bts *bts)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+
+	adm->load = adm->offered;
+	adm->offered = 0;
+
+	if (!adm->bar_high) {
+		if (adm->level)
+			set_level(bts, 0);
+		return;
+	}
+
+	/* raise at once, lower only after RACH_ADM_HOLD quiet seconds, as
+	 * the barring itself reduces the load */
+	if (adm->load >= adm->bar_high) {
+		adm->hold = 0;
+		if (adm->level < RACH_ADM_MAX_LEVEL)
+			set_level(bts, adm->level + 1);
+	} else if (adm->load <= adm->bar_low && adm->level) {
+		if (++adm->hold >= RACH_ADM_HOLD) {
+			adm->hold = 0;
+			set_level(bts, adm->level - 1);
+		}
+	} else
+		adm->hold = 0;
+}
+
+void rach_adm_tick(struct gsm_bts *bts, uint32_t fn)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+	uint32_t frames, units, max;
+
+	max = adm->rate_limit * UNITS_SEC;
+	if (!adm->running) {
+		adm->running = 1;
+		adm->last_fn = fn;
+		adm->credit = max;
+		return;
+	}
+
+	/* after a gap of more than a second, there is nothing to catch up */
+	frames = (fn + HYPERFRAME - adm->last_fn) % HYPERFRAME;
+	adm->last_fn = fn;
+	if (frames > UNITS_SEC / UNITS_FRAME + 1)
+		frames = UNITS_SEC / UNITS_FRAME + 1;
+	units = frames * UNITS_FRAME;
+
+	/* the bucket holds the requests of up to one second */
+	adm->credit += units * adm->rate_limit;
+	if (adm->credit > max)
+		adm->credit = max;
+
+	adm->period += units;
+	if (adm->period >= UNITS_SEC) {
+		adm->period -= UNITS_SEC;
+		second_elapsed(bts);
+	}
+}
+
+enum rach_adm_result rach_adm_check(struct gsm_bts *bts, uint8_t ra,
+	uint32_t fn)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+	int i;
+
+	adm->stats.received++;
+
+	/* emergency calls are neither suppressed nor limited */
+	if ((ra & 0xe0) == 0xa0) {
+		adm->stats.emergency++;
+		adm->stats.admitted++;
+		return RACH_ADM_ACCEPT;
+	}
+
+	/* an MS repeats its request until it is answered, each repetition
+	 * would cost another CHAN RQD and maybe another channel */
+	if (adm->dup_window) {
+		for (i = 0; i < RACH_ADM_HIST; i++) {
+			if (!adm->hist[i].valid || adm->hist[i].ra != ra)
+				continue;
+			if ((fn + HYPERFRAME - adm->hist[i].fn) % HYPERFRAME
+			    >= adm->dup_window)
+				continue;
+			adm->hist[i].fn = fn;
+			adm->stats.duplicate++;
+			return RACH_ADM_DUPLICATE;
+		}
+		adm->hist[adm->hist_next].ra = ra;
+		adm->hist[adm->hist_next].fn = fn;
+		adm->hist[adm->hist_next].valid = 1;
+		adm->hist_next = (adm->hist_next + 1) % RACH_ADM_HIST;
+	}
+
+	adm->offered++;
+
+	if (adm->rate_limit) {
+		if (adm->credit < UNITS_SEC) {
+			adm->stats.rate_limited++;
+			return RACH_ADM_RATE_LIMIT;
+		}
+		adm->credit -= UNITS_SEC;
+	}
+
+	adm->stats.admitted++;
+	return RACH_ADM_ACCEPT;
+}
+
+void rach_adm_dump_vty(struct vty *vty, struct gsm_bts *bts)
+{
+	struct rach_adm *adm = &bts_role_bts(bts)->rach_adm;
+
+	vty_out(vty, "  RACH admission: %u received, %u admitted, "
+		"%u duplicate, %u rate limited, %u emergency%s",
+		adm->stats.received, adm->stats.admitted,
+		adm->stats.duplicate, adm->stats.rate_limited,
+		adm->stats.emergency, VTY_NEWLINE);
+	if (adm->level)
+		vty_out(vty, "  RACH load %u/s, ACC 0-%u barred, "
+			"%u level changes%s", adm->load, 2 * adm->level - 1,
+			adm->stats.bar_changes, VTY_NEWLINE);
+	else
+		vty_out(vty, "  RACH load %u/s, no barring, "
+			"%u level changes%s", adm->load,
+			adm->stats.bar_changes, VTY_NEWLINE);
+}
@@ -21,7 +21,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <errno.h>
+#include <time.h>
 #include <netdb.h>
 #include <sys/types.h>
 #include <arpa/inet.h>
@@ -45,6 +47,9 @@
 #include <osmo-bts/pcu_if.h>
 #include <osmo-bts/l1sap.h>
 #include <osmo-bts/handover.h>
+#include <osmo-bts/rtp_conn.h>
+#include <osmo-bts/rtp_trunk.h>
+#include <osmo-bts/rach_adm.h>
 
 //#define FAKE_CIPH_MODE_COMPL
 
@@ -93,10 +98,21 @@ void gsm48_gen_starting_time(uint8_t *out, struct gsm_time *gtime)
 	out[1] = (gtime->t3 << 5) | gtime->t2;
 }
 
+uint8_t rsl_lchan_dtx(struct gsm_lchan *lchan)
+{
+	struct lchan_priv *priv = bts_lchan_priv(lchan);
+
+	return priv ? priv->dtx : 0;
+}
+
 /* compute lchan->rsl_cmode and lchan->tch_mode from RSL CHAN MODE IE */
 static void lchan_tchmode_from_cmode(struct gsm_lchan *lchan,
 				     struct rsl_ie_chan_mode *cm)
 {
+	struct lchan_priv *priv = bts_lchan_priv(lchan);
+
+	if (priv)
+		priv->dtx = cm->dtx_dtu & (RSL_CMOD_DTXu | RSL_CMOD_DTXd);
 	lchan->rsl_cmode = cm->spd_ind;
 	switch (cm->chan_rate) {
 	case RSL_CMOD_SP_GSM1:
@@ -335,6 +351,8 @@ static int rsl_rx_bcch_info(struct gsm_bts_trx *trx, struct msgb *msg)
 		LOGP(DRSL, LOGL_INFO, " RX RSL Disabling BCCH INFO (SI%s)\n",
 			get_value_string(osmo_sitype_strs, osmo_si));
 	}
+	/* keep the access classes barred under RACH overload */
+	rach_adm_si_update(bts, osmo_si);
 	osmo_signal_dispatch(SS_GLOBAL, S_NEW_SYSINFO, bts);
 
 	return 0;
@@ -502,6 +520,42 @@ int rsl_tx_rf_rel_ack(struct gsm_lchan *lchan)
 	return abis_rsl_sendmsg(msg);
 }
 
+/* account the end of an activation, the latency if it was acknowledged */
+static void lchan_act_done(struct gsm_lchan *lchan, int ack)
+{
+	struct gsm_bts_role_bts *btsb = bts_role_bts(lchan->ts->trx->bts);
+	struct lchan_priv *priv = bts_lchan_priv(lchan);
+	struct timespec *started, now;
+	uint32_t us;
+
+	if (!priv)
+		return;
+	started = &priv->act_started;
+	if (!started->tv_sec && !started->tv_nsec)
+		return;
+
+	if (!ack) {
+		btsb->chan_act.nacked++;
+		memset(started, 0, sizeof(*started));
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	us = (now.tv_sec - started->tv_sec) * 1000000
+		+ (now.tv_nsec - started->tv_nsec) / 1000;
+	memset(started, 0, sizeof(*started));
+
+	if (!btsb->chan_act.acked || us < btsb->chan_act.min_us)
+		btsb->chan_act.min_us = us;
+	if (us > btsb->chan_act.max_us)
+		btsb->chan_act.max_us = us;
+	btsb->chan_act.sum_us += us;
+	btsb->chan_act.acked++;
+
+	LOGP(DRSL, LOGL_INFO, "%s activated in %u us\n",
+		gsm_lchan_name(lchan), us);
+}
+
 /* 8.4.2 sending CHANnel ACTIVation ACKnowledge */
 int rsl_tx_chan_act_ack(struct gsm_lchan *lchan)
 {
@@ -523,6 +577,8 @@ int rsl_tx_chan_act_ack(struct gsm_lchan *lchan)
 
 	/* since activation was successful, do some lchan initialization */
 	lchan->meas.res_nr = 0;
+	lchan_meas_reset(lchan);
+	lchan_act_done(lchan, 1);
 
 	return abis_rsl_sendmsg(msg);
 }
@@ -567,6 +623,7 @@ int rsl_tx_chan_act_nack(struct gsm_lchan *lchan, uint8_t cause)
 	msgb_tlv_put(msg, RSL_IE_CAUSE, 1, &cause);
 	rsl_dch_push_hdr(msg, RSL_MT_CHAN_ACTIV_NACK, chan_nr);
 	msg->trx = lchan->ts->trx;
+	lchan_act_done(lchan, 0);
 
 	return abis_rsl_sendmsg(msg);
 }
@@ -673,6 +730,7 @@ static int rsl_rx_chan_activ(struct msgb *msg)
 	struct abis_rsl_dchan_hdr *dch = msgb_l2(msg);
 	struct gsm_lchan *lchan = msg->lchan;
 	struct rsl_ie_chan_mode *cm;
+	struct lchan_priv *priv;
 	struct tlv_parsed tp;
 	uint8_t type;
 
@@ -683,6 +741,11 @@ static int rsl_rx_chan_activ(struct msgb *msg)
 		return rsl_tx_chan_act_nack(lchan, RSL_ERR_EQUIPMENT_FAIL);
 	}
 
+	/* the latency is measured until the CHAN ACT ACK is sent */
+	priv = bts_lchan_priv(lchan);
+	if (priv)
+		clock_gettime(CLOCK_MONOTONIC, &priv->act_started);
+
 	rsl_tlv_parse(&tp, msgb_l3(msg), msgb_l3len(msg));
 
 	/* 9.3.3 Activation Type */
@@ -804,9 +867,14 @@ static int rsl_rx_rf_chan_rel(struct gsm_lchan *lchan, uint8_t chan_nr)
 {
 	if (lchan->abis_ip.rtp_socket) {
 		rsl_tx_ipac_dlcx_ind(lchan, RSL_ERR_NORMAL_UNSPEC);
+		rtp_conn_del(lchan);
 		osmo_rtp_socket_free(lchan->abis_ip.rtp_socket);
 		lchan->abis_ip.rtp_socket = NULL;
 		msgb_queue_flush(&lchan->dl_tch_queue);
+	} else if (rtp_trunk_call_cid(lchan) >= 0) {
+		rsl_tx_ipac_dlcx_ind(lchan, RSL_ERR_NORMAL_UNSPEC);
+		rtp_trunk_call_del(lchan);
+		msgb_queue_flush(&lchan->dl_tch_queue);
 	}
 
 	/* release handover starte */
@@ -1134,6 +1202,7 @@ static int rsl_tx_ipac_XXcx_ack(struct gsm_lchan *lchan, int inc_pt2,
 	uint8_t chan_nr = gsm_lchan2chan_nr(lchan);
 	const char *name;
 	struct in_addr ia;
+	int cid;
 
 	if (orig_msgt == RSL_MT_IPAC_CRCX)
 		name = "CRCX";
@@ -1170,6 +1239,11 @@ static int rsl_tx_ipac_XXcx_ack(struct gsm_lchan *lchan, int inc_pt2,
 					lchan->abis_ip.rtp_payload2);
 	}
 
+	/* multiplex ID, if the call is carried by a RTP trunk */
+	cid = rtp_trunk_call_cid(lchan);
+	if (cid >= 0)
+		msgb_tv_put(msg, RSL_IE_IPAC_RTP_MPLEX_ID, cid);
+
 	/* push the header in front */
 	rsl_ipa_push_hdr(msg, orig_msgt + 1, chan_nr);
 	msg->trx = lchan->ts->trx;
@@ -1283,13 +1357,54 @@ static char *get_rsl_local_ip(struct gsm_bts_trx *trx)
 	return hostbuf;
 }
 
+/* set up or modify a call, which is multiplexed with other calls on a RTP
+ * trunk to the remote IP/port (network byte order) */
+static int ipac_XXcx_mux(struct gsm_lchan *lchan, uint8_t msg_type,
+			 const uint8_t *mux_cid, uint32_t connect_ip,
+			 uint16_t connect_port)
+{
+	int cid = rtp_trunk_call_cid(lchan);
+
+	if (lchan->abis_ip.rtp_socket) {
+		LOGP(DRSL, LOGL_ERROR, "%s Rx RSL IPAC %s with multiplex ID, "
+			"but we already have a RTP socket!\n",
+			gsm_lchan_name(lchan),
+			msg_type == RSL_MT_IPAC_CRCX ? "CRCX" : "MDCX");
+		return -EBUSY;
+	}
+
+	if (msg_type == RSL_MT_IPAC_CRCX && cid >= 0) {
+		LOGP(DRSL, LOGL_ERROR, "%s Rx RSL IPAC CRCX, "
+			"but the call is multiplexed already!\n",
+			gsm_lchan_name(lchan));
+		return -EBUSY;
+	}
+
+	if (!connect_ip || !connect_port) {
+		/* the CID is kept, the call joins its trunk with the MDCX
+		 * that brings the address of the peer */
+		if (msg_type == RSL_MT_IPAC_CRCX)
+			return rtp_trunk_call_add(lchan, 0, 0, *mux_cid);
+		/* MDCX may only change the multiplex ID */
+		if (cid < 0)
+			return -EINVAL;
+		if (!mux_cid)
+			return 0;
+		connect_ip = htonl(lchan->abis_ip.connect_ip);
+		connect_port = htons(lchan->abis_ip.connect_port);
+	}
+
+	return rtp_trunk_call_add(lchan, ntohl(connect_ip), ntohs(connect_port),
+				  mux_cid ? *mux_cid : cid);
+}
+
 static int rsl_rx_ipac_XXcx(struct msgb *msg)
 {
 	struct abis_rsl_dchan_hdr *dch = msgb_l2(msg);
 	struct tlv_parsed tp;
 	struct gsm_lchan *lchan = msg->lchan;
 	struct gsm_bts_role_bts *btsb = bts_role_bts(msg->lchan->ts->trx->bts);
-	const uint8_t *payload_type, *speech_mode, *payload_type2;
+	const uint8_t *payload_type, *speech_mode, *payload_type2, *mux_cid;
 	uint32_t connect_ip = 0;
 	uint16_t connect_port = 0;
 	int rc, inc_ip_port = 0, port;
@@ -1309,6 +1424,7 @@ static int rsl_rx_ipac_XXcx(struct msgb *msg)
 	speech_mode = TLVP_VAL(&tp, RSL_IE_IPAC_SPEECH_MODE);
 	payload_type = TLVP_VAL(&tp, RSL_IE_IPAC_RTP_PAYLOAD);
 	payload_type2 = TLVP_VAL(&tp, RSL_IE_IPAC_RTP_PAYLOAD2);
+	mux_cid = TLVP_VAL(&tp, RSL_IE_IPAC_RTP_MPLEX_ID);
 
 	if (TLVP_PRESENT(&tp, RSL_IE_IPAC_REMOTE_IP))
 		connect_ip = tlvp_val32_unal(&tp, RSL_IE_IPAC_REMOTE_IP);
@@ -1331,6 +1447,17 @@ static int rsl_rx_ipac_XXcx(struct msgb *msg)
 					 inc_ip_port, dch->c.msg_type);
 	}
 
+	/* a multiplex ID requests the call to share one socket with the
+	 * other calls to the same peer */
+	if (mux_cid || rtp_trunk_call_cid(lchan) >= 0) {
+		rc = ipac_XXcx_mux(lchan, dch->c.msg_type, mux_cid,
+				   connect_ip, connect_port);
+		if (rc < 0)
+			return tx_ipac_XXcx_nack(lchan, RSL_ERR_RES_UNAVAIL,
+						 inc_ip_port, dch->c.msg_type);
+		goto store;
+	}
+
 	if (dch->c.msg_type == RSL_MT_IPAC_CRCX) {
 		char *ipstr = NULL;
 		if (lchan->abis_ip.rtp_socket) {
@@ -1377,13 +1504,14 @@ static int rsl_rx_ipac_XXcx(struct msgb *msg)
 			LOGP(DRSL, LOGL_ERROR,
 			     "%s IPAC Failed to bind RTP/RTCP sockets\n",
 			     gsm_lchan_name(lchan));
+			rtp_conn_del(lchan);
 			osmo_rtp_socket_free(lchan->abis_ip.rtp_socket);
 			lchan->abis_ip.rtp_socket = NULL;
 			msgb_queue_flush(&lchan->dl_tch_queue);
 			return tx_ipac_XXcx_nack(lchan, RSL_ERR_RES_UNAVAIL,
 						 inc_ip_port, dch->c.msg_type);
 		}
-		/* FIXME: multiplex connection, BSC proxy */
+		/* FIXME: BSC proxy */
 	} else {
 		/* MDCX */
 		if (!lchan->abis_ip.rtp_socket) {
@@ -1414,6 +1542,7 @@ static int rsl_rx_ipac_XXcx(struct msgb *msg)
 			LOGP(DRSL, LOGL_ERROR,
 			     "%s Failed to connect RTP/RTCP sockets\n",
 			     gsm_lchan_name(lchan));
+			rtp_conn_del(lchan);
 			osmo_rtp_socket_free(lchan->abis_ip.rtp_socket);
 			lchan->abis_ip.rtp_socket = NULL;
 			msgb_queue_flush(&lchan->dl_tch_queue);
@@ -1437,6 +1566,7 @@ static int rsl_rx_ipac_XXcx(struct msgb *msg)
 		     gsm_lchan_name(lchan), rc);
 	lchan->abis_ip.bound_port = port;
 
+store:
 	/* Everything has succeeded, we can store new values in lchan */
 	if (payload_type) {
 		lchan->abis_ip.rtp_payload = *payload_type;
@@ -1472,6 +1602,8 @@ static int rsl_rx_ipac_dlcx(struct msgb *msg)
 	if (TLVP_PRESENT(&tp, RSL_IE_IPAC_CONN_ID))
 		inc_conn_id = 1;
 
+	rtp_trunk_call_del(lchan);
+	rtp_conn_del(lchan);
 	osmo_rtp_socket_free(lchan->abis_ip.rtp_socket);
 	lchan->abis_ip.rtp_socket = NULL;
 	msgb_queue_flush(&lchan->dl_tch_queue);
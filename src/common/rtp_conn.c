@@ -0,0 +1,201 @@
+/* RTP transmission and per call statistics */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <ortp/ortp.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/vty/vty.h>
+#include <osmocom/trau/osmo_ortp.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/rtp_conn.h>
+
+/* The uplink frames of each call are sent through ortp, which keeps SSRC,
+ * sequence numbers and RTCP statistics. Here they are only counted per
+ * call, and the marker bit is set on the first frame of a talkspurt. The
+ * calls are looked up by their lchan in a small hash table. */
+#define RTP_CONN_HASH_SIZE	64
+
+struct rtp_conn {
+	struct llist_head list;
+	struct gsm_lchan *lchan;
+	uint32_t next_ts;	/* timestamp of a frame following the last */
+	int started;		/* a frame was sent already */
+	struct rtp_conn_stats stats;
+};
+
+static struct llist_head rtp_conns[RTP_CONN_HASH_SIZE];
+static int rtp_conns_init = 0;
+
+static void rtp_conns_setup(void)
+{
+	int i;
+
+	if (rtp_conns_init)
+		return;
+
+	for (i = 0; i < RTP_CONN_HASH_SIZE; i++)
+		INIT_LLIST_HEAD(&rtp_conns[i]);
+	rtp_conns_init = 1;
+}
+
+static struct llist_head *rtp_conn_bucket(const struct gsm_lchan *lchan)
+{
+	rtp_conns_setup();
+
+	return &rtp_conns[((uintptr_t) lchan >> 6) % RTP_CONN_HASH_SIZE];
+}
+
+static struct rtp_conn *rtp_conn_find(const struct gsm_lchan *lchan)
+{
+	struct llist_head *bucket = rtp_conn_bucket(lchan);
+	struct rtp_conn *conn;
+
+	llist_for_each_entry(conn, bucket, list) {
+		if (conn->lchan == lchan)
+			return conn;
+	}
+
+	return NULL;
+}
+
+static struct rtp_conn *rtp_conn_get(struct gsm_lchan *lchan)
+{
+	struct rtp_conn *conn = rtp_conn_find(lchan);
+
+	if (conn)
+		return conn;
+
+	conn = talloc_zero(tall_bts_ctx, struct rtp_conn);
+	if (!conn)
+		return NULL;
+	conn->lchan = lchan;
+	llist_add(&conn->list, rtp_conn_bucket(lchan));
+
+	return conn;
+}
+
+void rtp_conn_del(struct gsm_lchan *lchan)
+{
+	struct rtp_conn *conn = rtp_conn_find(lchan);
+
+	if (!conn)
+		return;
+
+	llist_del(&conn->list);
+	talloc_free(conn);
+}
+
+/* osmo_rtp_send_frame(), but with the marker bit */
+static int rtp_send_frame(struct osmo_rtp_socket *rs, const uint8_t *payload,
+	unsigned int len, unsigned int duration, int marker)
+{
+	mblk_t *mblk;
+	int rc;
+
+	mblk = rtp_session_create_packet(rs->sess, RTP_FIXED_HEADER_SIZE,
+					 payload, len);
+	if (!mblk)
+		return -ENOMEM;
+	rtp_set_markbit(mblk, marker);
+
+	/* the mblk is freed in any case */
+	rc = rtp_session_sendm_with_ts(rs->sess, mblk, rs->tx_timestamp);
+	rs->tx_timestamp += duration;
+
+	return rc;
+}
+
+int rtp_conn_send(struct gsm_lchan *lchan, const uint8_t *payload,
+	unsigned int len, unsigned int duration)
+{
+	struct osmo_rtp_socket *rs = lchan->abis_ip.rtp_socket;
+	struct rtp_conn *conn = rtp_conn_get(lchan);
+	int marker = 0, rc;
+
+	/* the first frame after a gap (e.g. DTX) starts a talkspurt */
+	if (conn)
+		marker = !conn->started || rs->tx_timestamp != conn->next_ts;
+
+	rc = rtp_send_frame(rs, payload, len, duration, marker);
+	if (!conn)
+		return rc;
+
+	conn->started = 1;
+	conn->next_ts = rs->tx_timestamp;
+	if (rc < 0)
+		conn->stats.tx_dropped++;
+	else {
+		conn->stats.tx_packets++;
+		conn->stats.tx_bytes += len;
+	}
+
+	return rc;
+}
+
+void rtp_conn_skip(struct gsm_lchan *lchan, unsigned int duration)
+{
+	struct osmo_rtp_socket *rs = lchan->abis_ip.rtp_socket;
+	struct rtp_conn *conn = rtp_conn_get(lchan);
+
+	rs->tx_timestamp += duration;
+	if (conn)
+		conn->stats.tx_skipped++;
+}
+
+void rtp_conn_rx(struct gsm_lchan *lchan, unsigned int len)
+{
+	struct rtp_conn *conn = rtp_conn_get(lchan);
+
+	if (!conn)
+		return;
+
+	conn->stats.rx_packets++;
+	conn->stats.rx_bytes += len;
+}
+
+void rtp_conn_dump_vty(struct vty *vty)
+{
+	struct rtp_conn *conn;
+	struct in_addr ia;
+	int i;
+
+	rtp_conns_setup();
+	for (i = 0; i < RTP_CONN_HASH_SIZE; i++) {
+		llist_for_each_entry(conn, &rtp_conns[i], list) {
+			ia.s_addr = htonl(conn->lchan->abis_ip.connect_ip);
+			vty_out(vty, "RTP of %s to %s:%u%s",
+				gsm_lchan_name(conn->lchan), inet_ntoa(ia),
+				conn->lchan->abis_ip.connect_port,
+				VTY_NEWLINE);
+			vty_out(vty, " Tx: %u frames, %u bytes, %u dropped, "
+				"%u skipped (DTX); Rx: %u frames, %u bytes%s",
+				conn->stats.tx_packets, conn->stats.tx_bytes,
+				conn->stats.tx_dropped, conn->stats.tx_skipped,
+				conn->stats.rx_packets, conn->stats.rx_bytes,
+				VTY_NEWLINE);
+		}
+	}
+}
@@ -0,0 +1,435 @@
+/* Multiplexing the voice frames of several calls over one UDP socket */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/core/select.h>
+#include <osmocom/core/socket.h>
+#include <osmocom/vty/vty.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/l1sap.h>
+#include <osmo-bts/rtp_trunk.h>
+
+/* Instead of a RTP/RTCP socket pair for each call, the BSC may ask (by
+ * adding a multiplex ID to the IPAC CRCX) to carry the voice frames of
+ * all calls towards the same peer in one UDP trunk.  Each packet of the
+ * trunk starts with a header:
+ *
+ *   octet 0	version (RTP_TRUNK_VERSION)
+ *   octet 1	sequence number of the packet
+ *
+ * followed by one or more frames, each with a header:
+ *
+ *   octet 0	CID, the multiplex ID of the call
+ *   octet 1	marker bit (start of a talkspurt) and RTP payload type
+ *   octet 2	number of the frame (RTP timestamp / 160, modulo 256)
+ *   octet 3	length of the payload
+ *
+ * The frames of all calls of one TDMA frame (or 'rtp_trunk_batch' TDMA
+ * frames) are sent in one packet.  There is no jitter buffer, received
+ * frames are queued to the lchan directly.
+ *
+ * A CRCX usually comes without the address of the peer, which follows in
+ * a MDCX.  Until then, the call only keeps its CID and is not part of any
+ * trunk, so its frames are not sent. */
+#define RTP_TRUNK_MTU		1400
+#define RTP_TRUNK_HASH_SIZE	64
+
+struct rtp_trunk_call;
+
+struct rtp_trunk {
+	struct llist_head list;
+	uint32_t remote_ip;
+	uint16_t remote_port;
+	uint32_t local_ip;
+	uint16_t local_port;
+	struct osmo_fd ofd;
+	struct rtp_trunk_call *calls[256];
+	unsigned int num_calls;
+	uint8_t seq;
+	uint8_t buf[RTP_TRUNK_MTU];
+	unsigned int len;
+	unsigned int frames;
+	struct rtp_trunk_stats stats;
+};
+
+struct rtp_trunk_call {
+	struct llist_head list;
+	struct rtp_trunk *trunk;	/* NULL until the peer is known */
+	struct gsm_lchan *lchan;
+	uint8_t cid;
+	uint8_t tx_fn;		/* number of the next frame */
+	uint8_t next_fn;	/* number following the last frame sent */
+	int started;		/* a frame was sent already */
+};
+
+unsigned int rtp_trunk_batch = 1;
+
+static LLIST_HEAD(rtp_trunks);
+static struct llist_head rtp_trunk_calls[RTP_TRUNK_HASH_SIZE];
+static int rtp_trunk_calls_init = 0;
+static unsigned int rtp_trunk_ticks = 0;
+
+static struct llist_head *rtp_trunk_bucket(const struct gsm_lchan *lchan)
+{
+	int i;
+
+	if (!rtp_trunk_calls_init) {
+		for (i = 0; i < RTP_TRUNK_HASH_SIZE; i++)
+			INIT_LLIST_HEAD(&rtp_trunk_calls[i]);
+		rtp_trunk_calls_init = 1;
+	}
+
+	return &rtp_trunk_calls[((uintptr_t) lchan >> 6) % RTP_TRUNK_HASH_SIZE];
+}
+
+static struct rtp_trunk_call *rtp_trunk_call_find(
+	const struct gsm_lchan *lchan)
+{
+	struct llist_head *bucket = rtp_trunk_bucket(lchan);
+	struct rtp_trunk_call *call;
+
+	llist_for_each_entry(call, bucket, list) {
+		if (call->lchan == lchan)
+			return call;
+	}
+
+	return NULL;
+}
+
+static int rtp_trunk_tx(struct rtp_trunk *trunk)
+{
+	int rc;
+
+	if (!trunk->frames)
+		return 0;
+
+	rc = send(trunk->ofd.fd, trunk->buf, trunk->len, MSG_DONTWAIT);
+	if (rc < 0) {
+		LOGP_HOT(DL1P, LOGL_DEBUG, "RTP trunk send failed: %s\n",
+			strerror(errno));
+		trunk->stats.tx_dropped += trunk->frames;
+	} else {
+		trunk->stats.tx_packets++;
+		trunk->stats.tx_frames += trunk->frames;
+	}
+
+	trunk->len = 0;
+	trunk->frames = 0;
+
+	return rc;
+}
+
+static void rtp_trunk_rx(struct rtp_trunk *trunk, const uint8_t *data,
+	unsigned int len)
+{
+	struct rtp_trunk_call *call;
+	unsigned int pos, pl_len;
+
+	if (len < RTP_TRUNK_HDR_LEN || data[0] != RTP_TRUNK_VERSION) {
+		trunk->stats.rx_errors++;
+		return;
+	}
+	trunk->stats.rx_packets++;
+
+	pos = RTP_TRUNK_HDR_LEN;
+	while (pos + RTP_TRUNK_FRAME_HDR_LEN <= len) {
+		pl_len = data[pos + 3];
+		if (pos + RTP_TRUNK_FRAME_HDR_LEN + pl_len > len) {
+			trunk->stats.rx_errors++;
+			return;
+		}
+		call = trunk->calls[data[pos]];
+		if (call) {
+			trunk->stats.rx_frames++;
+			l1sap_rtp_rx_frame(call->lchan,
+				data + pos + RTP_TRUNK_FRAME_HDR_LEN, pl_len);
+		} else
+			trunk->stats.rx_errors++;
+		pos += RTP_TRUNK_FRAME_HDR_LEN + pl_len;
+	}
+}
+
+static int rtp_trunk_read_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct rtp_trunk *trunk = ofd->data;
+	uint8_t buf[RTP_TRUNK_MTU];
+	int rc;
+
+	rc = recv(ofd->fd, buf, sizeof(buf), 0);
+	if (rc <= 0)
+		return rc;
+
+	rtp_trunk_rx(trunk, buf, rc);
+
+	return 0;
+}
+
+static struct rtp_trunk *rtp_trunk_get(uint32_t remote_ip,
+	uint16_t remote_port)
+{
+	struct rtp_trunk *trunk;
+	struct sockaddr_in sin;
+	socklen_t sin_len = sizeof(sin);
+	struct in_addr ia;
+	int rc;
+
+	llist_for_each_entry(trunk, &rtp_trunks, list) {
+		if (trunk->remote_ip == remote_ip
+		 && trunk->remote_port == remote_port)
+			return trunk;
+	}
+
+	trunk = talloc_zero(tall_bts_ctx, struct rtp_trunk);
+	if (!trunk)
+		return NULL;
+	trunk->remote_ip = remote_ip;
+	trunk->remote_port = remote_port;
+	trunk->seq = random();
+	trunk->ofd.cb = rtp_trunk_read_cb;
+	trunk->ofd.data = trunk;
+
+	/* connect, so that the kernel selects the local address, which is
+	 * reported to the BSC */
+	ia.s_addr = htonl(remote_ip);
+	rc = osmo_sock_init_ofd(&trunk->ofd, AF_INET, SOCK_DGRAM, IPPROTO_UDP,
+		inet_ntoa(ia), remote_port, OSMO_SOCK_F_CONNECT);
+	if (rc < 0) {
+		LOGP(DRSL, LOGL_ERROR, "Failed to open RTP trunk to %s:%u\n",
+			inet_ntoa(ia), remote_port);
+		talloc_free(trunk);
+		return NULL;
+	}
+
+	rc = getsockname(trunk->ofd.fd, (struct sockaddr *) &sin, &sin_len);
+	if (rc == 0) {
+		trunk->local_ip = ntohl(sin.sin_addr.s_addr);
+		trunk->local_port = ntohs(sin.sin_port);
+	}
+
+	LOGP(DRSL, LOGL_INFO, "Opened RTP trunk to %s:%u, local port %u\n",
+		inet_ntoa(ia), remote_port, trunk->local_port);
+	llist_add_tail(&trunk->list, &rtp_trunks);
+
+	return trunk;
+}
+
+static void rtp_trunk_put(struct rtp_trunk *trunk)
+{
+	if (trunk->num_calls)
+		return;
+
+	osmo_fd_unregister(&trunk->ofd);
+	close(trunk->ofd.fd);
+	llist_del(&trunk->list);
+	talloc_free(trunk);
+}
+
+int rtp_trunk_call_add(struct gsm_lchan *lchan, uint32_t remote_ip,
+	uint16_t remote_port, uint8_t cid)
+{
+	struct rtp_trunk_call *call = rtp_trunk_call_find(lchan);
+	struct rtp_trunk *trunk;
+
+	/* a MDCX may move the call */
+	if (call && call->trunk && call->trunk->remote_ip == remote_ip
+	 && call->trunk->remote_port == remote_port && call->cid == cid)
+		return 0;
+
+	/* without the peer, only the CID is kept */
+	if (!remote_ip || !remote_port) {
+		rtp_trunk_call_del(lchan);
+		call = talloc_zero(tall_bts_ctx, struct rtp_trunk_call);
+		if (!call)
+			return -ENOMEM;
+		call->lchan = lchan;
+		call->cid = cid;
+		call->tx_fn = random();
+		llist_add(&call->list, rtp_trunk_bucket(lchan));
+		lchan->abis_ip.connect_ip = 0;
+		lchan->abis_ip.connect_port = 0;
+		lchan->abis_ip.bound_ip = 0;
+		lchan->abis_ip.bound_port = 0;
+		return 0;
+	}
+
+	/* the call keeps its old trunk and CID, unless the new ones are
+	 * available */
+	trunk = rtp_trunk_get(remote_ip, remote_port);
+	if (!trunk)
+		return -EIO;
+
+	if (trunk->calls[cid]) {
+		LOGP(DRSL, LOGL_ERROR, "%s RTP trunk CID %u is already used "
+			"by %s\n", gsm_lchan_name(lchan), cid,
+			gsm_lchan_name(trunk->calls[cid]->lchan));
+		rtp_trunk_put(trunk);
+		return -EBUSY;
+	}
+
+	call = talloc_zero(trunk, struct rtp_trunk_call);
+	if (!call) {
+		rtp_trunk_put(trunk);
+		return -ENOMEM;
+	}
+	call->trunk = trunk;
+	call->lchan = lchan;
+	call->cid = cid;
+	call->tx_fn = random();
+	trunk->calls[cid] = call;
+	trunk->num_calls++;
+
+	/* now leave the old trunk, which is kept, if it is the new one */
+	rtp_trunk_call_del(lchan);
+	llist_add(&call->list, rtp_trunk_bucket(lchan));
+
+	lchan->abis_ip.connect_ip = remote_ip;
+	lchan->abis_ip.connect_port = remote_port;
+	lchan->abis_ip.bound_ip = trunk->local_ip;
+	lchan->abis_ip.bound_port = trunk->local_port;
+
+	return 0;
+}
+
+void rtp_trunk_call_del(struct gsm_lchan *lchan)
+{
+	struct rtp_trunk_call *call = rtp_trunk_call_find(lchan);
+	struct rtp_trunk *trunk;
+
+	if (!call)
+		return;
+
+	trunk = call->trunk;
+	if (trunk) {
+		trunk->calls[call->cid] = NULL;
+		trunk->num_calls--;
+	}
+	llist_del(&call->list);
+	talloc_free(call);
+
+	if (trunk)
+		rtp_trunk_put(trunk);
+}
+
+int rtp_trunk_call_cid(const struct gsm_lchan *lchan)
+{
+	struct rtp_trunk_call *call = rtp_trunk_call_find(lchan);
+
+	if (!call)
+		return -ENODEV;
+
+	return call->cid;
+}
+
+int rtp_trunk_send(struct gsm_lchan *lchan, const uint8_t *payload,
+	unsigned int len)
+{
+	struct rtp_trunk_call *call = rtp_trunk_call_find(lchan);
+	struct rtp_trunk *trunk;
+	uint8_t pt, marker, *hdr;
+
+	if (!call)
+		return -ENODEV;
+	trunk = call->trunk;
+
+	/* not transmitted, but the frame number keeps running */
+	if (!len || !trunk) {
+		call->tx_fn++;
+		return 0;
+	}
+
+	if (len > 0xff) {
+		trunk->stats.tx_dropped++;
+		return -EINVAL;
+	}
+
+	if (trunk->len + RTP_TRUNK_FRAME_HDR_LEN + len > sizeof(trunk->buf))
+		rtp_trunk_tx(trunk);
+
+	if (!trunk->len) {
+		trunk->buf[0] = RTP_TRUNK_VERSION;
+		trunk->buf[1] = trunk->seq++;
+		trunk->len = RTP_TRUNK_HDR_LEN;
+	}
+
+	/* the first frame after a gap (e.g. DTX) starts a talkspurt */
+	marker = !call->started || call->tx_fn != call->next_fn;
+	pt = lchan->abis_ip.rtp_payload2 ? lchan->abis_ip.rtp_payload2
+					  : lchan->abis_ip.rtp_payload;
+	if (!pt)
+		pt = 3; /* GSM */
+
+	hdr = trunk->buf + trunk->len;
+	hdr[0] = call->cid;
+	hdr[1] = (marker << 7) | (pt & 0x7f);
+	hdr[2] = call->tx_fn;
+	hdr[3] = len;
+	memcpy(hdr + RTP_TRUNK_FRAME_HDR_LEN, payload, len);
+	trunk->len += RTP_TRUNK_FRAME_HDR_LEN + len;
+	trunk->frames++;
+
+	call->tx_fn++;
+	call->next_fn = call->tx_fn;
+	call->started = 1;
+
+	return 0;
+}
+
+void rtp_trunk_flush(void)
+{
+	struct rtp_trunk *trunk;
+
+	if (++rtp_trunk_ticks < rtp_trunk_batch)
+		return;
+	rtp_trunk_ticks = 0;
+
+	llist_for_each_entry(trunk, &rtp_trunks, list)
+		rtp_trunk_tx(trunk);
+}
+
+void rtp_trunk_dump_vty(struct vty *vty)
+{
+	struct rtp_trunk *trunk;
+	struct in_addr ia;
+
+	llist_for_each_entry(trunk, &rtp_trunks, list) {
+		ia.s_addr = htonl(trunk->remote_ip);
+		vty_out(vty, "RTP trunk to %s:%u, local port %u, %u calls%s",
+			inet_ntoa(ia), trunk->remote_port, trunk->local_port,
+			trunk->num_calls, VTY_NEWLINE);
+		vty_out(vty, " Tx: %u packets, %u frames, %u dropped; "
+			"Rx: %u packets, %u frames, %u errors%s",
+			trunk->stats.tx_packets, trunk->stats.tx_frames,
+			trunk->stats.tx_dropped, trunk->stats.rx_packets,
+			trunk->stats.rx_frames, trunk->stats.rx_errors,
+			VTY_NEWLINE);
+	}
+}
@@ -0,0 +1,110 @@
+/* Timer wheel for many timeouts of the same granularity */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+
+#include <osmocom/core/linuxlist.h>
+#include <osmocom/core/timer.h>
+
+#include <osmo-bts/timer_wheel.h>
+
+/* Each osmo_timer is kept in the rbtree of libosmocore, so adding and
+ * removing one costs O(log n), and every pending L1 request had one of
+ * its own.  On the wheel an entry is put to the slot of the tick it
+ * expires in, which is O(1) for both adding and removing.  An entry that
+ * expires more than TIMER_WHEEL_SLOTS ticks ahead stays in its slot for
+ * more than one turn of the wheel. */
+
+static void timer_wheel_cb(void *data)
+{
+	timer_wheel_tick(data);
+}
+
+static void timer_wheel_schedule(struct timer_wheel *tw)
+{
+	osmo_timer_schedule(&tw->timer, tw->tick_ms / 1000,
+		(tw->tick_ms % 1000) * 1000);
+}
+
+void timer_wheel_init(struct timer_wheel *tw, unsigned int tick_ms)
+{
+	int i;
+
+	for (i = 0; i < TIMER_WHEEL_SLOTS; i++)
+		INIT_LLIST_HEAD(&tw->slots[i]);
+	tw->tick_ms = tick_ms;
+	tw->now = 0;
+	tw->pending = 0;
+	tw->timer.cb = timer_wheel_cb;
+	tw->timer.data = tw;
+}
+
+void timer_wheel_add(struct timer_wheel *tw, struct timer_wheel_entry *e,
+	unsigned int ticks)
+{
+	timer_wheel_del(tw, e);
+
+	/* expire no earlier than requested: the current tick is partially
+	 * over already */
+	e->expires = tw->now + ticks + 1;
+	e->active = 1;
+	llist_add_tail(&e->list,
+		&tw->slots[e->expires & (TIMER_WHEEL_SLOTS - 1)]);
+
+	if (tw->pending++ == 0)
+		timer_wheel_schedule(tw);
+}
+
+void timer_wheel_del(struct timer_wheel *tw, struct timer_wheel_entry *e)
+{
+	if (!e->active)
+		return;
+
+	llist_del(&e->list);
+	e->active = 0;
+
+	if (--tw->pending == 0)
+		osmo_timer_del(&tw->timer);
+}
+
+void timer_wheel_tick(struct timer_wheel *tw)
+{
+	struct llist_head *slot;
+	struct timer_wheel_entry *e, *tmp;
+	LLIST_HEAD(expired);
+
+	tw->now++;
+	slot = &tw->slots[tw->now & (TIMER_WHEEL_SLOTS - 1)];
+
+	llist_for_each_entry_safe(e, tmp, slot, list) {
+		if ((int32_t) (e->expires - tw->now) > 0)
+			continue;
+		llist_del(&e->list);
+		llist_add_tail(&e->list, &expired);
+	}
+
+	if (tw->pending && !osmo_timer_pending(&tw->timer))
+		timer_wheel_schedule(tw);
+
+	/* a call-back may remove or add other entries */
+	while (!llist_empty(&expired)) {
+		e = llist_entry(expired.next, struct timer_wheel_entry, list);
+		timer_wheel_del(tw, e);
+		e->cb(e->data);
+	}
+}
@@ -46,6 +46,11 @@
 #include <osmo-bts/measurement.h>
 #include <osmo-bts/vty.h>
 #include <osmo-bts/l1sap.h>
+#include <osmo-bts/gsmtap_export.h>
+#include <osmo-bts/msgb_pool.h>
+#include <osmo-bts/rtp_conn.h>
+#include <osmo-bts/rtp_trunk.h>
+#include <osmo-bts/rach_adm.h>
 
 enum node_type bts_vty_go_parent(struct vty *vty)
 {
@@ -217,10 +222,25 @@ static void config_write_bts_single(struct vty *vty, struct gsm_bts *bts)
 	vty_out(vty, " oml remote-ip %s%s", btsb->bsc_oml_host, VTY_NEWLINE);
 	vty_out(vty, " rtp jitter-buffer %u%s", btsb->rtp_jitter_buf_ms,
 		VTY_NEWLINE);
+	if (rtp_trunk_batch != 1)
+		vty_out(vty, " rtp multiplex-batch %u%s", rtp_trunk_batch,
+			VTY_NEWLINE);
 	vty_out(vty, " paging queue-size %u%s", paging_get_queue_max(btsb->paging_state),
 		VTY_NEWLINE);
 	vty_out(vty, " paging lifetime %u%s", paging_get_lifetime(btsb->paging_state),
 		VTY_NEWLINE);
+	vty_out(vty, " measurement averaging %u%s", btsb->meas.avg_periods,
+		VTY_NEWLINE);
+	if (btsb->rach_adm.rate_limit)
+		vty_out(vty, " rach admission rate-limit %u%s",
+			btsb->rach_adm.rate_limit, VTY_NEWLINE);
+	if (btsb->rach_adm.dup_window)
+		vty_out(vty, " rach admission duplicate-window %u%s",
+			btsb->rach_adm.dup_window, VTY_NEWLINE);
+	if (btsb->rach_adm.bar_high)
+		vty_out(vty, " rach admission barring %u %u%s",
+			btsb->rach_adm.bar_high, btsb->rach_adm.bar_low,
+			VTY_NEWLINE);
 
 	for (i = 0; i < 32; i++) {
 		if (gsmtap_sapi_mask & (1 << i)) {
@@ -232,6 +252,8 @@ static void config_write_bts_single(struct vty *vty, struct gsm_bts *bts)
 		const char *name = get_value_string(gsmtap_sapi_names, GSMTAP_CHANNEL_ACCH);
 		vty_out(vty, " gsmtap-sapi %s%s", osmo_str_tolower(name), VTY_NEWLINE);
 	}
+	if (gsmtap_bursts)
+		vty_out(vty, " gsmtap-bursts%s", VTY_NEWLINE);
 
 	bts_model_config_write_bts(vty, bts);
 
@@ -368,6 +390,17 @@ DEFUN(cfg_bts_rtp_jitbuf,
 	return CMD_SUCCESS;
 }
 
+DEFUN(cfg_bts_rtp_mux_batch,
+	cfg_bts_rtp_mux_batch_cmd,
+	"rtp multiplex-batch <1-8>",
+	RTP_STR "Number of TDMA frames, whose voice frames are sent in one "
+	"packet of a multiplexed RTP trunk\n" "Number of TDMA frames\n")
+{
+	rtp_trunk_batch = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
 #define PAG_STR "Paging related parameters\n"
 
 DEFUN(cfg_bts_paging_queue_size,
@@ -399,6 +432,119 @@ DEFUN(cfg_bts_paging_lifetime,
 }
 
 
+DEFUN(cfg_bts_meas_avg,
+	cfg_bts_meas_avg_cmd,
+	"measurement averaging <1-8>",
+	"Uplink measurement processing\n"
+	"Average the uplink results over a number of SACCH periods\n"
+	"Number of SACCH periods (1 = no averaging)\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	btsb->meas.avg_periods = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+#define RACH_ADM_STR "Random access channel\n" \
+	"Admission control of access bursts for RR access\n"
+
+DEFUN(cfg_bts_rach_rate_limit,
+	cfg_bts_rach_rate_limit_cmd,
+	"rach admission rate-limit <1-1000>",
+	RACH_ADM_STR "Limit the rate of CHANnel ReQuireD sent to the BSC, "
+	"emergency calls are not limited\n"
+	"Maximum number of CHANnel ReQuireD per second\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	btsb->rach_adm.rate_limit = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_rate_limit,
+	cfg_bts_no_rach_rate_limit_cmd,
+	"no rach admission rate-limit",
+	NO_STR RACH_ADM_STR "Do not limit the rate of CHANnel ReQuireD\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	btsb->rach_adm.rate_limit = 0;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_rach_dup_window,
+	cfg_bts_rach_dup_window_cmd,
+	"rach admission duplicate-window <1-1024>",
+	RACH_ADM_STR "Drop access bursts repeating the RA of a recent one\n"
+	"Number of TDMA frames, within which a burst is a repetition\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	btsb->rach_adm.dup_window = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_dup_window,
+	cfg_bts_no_rach_dup_window_cmd,
+	"no rach admission duplicate-window",
+	NO_STR RACH_ADM_STR "Forward repeated access bursts\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	btsb->rach_adm.dup_window = 0;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_rach_barring,
+	cfg_bts_rach_barring_cmd,
+	"rach admission barring <1-1000> <0-1000>",
+	RACH_ADM_STR "Bar access classes 0-9 in SI1-SI4 under load, two more "
+	"classes each second the load stays above the high threshold\n"
+	"High threshold in access bursts per second\n"
+	"Low threshold in access bursts per second, below which the barring "
+	"is lifted step by step\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+	unsigned int high = atoi(argv[0]);
+	unsigned int low = atoi(argv[1]);
+
+	if (low >= high) {
+		vty_out(vty, "%% The low threshold must be below the high "
+			"threshold%s", VTY_NEWLINE);
+		return CMD_WARNING;
+	}
+
+	btsb->rach_adm.bar_high = high;
+	btsb->rach_adm.bar_low = low;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_barring,
+	cfg_bts_no_rach_barring_cmd,
+	"no rach admission barring",
+	NO_STR RACH_ADM_STR "Do not bar access classes under load\n")
+{
+	struct gsm_bts *bts = vty->index;
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bts);
+
+	/* a present barring is lifted with the next second */
+	btsb->rach_adm.bar_high = 0;
+	btsb->rach_adm.bar_low = 0;
+
+	return CMD_SUCCESS;
+}
 
 /* ======================================================================
  * SHOW
@@ -433,6 +579,17 @@ static void bts_dump_vty(struct vty *vty, struct gsm_bts *bts)
 	vty_out(vty, "  Paging: Queue size %u, occupied %u, lifetime %us%s",
 		paging_get_queue_max(btsb->paging_state), paging_queue_length(btsb->paging_state),
 		paging_get_lifetime(btsb->paging_state), VTY_NEWLINE);
+	vty_out(vty, "  GSMTAP: %u queued, %u sent in %u batches, %u dropped%s",
+		gsmtap_export_stats.queued, gsmtap_export_stats.sent,
+		gsmtap_export_stats.flushes, gsmtap_export_stats.dropped,
+		VTY_NEWLINE);
+	vty_out(vty, "  Channel activation: %u ACK, %u NACK, latency "
+		"avg %u us, min %u us, max %u us%s",
+		btsb->chan_act.acked, btsb->chan_act.nacked,
+		btsb->chan_act.acked ? (unsigned int)
+			(btsb->chan_act.sum_us / btsb->chan_act.acked) : 0,
+		btsb->chan_act.min_us, btsb->chan_act.max_us, VTY_NEWLINE);
+	rach_adm_dump_vty(vty, bts);
 #if 0
 	vty_out(vty, "  Paging: %u pending requests, %u free slots%s",
 		paging_pending_requests_nr(bts),
@@ -479,6 +636,38 @@ DEFUN(show_bts, show_bts_cmd, "show bts <0-255>",
 	return CMD_SUCCESS;
 }
 
+DEFUN(show_msgb_pools, show_msgb_pools_cmd, "show msgb-pools",
+	SHOW_STR "Display utilisation of the msgb pools\n")
+{
+	int i;
+
+	for (i = 0; i < msgb_pools_num; i++) {
+		struct msgb_pool *pool = &msgb_pools[i];
+
+		vty_out(vty, "Pool of %u byte msgbs:%s", pool->size,
+			VTY_NEWLINE);
+		vty_out(vty, "  In use: %u, free: %u (max %u), "
+			"high watermark: %u%s", pool->num_used,
+			pool->num_free, pool->max_free, pool->high_watermark,
+			VTY_NEWLINE);
+		vty_out(vty, "  Allocated: %u, recycled: %u, released: %u, "
+			"failed: %u%s", pool->stats.allocated,
+			pool->stats.recycled, pool->stats.released,
+			pool->stats.failed, VTY_NEWLINE);
+	}
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(show_rtp, show_rtp_cmd, "show rtp",
+	SHOW_STR "Display RTP statistics of all calls\n")
+{
+	rtp_conn_dump_vty(vty);
+	rtp_trunk_dump_vty(vty);
+
+	return CMD_SUCCESS;
+}
+
 static struct gsm_lchan *resolve_lchan(struct gsm_network *net,
 					const char **argv, int idx)
 {
@@ -548,6 +737,24 @@ DEFUN(cfg_trx_no_gsmtap_sapi, cfg_trx_no_gsmtap_sapi_cmd,
 	return CMD_SUCCESS;
 }
 
+DEFUN(cfg_bts_gsmtap_bursts, cfg_bts_gsmtap_bursts_cmd,
+	"gsmtap-bursts",
+	"Send raw bursts of all timeslots via GSMTAP (osmo-bts-trx only)\n")
+{
+	gsmtap_bursts = 1;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_gsmtap_bursts, cfg_bts_no_gsmtap_bursts_cmd,
+	"no gsmtap-bursts",
+	NO_STR "Send raw bursts of all timeslots via GSMTAP\n")
+{
+	gsmtap_bursts = 0;
+
+	return CMD_SUCCESS;
+}
+
 DEFUN(bts_t_t_l_jitter_buf,
 	bts_t_t_l_jitter_buf_cmd,
 	"bts <0-0> trx <0-0> ts <0-7> lchan <0-1> rtp jitter-buffer <0-10000>",
@@ -627,6 +834,8 @@ int bts_vty_init(struct gsm_bts *bts, const struct log_info *cat)
 						"\n", "", 0);
 
 	install_element_ve(&show_bts_cmd);
+	install_element_ve(&show_msgb_pools_cmd);
+	install_element_ve(&show_rtp_cmd);
 
 	logging_vty_add_cmds(cat);
 
@@ -637,14 +846,24 @@ int bts_vty_init(struct gsm_bts *bts, const struct log_info *cat)
 	install_element(BTS_NODE, &cfg_bts_oml_ip_cmd);
 	install_element(BTS_NODE, &cfg_bts_rtp_bind_ip_cmd);
 	install_element(BTS_NODE, &cfg_bts_rtp_jitbuf_cmd);
+	install_element(BTS_NODE, &cfg_bts_rtp_mux_batch_cmd);
 	install_element(BTS_NODE, &cfg_bts_band_cmd);
 	install_element(BTS_NODE, &cfg_description_cmd);
 	install_element(BTS_NODE, &cfg_no_description_cmd);
 	install_element(BTS_NODE, &cfg_bts_paging_queue_size_cmd);
 	install_element(BTS_NODE, &cfg_bts_paging_lifetime_cmd);
+	install_element(BTS_NODE, &cfg_bts_meas_avg_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_rate_limit_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_rate_limit_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_dup_window_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_dup_window_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_barring_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_barring_cmd);
 
 	install_element(BTS_NODE, &cfg_trx_gsmtap_sapi_cmd);
 	install_element(BTS_NODE, &cfg_trx_no_gsmtap_sapi_cmd);
+	install_element(BTS_NODE, &cfg_bts_gsmtap_bursts_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_gsmtap_bursts_cmd);
 
 	/* add and link to TRX config node */
 	install_element(BTS_NODE, &cfg_bts_trx_cmd);
@@ -0,0 +1,891 @@
+/* Emulated sysmoBTS DSP L1 for load testing of sysmobts-remote */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <getopt.h>
+#include <time.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/utils.h>
+#include <osmocom/core/select.h>
+#include <osmocom/core/timer.h>
+#include <osmocom/core/logging.h>
+#include <osmocom/core/socket.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/l1sap.h>
+
+#include <sysmocom/femtobts/superfemto.h>
+#include <sysmocom/femtobts/gsml1prim.h>
+#include <sysmocom/femtobts/gsml1const.h>
+#include <sysmocom/femtobts/gsml1types.h>
+
+#include "femtobts.h"
+#include "l1_transp.h"
+#include "l1_fwd.h"
+
+/* The emulator takes the place of the l1fwd-proxy and the DSP behind it:
+ * it binds the l1fwd UDP ports, confirms every request of the BTS and,
+ * once per TDMA frame, sends the MPH-TIME.ind, a PH-RTS.ind for every
+ * block of an activated downlink SAPI and a synthetic PH-DATA.ind for
+ * every block of an activated uplink SAPI.  The blocks follow the 51, 26
+ * and 52 multiframe layout of the connected channel combination, but
+ * nothing is decoded: uplink signalling blocks are LAPDm fill frames and
+ * uplink speech frames are silent FR/HR frames.  The clock can be sped
+ * up, so that the BTS can be driven at a multiple of the real load. */
+
+#define EMU_HYPERFRAME		(2048 * 26 * 51)
+#define EMU_FRAME_NS		4615385
+/* frames emulated in one timer expiry at most, if we are late */
+#define EMU_MAX_CATCHUP		8
+#define EMU_MAX_CHAN		32
+#define EMU_HLAYER1		0x454d554c
+
+#define EMU_FR_BYTES		33
+#define EMU_HR_BYTES		14
+
+static const uint16_t emu_udp_ports[_NUM_MQ_WRITE] = {
+	[MQ_SYS_READ]	= L1FWD_SYS_PORT,
+	[MQ_L1_READ]	= L1FWD_L1_PORT,
+#ifndef HW_SYSMOBTS_V1
+	[MQ_TCH_READ]	= L1FWD_TCH_PORT,
+	[MQ_PDTCH_READ]	= L1FWD_PDTCH_PORT,
+#endif
+};
+
+static const uint8_t fill_frame[GSM_MACBLOCK_LEN] = {
+	0x03, 0x03, 0x01, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B,
+	0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B,
+	0x2B, 0x2B, 0x2B
+};
+
+/* one activated SAPI in one direction */
+struct emu_chan {
+	int active;
+	GsmL1_Sapi_t sapi;
+	GsmL1_SubCh_t subCh;
+	GsmL1_Dir_t dir;
+	uint32_t hLayer2;
+	int queue;		/* queue the activation came from */
+};
+
+struct emu_ts {
+	int connected;
+	GsmL1_LogChComb_t comb;
+	struct emu_chan chan[EMU_MAX_CHAN];
+};
+
+struct emu_queue {
+	struct osmo_fd ofd;
+	struct sockaddr_storage remote_sa;
+	socklen_t remote_sa_len;
+};
+
+struct emu_stats {
+	uint32_t frames;
+	uint32_t late_frames;	/* frames skipped, as we were too late */
+	uint32_t reqs;		/* requests confirmed */
+	uint32_t rts_ind;
+	uint32_t data_ind;
+	uint32_t data_req;
+	uint32_t empty_req;
+	uint32_t dropped;	/* no remote to send to */
+};
+
+struct l1emu_hdl {
+	struct emu_queue q[_NUM_MQ_WRITE];
+
+	/* all queues on one socket, once the remote used it */
+	struct osmo_fd mux_ofd;
+	struct sockaddr_storage mux_sa;
+	socklen_t mux_sa_len;
+	uint8_t mux_buf[L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	unsigned int mux_len;
+
+	struct emu_ts ts[8];
+
+	/* the emulated clock */
+	struct osmo_timer_list timer;
+	struct timespec start;
+	uint64_t frame_ns;
+	uint64_t frames_done;
+	uint32_t fn;
+
+	struct emu_stats stats;
+};
+
+static double speed = 1.0;
+static uint32_t max_frames = 0;
+static int dump_stats = 0;
+
+static void emu_mux_flush(struct l1emu_hdl *emu)
+{
+	if (!emu->mux_len)
+		return;
+
+	if (sendto(emu->mux_ofd.fd, emu->mux_buf, emu->mux_len, 0,
+		   (struct sockaddr *) &emu->mux_sa, emu->mux_sa_len) < 0) {
+		LOGP(DL1C, LOGL_ERROR, "error writing to UDP: %s\n",
+			strerror(errno));
+		emu->stats.dropped++;
+	}
+	emu->mux_len = 0;
+}
+
+/* send a primitive to the BTS on the given queue */
+static void emu_send(struct l1emu_hdl *emu, int queue, const void *prim,
+	unsigned int len)
+{
+	struct emu_queue *q = &emu->q[queue];
+	int rc;
+
+	if (emu->mux_sa_len) {
+		rc = l1fwd_mux_put(emu->mux_buf, emu->mux_len,
+			L1FWD_MUX_MAX_LEN, queue, prim, len);
+		if (rc == -ENOSPC && emu->mux_len) {
+			emu_mux_flush(emu);
+			rc = l1fwd_mux_put(emu->mux_buf, 0, L1FWD_MUX_MAX_LEN,
+				queue, prim, len);
+		}
+		if (rc == -ENOSPC) {
+			/* too long for a datagram with others */
+			rc = l1fwd_mux_put(emu->mux_buf, 0,
+				sizeof(emu->mux_buf), queue, prim, len);
+		}
+		if (rc < 0) {
+			emu->stats.dropped++;
+			return;
+		}
+		emu->mux_len = rc;
+		return;
+	}
+
+	if (!q->remote_sa_len) {
+		emu->stats.dropped++;
+		return;
+	}
+
+	if (sendto(q->ofd.fd, prim, len, 0, (struct sockaddr *) &q->remote_sa,
+		   q->remote_sa_len) < 0) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			LOGP(DL1C, LOGL_ERROR, "error writing to UDP: %s\n",
+				strerror(errno));
+		emu->stats.dropped++;
+	}
+}
+
+static unsigned int subch_idx(GsmL1_SubCh_t subCh)
+{
+	return subCh == GsmL1_SubCh_NA ? 0 : subCh;
+}
+
+static const uint8_t ccch_blocks[] = { 6, 12, 16, 22, 26, 32, 36, 42, 46 };
+static const uint8_t pdch_blocks[] = {
+	0, 4, 8, 13, 17, 21, 26, 30, 34, 39, 43, 47,
+};
+
+/* the number of the block of 'sapi' that starts at 'fn', or -1 if none */
+static int block_nr(GsmL1_LogChComb_t comb, GsmL1_Sapi_t sapi,
+	GsmL1_SubCh_t subCh, uint32_t fn)
+{
+	unsigned int ss = subch_idx(subCh);
+	unsigned int fn51 = fn % 51, fn26 = fn % 26, fn52 = fn % 52;
+	unsigned int num_ccch, i;
+
+	switch (comb) {
+	case GsmL1_LogChComb_IV:
+	case GsmL1_LogChComb_V:
+	case GsmL1_LogChComb_VII:
+		num_ccch = comb == GsmL1_LogChComb_IV ? 9 : 3;
+		switch (sapi) {
+		case GsmL1_Sapi_Sch:
+			if (comb != GsmL1_LogChComb_VII && fn51 % 10 == 1)
+				return 0;
+			return -1;
+		case GsmL1_Sapi_Bcch:
+			if (comb != GsmL1_LogChComb_VII && fn51 == 2)
+				return 0;
+			return -1;
+		case GsmL1_Sapi_Agch:
+		case GsmL1_Sapi_Pch:
+			if (comb == GsmL1_LogChComb_VII)
+				return -1;
+			for (i = 0; i < num_ccch; i++) {
+				if (fn51 == ccch_blocks[i])
+					break;
+			}
+			if (i == num_ccch)
+				return -1;
+			/* the first block is the AGCH, as configured */
+			if ((sapi == GsmL1_Sapi_Agch) != (i == 0))
+				return -1;
+			return L1SAP_FN2CCCHBLOCK(fn);
+		case GsmL1_Sapi_Sdcch:
+			if (comb == GsmL1_LogChComb_V && ss < 4
+			 && fn51 == ccch_blocks[3 + ss])
+				return 0;
+			if (comb == GsmL1_LogChComb_VII && ss < 8
+			 && fn51 == 4 * ss)
+				return 0;
+			return -1;
+		case GsmL1_Sapi_Sacch:
+			/* two multiframes carry the SACCH of all subslots */
+			if (comb == GsmL1_LogChComb_V && ss < 4
+			 && fn51 == 42 + 4 * (ss % 2) && (fn / 51) % 2 == ss / 2)
+				return 0;
+			if (comb == GsmL1_LogChComb_VII && ss < 8
+			 && fn51 == 32 + 4 * (ss % 4) && (fn / 51) % 2 == ss / 4)
+				return 0;
+			return -1;
+		default:
+			return -1;
+		}
+	case GsmL1_LogChComb_I:
+	case GsmL1_LogChComb_II:
+		switch (sapi) {
+		case GsmL1_Sapi_TchF:
+			if (comb == GsmL1_LogChComb_I && fn26 != 12
+			 && fn26 != 25 && (fn26 % 13) % 4 == 0)
+				return (fn % 13) >> 2;
+			return -1;
+		case GsmL1_Sapi_TchH:
+			/* the subslots use alternating frames */
+			if (comb != GsmL1_LogChComb_II || ss > 1 || fn26 < ss)
+				return -1;
+			fn26 -= ss;
+			if (fn26 != 12 && fn26 < 24 && (fn26 % 13) % 4 == 0)
+				return fn26 >> 3;
+			return -1;
+		case GsmL1_Sapi_Sacch:
+			if (fn % 104 == (ss ? 25 : 12))
+				return 0;
+			return -1;
+		default:
+			return -1;
+		}
+	case GsmL1_LogChComb_XIII:
+		switch (sapi) {
+		case GsmL1_Sapi_Pdtch:
+			for (i = 0; i < ARRAY_SIZE(pdch_blocks); i++) {
+				if (fn52 == pdch_blocks[i])
+					return L1SAP_FN2MACBLOCK(fn);
+			}
+			return -1;
+		case GsmL1_Sapi_Ptcch:
+			if (L1SAP_IS_PTCCH(fn))
+				return L1SAP_FN2PTCCHBLOCK(fn);
+			return -1;
+		default:
+			return -1;
+		}
+	default:
+		return -1;
+	}
+}
+
+static void emu_send_rts(struct l1emu_hdl *emu, uint8_t tn,
+	struct emu_chan *ch, uint32_t fn, int block)
+{
+	GsmL1_Prim_t prim;
+	GsmL1_PhReadyToSendInd_t *rts_ind = &prim.u.phReadyToSendInd;
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_PhReadyToSendInd;
+	rts_ind->hLayer1 = EMU_HLAYER1;
+	rts_ind->u8Tn = tn;
+	rts_ind->u32Fn = fn;
+	rts_ind->sapi = ch->sapi;
+	rts_ind->subCh = ch->subCh;
+	rts_ind->u8BlockNbr = block;
+
+	emu_send(emu, ch->queue, &prim, sizeof(prim));
+	emu->stats.rts_ind++;
+}
+
+static void emu_send_data_ind(struct l1emu_hdl *emu, uint8_t tn,
+	struct emu_chan *ch, uint32_t fn)
+{
+	GsmL1_Prim_t prim;
+	GsmL1_PhDataInd_t *data_ind = &prim.u.phDataInd;
+	GsmL1_MsgUnitParam_t *msu_param = &data_ind->msgUnitParam;
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_PhDataInd;
+	data_ind->hLayer2 = ch->hLayer2;
+	data_ind->u8Tn = tn;
+	data_ind->u32Fn = fn;
+	data_ind->sapi = ch->sapi;
+	data_ind->subCh = ch->subCh;
+	data_ind->measParam.fRssi = -65.0;
+	data_ind->measParam.fLinkQuality = 20.0;
+	data_ind->measParam.fBer = 0.0;
+	data_ind->measParam.i16BurstTiming = 0;
+
+	switch (ch->sapi) {
+	case GsmL1_Sapi_TchF:
+		/* silent FR frame */
+		msu_param->u8Buffer[0] = GsmL1_TchPlType_Fr;
+		msu_param->u8Buffer[1] = 0xd0;
+		msu_param->u8Size = 1 + EMU_FR_BYTES;
+		break;
+	case GsmL1_Sapi_TchH:
+		msu_param->u8Buffer[0] = GsmL1_TchPlType_Hr;
+		msu_param->u8Size = 1 + EMU_HR_BYTES;
+		break;
+	case GsmL1_Sapi_Sacch:
+		/* L1 header with MS power and timing advance */
+		msu_param->u8Buffer[0] = 0;
+		msu_param->u8Buffer[1] = 0;
+		memcpy(msu_param->u8Buffer + 2, fill_frame,
+			GSM_MACBLOCK_LEN - 2);
+		msu_param->u8Size = GSM_MACBLOCK_LEN;
+		break;
+	default:
+		memcpy(msu_param->u8Buffer, fill_frame, GSM_MACBLOCK_LEN);
+		msu_param->u8Size = GSM_MACBLOCK_LEN;
+		break;
+	}
+
+	emu_send(emu, ch->queue, &prim, sizeof(prim));
+	emu->stats.data_ind++;
+}
+
+/* emulate one TDMA frame */
+static void emu_frame(struct l1emu_hdl *emu, uint32_t fn)
+{
+	GsmL1_Prim_t prim;
+	int tn, i, block;
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_MphTimeInd;
+	prim.u.mphTimeInd.u32Fn = fn;
+	emu_send(emu, MQ_L1_READ, &prim, sizeof(prim));
+
+	for (tn = 0; tn < ARRAY_SIZE(emu->ts); tn++) {
+		struct emu_ts *ts = &emu->ts[tn];
+
+		if (!ts->connected)
+			continue;
+
+		for (i = 0; i < EMU_MAX_CHAN; i++) {
+			struct emu_chan *ch = &ts->chan[i];
+
+			if (!ch->active)
+				continue;
+			block = block_nr(ts->comb, ch->sapi, ch->subCh, fn);
+			if (block < 0)
+				continue;
+
+			if (ch->dir == GsmL1_Dir_TxDownlink) {
+				emu_send_rts(emu, tn, ch, fn, block);
+				continue;
+			}
+
+			/* only signalling and speech is sent uplink */
+			switch (ch->sapi) {
+			case GsmL1_Sapi_Sdcch:
+			case GsmL1_Sapi_Sacch:
+			case GsmL1_Sapi_TchF:
+			case GsmL1_Sapi_TchH:
+				emu_send_data_ind(emu, tn, ch, fn);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	emu->stats.frames++;
+}
+
+static uint64_t elapsed_ns(const struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000000000ULL
+		+ now.tv_nsec - start->tv_nsec;
+}
+
+/* emulate all frames, that are due, and schedule the next one */
+static void emu_timer_cb(void *data)
+{
+	struct l1emu_hdl *emu = data;
+	uint64_t due, next_ns, ns;
+	int n = 0;
+
+	ns = elapsed_ns(&emu->start);
+	due = ns / emu->frame_ns + 1;
+	if (due > emu->frames_done + EMU_MAX_CATCHUP) {
+		/* drop the frames, we can't keep up with */
+		emu->stats.late_frames += due - emu->frames_done
+			- EMU_MAX_CATCHUP;
+		emu->fn = (emu->fn + due - emu->frames_done - EMU_MAX_CATCHUP)
+			% EMU_HYPERFRAME;
+		emu->frames_done = due - EMU_MAX_CATCHUP;
+	}
+
+	while (emu->frames_done < due) {
+		/* stop after exactly the requested number of frames */
+		if (max_frames && emu->stats.frames >= max_frames)
+			break;
+		emu_frame(emu, emu->fn);
+		emu->fn = (emu->fn + 1) % EMU_HYPERFRAME;
+		emu->frames_done++;
+		n++;
+	}
+	emu_mux_flush(emu);
+
+	if (max_frames && emu->stats.frames >= max_frames) {
+		dump_stats = -1;
+		return;
+	}
+
+	next_ns = emu->frames_done * emu->frame_ns;
+	ns = elapsed_ns(&emu->start);
+	ns = next_ns > ns ? next_ns - ns : 0;
+	osmo_timer_schedule(&emu->timer, ns / 1000000000ULL,
+		(ns % 1000000000ULL) / 1000);
+}
+
+static struct emu_chan *chan_find(struct emu_ts *ts, GsmL1_Sapi_t sapi,
+	GsmL1_SubCh_t subCh, GsmL1_Dir_t dir)
+{
+	int i;
+
+	for (i = 0; i < EMU_MAX_CHAN; i++) {
+		struct emu_chan *ch = &ts->chan[i];
+
+		if (ch->active && ch->sapi == sapi && ch->subCh == subCh
+		 && ch->dir == dir)
+			return ch;
+	}
+	return NULL;
+}
+
+static GsmL1_Status_t chan_activate(struct l1emu_hdl *emu, int queue,
+	GsmL1_MphActivateReq_t *act_req)
+{
+	static const GsmL1_Dir_t dirs[] = {
+		GsmL1_Dir_TxDownlink, GsmL1_Dir_RxUplink,
+	};
+	struct emu_ts *ts;
+	struct emu_chan *ch;
+	int i, j;
+
+	if (act_req->u8Tn >= ARRAY_SIZE(emu->ts))
+		return GsmL1_Status_InvalidParam;
+	ts = &emu->ts[act_req->u8Tn];
+
+	for (i = 0; i < ARRAY_SIZE(dirs); i++) {
+		if (!(act_req->dir & dirs[i]))
+			continue;
+		ch = chan_find(ts, act_req->sapi, act_req->subCh, dirs[i]);
+		for (j = 0; !ch && j < EMU_MAX_CHAN; j++) {
+			if (!ts->chan[j].active)
+				ch = &ts->chan[j];
+		}
+		if (!ch)
+			return GsmL1_Status_NoRessource;
+
+		ch->active = 1;
+		ch->sapi = act_req->sapi;
+		ch->subCh = act_req->subCh;
+		ch->dir = dirs[i];
+		ch->hLayer2 = act_req->hLayer2;
+		ch->queue = queue;
+	}
+
+	return GsmL1_Status_Success;
+}
+
+static void chan_deactivate(struct l1emu_hdl *emu,
+	GsmL1_MphDeactivateReq_t *deact_req)
+{
+	struct emu_ts *ts;
+	int i;
+
+	if (deact_req->u8Tn >= ARRAY_SIZE(emu->ts))
+		return;
+	ts = &emu->ts[deact_req->u8Tn];
+
+	for (i = 0; i < EMU_MAX_CHAN; i++) {
+		struct emu_chan *ch = &ts->chan[i];
+
+		if (ch->active && ch->sapi == deact_req->sapi
+		 && ch->subCh == deact_req->subCh
+		 && (ch->dir & deact_req->dir))
+			ch->active = 0;
+	}
+}
+
+/* confirm a request of the BTS on the L1 queue */
+static void handle_l1_req(struct l1emu_hdl *emu, int queue,
+	GsmL1_Prim_t *req)
+{
+	GsmL1_Prim_t cnf;
+	GsmL1_Status_t status = GsmL1_Status_Success;
+	uint8_t tn;
+
+	switch (req->id) {
+	case GsmL1_PrimId_PhDataReq:
+		emu->stats.data_req++;
+		return;
+	case GsmL1_PrimId_PhEmptyFrameReq:
+		emu->stats.empty_req++;
+		return;
+	default:
+		break;
+	}
+
+	if (req->id >= GsmL1_PrimId_NUM
+	 || femtobts_l1prim_type[req->id] != L1P_T_REQ) {
+		LOGP(DL1C, LOGL_NOTICE, "Unexpected L1 prim %u\n", req->id);
+		return;
+	}
+
+	memset(&cnf, 0, sizeof(cnf));
+	cnf.id = femtobts_l1prim_req2conf[req->id];
+
+	switch (req->id) {
+	case GsmL1_PrimId_MphInitReq:
+		memset(emu->ts, 0, sizeof(emu->ts));
+		cnf.u.mphInitCnf.hLayer1 = EMU_HLAYER1;
+		cnf.u.mphInitCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphCloseReq:
+		memset(emu->ts, 0, sizeof(emu->ts));
+		cnf.u.mphCloseCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphConnectReq:
+		tn = req->u.mphConnectReq.u8Tn;
+		if (tn < ARRAY_SIZE(emu->ts)) {
+			memset(&emu->ts[tn], 0, sizeof(emu->ts[tn]));
+			emu->ts[tn].connected = 1;
+			emu->ts[tn].comb = req->u.mphConnectReq.logChComb;
+		} else
+			status = GsmL1_Status_InvalidParam;
+		cnf.u.mphConnectCnf.u8Tn = tn;
+		cnf.u.mphConnectCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphDisconnectReq:
+		cnf.u.mphDisconnectCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphActivateReq:
+		status = chan_activate(emu, queue, &req->u.mphActivateReq);
+		cnf.u.mphActivateCnf.hLayer3 = req->u.mphActivateReq.hLayer3;
+		cnf.u.mphActivateCnf.u8Tn = req->u.mphActivateReq.u8Tn;
+		cnf.u.mphActivateCnf.sapi = req->u.mphActivateReq.sapi;
+		cnf.u.mphActivateCnf.dir = req->u.mphActivateReq.dir;
+		cnf.u.mphActivateCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphDeactivateReq:
+		chan_deactivate(emu, &req->u.mphDeactivateReq);
+		cnf.u.mphDeactivateCnf.hLayer3 = req->u.mphDeactivateReq.hLayer3;
+		cnf.u.mphDeactivateCnf.u8Tn = req->u.mphDeactivateReq.u8Tn;
+		cnf.u.mphDeactivateCnf.sapi = req->u.mphDeactivateReq.sapi;
+		cnf.u.mphDeactivateCnf.dir = req->u.mphDeactivateReq.dir;
+		cnf.u.mphDeactivateCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphConfigReq:
+		cnf.u.mphConfigCnf.hLayer3 = req->u.mphConfigReq.hLayer3;
+		cnf.u.mphConfigCnf.cfgParamId = req->u.mphConfigReq.cfgParamId;
+		cnf.u.mphConfigCnf.cfgParams = req->u.mphConfigReq.cfgParams;
+		cnf.u.mphConfigCnf.status = status;
+		break;
+	case GsmL1_PrimId_MphMeasureReq:
+		cnf.u.mphMeasureCnf.status = status;
+		break;
+	default:
+		break;
+	}
+
+	emu_send(emu, queue, &cnf, sizeof(cnf));
+	emu->stats.reqs++;
+}
+
+/* confirm a request of the BTS on the SYS queue */
+static void handle_sys_req(struct l1emu_hdl *emu, SuperFemto_Prim_t *req)
+{
+	SuperFemto_Prim_t cnf;
+
+	if (req->id >= SuperFemto_PrimId_NUM
+	 || femtobts_sysprim_type[req->id] != L1P_T_REQ) {
+		LOGP(DL1C, LOGL_NOTICE, "Unexpected SYS prim %u\n", req->id);
+		return;
+	}
+
+	/* there is no confirmation of the trace flags */
+	if (req->id == SuperFemto_PrimId_SetTraceFlagsReq)
+		return;
+
+	memset(&cnf, 0, sizeof(cnf));
+	cnf.id = femtobts_sysprim_req2conf[req->id];
+
+	switch (req->id) {
+	case SuperFemto_PrimId_Layer1ResetReq:
+		memset(emu->ts, 0, sizeof(emu->ts));
+		cnf.u.layer1ResetCnf.status = GsmL1_Status_Success;
+		break;
+	case SuperFemto_PrimId_SystemInfoReq:
+		cnf.u.systemInfoCnf.dspVersion.major = 0;
+		cnf.u.systemInfoCnf.dspVersion.minor = 0;
+		cnf.u.systemInfoCnf.dspVersion.build = 0;
+#ifdef HW_SYSMOBTS_V1
+		cnf.u.systemInfoCnf.rfBand.gsm850 = 1;
+		cnf.u.systemInfoCnf.rfBand.gsm900 = 1;
+		cnf.u.systemInfoCnf.rfBand.dcs1800 = 1;
+		cnf.u.systemInfoCnf.rfBand.pcs1900 = 1;
+#endif
+		break;
+	case SuperFemto_PrimId_ActivateRfReq:
+		cnf.u.activateRfCnf.status = GsmL1_Status_Success;
+		break;
+	case SuperFemto_PrimId_DeactivateRfReq:
+		cnf.u.deactivateRfCnf.status = GsmL1_Status_Success;
+		break;
+	default:
+		break;
+	}
+
+	emu_send(emu, MQ_SYS_READ, &cnf, sizeof(cnf));
+	emu->stats.reqs++;
+}
+
+/* a primitive of the BTS has arrived on a queue */
+static void handle_prim(struct l1emu_hdl *emu, int queue, const uint8_t *data,
+	unsigned int len)
+{
+	union {
+		GsmL1_Prim_t l1p;
+		SuperFemto_Prim_t sysp;
+	} prim;
+
+	if (queue >= ARRAY_SIZE(emu->q))
+		return;
+
+	memset(&prim, 0, sizeof(prim));
+	memcpy(&prim, data, OSMO_MIN(len, sizeof(prim)));
+
+	if (queue == MQ_SYS_WRITE)
+		handle_sys_req(emu, &prim.sysp);
+	else
+		handle_l1_req(emu, queue, &prim.l1p);
+}
+
+static int udp_fd_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct l1emu_hdl *emu = ofd->data;
+	struct emu_queue *q = &emu->q[ofd->priv_nr];
+	uint8_t buf[SYSMOBTS_PRIM_SIZE];
+	struct sockaddr_storage sa;
+	socklen_t sa_len = sizeof(sa);
+	int rc;
+
+	rc = recvfrom(ofd->fd, buf, sizeof(buf), MSG_DONTWAIT,
+		(struct sockaddr *) &sa, &sa_len);
+	if (rc <= 0)
+		return 0;
+
+	/* the latest sender is the remote */
+	memcpy(&q->remote_sa, &sa, sa_len);
+	q->remote_sa_len = sa_len;
+
+	handle_prim(emu, ofd->priv_nr, buf, rc);
+
+	return 0;
+}
+
+static int mux_fd_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct l1emu_hdl *emu = ofd->data;
+	uint8_t buf[L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	struct sockaddr_storage sa;
+	socklen_t sa_len = sizeof(sa);
+	const uint8_t *data;
+	unsigned int data_len, offset = 0;
+	uint8_t queue;
+	int rc, res;
+
+	rc = recvfrom(ofd->fd, buf, sizeof(buf), MSG_DONTWAIT,
+		(struct sockaddr *) &sa, &sa_len);
+	if (rc <= 0)
+		return 0;
+
+	if (!emu->mux_sa_len)
+		LOGP(DL1C, LOGL_NOTICE, "Remote uses the multiplexed socket\n");
+	memcpy(&emu->mux_sa, &sa, sa_len);
+	emu->mux_sa_len = sa_len;
+
+	while ((res = l1fwd_mux_get(buf, rc, &offset, &queue, &data,
+				    &data_len)) > 0)
+		handle_prim(emu, queue, data, data_len);
+	if (res < 0)
+		LOGP(DL1C, LOGL_ERROR, "Malformed mux datagram\n");
+
+	emu_mux_flush(emu);
+
+	return 0;
+}
+
+static void emu_dump_stats(struct l1emu_hdl *emu)
+{
+	struct emu_stats *st = &emu->stats;
+
+	LOGP(DL1C, LOGL_NOTICE, "%u frames (%u late), %u requests confirmed, "
+		"%u PH-RTS.ind, %u PH-DATA.ind, %u PH-DATA.req, "
+		"%u PH-EMPTY-FRAME.req, %u dropped\n", st->frames,
+		st->late_frames, st->reqs, st->rts_ind, st->data_ind,
+		st->data_req, st->empty_req, st->dropped);
+}
+
+static void signal_handler(int signal)
+{
+	if (signal == SIGUSR1)
+		dump_stats = 1;
+}
+
+static void print_help()
+{
+	printf( "Some useful options:\n"
+		"  -h	--help		this text\n"
+		"  -d	--debug MASK	Enable debugging (e.g. -d DL1C)\n"
+		"  -s	--speed FACTOR	Run the TDMA clock FACTOR times faster\n"
+		"  -n	--frames NUM	Exit after NUM frames\n"
+		);
+}
+
+static void handle_options(int argc, char **argv)
+{
+	while (1) {
+		int option_idx = 0, c;
+		static const struct option long_options[] = {
+			{ "help", 0, 0, 'h' },
+			{ "debug", 1, 0, 'd' },
+			{ "speed", 1, 0, 's' },
+			{ "frames", 1, 0, 'n' },
+			{ 0, 0, 0, 0 }
+		};
+
+		c = getopt_long(argc, argv, "hd:s:n:",
+				long_options, &option_idx);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'h':
+			print_help();
+			exit(0);
+			break;
+		case 'd':
+			log_parse_category_mask(osmo_stderr_target, optarg);
+			break;
+		case 's':
+			speed = atof(optarg);
+			if (speed <= 0) {
+				fprintf(stderr, "Invalid speed factor\n");
+				exit(2);
+			}
+			break;
+		case 'n':
+			max_frames = strtoul(optarg, NULL, 10);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct l1emu_hdl *emu;
+	int rc, i;
+
+	bts_log_init(NULL);
+	handle_options(argc, argv);
+	signal(SIGUSR1, &signal_handler);
+
+	emu = talloc_zero(NULL, struct l1emu_hdl);
+
+	for (i = 0; i < ARRAY_SIZE(emu->q); i++) {
+		struct emu_queue *q = &emu->q[i];
+
+		q->ofd.cb = udp_fd_cb;
+		q->ofd.when = BSC_FD_READ;
+		q->ofd.data = emu;
+		q->ofd.priv_nr = i;
+		rc = osmo_sock_init_ofd(&q->ofd, AF_UNSPEC, SOCK_DGRAM,
+					IPPROTO_UDP, NULL, emu_udp_ports[i],
+					OSMO_SOCK_F_BIND);
+		if (rc < 0) {
+			perror("sock_init");
+			exit(1);
+		}
+	}
+
+	emu->mux_ofd.cb = mux_fd_cb;
+	emu->mux_ofd.when = BSC_FD_READ;
+	emu->mux_ofd.data = emu;
+	rc = osmo_sock_init_ofd(&emu->mux_ofd, AF_UNSPEC, SOCK_DGRAM,
+				IPPROTO_UDP, NULL, L1FWD_MUX_PORT,
+				OSMO_SOCK_F_BIND);
+	if (rc < 0) {
+		perror("sock_init");
+		exit(1);
+	}
+
+	/* start the TDMA clock */
+	emu->frame_ns = EMU_FRAME_NS / speed;
+	if (!emu->frame_ns)
+		emu->frame_ns = 1;
+	clock_gettime(CLOCK_MONOTONIC, &emu->start);
+	emu->timer.cb = emu_timer_cb;
+	emu->timer.data = emu;
+	osmo_timer_schedule(&emu->timer, 0, 0);
+
+	LOGP(DL1C, LOGL_NOTICE, "Emulating the L1 at %.2f times real time\n",
+		speed);
+
+	while (1) {
+		rc = osmo_select_main(0);
+		if (rc < 0) {
+			perror("select");
+			exit(1);
+		}
+		if (dump_stats) {
+			emu_dump_stats(emu);
+			if (dump_stats < 0)
+				break;
+			dump_stats = 0;
+		}
+	}
+	exit(0);
+}
@@ -1,5 +1,69 @@
+#ifndef _L1_FWD_H
+#define _L1_FWD_H
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
 #define L1FWD_L1_PORT	9999
 #define L1FWD_SYS_PORT	9998
 #define L1FWD_TCH_PORT	9997
 #define L1FWD_PDTCH_PORT 9996
 
+/* all queues multiplexed over one socket */
+#define L1FWD_MUX_PORT	9995
+
+/* In the multiplexed framing, a datagram carries one or more primitives,
+ * each preceded by the number of its message queue and its length (in
+ * network byte order).  The primitives of all queues, that are ready at
+ * the same time, are packed into datagrams of at most L1FWD_MUX_MAX_LEN
+ * bytes, a primitive that doesn't fit is sent alone. */
+#define L1FWD_MUX_HDR_LEN	4
+#define L1FWD_MUX_MAX_LEN	1472
+
+/* append a primitive of 'queue' to the datagram in 'buf' of 'len' bytes,
+ * returns the new length or -ENOSPC */
+static inline int l1fwd_mux_put(uint8_t *buf, unsigned int len,
+	unsigned int max_len, uint8_t queue, const uint8_t *data,
+	unsigned int data_len)
+{
+	if (data_len > 0xffff
+	 || len + L1FWD_MUX_HDR_LEN + data_len > max_len)
+		return -ENOSPC;
+
+	buf[len++] = queue;
+	buf[len++] = 0;
+	buf[len++] = data_len >> 8;
+	buf[len++] = data_len;
+	memcpy(buf + len, data, data_len);
+
+	return len + data_len;
+}
+
+/* get the primitive at '*offset' of the datagram and advance '*offset'
+ * to the next one, returns 0 at the end of the datagram or -EINVAL if it
+ * is malformed */
+static inline int l1fwd_mux_get(const uint8_t *buf, unsigned int len,
+	unsigned int *offset, uint8_t *queue, const uint8_t **data,
+	unsigned int *data_len)
+{
+	unsigned int pos = *offset;
+
+	if (pos == len)
+		return 0;
+	if (pos + L1FWD_MUX_HDR_LEN > len)
+		return -EINVAL;
+
+	*queue = buf[pos];
+	*data_len = (buf[pos + 2] << 8) | buf[pos + 3];
+	pos += L1FWD_MUX_HDR_LEN;
+	if (!*data_len || pos + *data_len > len)
+		return -EINVAL;
+
+	*data = buf + pos;
+	*offset = pos + *data_len;
+
+	return 1;
+}
+
+#endif /* _L1_FWD_H */
@@ -19,10 +19,15 @@
  *
  */
 
+#define _GNU_SOURCE
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <signal.h>
+#include <time.h>
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -41,6 +46,7 @@
 
 #include <osmo-bts/logging.h>
 #include <osmo-bts/gsm_data.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include <sysmocom/femtobts/superfemto.h>
 #include <sysmocom/femtobts/gsml1prim.h>
@@ -52,6 +58,16 @@
 #include "l1_transp.h"
 #include "l1_fwd.h"
 
+/* The primitives are moved in batches: all datagrams waiting on a socket
+ * are received with one recvmmsg() and the primitives read from the DSP
+ * in one select() round are sent with one sendmmsg().  The msgbs come
+ * from the pool of the L1 transport.  The remote can either use one UDP
+ * socket per message queue, or all queues multiplexed on one socket, in
+ * which case the primitives ready at the same time share a datagram. */
+#define L1FWD_BATCH		16
+#define L1FWD_QUEUE_DEPTH	256
+#define L1FWD_SOCK_BUF		(256 * 1024)
+
 static const uint16_t fwd_udp_ports[_NUM_MQ_WRITE] = {
 	[MQ_SYS_READ]	= L1FWD_SYS_PORT,
 	[MQ_L1_READ]	= L1FWD_L1_PORT,
@@ -61,95 +77,453 @@ static const uint16_t fwd_udp_ports[_NUM_MQ_WRITE] = {
 #endif
 };
 
+/* time a primitive spent in the proxy, from the DSP to the network */
+static const uint32_t hist_limits_us[] = {
+	100, 200, 500, 1000, 2000, 5000, 10000,
+};
+
+struct l1fwd_hist {
+	uint32_t count[ARRAY_SIZE(hist_limits_us) + 1];
+	uint32_t max_us;
+};
+
+struct l1fwd_queue {
+	struct osmo_fd ofd;		/* UDP socket of the queue */
+	struct sockaddr_storage remote_sa;
+	socklen_t remote_sa_len;
+
+	struct llist_head tx_queue;	/* primitives to the remote */
+	unsigned int tx_len;
+
+	uint32_t rx_prims;
+	uint32_t tx_prims;
+	uint32_t dropped;
+	struct l1fwd_hist hist;
+};
+
 struct l1fwd_hdl {
-	struct sockaddr_storage remote_sa[_NUM_MQ_WRITE];
-	socklen_t remote_sa_len[_NUM_MQ_WRITE];
+	struct l1fwd_queue q[_NUM_MQ_WRITE];
 
-	struct osmo_wqueue udp_wq[_NUM_MQ_WRITE];
+	/* all queues on one socket, once the remote used it */
+	struct osmo_fd mux_ofd;
+	struct sockaddr_storage mux_sa;
+	socklen_t mux_sa_len;
 
 	struct femtol1_hdl *fl1h;
 };
 
+static int dump_stats = 0;
+
+static uint32_t now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void hist_add(struct l1fwd_hist *hist, uint32_t us)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(hist_limits_us); i++) {
+		if (us < hist_limits_us[i])
+			break;
+	}
+	hist->count[i]++;
+	if (us > hist->max_us)
+		hist->max_us = us;
+}
+
+static void l1fwd_dump_stats(struct l1fwd_hdl *l1fh)
+{
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(l1fh->q); i++) {
+		struct l1fwd_queue *q = &l1fh->q[i];
+
+		LOGP(DL1C, LOGL_NOTICE, "Queue %d: %u prims from the remote, "
+			"%u to the remote, %u dropped, max latency %u us\n",
+			i, q->rx_prims, q->tx_prims, q->dropped, q->hist.max_us);
+		for (j = 0; j < ARRAY_SIZE(q->hist.count); j++) {
+			if (j < ARRAY_SIZE(hist_limits_us))
+				LOGP(DL1C, LOGL_NOTICE, "  < %5u us: %u\n",
+					hist_limits_us[j], q->hist.count[j]);
+			else
+				LOGP(DL1C, LOGL_NOTICE, " >= %5u us: %u\n",
+					hist_limits_us[j - 1], q->hist.count[j]);
+		}
+	}
+}
+
+static void signal_handler(int signal)
+{
+	if (signal == SIGUSR1)
+		dump_stats = 1;
+}
+
+/* queue a primitive from the DSP for the remote */
+static int l1fwd_enqueue(struct l1fwd_hdl *l1fh, int queue, struct msgb *msg)
+{
+	struct l1fwd_queue *q = &l1fh->q[queue];
+
+	if (q->tx_len >= L1FWD_QUEUE_DEPTH) {
+		q->dropped++;
+		bts_msgb_free(msg);
+		return -ENOSPC;
+	}
+
+	msg->cb[0] = now_us();
+	msgb_enqueue(&q->tx_queue, msg);
+	q->tx_len++;
+
+	if (l1fh->mux_sa_len)
+		l1fh->mux_ofd.when |= BSC_FD_WRITE;
+	else
+		q->ofd.when |= BSC_FD_WRITE;
+
+	return 0;
+}
+
+static void l1fwd_sent(struct l1fwd_queue *q, struct msgb *msg, uint32_t now)
+{
+	hist_add(&q->hist, now - msg->cb[0]);
+	q->tx_prims++;
+	bts_msgb_free(msg);
+}
 
 /* callback when there's a new L1 primitive coming in from the HW */
 int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg)
 {
-	struct l1fwd_hdl *l1fh = fl1h->priv;
-
-	/* Enqueue message to UDP socket */
-	return osmo_wqueue_enqueue(&l1fh->udp_wq[wq], msg);
+	return l1fwd_enqueue(fl1h->priv, wq, msg);
 }
 
 /* callback when there's a new SYS primitive coming in from the HW */
 int l1if_handle_sysprim(struct femtol1_hdl *fl1h, struct msgb *msg)
 {
-	struct l1fwd_hdl *l1fh = fl1h->priv;
-
-	/* Enqueue message to UDP socket */
-	return osmo_wqueue_enqueue(&l1fh->udp_wq[MQ_SYS_WRITE], msg);
+	return l1fwd_enqueue(fl1h->priv, MQ_SYS_WRITE, msg);
 }
 
-
-/* data has arrived on the udp socket */
-static int udp_read_cb(struct osmo_fd *ofd)
+/* hand a primitive from the remote to the DSP */
+static void l1fwd_to_dsp(struct l1fwd_hdl *l1fh, int queue, struct msgb *msg)
 {
-	struct msgb *msg = msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128, "udp_rx");
-	struct l1fwd_hdl *l1fh = ofd->data;
-	struct femtol1_hdl *fl1h = l1fh->fl1h;
-	int rc;
+	if (queue >= ARRAY_SIZE(l1fh->q)) {
+		bts_msgb_free(msg);
+		return;
+	}
+
+	l1fh->q[queue].rx_prims++;
+	if (osmo_wqueue_enqueue(&l1fh->fl1h->write_q[queue], msg) < 0) {
+		l1fh->q[queue].dropped++;
+		bts_msgb_free(msg);
+	}
+}
 
-	if (!msg)
+/* datagrams have arrived on the UDP socket of a queue */
+static int udp_read_cb(struct l1fwd_hdl *l1fh, struct l1fwd_queue *q,
+	int queue)
+{
+	struct mmsghdr mmsg[L1FWD_BATCH];
+	struct iovec iov[L1FWD_BATCH];
+	struct msgb *msg[L1FWD_BATCH];
+	struct sockaddr_storage sa[L1FWD_BATCH];
+	int i, n, rc;
+
+	for (n = 0; n < L1FWD_BATCH; n++) {
+		msg[n] = bts_msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128,
+			"udp_rx");
+		if (!msg[n])
+			break;
+		msg[n]->l1h = msg[n]->data;
+		iov[n].iov_base = msg[n]->l1h;
+		iov[n].iov_len = msgb_tailroom(msg[n]);
+		memset(&mmsg[n], 0, sizeof(mmsg[n]));
+		mmsg[n].msg_hdr.msg_name = &sa[n];
+		mmsg[n].msg_hdr.msg_namelen = sizeof(sa[n]);
+		mmsg[n].msg_hdr.msg_iov = &iov[n];
+		mmsg[n].msg_hdr.msg_iovlen = 1;
+	}
+	if (!n)
 		return -ENOMEM;
 
-	msg->l1h = msg->data;
+	rc = recvmmsg(q->ofd.fd, mmsg, n, MSG_DONTWAIT, NULL);
+	if (rc < 0) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			perror("read from udp");
+		rc = 0;
+	}
+
+	for (i = 0; i < rc; i++) {
+		if (mmsg[i].msg_len == 0) {
+			LOGP(DL1C, LOGL_ERROR, "len=0 read from udp\n");
+			bts_msgb_free(msg[i]);
+			continue;
+		}
+		msgb_put(msg[i], mmsg[i].msg_len);
+
+		DEBUGP(DL1C, "UDP: Received %u bytes for queue %d\n",
+			mmsg[i].msg_len, queue);
+
+		/* the latest sender is the remote */
+		memcpy(&q->remote_sa, &sa[i], mmsg[i].msg_hdr.msg_namelen);
+		q->remote_sa_len = mmsg[i].msg_hdr.msg_namelen;
+
+		/* put the message into the right queue */
+		l1fwd_to_dsp(l1fh, queue, msg[i]);
+	}
+
+	for (i = rc; i < n; i++)
+		bts_msgb_free(msg[i]);
+
+	return 0;
+}
+
+/* send the primitives of a queue, one per datagram */
+static int udp_write_cb(struct l1fwd_queue *q)
+{
+	struct mmsghdr mmsg[L1FWD_BATCH];
+	struct iovec iov[L1FWD_BATCH];
+	struct msgb *msg;
+	uint32_t now;
+	int i, n = 0, rc;
+
+	q->ofd.when &= ~BSC_FD_WRITE;
+
+	/* nobody to send it to yet */
+	if (!q->remote_sa_len) {
+		while ((msg = msgb_dequeue(&q->tx_queue))) {
+			q->tx_len--;
+			q->dropped++;
+			bts_msgb_free(msg);
+		}
+		return 0;
+	}
+
+	llist_for_each_entry(msg, &q->tx_queue, list) {
+		if (n == L1FWD_BATCH)
+			break;
+		iov[n].iov_base = msg->l1h;
+		iov[n].iov_len = msgb_l1len(msg);
+		memset(&mmsg[n], 0, sizeof(mmsg[n]));
+		mmsg[n].msg_hdr.msg_name = &q->remote_sa;
+		mmsg[n].msg_hdr.msg_namelen = q->remote_sa_len;
+		mmsg[n].msg_hdr.msg_iov = &iov[n];
+		mmsg[n].msg_hdr.msg_iovlen = 1;
+		n++;
+	}
 
-	l1fh->remote_sa_len[ofd->priv_nr] = sizeof(l1fh->remote_sa[ofd->priv_nr]);
-	rc = recvfrom(ofd->fd, msg->l1h, msgb_tailroom(msg), 0,
-		      (struct sockaddr *) &l1fh->remote_sa[ofd->priv_nr], &l1fh->remote_sa_len[ofd->priv_nr]);
+	rc = sendmmsg(q->ofd.fd, mmsg, n, MSG_DONTWAIT);
 	if (rc < 0) {
-		perror("read from udp");
-		msgb_free(msg);
-		return rc;
-	} else if (rc == 0) {
-		perror("len=0 read from udp");
-		msgb_free(msg);	
-		return rc;
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			LOGP(DL1C, LOGL_ERROR, "error writing to UDP: %s\n",
+				strerror(errno));
+			/* the first one can't be sent */
+			msg = msgb_dequeue(&q->tx_queue);
+			q->tx_len--;
+			q->dropped++;
+			bts_msgb_free(msg);
+		}
+		rc = 0;
+	}
+
+	now = now_us();
+	for (i = 0; i < rc; i++) {
+		msg = msgb_dequeue(&q->tx_queue);
+		q->tx_len--;
+		l1fwd_sent(q, msg, now);
 	}
-	msgb_put(msg, rc);
 
-	DEBUGP(DL1C, "UDP: Received %u bytes for queue %d\n", rc,
-		ofd->priv_nr);
+	if (q->tx_len)
+		q->ofd.when |= BSC_FD_WRITE;
 
-	/* put the message into the right queue */
-	rc = osmo_wqueue_enqueue(&fl1h->write_q[ofd->priv_nr], msg);
-	
-	return rc;
+	return 0;
 }
 
-/* callback when we can write to the UDP socket */
-static int udp_write_cb(struct osmo_fd *ofd, struct msgb *msg)
+static int udp_fd_cb(struct osmo_fd *ofd, unsigned int what)
 {
-	int rc;
 	struct l1fwd_hdl *l1fh = ofd->data;
+	struct l1fwd_queue *q = &l1fh->q[ofd->priv_nr];
+
+	if (what & BSC_FD_READ)
+		udp_read_cb(l1fh, q, ofd->priv_nr);
+	if (what & BSC_FD_WRITE)
+		udp_write_cb(q);
+
+	return 0;
+}
+
+/* datagrams with primitives of all queues have arrived */
+static int mux_read_cb(struct l1fwd_hdl *l1fh)
+{
+	static uint8_t buf[L1FWD_BATCH][L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	struct mmsghdr mmsg[L1FWD_BATCH];
+	struct iovec iov[L1FWD_BATCH];
+	struct sockaddr_storage sa;
+	const uint8_t *data;
+	unsigned int data_len, offset;
+	struct msgb *msg;
+	uint8_t queue;
+	int i, rc, res;
+
+	memset(mmsg, 0, sizeof(mmsg));
+	for (i = 0; i < L1FWD_BATCH; i++) {
+		iov[i].iov_base = buf[i];
+		iov[i].iov_len = sizeof(buf[i]);
+		mmsg[i].msg_hdr.msg_iov = &iov[i];
+		mmsg[i].msg_hdr.msg_iovlen = 1;
+	}
+	/* the sender of the first datagram is the remote */
+	mmsg[0].msg_hdr.msg_name = &sa;
+	mmsg[0].msg_hdr.msg_namelen = sizeof(sa);
+
+	rc = recvmmsg(l1fh->mux_ofd.fd, mmsg, L1FWD_BATCH, MSG_DONTWAIT, NULL);
+	if (rc <= 0) {
+		if (rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+			perror("read from mux udp");
+		return 0;
+	}
 
-	DEBUGP(DL1C, "UDP: Writing %u bytes for queue %d\n", msgb_l1len(msg),
-		ofd->priv_nr);
+	if (!l1fh->mux_sa_len)
+		LOGP(DL1C, LOGL_NOTICE, "Remote uses the multiplexed socket\n");
+	memcpy(&l1fh->mux_sa, &sa, mmsg[0].msg_hdr.msg_namelen);
+	l1fh->mux_sa_len = mmsg[0].msg_hdr.msg_namelen;
+
+	for (i = 0; i < rc; i++) {
+		offset = 0;
+		while ((res = l1fwd_mux_get(buf[i], mmsg[i].msg_len, &offset,
+					&queue, &data, &data_len)) > 0) {
+			if (data_len > SYSMOBTS_PRIM_SIZE - 128)
+				continue;
+			msg = bts_msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128,
+				"mux_rx");
+			if (!msg)
+				break;
+			msg->l1h = msgb_put(msg, data_len);
+			memcpy(msg->l1h, data, data_len);
+			l1fwd_to_dsp(l1fh, queue, msg);
+		}
+		if (res < 0)
+			LOGP(DL1C, LOGL_ERROR, "Malformed mux datagram\n");
+	}
+
+	return 0;
+}
 
-	rc = sendto(ofd->fd, msg->l1h, msgb_l1len(msg), 0,
-		    (const struct sockaddr *)&l1fh->remote_sa[ofd->priv_nr], l1fh->remote_sa_len[ofd->priv_nr]);
+/* pack the primitives of all queues into datagrams */
+static int mux_write_cb(struct l1fwd_hdl *l1fh)
+{
+	static uint8_t buf[L1FWD_BATCH][L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	struct mmsghdr mmsg[L1FWD_BATCH];
+	struct iovec iov[L1FWD_BATCH];
+	unsigned int nprims[L1FWD_BATCH][ARRAY_SIZE(l1fh->q)];
+	struct msgb *msg;
+	uint32_t now;
+	int i, j, n = 0, len = 0, rc;
+
+	l1fh->mux_ofd.when &= ~BSC_FD_WRITE;
+
+	memset(nprims, 0, sizeof(nprims));
+	for (i = 0; i < ARRAY_SIZE(l1fh->q) && n < L1FWD_BATCH; i++) {
+		struct l1fwd_queue *q = &l1fh->q[i];
+
+		llist_for_each_entry(msg, &q->tx_queue, list) {
+			rc = l1fwd_mux_put(buf[n], len, L1FWD_MUX_MAX_LEN, i,
+				msg->l1h, msgb_l1len(msg));
+			if (rc == -ENOSPC && len) {
+				/* start the next datagram */
+				iov[n].iov_len = len;
+				if (++n == L1FWD_BATCH)
+					break;
+				len = 0;
+				rc = l1fwd_mux_put(buf[n], len,
+					L1FWD_MUX_MAX_LEN, i, msg->l1h,
+					msgb_l1len(msg));
+			}
+			if (rc == -ENOSPC) {
+				/* too long for a datagram with others */
+				rc = l1fwd_mux_put(buf[n], len,
+					sizeof(buf[n]), i, msg->l1h,
+					msgb_l1len(msg));
+			}
+			if (rc < 0)
+				break;
+			len = rc;
+			nprims[n][i]++;
+		}
+	}
+	if (len && n < L1FWD_BATCH)
+		iov[n++].iov_len = len;
+	if (!n)
+		return 0;
+
+	for (i = 0; i < n; i++) {
+		iov[i].iov_base = buf[i];
+		memset(&mmsg[i], 0, sizeof(mmsg[i]));
+		mmsg[i].msg_hdr.msg_name = &l1fh->mux_sa;
+		mmsg[i].msg_hdr.msg_namelen = l1fh->mux_sa_len;
+		mmsg[i].msg_hdr.msg_iov = &iov[i];
+		mmsg[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rc = sendmmsg(l1fh->mux_ofd.fd, mmsg, n, MSG_DONTWAIT);
 	if (rc < 0) {
-		LOGP(DL1C, LOGL_ERROR, "error writing to L1 msg_queue: %s\n",
-			strerror(errno));
-		return rc;
-	} else if (rc < msgb_l1len(msg)) {
-		LOGP(DL1C, LOGL_ERROR, "short write to L1 msg_queue: "
-			"%u < %u\n", rc, msgb_l1len(msg));
-		return -EIO;
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			LOGP(DL1C, LOGL_ERROR, "error writing to UDP: %s\n",
+				strerror(errno));
+			/* drop the first datagram */
+			for (j = 0; j < ARRAY_SIZE(l1fh->q); j++)
+				l1fh->q[j].dropped += nprims[0][j];
+			rc = -1;
+		} else
+			rc = 0;
+	}
+
+	/* the primitives of the datagrams, that were sent */
+	now = now_us();
+	for (i = 0; i < (rc < 0 ? 1 : rc); i++) {
+		for (j = 0; j < ARRAY_SIZE(l1fh->q); j++) {
+			struct l1fwd_queue *q = &l1fh->q[j];
+
+			while (nprims[i][j]--) {
+				msg = msgb_dequeue(&q->tx_queue);
+				q->tx_len--;
+				if (rc < 0) {
+					bts_msgb_free(msg);
+					continue;
+				}
+				l1fwd_sent(q, msg, now);
+			}
+		}
+	}
+
+	for (j = 0; j < ARRAY_SIZE(l1fh->q); j++) {
+		if (l1fh->q[j].tx_len)
+			l1fh->mux_ofd.when |= BSC_FD_WRITE;
 	}
 
 	return 0;
 }
 
+static int mux_fd_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct l1fwd_hdl *l1fh = ofd->data;
+
+	if (what & BSC_FD_READ)
+		mux_read_cb(l1fh);
+	if (what & BSC_FD_WRITE)
+		mux_write_cb(l1fh);
+
+	return 0;
+}
+
+static void sock_set_bufs(int fd)
+{
+	int size = L1FWD_SOCK_BUF;
+
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+	setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+}
+
 int main(int argc, char **argv)
 {
 	struct l1fwd_hdl *l1fh;
@@ -160,16 +534,17 @@ int main(int argc, char **argv)
 	printf("sizeof(SuperFemto_Prim_t) = %zu\n", sizeof(SuperFemto_Prim_t));
 
 	bts_log_init(NULL);
+	signal(SIGUSR1, &signal_handler);
 
 	/* allocate new femtol1_handle */
 	fl1h = talloc_zero(NULL, struct femtol1_hdl);
-	INIT_LLIST_HEAD(&fl1h->wlc_list);
 
 	/* open the actual hardware transport */
 	for (i = 0; i < ARRAY_SIZE(fl1h->write_q); i++) {
 		rc = l1if_transport_open(i, fl1h);
 		if (rc < 0)
 			exit(1);
+		fl1h->write_q[i].max_length = L1FWD_QUEUE_DEPTH;
 	}
 
 	/* create our fwd handle */
@@ -179,31 +554,46 @@ int main(int argc, char **argv)
 	fl1h->priv = l1fh;
 
 	/* Open UDP */
-	for (i = 0; i < ARRAY_SIZE(l1fh->udp_wq); i++) {
-		struct osmo_wqueue *wq = &l1fh->udp_wq[i];
-
-		osmo_wqueue_init(wq, 10);
-		wq->write_cb = udp_write_cb;
-		wq->read_cb = udp_read_cb;
-
-		wq->bfd.when |= BSC_FD_READ;
-		wq->bfd.data = l1fh;
-		wq->bfd.priv_nr = i;
-		rc = osmo_sock_init_ofd(&wq->bfd, AF_UNSPEC, SOCK_DGRAM,
+	for (i = 0; i < ARRAY_SIZE(l1fh->q); i++) {
+		struct l1fwd_queue *q = &l1fh->q[i];
+
+		INIT_LLIST_HEAD(&q->tx_queue);
+		q->ofd.cb = udp_fd_cb;
+		q->ofd.when = BSC_FD_READ;
+		q->ofd.data = l1fh;
+		q->ofd.priv_nr = i;
+		rc = osmo_sock_init_ofd(&q->ofd, AF_UNSPEC, SOCK_DGRAM,
 					IPPROTO_UDP, NULL, fwd_udp_ports[i],
 					OSMO_SOCK_F_BIND);
 		if (rc < 0) {
 			perror("sock_init");
 			exit(1);
 		}
+		sock_set_bufs(q->ofd.fd);
+	}
+
+	l1fh->mux_ofd.cb = mux_fd_cb;
+	l1fh->mux_ofd.when = BSC_FD_READ;
+	l1fh->mux_ofd.data = l1fh;
+	rc = osmo_sock_init_ofd(&l1fh->mux_ofd, AF_UNSPEC, SOCK_DGRAM,
+				IPPROTO_UDP, NULL, L1FWD_MUX_PORT,
+				OSMO_SOCK_F_BIND);
+	if (rc < 0) {
+		perror("sock_init");
+		exit(1);
 	}
+	sock_set_bufs(l1fh->mux_ofd.fd);
 
 	while (1) {
-		rc = osmo_select_main(0);		
+		rc = osmo_select_main(0);
 		if (rc < 0) {
 			perror("select");
 			exit(1);
 		}
+		if (dump_stats) {
+			dump_stats = 0;
+			l1fwd_dump_stats(l1fh);
+		}
 	}
 	exit(0);
 }
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -43,6 +44,8 @@
 #include <osmo-bts/measurement.h>
 #include <osmo-bts/pcu_if.h>
 #include <osmo-bts/l1sap.h>
+#include <osmo-bts/msgb_pool.h>
+#include <osmo-bts/timer_wheel.h>
 
 #include <sysmocom/femtobts/superfemto.h>
 #include <sysmocom/femtobts/gsml1prim.h>
@@ -59,21 +62,22 @@ extern int pcu_direct;
 #define MIN_QUAL_RACH	 5.0f	/* at least  5 dB C/I */
 #define MIN_QUAL_NORM	-0.5f	/* at least -1 dB C/I */
 
+/* Pending requests are kept in a list per confirm primitive id, so a
+ * received confirm is matched without walking all pending requests, and
+ * indications don't have to look at them at all.  Requests waiting for
+ * the same confirm are completed in the order they were sent.  The
+ * timeouts are on one timer wheel instead of an osmo_timer each. */
+#define L1_REQ_TIMEOUT_SECS	30
+
 struct wait_l1_conf {
 	struct llist_head list;		/* internal linked list */
-	struct osmo_timer_list timer;	/* timer for L1 timeout */
+	struct timer_wheel_entry timeout; /* timeout for the L1 response */
 	unsigned int conf_prim_id;	/* primitive we expect in response */
 	unsigned int is_sys_prim;	/* is this a system (1) or L1 (0) primitive */
 	l1if_compl_cb *cb;
 	void *cb_data;
 };
 
-static void release_wlc(struct wait_l1_conf *wlc)
-{
-	osmo_timer_del(&wlc->timer);
-	talloc_free(wlc);
-}
-
 static void l1if_req_timeout(void *data)
 {
 	struct wait_l1_conf *wlc = data;
@@ -87,17 +91,51 @@ static void l1if_req_timeout(void *data)
 	exit(23);
 }
 
+static struct wait_l1_conf *alloc_wlc(struct femtol1_hdl *fl1h)
+{
+	struct wait_l1_conf *wlc;
+
+	if (llist_empty(&fl1h->wlc_free))
+		return talloc_zero(fl1h, struct wait_l1_conf);
+
+	wlc = llist_entry(fl1h->wlc_free.next, struct wait_l1_conf, list);
+	llist_del(&wlc->list);
+	memset(wlc, 0, sizeof(*wlc));
+
+	return wlc;
+}
+
+/* remove a pending request and keep it for the next one */
+static void release_wlc(struct femtol1_hdl *fl1h, struct wait_l1_conf *wlc)
+{
+	timer_wheel_del(&fl1h->wlc_timeouts, &wlc->timeout);
+	llist_del(&wlc->list);
+	llist_add(&wlc->list, &fl1h->wlc_free);
+}
+
+static int complete_wlc(struct femtol1_hdl *fl1h, struct llist_head *pending,
+		struct msgb *msg)
+{
+	struct wait_l1_conf *wlc;
+	l1if_compl_cb *cb;
+
+	wlc = llist_entry(pending->next, struct wait_l1_conf, list);
+	cb = wlc->cb;
+	release_wlc(fl1h, wlc);
+
+	if (cb)
+		return cb(fl1h->priv, msg);
+
+	bts_msgb_free(msg);
+	return 0;
+}
+
 static int _l1if_req_compl(struct femtol1_hdl *fl1h, struct msgb *msg,
 		   int is_system_prim, l1if_compl_cb *cb)
 {
 	struct wait_l1_conf *wlc;
 	struct osmo_wqueue *wqueue;
-	unsigned int timeout_secs;
-
-	/* allocate new wsc and store reference to mutex and conf_id */
-	wlc = talloc_zero(fl1h, struct wait_l1_conf);
-	wlc->cb = cb;
-	wlc->cb_data = NULL;
+	struct llist_head *pending;
 
 	/* Make sure we actually have received a REQUEST type primitive */
 	if (is_system_prim == 0) {
@@ -109,13 +147,15 @@ static int _l1if_req_compl(struct femtol1_hdl *fl1h, struct msgb *msg,
 		if (femtobts_l1prim_type[l1p->id] != L1P_T_REQ) {
 			LOGP(DL1C, LOGL_ERROR, "L1 Prim %s is not a Request!\n",
 				get_value_string(femtobts_l1prim_names, l1p->id));
-			talloc_free(wlc);
 			return -EINVAL;
 		}
+		wlc = alloc_wlc(fl1h);
+		if (!wlc)
+			return -ENOMEM;
 		wlc->is_sys_prim = 0;
 		wlc->conf_prim_id = femtobts_l1prim_req2conf[l1p->id];
 		wqueue = &fl1h->write_q[MQ_L1_WRITE];
-		timeout_secs = 30;
+		pending = &fl1h->wlc_l1[wlc->conf_prim_id];
 	} else {
 		SuperFemto_Prim_t *sysp = msgb_sysprim(msg);
 
@@ -125,23 +165,28 @@ static int _l1if_req_compl(struct femtol1_hdl *fl1h, struct msgb *msg,
 		if (femtobts_sysprim_type[sysp->id] != L1P_T_REQ) {
 			LOGP(DL1C, LOGL_ERROR, "SYS Prim %s is not a Request!\n",
 				get_value_string(femtobts_sysprim_names, sysp->id));
-			talloc_free(wlc);
 			return -EINVAL;
 		}
+		wlc = alloc_wlc(fl1h);
+		if (!wlc)
+			return -ENOMEM;
 		wlc->is_sys_prim = 1;
 		wlc->conf_prim_id = femtobts_sysprim_req2conf[sysp->id];
 		wqueue = &fl1h->write_q[MQ_SYS_WRITE];
-		timeout_secs = 30;
+		pending = &fl1h->wlc_sys[wlc->conf_prim_id];
 	}
+	wlc->cb = cb;
+	wlc->cb_data = NULL;
 
 	/* enqueue the message in the queue and add wsc to list */
 	osmo_wqueue_enqueue(wqueue, msg);
-	llist_add(&wlc->list, &fl1h->wlc_list);
+	llist_add_tail(&wlc->list, pending);
 
-	/* schedule a timer for timeout_secs seconds. If DSP fails to respond, we terminate */
-	wlc->timer.data = wlc;
-	wlc->timer.cb = l1if_req_timeout;
-	osmo_timer_schedule(&wlc->timer, timeout_secs, 0);
+	/* If DSP fails to respond, we terminate */
+	wlc->timeout.cb = l1if_req_timeout;
+	wlc->timeout.data = wlc;
+	timer_wheel_add(&fl1h->wlc_timeouts, &wlc->timeout,
+			L1_REQ_TIMEOUT_SECS);
 
 	return 0;
 }
@@ -162,7 +207,7 @@ int l1if_gsm_req_compl(struct femtol1_hdl *fl1h, struct msgb *msg,
 /* allocate a msgb containing a GsmL1_Prim_t */
 struct msgb *l1p_msgb_alloc(void)
 {
-	struct msgb *msg = msgb_alloc(sizeof(GsmL1_Prim_t), "l1_prim");
+	struct msgb *msg = bts_msgb_alloc(sizeof(GsmL1_Prim_t), "l1_prim");
 
 	if (msg)
 		msg->l1h = msgb_put(msg, sizeof(GsmL1_Prim_t));
@@ -173,7 +218,7 @@ struct msgb *l1p_msgb_alloc(void)
 /* allocate a msgb containing a SuperFemto_Prim_t */
 struct msgb *sysp_msgb_alloc(void)
 {
-	struct msgb *msg = msgb_alloc(sizeof(SuperFemto_Prim_t), "sys_prim");
+	struct msgb *msg = bts_msgb_alloc(sizeof(SuperFemto_Prim_t), "sys_prim");
 
 	if (msg)
 		msg->l1h = msgb_put(msg, sizeof(SuperFemto_Prim_t));
@@ -486,7 +531,7 @@ int bts_model_l1sap_down(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 
 done:
 	if (msg)
-		msgb_free(msg);
+		bts_msgb_free(msg);
 	return rc;
 }
 
@@ -697,7 +742,7 @@ tx:
 	/* transmit */
 	osmo_wqueue_enqueue(&fl1->write_q[MQ_L1_WRITE], resp_msg);
 
-	msgb_free(l1p_msg);
+	bts_msgb_free(l1p_msg);
 	return 0;
 
 empty_frame:
@@ -737,7 +782,7 @@ static int handle_ph_data_ind(struct femtol1_hdl *fl1, GsmL1_PhDataInd_t *data_i
 
 	if (data_ind->measParam.fLinkQuality < fl1->min_qual_norm
 	 && data_ind->msgUnitParam.u8Size != 0) {
-		msgb_free(l1p_msg);
+		bts_msgb_free(l1p_msg);
  		return 0;
 	}
 
@@ -799,7 +844,7 @@ static int handle_ph_ra_ind(struct femtol1_hdl *fl1, GsmL1_PhRaInd_t *ra_ind,
 		btsb->load.rach.busy++;
 
 	if (ra_ind->measParam.fLinkQuality < fl1->min_qual_rach) {
-		msgb_free(l1p_msg);
+		bts_msgb_free(l1p_msg);
 		return 0;
 	}
 
@@ -808,7 +853,7 @@ static int handle_ph_ra_ind(struct femtol1_hdl *fl1, GsmL1_PhRaInd_t *ra_ind,
 	if (ra_ind->msgUnitParam.u8Size != 1) {
 		LOGP(DL1C, LOGL_ERROR, "PH-RACH-INDICATION has %d bits\n",
 			ra_ind->sapi);
-		msgb_free(l1p_msg);
+		bts_msgb_free(l1p_msg);
 		return 0;
 	}
 
@@ -859,27 +904,14 @@ static int l1if_handle_ind(struct femtol1_hdl *fl1, struct msgb *msg)
 		break;
 	}
 
-	msgb_free(msg);
+	bts_msgb_free(msg);
 
 	return rc;
 }
 
-static inline int is_prim_compat(GsmL1_Prim_t *l1p, struct wait_l1_conf *wlc)
-{
-	/* the limitation here is that we cannot have multiple callers
-	 * sending the same primitive */
-	if (wlc->is_sys_prim != 0)
-		return 0;
-	if (l1p->id != wlc->conf_prim_id)
-		return 0;
-	return 1;
-}
-
 int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg)
 {
 	GsmL1_Prim_t *l1p = msgb_l1prim(msg);
-	struct wait_l1_conf *wlc;
-	int rc;
 
 	switch (l1p->id) {
 	case GsmL1_PrimId_MphTimeInd:
@@ -891,19 +923,10 @@ int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg)
 	}
 
 	/* check if this is a resposne to a sync-waiting request */
-	llist_for_each_entry(wlc, &fl1h->wlc_list, list) {
-		if (is_prim_compat(l1p, wlc)) {
-			llist_del(&wlc->list);
-			if (wlc->cb)
-				rc = wlc->cb(fl1h->priv, msg);
-			else {
-				rc = 0;
-				msgb_free(msg);
-			}
-			release_wlc(wlc);
-			return rc;
-		}
-	}
+	if (l1p->id < GsmL1_PrimId_NUM
+	 && femtobts_l1prim_type[l1p->id] == L1P_T_CONF
+	 && !llist_empty(&fl1h->wlc_l1[l1p->id]))
+		return complete_wlc(fl1h, &fl1h->wlc_l1[l1p->id], msg);
 
 	/* if we reach here, it is not a Conf for a pending Req */
 	return l1if_handle_ind(fl1h, msg);
@@ -912,28 +935,15 @@ int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg)
 int l1if_handle_sysprim(struct femtol1_hdl *fl1h, struct msgb *msg)
 {
 	SuperFemto_Prim_t *sysp = msgb_sysprim(msg);
-	struct wait_l1_conf *wlc;
-	int rc;
 
 	LOGP(DL1P, LOGL_DEBUG, "Rx SYS prim %s\n",
 		get_value_string(femtobts_sysprim_names, sysp->id));
 
 	/* check if this is a resposne to a sync-waiting request */
-	llist_for_each_entry(wlc, &fl1h->wlc_list, list) {
-		/* the limitation here is that we cannot have multiple callers
-		 * sending the same primitive */
-		if (wlc->is_sys_prim && sysp->id == wlc->conf_prim_id) {
-			llist_del(&wlc->list);
-			if (wlc->cb)
-				rc = wlc->cb(fl1h->priv, msg);
-			else {
-				rc = 0;
-				msgb_free(msg);
-			}
-			release_wlc(wlc);
-			return rc;
-		}
-	}
+	if (sysp->id < SuperFemto_PrimId_NUM
+	 && !llist_empty(&fl1h->wlc_sys[sysp->id]))
+		return complete_wlc(fl1h, &fl1h->wlc_sys[sysp->id], msg);
+
 	/* if we reach here, it is not a Conf for a pending Req */
 	return l1if_handle_ind(fl1h, msg);
 }
@@ -1166,6 +1176,7 @@ int l1if_set_trace_flags(struct femtol1_hdl *hdl, uint32_t flags)
 struct femtol1_hdl *l1if_open(void *priv)
 {
 	struct femtol1_hdl *fl1h;
+	unsigned int i;
 	int rc;
 
 #ifndef HW_SYSMOBTS_V1
@@ -1183,7 +1194,12 @@ struct femtol1_hdl *l1if_open(void *priv)
 	fl1h = talloc_zero(priv, struct femtol1_hdl);
 	if (!fl1h)
 		return NULL;
-	INIT_LLIST_HEAD(&fl1h->wlc_list);
+	for (i = 0; i < ARRAY_SIZE(fl1h->wlc_l1); i++)
+		INIT_LLIST_HEAD(&fl1h->wlc_l1[i]);
+	for (i = 0; i < ARRAY_SIZE(fl1h->wlc_sys); i++)
+		INIT_LLIST_HEAD(&fl1h->wlc_sys[i]);
+	INIT_LLIST_HEAD(&fl1h->wlc_free);
+	timer_wheel_init(&fl1h->wlc_timeouts, 1000);
 
 	fl1h->priv = priv;
 	fl1h->clk_cal = 0;
@@ -7,6 +7,11 @@
 #include <osmocom/core/timer.h>
 #include <osmocom/gsm/gsm_utils.h>
 
+#include <osmo-bts/timer_wheel.h>
+
+#include <sysmocom/femtobts/superfemto.h>
+#include <sysmocom/femtobts/gsml1prim.h>
+
 enum {
 	MQ_SYS_READ,
 	MQ_L1_READ,
@@ -42,7 +47,10 @@ struct femtol1_hdl {
 	float min_qual_rach;
 	float min_qual_norm;
 	char *calib_path;
-	struct llist_head wlc_list;
+	struct llist_head wlc_l1[GsmL1_PrimId_NUM];	/* pending requests by confirm */
+	struct llist_head wlc_sys[SuperFemto_PrimId_NUM];
+	struct llist_head wlc_free;		/* unused wait_l1_conf */
+	struct timer_wheel wlc_timeouts;
 
 	void *priv;			/* user reference */
 
@@ -50,6 +58,7 @@ struct femtol1_hdl {
 	unsigned int alive_prim_cnt;
 
 	struct osmo_fd read_ofd[_NUM_MQ_READ];	/* osmo file descriptors */
+	unsigned int read_batch[_NUM_MQ_READ];	/* primitives per readv() */
 	struct osmo_wqueue write_q[_NUM_MQ_WRITE];
 
 	struct {
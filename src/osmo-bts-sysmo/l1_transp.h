@@ -7,6 +7,9 @@
 int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg);
 int l1if_handle_sysprim(struct femtol1_hdl *fl1h, struct msgb *msg);
 
+/* directory of the DSP message queue devices */
+extern const char *l1if_msgq_dir;
+
 /* functions exported by a transport */
 int l1if_transport_open(int q, struct femtol1_hdl *fl1h);
 int l1if_transport_close(int q, struct femtol1_hdl *fl1h);
@@ -20,7 +20,9 @@
  */
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -42,6 +44,7 @@
 
 #include <osmo-bts/logging.h>
 #include <osmo-bts/gsm_data.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include <sysmocom/femtobts/superfemto.h>
 #include <sysmocom/femtobts/gsml1prim.h>
@@ -62,9 +65,19 @@ static const uint16_t fwd_udp_ports[] = {
 #endif
 };
 
+#define L1FWD_QUEUE_DEPTH	64
+
+/* With L1FWD_MUX set in the environment, all queues share one socket
+ * towards the multiplexed port of the proxy.  Each queue keeps its own
+ * osmo_fd on a dup() of the socket, so the write queues work as before,
+ * but whichever becomes writable sends the primitives of all queues. */
+static int mux_fd = -1;
+static unsigned int mux_queues = 0;	/* bitmask of the open queues */
+
 static int fwd_read_cb(struct osmo_fd *ofd)
 {
-	struct msgb *msg = msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128, "udp_rx");
+	struct msgb *msg = bts_msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128,
+		"udp_rx");
 	struct femtol1_hdl *fl1h = ofd->data;
 	int rc;
 
@@ -75,11 +88,11 @@ static int fwd_read_cb(struct osmo_fd *ofd)
 	rc = read(ofd->fd, msg->l1h, msgb_tailroom(msg));
 	if (rc < 0) {
 		LOGP(DL1C, LOGL_ERROR, "Short read from UDP\n");
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		return rc;
 	} else if (rc == 0) {
 		LOGP(DL1C, LOGL_ERROR, "Len=0 from UDP\n");
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		return rc;
 	}
 	msgb_put(msg, rc);
@@ -98,10 +111,141 @@ static int prim_write_cb(struct osmo_fd *ofd, struct msgb *msg)
 	return write(ofd->fd, msg->head, msg->len);
 }
 
+static void mux_read(struct femtol1_hdl *fl1h, int fd)
+{
+	uint8_t buf[L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	const uint8_t *data;
+	unsigned int data_len, offset = 0;
+	struct msgb *msg;
+	uint8_t queue;
+	int len, rc;
+
+	len = read(fd, buf, sizeof(buf));
+	if (len <= 0) {
+		LOGP(DL1C, LOGL_ERROR, "Short read from UDP\n");
+		return;
+	}
+
+	while ((rc = l1fwd_mux_get(buf, len, &offset, &queue, &data,
+				   &data_len)) > 0) {
+		if (data_len > SYSMOBTS_PRIM_SIZE - 128
+		 || queue >= _NUM_MQ_WRITE || !(mux_queues & (1 << queue)))
+			continue;
+		msg = bts_msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128,
+			"mux_rx");
+		if (!msg)
+			return;
+		msg->l1h = msgb_put(msg, data_len);
+		memcpy(msg->l1h, data, data_len);
+
+		if (queue == MQ_SYS_WRITE)
+			l1if_handle_sysprim(fl1h, msg);
+		else
+			l1if_handle_l1prim(queue, fl1h, msg);
+	}
+	if (rc < 0)
+		LOGP(DL1C, LOGL_ERROR, "Malformed mux datagram\n");
+}
+
+static void mux_write(struct femtol1_hdl *fl1h, int fd)
+{
+	uint8_t buf[L1FWD_MUX_MAX_LEN + SYSMOBTS_PRIM_SIZE];
+	struct osmo_wqueue *wq;
+	struct msgb *msg;
+	int q, len = 0, rc;
+
+	for (q = 0; q < _NUM_MQ_WRITE; q++) {
+		if (!(mux_queues & (1 << q)))
+			continue;
+		wq = &fl1h->write_q[q];
+		wq->bfd.when &= ~BSC_FD_WRITE;
+
+		while ((msg = msgb_dequeue(&wq->msg_queue))) {
+			wq->current_length--;
+
+			rc = l1fwd_mux_put(buf, len, L1FWD_MUX_MAX_LEN, q,
+				msg->l1h, msgb_l1len(msg));
+			if (rc == -ENOSPC && len) {
+				if (write(fd, buf, len) < 0)
+					LOGP(DL1C, LOGL_ERROR, "error writing "
+						"to UDP: %s\n", strerror(errno));
+				len = 0;
+				rc = l1fwd_mux_put(buf, len,
+					L1FWD_MUX_MAX_LEN, q, msg->l1h,
+					msgb_l1len(msg));
+			}
+			/* too long for a datagram with others */
+			if (rc == -ENOSPC)
+				rc = l1fwd_mux_put(buf, len, sizeof(buf), q,
+					msg->l1h, msgb_l1len(msg));
+			bts_msgb_free(msg);
+			if (rc >= 0)
+				len = rc;
+		}
+	}
+
+	if (len && write(fd, buf, len) < 0)
+		LOGP(DL1C, LOGL_ERROR, "error writing to UDP: %s\n",
+			strerror(errno));
+}
+
+static int mux_fd_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct femtol1_hdl *fl1h = ofd->data;
+
+	if (what & BSC_FD_READ)
+		mux_read(fl1h, ofd->fd);
+	if (what & BSC_FD_WRITE)
+		mux_write(fl1h, ofd->fd);
+
+	return 0;
+}
+
+static int mux_transport_open(int q, struct femtol1_hdl *fl1h,
+	const char *bts_host)
+{
+	struct osmo_wqueue *wq = &fl1h->write_q[q];
+	struct osmo_fd *ofd = &wq->bfd;
+	int rc;
+
+	osmo_wqueue_init(wq, L1FWD_QUEUE_DEPTH);
+
+	if (mux_fd < 0) {
+		rc = osmo_sock_init(AF_UNSPEC, SOCK_DGRAM, IPPROTO_UDP,
+				    bts_host, L1FWD_MUX_PORT,
+				    OSMO_SOCK_F_CONNECT);
+		if (rc < 0)
+			return rc;
+		mux_fd = rc;
+		/* the first queue receives for all */
+		ofd->fd = mux_fd;
+		ofd->when = BSC_FD_READ;
+	} else {
+		ofd->fd = dup(mux_fd);
+		if (ofd->fd < 0)
+			return -errno;
+	}
+
+	ofd->cb = mux_fd_cb;
+	ofd->data = fl1h;
+	ofd->priv_nr = q;
+	rc = osmo_fd_register(ofd);
+	if (rc < 0) {
+		close(ofd->fd);
+		if (ofd->fd == mux_fd)
+			mux_fd = -1;
+		return rc;
+	}
+	mux_queues |= 1 << q;
+
+	return 0;
+}
+
 int l1if_transport_open(int q, struct femtol1_hdl *fl1h)
 {
 	int rc;
 	char *bts_host = getenv("L1FWD_BTS_HOST");
+	char *mux = getenv("L1FWD_MUX");
 
 	switch (q) {
 	case MQ_L1_WRITE:
@@ -119,10 +263,15 @@ int l1if_transport_open(int q, struct femtol1_hdl *fl1h)
 		exit(2);
 	}
 
+	msgb_pool_add(SYSMOBTS_PRIM_SIZE, L1FWD_QUEUE_DEPTH, 0);
+
+	if (mux && strcmp(mux, "0"))
+		return mux_transport_open(q, fl1h, bts_host);
+
 	struct osmo_wqueue *wq = &fl1h->write_q[q];
 	struct osmo_fd *ofd = &wq->bfd;
 
-	osmo_wqueue_init(wq, 10);
+	osmo_wqueue_init(wq, L1FWD_QUEUE_DEPTH);
 	wq->write_cb = prim_write_cb;
 	wq->read_cb = fwd_read_cb;
 
@@ -147,6 +296,12 @@ int l1if_transport_close(int q, struct femtol1_hdl *fl1h)
 	osmo_wqueue_clear(wq);
 	osmo_fd_unregister(ofd);
 	close(ofd->fd);
-	
+
+	if (mux_queues & (1 << q)) {
+		mux_queues &= ~(1 << q);
+		if (ofd->fd == mux_fd)
+			mux_fd = -1;
+	}
+
 	return 0;
 }
@@ -21,12 +21,15 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <limits.h>
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 #include <osmocom/core/talloc.h>
 #include <osmocom/core/utils.h>
@@ -36,6 +39,7 @@
 
 #include <osmo-bts/logging.h>
 #include <osmo-bts/gsm_data.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include <sysmocom/femtobts/superfemto.h>
 #include <sysmocom/femtobts/gsml1prim.h>
@@ -48,22 +52,33 @@
 
 
 #ifdef HW_SYSMOBTS_V1
-#define DEV_SYS_DSP2ARM_NAME	"/dev/msgq/femtobts_dsp2arm"
-#define DEV_SYS_ARM2DSP_NAME	"/dev/msgq/femtobts_arm2dsp"
-#define DEV_L1_DSP2ARM_NAME	"/dev/msgq/gsml1_dsp2arm"
-#define DEV_L1_ARM2DSP_NAME	"/dev/msgq/gsml1_arm2dsp"
+#define DEV_SYS_DSP2ARM_NAME	"femtobts_dsp2arm"
+#define DEV_SYS_ARM2DSP_NAME	"femtobts_arm2dsp"
+#define DEV_L1_DSP2ARM_NAME	"gsml1_dsp2arm"
+#define DEV_L1_ARM2DSP_NAME	"gsml1_arm2dsp"
 #else
-#define DEV_SYS_DSP2ARM_NAME	"/dev/msgq/superfemto_dsp2arm"
-#define DEV_SYS_ARM2DSP_NAME	"/dev/msgq/superfemto_arm2dsp"
-#define DEV_L1_DSP2ARM_NAME	"/dev/msgq/gsml1_sig_dsp2arm"
-#define DEV_L1_ARM2DSP_NAME	"/dev/msgq/gsml1_sig_arm2dsp"
-
-#define DEV_TCH_DSP2ARM_NAME	"/dev/msgq/gsml1_tch_dsp2arm"
-#define DEV_TCH_ARM2DSP_NAME	"/dev/msgq/gsml1_tch_arm2dsp"
-#define DEV_PDTCH_DSP2ARM_NAME	"/dev/msgq/gsml1_pdtch_dsp2arm"
-#define DEV_PDTCH_ARM2DSP_NAME	"/dev/msgq/gsml1_pdtch_arm2dsp"
+#define DEV_SYS_DSP2ARM_NAME	"superfemto_dsp2arm"
+#define DEV_SYS_ARM2DSP_NAME	"superfemto_arm2dsp"
+#define DEV_L1_DSP2ARM_NAME	"gsml1_sig_dsp2arm"
+#define DEV_L1_ARM2DSP_NAME	"gsml1_sig_arm2dsp"
+
+#define DEV_TCH_DSP2ARM_NAME	"gsml1_tch_dsp2arm"
+#define DEV_TCH_ARM2DSP_NAME	"gsml1_tch_arm2dsp"
+#define DEV_PDTCH_DSP2ARM_NAME	"gsml1_pdtch_dsp2arm"
+#define DEV_PDTCH_ARM2DSP_NAME	"gsml1_pdtch_arm2dsp"
 #endif
 
+const char *l1if_msgq_dir = "/dev/msgq";
+
+/* Primitives are read into msgbs from a pool of SYSMOBTS_PRIM_SIZE byte
+ * msgbs, so a read doesn't cost a malloc()/free() per primitive.  The
+ * number of primitives read with one readv() doubles (up to
+ * L1_READ_BATCH_MAX), as long as the queue had more, and halves, if it
+ * had less than half of it. */
+#define L1_READ_BATCH_MAX	16
+#define L1_WRITE_BATCH_MAX	32
+#define L1_POOL_MAX_FREE	64
+
 static const char *rd_devnames[] = {
 	[MQ_SYS_READ]	= DEV_SYS_DSP2ARM_NAME,
 	[MQ_L1_READ]	= DEV_L1_DSP2ARM_NAME,
@@ -101,12 +116,14 @@ static int wqueue_vector_cb(struct osmo_fd *fd, unsigned int what)
 		queue->except_cb(fd);
 
 	if (what & BSC_FD_WRITE) {
-		struct iovec iov[5];
+		struct iovec iov[L1_WRITE_BATCH_MAX];
 		struct msgb *msg, *tmp;
+		unsigned int len;
 		int written, count = 0;
 
 		fd->when &= ~BSC_FD_WRITE;
 
+		/* the primitives may differ in length */
 		llist_for_each_entry(msg, &queue->msg_queue, list) {
 			/* more writes than we have */
 			if (count >= ARRAY_SIZE(iov))
@@ -117,9 +134,6 @@ static int wqueue_vector_cb(struct osmo_fd *fd, unsigned int what)
 			count += 1;
 		}
 
-		/* TODO: check if all lengths are the same. */
-
-
 		/* Nothing scheduled? This should not happen. */
 		if (count == 0) {
 			if (!llist_empty(&queue->msg_queue))
@@ -135,17 +149,22 @@ static int wqueue_vector_cb(struct osmo_fd *fd, unsigned int what)
 			return 0;
 		}
 
-		/* now delete the written entries */
-		written = written / iov[0].iov_len;
-		count = 0;
+		/* now delete the written entries, the rest of a partially
+		 * written one is written next time */
 		llist_for_each_entry_safe(msg, tmp, &queue->msg_queue, list) {
+			len = msgb_l1len(msg);
+			if (written < len) {
+				msg->l1h += written;
+				break;
+			}
+			written -= len;
+
 			queue->current_length -= 1;
 
 			llist_del(&msg->list);
-			msgb_free(msg);
+			bts_msgb_free(msg);
 
-			count += 1;
-			if (count >= written)
+			if (!written)
 				break;
 		}
 
@@ -199,33 +218,47 @@ static int read_dispatch_one(struct femtol1_hdl *fl1h, struct msgb *msg, int que
 
 static int l1if_fd_cb(struct osmo_fd *ofd, unsigned int what)
 {
-	int i, rc;
+	struct femtol1_hdl *fl1h = ofd->data;
+	unsigned int *batch = &fl1h->read_batch[ofd->priv_nr];
+	int i, rc, num;
 
 	const uint32_t prim_size = prim_size_for_queue(ofd->priv_nr);
 	uint32_t count;
 
-	struct iovec iov[3];
+	struct iovec iov[L1_READ_BATCH_MAX];
 	struct msgb *msg[ARRAY_SIZE(iov)];
 
-	for (i = 0; i < ARRAY_SIZE(iov); ++i) {
-		msg[i] = msgb_alloc_headroom(prim_size + 128, 128, "1l_fd");
+	num = OSMO_MIN(OSMO_MAX(*batch, 1), ARRAY_SIZE(iov));
+	for (i = 0; i < num; ++i) {
+		msg[i] = bts_msgb_alloc_headroom(SYSMOBTS_PRIM_SIZE, 128,
+			"1l_fd");
+		if (!msg[i])
+			break;
 		msg[i]->l1h = msg[i]->data;
 
+		/* one primitive per buffer */
 		iov[i].iov_base = msg[i]->l1h;
-		iov[i].iov_len = msgb_tailroom(msg[i]);
+		iov[i].iov_len = prim_size;
 	}
+	num = i;
+	if (!num)
+		return -ENOMEM;
 
+	rc = readv(ofd->fd, iov, num);
+	count = rc > 0 ? rc / prim_size : 0;
 
-	rc = readv(ofd->fd, iov, ARRAY_SIZE(iov));
-	count = rc / prim_size;
+	if (count == num)
+		*batch = OSMO_MIN(num * 2, ARRAY_SIZE(iov));
+	else if (count < num / 2)
+		*batch = num / 2;
 
 	for (i = 0; i < count; ++i) {
 		msgb_put(msg[i], prim_size);
 		read_dispatch_one(ofd->data, msg[i], ofd->priv_nr);
 	}
 
-	for (i = count; i < ARRAY_SIZE(iov); ++i)
-		msgb_free(msg[i]);
+	for (i = count; i < num; ++i)
+		bts_msgb_free(msg[i]);
 
 	return 1;
 }
@@ -257,8 +290,16 @@ int l1if_transport_open(int q, struct femtol1_hdl *hdl)
 	struct osmo_fd *read_ofd = &hdl->read_ofd[q];
 	struct osmo_wqueue *wq = &hdl->write_q[q];
 	struct osmo_fd *write_ofd = &hdl->write_q[q].bfd;
+	char path[PATH_MAX];
+
+	rc = msgb_pool_add(SYSMOBTS_PRIM_SIZE, L1_POOL_MAX_FREE,
+			   L1_READ_BATCH_MAX);
+	if (rc < 0)
+		LOGP(DL1C, LOGL_NOTICE, "unable to add a msgb pool for "
+			"primitives: %d\n", rc);
 
-	rc = open(rd_devnames[q], O_RDONLY);
+	snprintf(path, sizeof(path), "%s/%s", l1if_msgq_dir, rd_devnames[q]);
+	rc = open(path, O_RDONLY);
 	if (rc < 0) {
 		LOGP(DL1C, LOGL_FATAL, "unable to open msg_queue: %s\n",
 			strerror(errno));
@@ -269,6 +310,7 @@ int l1if_transport_open(int q, struct femtol1_hdl *hdl)
 	read_ofd->data = hdl;
 	read_ofd->cb = l1if_fd_cb;
 	read_ofd->when = BSC_FD_READ;
+	hdl->read_batch[q] = 1;
 	rc = osmo_fd_register(read_ofd);
 	if (rc < 0) {
 		close(read_ofd->fd);
@@ -276,7 +318,8 @@ int l1if_transport_open(int q, struct femtol1_hdl *hdl)
 		return rc;
 	}
 
-	rc = open(wr_devnames[q], O_WRONLY);
+	snprintf(path, sizeof(path), "%s/%s", l1if_msgq_dir, wr_devnames[q]);
+	rc = open(path, O_WRONLY);
 	if (rc < 0) {
 		LOGP(DL1C, LOGL_FATAL, "unable to open msg_queue: %s\n",
 			strerror(errno));
@@ -303,6 +303,8 @@ int main(int argc, char **argv)
 			config_file);
 		exit(1);
 	}
+	/* command line and config file may have changed the log levels */
+	bts_log_cache_update();
 
 	if (stat(SYSMOBTS_RF_LOCK_PATH, &st) == 0) {
 		LOGP(DL1C, LOGL_NOTICE, "Not starting BTS due to RF_LOCK file present\n");
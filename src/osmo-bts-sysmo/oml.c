@@ -70,6 +70,7 @@ struct sapi_cmd {
 	GsmL1_Sapi_t sapi;
 	GsmL1_Dir_t dir;
 	enum sapi_cmd_type type;
+	int sent;		/* the request is with the L1 */
 	int (*callback)(struct gsm_lchan *lchan, int status);
 };
 
@@ -477,86 +478,106 @@ static int mph_send_config_logchpar(struct gsm_lchan *lchan, struct sapi_cmd *cm
 
 static int check_sapi_release(struct gsm_lchan *lchan, int sapi, int dir);
 static int lchan_deactivate_sapis(struct gsm_lchan *lchan);
+static int lchan_release_sapis(struct gsm_lchan *lchan);
+
+/*
+ * The SAPI commands of an lchan are executed in the order of the queue,
+ * the commands that were sent to the L1 are at its head.  Activations of
+ * different SAPIs don't depend on each other, so consecutive activations
+ * are sent together and the L1 confirms them in any order.  Everything
+ * else waits until the commands before it are confirmed: a configuration
+ * needs the SAPI to be active and the SAPIs have to be released in the
+ * order of the queue (FACCH first).
+ */
+static int sapi_cmd_can_send(struct gsm_lchan *lchan, struct sapi_cmd *cmd)
+{
+	struct sapi_cmd *head;
+
+	head = llist_entry(lchan->sapi_cmds.next, struct sapi_cmd, entry);
+	if (head == cmd)
+		return 1;
+
+	return head->type == SAPI_CMD_ACTIVATE
+		&& cmd->type == SAPI_CMD_ACTIVATE;
+}
 
 /**
- * Execute the first SAPI command of the queue. In case of the markers
+ * Execute a SAPI command of the queue. In case of the markers
  * this method is re-entrant so we need to make sure to remove a command
  * from the list before calling a function that will queue a command.
- *
- * \return 0 in case no Gsm Request was sent, 1 otherwise
  */
-static int sapi_queue_exeute(struct gsm_lchan *lchan)
+static void sapi_queue_exeute(struct gsm_lchan *lchan, struct sapi_cmd *cmd)
 {
-	int res;
-	struct sapi_cmd *cmd;
-
-	cmd = llist_entry(lchan->sapi_cmds.next, struct sapi_cmd, entry);
-
 	switch (cmd->type) {
 	case SAPI_CMD_ACTIVATE:
+		cmd->sent = 1;
 		mph_send_activate_req(lchan, cmd);
-		res = 1;
 		break;
 	case SAPI_CMD_CONFIG_CIPHERING:
+		cmd->sent = 1;
 		mph_send_config_ciphering(lchan, cmd);
-		res = 1;
 		break;
 	case SAPI_CMD_CONFIG_LOGCH_PARAM:
+		cmd->sent = 1;
 		mph_send_config_logchpar(lchan, cmd);
-		res = 1;
 		break;
 	case SAPI_CMD_SACCH_REL_MARKER:
 		llist_del(&cmd->entry);
 		talloc_free(cmd);
-		res = check_sapi_release(lchan, GsmL1_Sapi_Sacch,
+		check_sapi_release(lchan, GsmL1_Sapi_Sacch,
 					GsmL1_Dir_TxDownlink);
-		res |= check_sapi_release(lchan, GsmL1_Sapi_Sacch,
+		check_sapi_release(lchan, GsmL1_Sapi_Sacch,
 					GsmL1_Dir_RxUplink);
 		break;
 	case SAPI_CMD_REL_MARKER:
 		llist_del(&cmd->entry);
 		talloc_free(cmd);
-		res = lchan_deactivate_sapis(lchan);
+		lchan_deactivate_sapis(lchan);
 		break;
 	case SAPI_CMD_DEACTIVATE:
+		cmd->sent = 1;
 		mph_send_deactivate_req(lchan, cmd);
-		res = 1;
 		break;
 	default:
 		LOGP(DL1C, LOGL_NOTICE,
 			"Unimplemented command type %d\n", cmd->type);
 		llist_del(&cmd->entry);
 		talloc_free(cmd);
-		res = 0;
 		abort();
 		break;
 	}
-
-	return res;
 }
 
+/* send all commands that don't have to wait for a confirm */
 static void sapi_queue_send(struct gsm_lchan *lchan)
 {
-	int res;
+	struct sapi_cmd *cmd;
 
-	do {
-		res = sapi_queue_exeute(lchan);
-	} while (res == 0 && !llist_empty(&lchan->sapi_cmds));
+	/* a marker changes the queue, so start over after each command */
+	while (!llist_empty(&lchan->sapi_cmds)) {
+		llist_for_each_entry(cmd, &lchan->sapi_cmds, entry) {
+			if (!cmd->sent)
+				break;
+		}
+		if (&cmd->entry == &lchan->sapi_cmds)
+			return;
+		if (!sapi_cmd_can_send(lchan, cmd))
+			return;
+		sapi_queue_exeute(lchan, cmd);
+	}
 }
 
-static void sapi_queue_dispatch(struct gsm_lchan *lchan, int status)
+/* the sent command 'cmd' was confirmed by the L1 */
+static void sapi_queue_dispatch(struct gsm_lchan *lchan, struct sapi_cmd *cmd,
+		int status)
 {
-	int end;
-	struct sapi_cmd *cmd = llist_entry(lchan->sapi_cmds.next,
-			struct sapi_cmd, entry);
 	llist_del(&cmd->entry);
-	end = llist_empty(&lchan->sapi_cmds);
 
 	if (cmd->callback)
 		cmd->callback(lchan, status);
 	talloc_free(cmd);
 
-	if (end || llist_empty(&lchan->sapi_cmds)) {
+	if (llist_empty(&lchan->sapi_cmds)) {
 		LOGP(DL1C, LOGL_NOTICE,
 			"%s End of queue encountered. Now empty? %d\n",
 			gsm_lchan_name(lchan), llist_empty(&lchan->sapi_cmds));
@@ -566,20 +587,47 @@ static void sapi_queue_dispatch(struct gsm_lchan *lchan, int status)
 	sapi_queue_send(lchan);
 }
 
+/* find the sent command, which is confirmed by a primitive */
+static struct sapi_cmd *sapi_queue_find_sent(struct gsm_lchan *lchan,
+		enum sapi_cmd_type type, GsmL1_Sapi_t sapi, GsmL1_Dir_t dir)
+{
+	struct sapi_cmd *cmd;
+
+	llist_for_each_entry(cmd, &lchan->sapi_cmds, entry) {
+		if (!cmd->sent)
+			break;
+		if (cmd->type == type && cmd->sapi == sapi && cmd->dir == dir)
+			return cmd;
+	}
+
+	return NULL;
+}
+
+/* a configuration is sent alone, so it is at the head of the queue */
+static struct sapi_cmd *sapi_queue_head_config(struct gsm_lchan *lchan)
+{
+	struct sapi_cmd *cmd;
+
+	if (llist_empty(&lchan->sapi_cmds))
+		return NULL;
+
+	cmd = llist_entry(lchan->sapi_cmds.next, struct sapi_cmd, entry);
+	if (!cmd->sent)
+		return NULL;
+	if (cmd->type != SAPI_CMD_CONFIG_CIPHERING
+	 && cmd->type != SAPI_CMD_CONFIG_LOGCH_PARAM)
+		return NULL;
+
+	return cmd;
+}
+
 /**
- * Queue and possible execute a SAPI command. Return 1 in case the command was
- * already executed and 0 in case if it was only put into the queue
+ * Queue and possibly execute a SAPI command.
  */
-static int queue_sapi_command(struct gsm_lchan *lchan, struct sapi_cmd *cmd)
+static void queue_sapi_command(struct gsm_lchan *lchan, struct sapi_cmd *cmd)
 {
-	int start = llist_empty(&lchan->sapi_cmds);
 	llist_add_tail(&cmd->entry, &lchan->sapi_cmds);
-
-	if (!start)
-		return 0;
-
 	sapi_queue_send(lchan);
-	return 1;
 }
 
 static int lchan_act_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
@@ -627,17 +675,16 @@ static int lchan_act_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 		goto err;
 	}
 
-	cmd = llist_entry(lchan->sapi_cmds.next, struct sapi_cmd, entry);
-	if (cmd->sapi != ic->sapi || cmd->dir != ic->dir ||
-			cmd->type != SAPI_CMD_ACTIVATE) {
+	cmd = sapi_queue_find_sent(lchan, SAPI_CMD_ACTIVATE, ic->sapi, ic->dir);
+	if (!cmd) {
 		LOGP(DL1C, LOGL_ERROR,
-				"%s Confirmation mismatch (%d, %d) (%d, %d)\n",
-				gsm_lchan_name(lchan), cmd->sapi, cmd->dir,
+				"%s Confirmation mismatch, no activation of "
+				"(%d, %d) pending\n", gsm_lchan_name(lchan),
 				ic->sapi, ic->dir);
 		goto err;
 	}
 
-	sapi_queue_dispatch(lchan, ic->status);
+	sapi_queue_dispatch(lchan, cmd, ic->status);
 
 err:
 	msgb_free(l1_msg);
@@ -869,18 +916,46 @@ static void sapi_clear_queue(struct llist_head *queue)
 	}
 }
 
+/* drop the commands that were not sent to the L1 yet */
+static void sapi_queue_drop_unsent(struct gsm_lchan *lchan)
+{
+	struct sapi_cmd *cmd, *tmp;
+
+	llist_for_each_entry_safe(cmd, tmp, &lchan->sapi_cmds, entry) {
+		if (cmd->sent)
+			continue;
+		llist_del(&cmd->entry);
+		talloc_free(cmd);
+	}
+}
+
 static int sapi_activate_cb(struct gsm_lchan *lchan, int status)
 {
 	struct femtol1_hdl *fl1h = trx_femtol1_hdl(lchan->ts->trx);
 
-	/* FIXME: Error handling */
-	if (status != GsmL1_Status_Success) {
+	/*
+	 * The first failure NACKs the activation.  The activations that
+	 * were sent together with it are still confirmed by the L1, so
+	 * only the rest of the queue is dropped.  Once all of them are
+	 * confirmed, the SAPIs they assigned are released again.  If the
+	 * lchan is released meanwhile, the release takes care of them.
+	 */
+	if (status != GsmL1_Status_Success && lchan->state != LCHAN_S_BROKEN
+	 && lchan->state != LCHAN_S_REL_REQ) {
 		lchan_set_state(lchan, LCHAN_S_BROKEN);
-		sapi_clear_queue(&lchan->sapi_cmds);
+		sapi_queue_drop_unsent(lchan);
 		mph_info_chan_confirm(lchan, PRIM_INFO_ACTIVATE, RSL_ERR_EQUIPMENT_FAIL);
-		return -1;
 	}
 
+	if (lchan->state == LCHAN_S_BROKEN) {
+		if (llist_empty(&lchan->sapi_cmds))
+			lchan_release_sapis(lchan);
+		return status == GsmL1_Status_Success ? 0 : -1;
+	}
+
+	if (status != GsmL1_Status_Success)
+		return -1;
+
 	if (!llist_empty(&lchan->sapi_cmds))
 		return 0;
 
@@ -1005,6 +1080,7 @@ static int chmod_txpower_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 
 static int chmod_modif_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 {
+	struct sapi_cmd *cmd;
 	struct gsm_lchan *lchan;
 	GsmL1_Prim_t *l1p = msgb_l1prim(l1_msg);
 	GsmL1_MphConfigCnf_t *cc = &l1p->u.mphConfigCnf;
@@ -1027,7 +1103,15 @@ static int chmod_modif_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 			     &cc->cfgParams.setLogChParams.logChParams,
 			     cc->cfgParams.setLogChParams.sapi);
 
-		sapi_queue_dispatch(lchan, cc->status);
+		cmd = sapi_queue_head_config(lchan);
+		if (!cmd) {
+			LOGP(DL1C, LOGL_ERROR,
+				"%s Got logical channel conf without request\n",
+				gsm_lchan_name(lchan));
+			goto err;
+		}
+
+		sapi_queue_dispatch(lchan, cmd, cc->status);
 		break;
 	case GsmL1_ConfigParamId_SetCipheringParams:
 		switch (lchan->ciph_state) {
@@ -1050,14 +1134,15 @@ static int chmod_modif_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 			LOGPC(DL1C, LOGL_INFO, "unhandled state %u\n", lchan->ciph_state);
 			break;
 		}
-		if (llist_empty(&lchan->sapi_cmds)) {
+		cmd = sapi_queue_head_config(lchan);
+		if (!cmd) {
 			LOGP(DL1C, LOGL_ERROR,
 				"%s Got ciphering conf with empty queue\n",
 				gsm_lchan_name(lchan));
 			goto err;
 		}
 
-		sapi_queue_dispatch(lchan, cc->status);
+		sapi_queue_dispatch(lchan, cmd, cc->status);
 		break;
 	case GsmL1_ConfigParamId_SetNbTsc:
 	default:
@@ -1265,17 +1350,17 @@ static int lchan_deact_compl_cb(struct gsm_bts_trx *trx, struct msgb *l1_msg)
 		goto err;
 	}
 
-	cmd = llist_entry(lchan->sapi_cmds.next, struct sapi_cmd, entry);
-	if (cmd->sapi != ic->sapi || cmd->dir != ic->dir ||
-			cmd->type != SAPI_CMD_DEACTIVATE) {
+	cmd = sapi_queue_find_sent(lchan, SAPI_CMD_DEACTIVATE, ic->sapi,
+				   ic->dir);
+	if (!cmd) {
 		LOGP(DL1C, LOGL_ERROR,
-				"%s Confirmation mismatch (%d, %d) (%d, %d)\n",
-				gsm_lchan_name(lchan), cmd->sapi, cmd->dir,
+				"%s Confirmation mismatch, no deactivation of "
+				"(%d, %d) pending\n", gsm_lchan_name(lchan),
 				ic->sapi, ic->dir);
 		goto err;
 	}
 
-	sapi_queue_dispatch(lchan, ic->status);
+	sapi_queue_dispatch(lchan, cmd, ic->status);
 
 err:
 	msgb_free(l1_msg);
@@ -1337,7 +1422,8 @@ static int enqueue_sapi_deact_cmd(struct gsm_lchan *lchan, int sapi, int dir)
 	cmd->dir = dir;
 	cmd->type = SAPI_CMD_DEACTIVATE;
 	cmd->callback = sapi_deactivate_cb;
-	return queue_sapi_command(lchan, cmd);
+	queue_sapi_command(lchan, cmd);
+	return 1;
 }
 
 /*
@@ -1362,7 +1448,8 @@ static int check_sapi_release(struct gsm_lchan *lchan, int sapi, int dir)
 }
 
 
-static int lchan_deactivate_sapis(struct gsm_lchan *lchan)
+/* queue the release of all assigned SAPIs, returns 0 if there is none */
+static int lchan_release_sapis(struct gsm_lchan *lchan)
 {
 	struct femtol1_hdl *fl1h = trx_femtol1_hdl(lchan->ts->trx);
 	const struct lchan_sapis *s4l = &sapis_for_lchan[lchan->type];
@@ -1380,6 +1467,15 @@ static int lchan_deactivate_sapis(struct gsm_lchan *lchan)
 		res |= check_sapi_release(lchan, s4l->sapis[i].sapi, s4l->sapis[i].dir);
 	}
 
+	return res;
+}
+
+static int lchan_deactivate_sapis(struct gsm_lchan *lchan)
+{
+	int res;
+
+	res = lchan_release_sapis(lchan);
+
 	/* nothing was queued */
 	if (res == 0) {
 		LOGP(DL1C, LOGL_ERROR, "%s all SAPIs already released?\n",
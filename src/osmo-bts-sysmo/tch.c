@@ -40,6 +40,7 @@
 #include <osmo-bts/gsm_data.h>
 #include <osmo-bts/measurement.h>
 #include <osmo-bts/l1sap.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include <sysmocom/femtobts/superfemto.h>
 #include <sysmocom/femtobts/gsml1prim.h>
@@ -48,46 +49,7 @@
 
 #include "femtobts.h"
 #include "l1_if.h"
-
-/* input octet-aligned, output not octet-aligned */
-void osmo_nibble_shift_right(uint8_t *out, const uint8_t *in,
-			     unsigned int num_nibbles)
-{
-	unsigned int i;
-	unsigned int num_whole_bytes = num_nibbles / 2;
-
-	/* first byte: upper nibble empty, lower nibble from src */
-	out[0] = (in[0] >> 4);
-
-	/* bytes 1.. */
-	for (i = 1; i < num_whole_bytes; i++)
-		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
-
-	/* shift the last nibble, in case there's an odd count */
-	i = num_whole_bytes;
-	if (num_nibbles & 1)
-		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
-	else
-		out[i] = (in[i-1] & 0xF) << 4;
-}
-
-
-/* input unaligned, output octet-aligned */
-void osmo_nibble_shift_left_unal(uint8_t *out, const uint8_t *in,
-				unsigned int num_nibbles)
-{
-	unsigned int i;
-	unsigned int num_whole_bytes = num_nibbles / 2;
-
-	for (i = 0; i < num_whole_bytes; i++)
-		out[i] = ((in[i] & 0xF) << 4) | (in[i+1] >> 4);
-
-	/* shift the last nibble, in case there's an odd count */
-	i = num_whole_bytes;
-	if (num_nibbles & 1)
-		out[i] = (in[i] & 0xF) << 4;
-}
-
+#include "utils.h"
 
 #define GSM_FR_BITS	260
 #define GSM_EFR_BITS	244
@@ -96,32 +58,28 @@ void osmo_nibble_shift_left_unal(uint8_t *out, const uint8_t *in,
 #define GSM_HR_BYTES	14	/* TS 101318 Chapter 5.2: 112 bits, no sig */
 #define GSM_EFR_BYTES	31	/* TS 101318 Chapter 5.3: 244 bits + 4bit sig */
 
-static struct msgb *l1_to_rtppayload_fr(uint8_t *l1_payload, uint8_t payload_len)
-{
-	struct msgb *msg;
-	uint8_t *cur;
+/* The l1_to_rtppayload_*() functions convert the codec frame in place
+ * within the L1 primitive, set *rtp_pl to the start of the RTP payload
+ * and return its length, so that the primitive can be passed on to RTP
+ * without allocating and copying. */
 
-	msg = msgb_alloc_headroom(1024, 128, "L1C-to-RTP");
-	if (!msg)
-		return NULL;
+/*! \brief convert GSM-FR from L1 format to RTP payload, in place */
+static int l1_to_rtppayload_fr(uint8_t **rtp_pl, uint8_t *l1_payload,
+				uint8_t payload_len)
+{
+	*rtp_pl = l1_payload;
 
-#ifdef USE_L1_RTP_MODE
-	/* new L1 can deliver bits like we need them */
-	cur = msgb_put(msg, GSM_FR_BYTES);
-	memcpy(cur, l1_payload, GSM_FR_BYTES);
-#else
+#ifndef USE_L1_RTP_MODE
 	/* step1: reverse the bit-order of each payload byte */
-	osmo_revbytebits_buf(l1_payload, payload_len);
-
-	cur = msgb_put(msg, GSM_FR_BYTES);
+	sysmobts_revbytebits_buf(l1_payload, payload_len);
 
 	/* step2: we need to shift the entire L1 payload by 4 bits right */
-	osmo_nibble_shift_right(cur, l1_payload, GSM_FR_BITS/4);
+	osmo_nibble_shift_right(l1_payload, l1_payload, GSM_FR_BITS/4);
 
-	cur[0] |= 0xD0;
+	l1_payload[0] |= 0xD0;
 #endif /* USE_L1_RTP_MODE */
 
-	return msg;
+	return GSM_FR_BYTES;
 }
 
 /*! \brief convert GSM-FR from RTP payload to L1 format
@@ -141,37 +99,20 @@ static int rtppayload_to_l1_fr(uint8_t *l1_payload, const uint8_t *rtp_payload,
 	osmo_nibble_shift_left_unal(l1_payload, rtp_payload, GSM_FR_BITS/4);
 
 	/* step1: reverse the bit-order of each payload byte */
-	osmo_revbytebits_buf(l1_payload, payload_len);
+	sysmobts_revbytebits_buf(l1_payload, payload_len);
 #endif /* USE_L1_RTP_MODE */
 	return GSM_FR_BYTES;
 }
 
 #if defined(L1_HAS_EFR) && defined(USE_L1_RTP_MODE)
-static struct msgb *l1_to_rtppayload_efr(uint8_t *l1_payload, uint8_t payload_len)
+/*! \brief convert GSM-EFR from L1 format to RTP payload, in place */
+static int l1_to_rtppayload_efr(uint8_t **rtp_pl, uint8_t *l1_payload,
+				uint8_t payload_len)
 {
-	struct msgb *msg;
-	uint8_t *cur;
-
-	msg = msgb_alloc_headroom(1024, 128, "L1C-to-RTP");
-	if (!msg)
-		return NULL;
-
-#ifdef USE_L1_RTP_MODE
 	/* new L1 can deliver bits like we need them */
-	cur = msgb_put(msg, GSM_EFR_BYTES);
-	memcpy(cur, l1_payload, GSM_EFR_BYTES);
-#else
-	/* step1: reverse the bit-order of each payload byte */
-	osmo_revbytebits_buf(l1_payload, payload_len);
-
-	cur = msgb_put(msg, GSM_EFR_BYTES);
+	*rtp_pl = l1_payload;
 
-	/* step 2: we need to shift the entire L1 payload by 4 bits right */
-	osmo_nibble_shift_right(cur, l1_payload, GSM_EFR_BITS/4);
-
-	cur[0] |= 0xC0;
-#endif /* USE_L1_RTP_MODE */
-	return msg;
+	return GSM_EFR_BYTES;
 }
 
 static int rtppayload_to_l1_efr(uint8_t *l1_payload, const uint8_t *rtp_payload,
@@ -189,30 +130,24 @@ static int rtppayload_to_l1_efr(uint8_t *l1_payload, const uint8_t *rtp_payload,
 #warning No EFR support in L1
 #endif /* L1_HAS_EFR */
 
-static struct msgb *l1_to_rtppayload_hr(uint8_t *l1_payload, uint8_t payload_len)
+/*! \brief convert GSM-HR from L1 format to RTP payload, in place */
+static int l1_to_rtppayload_hr(uint8_t **rtp_pl, uint8_t *l1_payload,
+				uint8_t payload_len)
 {
-	struct msgb *msg;
-	uint8_t *cur;
-
-	msg = msgb_alloc_headroom(1024, 128, "L1C-to-RTP");
-	if (!msg)
-		return NULL;
-
 	if (payload_len != GSM_HR_BYTES) {
 		LOGP(DL1C, LOGL_ERROR, "L1 HR frame length %u != expected %u\n",
 			payload_len, GSM_HR_BYTES);
-		return NULL;
+		return -EINVAL;
 	}
 
-	cur = msgb_put(msg, GSM_HR_BYTES);
-	memcpy(cur, l1_payload, GSM_HR_BYTES);
+	*rtp_pl = l1_payload;
 
 #ifndef USE_L1_RTP_MODE
 	/* reverse the bit-order of each payload byte */
-	osmo_revbytebits_buf(cur, GSM_HR_BYTES);
+	sysmobts_revbytebits_buf(l1_payload, GSM_HR_BYTES);
 #endif /* USE_L1_RTP_MODE */
 
-	return msg;
+	return GSM_HR_BYTES;
 }
 
 /*! \brief convert GSM-FR from RTP payload to L1 format
@@ -235,7 +170,7 @@ static int rtppayload_to_l1_hr(uint8_t *l1_payload, const uint8_t *rtp_payload,
 
 #ifndef USE_L1_RTP_MODE
 	/* reverse the bit-order of each payload byte */
-	osmo_revbytebits_buf(l1_payload, GSM_HR_BYTES);
+	sysmobts_revbytebits_buf(l1_payload, GSM_HR_BYTES);
 #endif /* USE_L1_RTP_MODE */
 
 	return GSM_HR_BYTES;
@@ -244,18 +179,21 @@ static int rtppayload_to_l1_hr(uint8_t *l1_payload, const uint8_t *rtp_payload,
 #define AMR_TOC_QBIT	0x04
 #define AMR_CMR_NONE	0xF
 
-static struct msgb *l1_to_rtppayload_amr(uint8_t *l1_payload, uint8_t payload_len,
-					 struct amr_multirate_conf *amr_mrc)
+/*! \brief convert AMR from L1 format to RTP payload, in place */
+static int l1_to_rtppayload_amr(uint8_t **rtp_pl, uint8_t *l1_payload,
+				uint8_t payload_len,
+				struct amr_multirate_conf *amr_mrc)
 {
-	struct msgb *msg;
-	uint8_t *cur;
 	u_int8_t cmr;
-	uint8_t ft = l1_payload[2] & 0xF;
-	uint8_t amr_if2_len = payload_len - 2;
+	uint8_t ft, amr_if2_len;
 
-	msg = msgb_alloc_headroom(1024, 128, "L1C-to-RTP");
-	if (!msg)
-		return NULL;
+	if (payload_len < 3) {
+		LOGP(DL1C, LOGL_ERROR, "L1 AMR frame length %u too short\n",
+			payload_len);
+		return -EINVAL;
+	}
+	ft = l1_payload[2] & 0xF;
+	amr_if2_len = payload_len - 2;
 
 #if 1
 	uint8_t cmr_idx = l1_payload[1];
@@ -275,26 +213,29 @@ static struct msgb *l1_to_rtppayload_amr(uint8_t *l1_payload, uint8_t payload_le
 #endif
 
 #ifdef USE_L1_RTP_MODE
-	cur = msgb_put(msg, amr_if2_len);
-	memcpy(cur, l1_payload+2, amr_if2_len);
+	/* the RTP payload follows the CMI and CMR */
+	*rtp_pl = l1_payload + 2;
+
+	return amr_if2_len;
 #else
-	/* RFC 3267  4.4.1 Payload Header */
-	msgb_put_u8(msg, (cmr << 4));
+	/* step1: reverse the bit-order within every byte */
+	sysmobts_revbytebits_buf(l1_payload+2, amr_if2_len);
 
-	/* RFC 3267  AMR TOC */
-	msgb_put_u8(msg, AMR_TOC_QBIT | (ft << 3));
+	/* step2: shift everything left by one nibble, the IF2 frame
+	 * starts at the same position in the RTP payload */
+	osmo_nibble_shift_left_unal(l1_payload+2, l1_payload+2,
+				    amr_if2_len*2 -1);
 
-	cur = msgb_put(msg, amr_if2_len-1);
+	/* RFC 3267  4.4.1 Payload Header */
+	l1_payload[0] = cmr << 4;
 
-	/* step1: reverse the bit-order within every byte */
-	osmo_revbytebits_buf(l1_payload+2, amr_if2_len);
+	/* RFC 3267  AMR TOC */
+	l1_payload[1] = AMR_TOC_QBIT | (ft << 3);
 
-	/* step2: shift everything left by one nibble */
-	osmo_nibble_shift_left_unal(cur, l1_payload+2, amr_if2_len*2 -1);
+	*rtp_pl = l1_payload;
 
+	return amr_if2_len + 1;
 #endif /* USE_L1_RTP_MODE */
-
-	return msg;
 }
 
 enum amr_frame_type {
@@ -337,7 +278,7 @@ static int rtppayload_to_l1_amr(uint8_t *l1_payload, const uint8_t *rtp_payload,
 	osmo_nibble_shift_right(l1_payload+2, rtp_payload+2, amr_if2_core_len*2);
 	/* step2: reverse the bit-order within every byte of the IF2
 	 * core frame contained in the RTP payload */
-	osmo_revbytebits_buf(l1_payload+2, amr_if2_core_len+1);
+	sysmobts_revbytebits_buf(l1_payload+2, amr_if2_core_len+1);
 
 	/* lower 4 bit of first FR2 byte contains FT */
 	l1_payload[2] |= ft;
@@ -492,12 +433,15 @@ int l1if_tch_rx(struct gsm_bts_trx *trx, uint8_t chan_nr, struct msgb *l1p_msg)
 	uint8_t payload_type = data_ind->msgUnitParam.u8Buffer[0];
 	uint8_t *payload = data_ind->msgUnitParam.u8Buffer + 1;
 	uint8_t payload_len;
-	struct msgb *rmsg = NULL;
+	uint8_t *rtp_pl = NULL;
+	struct osmo_phsap_prim *l1sap;
 	struct gsm_lchan *lchan = &trx->ts[L1SAP_CHAN2TS(chan_nr)].lchan[l1sap_chan2ss(chan_nr)];
+	int rc = 0;
 
 	if (data_ind->msgUnitParam.u8Size < 1) {
 		LOGP(DL1C, LOGL_ERROR, "chan_nr %d Rx Payload size 0\n",
 			chan_nr);
+		bts_msgb_free(l1p_msg);
 		return -EINVAL;
 	}
 	payload_len = data_ind->msgUnitParam.u8Size - 1;
@@ -531,45 +475,48 @@ int l1if_tch_rx(struct gsm_bts_trx *trx, uint8_t chan_nr, struct msgb *l1p_msg)
 
 	switch (payload_type) {
 	case GsmL1_TchPlType_Fr:
-		rmsg = l1_to_rtppayload_fr(payload, payload_len);
+		rc = l1_to_rtppayload_fr(&rtp_pl, payload, payload_len);
 		break;
 	case GsmL1_TchPlType_Hr:
-		rmsg = l1_to_rtppayload_hr(payload, payload_len);
+		rc = l1_to_rtppayload_hr(&rtp_pl, payload, payload_len);
 		break;
 #if defined(L1_HAS_EFR) && defined(USE_L1_RTP_MODE)
 	case GsmL1_TchPlType_Efr:
-		rmsg = l1_to_rtppayload_efr(payload, payload_len);
+		rc = l1_to_rtppayload_efr(&rtp_pl, payload, payload_len);
 		break;
 #endif
 	case GsmL1_TchPlType_Amr:
-		rmsg = l1_to_rtppayload_amr(payload, payload_len,
-					    &lchan->tch.amr_mr);
+		rc = l1_to_rtppayload_amr(&rtp_pl, payload, payload_len,
+					  &lchan->tch.amr_mr);
 		break;
 	}
 
-	if (rmsg) {
-		struct osmo_phsap_prim *l1sap;
-
-		LOGP(DL1C, LOGL_DEBUG, "%s Rx -> RTP: %s\n",
-			gsm_lchan_name(lchan), osmo_hexdump(rmsg->data, rmsg->len));
+	if (rc <= 0) {
+		bts_msgb_free(l1p_msg);
+		return rc;
+	}
 
-		/* add l1sap header */
-		rmsg->l2h = rmsg->data;
-		msgb_push(rmsg, sizeof(*l1sap));
-		rmsg->l1h = rmsg->data;
-		l1sap = msgb_l1sap_prim(rmsg);
-		osmo_prim_init(&l1sap->oph, SAP_GSM_PH, PRIM_TCH, PRIM_OP_INDICATION, rmsg);
-		l1sap->u.tch.chan_nr = chan_nr;
+	LOGP(DL1C, LOGL_DEBUG, "%s Rx -> RTP: %s\n",
+		gsm_lchan_name(lchan), osmo_hexdump(rtp_pl, rc));
 
-		return l1sap_up(trx, l1sap);
-	}
+	/* the RTP payload stays where it is, cut the L1 primitive around
+	 * it and add the l1sap header in front */
+	msgb_pull(l1p_msg, rtp_pl - l1p_msg->data);
+	msgb_trim(l1p_msg, rc);
+	l1p_msg->l2h = l1p_msg->data;
+	l1p_msg->l1h = msgb_push(l1p_msg, sizeof(*l1sap));
+	l1sap = msgb_l1sap_prim(l1p_msg);
+	osmo_prim_init(&l1sap->oph, SAP_GSM_PH, PRIM_TCH, PRIM_OP_INDICATION,
+		l1p_msg);
+	l1sap->u.tch.chan_nr = chan_nr;
 
-	return 0;
+	return l1sap_up(trx, l1sap);
 
 err_payload_match:
 	LOGP(DL1C, LOGL_ERROR, "%s Rx Payload Type %s incompatible with lchan\n",
 		gsm_lchan_name(lchan),
 		get_value_string(femtobts_tch_pl_names, payload_type));
+	bts_msgb_free(l1p_msg);
 	return -EINVAL;
 }
 
@@ -613,7 +560,7 @@ struct msgb *gen_empty_tch_msg(struct gsm_lchan *lchan)
 		}
 		break;
 	default:
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		msg = NULL;
 		break;
 	}
@@ -85,3 +85,86 @@ int sysmobts_select_femto_band(struct gsm_bts *bts, uint16_t arfcn)
 	/* give up */
 	return -1;
 }
+
+/* The codec frames are converted in place within the L1 primitive, so
+ * the nibble shifts work from the end (right shift) or from the start
+ * (left shift) of the buffer.  Four bytes are shifted at once. */
+
+static inline uint32_t load32be(const uint8_t *p)
+{
+	return ((uint32_t) p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline void store32be(uint8_t *p, uint32_t w)
+{
+	p[0] = w >> 24;
+	p[1] = w >> 16;
+	p[2] = w >> 8;
+	p[3] = w;
+}
+
+/* input octet-aligned, output not octet-aligned */
+void osmo_nibble_shift_right(uint8_t *out, const uint8_t *in,
+			     unsigned int num_nibbles)
+{
+	unsigned int i = num_nibbles / 2;
+
+	/* shift the last nibble, in case there's an odd count */
+	if (num_nibbles & 1)
+		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
+	else
+		out[i] = (in[i-1] & 0xF) << 4;
+
+	/* bytes 1.., backwards */
+	while (i >= 5) {
+		i -= 4;
+		store32be(out + i, (load32be(in + i) >> 4) |
+				   ((uint32_t) in[i-1] << 28));
+	}
+	while (i > 1) {
+		i--;
+		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
+	}
+
+	/* first byte: upper nibble empty, lower nibble from src */
+	out[0] = (in[0] >> 4);
+}
+
+/* input unaligned, output octet-aligned */
+void osmo_nibble_shift_left_unal(uint8_t *out, const uint8_t *in,
+				unsigned int num_nibbles)
+{
+	unsigned int i = 0;
+	unsigned int num_whole_bytes = num_nibbles / 2;
+
+	for (; i + 4 <= num_whole_bytes; i += 4)
+		store32be(out + i, (load32be(in + i) << 4) | (in[i+4] >> 4));
+	for (; i < num_whole_bytes; i++)
+		out[i] = ((in[i] & 0xF) << 4) | (in[i+1] >> 4);
+
+	/* shift the last nibble, in case there's an odd count */
+	i = num_whole_bytes;
+	if (num_nibbles & 1)
+		out[i] = (in[i] & 0xF) << 4;
+}
+
+static uint8_t revbits_tbl[256];
+static int revbits_tbl_init = 0;
+
+void sysmobts_revbytebits_buf(uint8_t *buf, unsigned int len)
+{
+	unsigned int i, b;
+
+	if (!revbits_tbl_init) {
+		for (i = 0; i < 256; i++) {
+			for (b = 0; b < 8; b++) {
+				if (i & (1 << b))
+					revbits_tbl[i] |= 0x80 >> b;
+			}
+		}
+		revbits_tbl_init = 1;
+	}
+
+	for (i = 0; i < len; i++)
+		buf[i] = revbits_tbl[buf[i]];
+}
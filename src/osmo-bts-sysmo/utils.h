@@ -7,4 +7,15 @@ struct gsm_bts;
 
 int sysmobts_select_femto_band(struct gsm_bts *bts, uint16_t arfcn);
 
+/* input octet-aligned, output not octet-aligned, 'out' may be 'in' */
+void osmo_nibble_shift_right(uint8_t *out, const uint8_t *in,
+			     unsigned int num_nibbles);
+
+/* input unaligned, output octet-aligned, 'out' may be 'in' */
+void osmo_nibble_shift_left_unal(uint8_t *out, const uint8_t *in,
+				unsigned int num_nibbles);
+
+/* reverse the bit order within every byte of 'buf' */
+void sysmobts_revbytebits_buf(uint8_t *buf, unsigned int len);
+
 #endif
@@ -7,6 +7,7 @@
 #include <osmocom/core/bits.h>
 #include <osmocom/core/conv.h>
 #include <osmocom/core/crcgen.h>
+#include <osmocom/core/utils.h>
 #include <osmocom/codec/codec.h>
 
 #include "gsm0503_conv.h"
@@ -16,12 +17,53 @@
 #include "gsm0503_tables.h"
 #include "gsm0503_coding.h"
 
-static int _xcch_decode_cB(uint8_t *l2_data, sbit_t *cB)
+/* count number of wrong bits of the received block 'orig' against the
+ * re-encoded block 'test', sbits with 0-value (punctured or erased) are
+ * omitted, so they count neither as error nor as received bit */
+static void calc_ber(const sbit_t *orig, const ubit_t *test, int len,
+	int *n_errors, int *n_bits_total)
+{
+	int i, err = 0, total = 0;
+
+	for (i=0; i<len; i++) {
+		if (orig[i] > 0) {
+			total++;
+			err += test[i];
+		} else if (orig[i] < 0) {
+			total++;
+			err += !test[i];
+		}
+	}
+
+	if (n_errors)
+		*n_errors = err;
+	if (n_bits_total)
+		*n_bits_total = total;
+}
+
+/* decode and get the bit errors by re-encoding the decoded bits */
+static void conv_decode_ber(const struct osmo_conv_code *code, sbit_t *input,
+	ubit_t *output, int *n_errors, int *n_bits_total)
+{
+	ubit_t recoded[676];
+	int len;
+
+	osmo_conv_decode(code, input, output);
+
+	if (!n_errors && !n_bits_total)
+		return;
+
+	len = osmo_conv_encode(code, output, recoded);
+	calc_ber(input, recoded, len, n_errors, n_bits_total);
+}
+
+static int _xcch_decode_cB(uint8_t *l2_data, sbit_t *cB, int *n_errors,
+	int *n_bits_total)
 {
 	ubit_t conv[224];
 	int rv;
 
-	osmo_conv_decode(&gsm0503_conv_xcch, cB, conv);
+	conv_decode_ber(&gsm0503_conv_xcch, cB, conv, n_errors, n_bits_total);
 
 	rv = osmo_crc64gen_check_bits(&gsm0503_fire_crc40, conv, 184, conv+184);
 	if (rv)
@@ -50,7 +92,8 @@ static int _xcch_encode_cB(ubit_t *cB, uint8_t *l2_data)
  * GSM xCCH block transcoding
  */
 
-int xcch_decode(uint8_t *l2_data, sbit_t *bursts)
+int xcch_decode(uint8_t *l2_data, sbit_t *bursts, int *n_errors,
+	int *n_bits_total)
 {
 	sbit_t iB[456], cB[456];
 	int i;
@@ -61,7 +104,7 @@ int xcch_decode(uint8_t *l2_data, sbit_t *bursts)
 
 	gsm0503_xcch_deinterleave(cB, iB);
 
-	return _xcch_decode_cB(l2_data, cB);
+	return _xcch_decode_cB(l2_data, cB, n_errors, n_bits_total);
 }
 
 int xcch_encode(ubit_t *bursts, uint8_t *l2_data)
@@ -85,7 +128,8 @@ int xcch_encode(ubit_t *bursts, uint8_t *l2_data)
  * GSM PDTCH block transcoding
  */
 
-int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p)
+int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p,
+	int *n_errors, int *n_bits_total)
 {
 	sbit_t iB[456], cB[676], hl_hn[8];
 	ubit_t conv[456];
@@ -109,7 +153,8 @@ int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p)
 
 	switch (cs) {
 	case 1:
-		osmo_conv_decode(&gsm0503_conv_xcch, cB, conv);
+		conv_decode_ber(&gsm0503_conv_xcch, cB, conv, n_errors,
+			n_bits_total);
 
 		rv = osmo_crc64gen_check_bits(&gsm0503_fire_crc40, conv, 184,
 			conv+184);
@@ -126,7 +171,8 @@ int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p)
 			else
 				cB[i] = 0;
 
-		osmo_conv_decode(&gsm0503_conv_cs2, cB, conv);
+		conv_decode_ber(&gsm0503_conv_cs2, cB, conv, n_errors,
+			n_bits_total);
 
 		for (i=0; i<8; i++) {
 			for (j=0, k=0; j<6; j++)
@@ -159,7 +205,8 @@ int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p)
 			else
 				cB[i] = 0;
 
-		osmo_conv_decode(&gsm0503_conv_cs3, cB, conv);
+		conv_decode_ber(&gsm0503_conv_cs3, cB, conv, n_errors,
+			n_bits_total);
 
 		for (i=0; i<8; i++) {
 			for (j=0, k=0; j<6; j++)
@@ -189,6 +236,13 @@ int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p)
 		for (i=12; i<456;i++)
 			conv[i] = (cB[i] < 0) ? 1:0;
 
+		/* CS-4 is not convolutional coded, no bit errors can be
+		 * counted */
+		if (n_errors)
+			*n_errors = 0;
+		if (n_bits_total)
+			*n_bits_total = 0;
+
 		for (i=0; i<8; i++) {
 			for (j=0, k=0; j<12; j++)
 				k += abs(((int)gsm0503_usf2twelve_sbit[i][j]) -
@@ -608,7 +662,123 @@ static void tch_amr_unmerge(ubit_t *d, ubit_t *p, ubit_t *u, int len, int prot)
 	memcpy(d+prot, u+prot+6, len-prot);
 }
 
-int tch_fr_decode(uint8_t *tch_data, sbit_t *bursts, int net_order, int efr)
+static unsigned int sbit_energy(const sbit_t *bits, int len)
+{
+	unsigned int energy = 0;
+	int i;
+
+	for (i=0; i<len; i++)
+		energy += (bits[i] < 0) ? -bits[i] : bits[i];
+
+	return energy;
+}
+
+/* classify a block of 8 bursts by its stealing bits and its energy, so
+ * that only the required decoder runs and idle blocks are not decoded: a
+ * block is idle (the MS does not transmit, e.g. during DTX), if the mean
+ * magnitude of its soft bits is below idle_level, 0 never finds it idle */
+enum tch_ul_class tch_fr_classify(const sbit_t *bursts, int idle_level)
+{
+	int i, steal = 0;
+
+	for (i=0; i<8; i++)
+		steal -= bursts[i * 116 + ((i>>2) ? 57 : 58)];
+
+	if (steal > 0)
+		return TCH_UL_FACCH;
+
+	if (sbit_energy(bursts, 928) < 928 * idle_level)
+		return TCH_UL_IDLE;
+
+	return TCH_UL_SPEECH;
+}
+
+/* the SID code word of a FR frame (GSM 06.12 section 5.2) are the 95 bits
+ * of the RPE pulses xMc, which are protected by the channel coding, i.e.
+ * the xMc bits among the 182 class 1 bits of GSM 05.03 Table 2. These are
+ * the MSBs of all 52 pulses and 43 of the middle bits. The list holds their
+ * positions in the RTP format, which is preceded by 4 signature bits. */
+static uint16_t tch_fr_sid_bits[95];
+static int tch_fr_sid_num;
+
+static void tch_fr_sid_init(void)
+{
+	int i, b;
+
+	for (i = 0; i < 182; i++) {
+		b = gsm610_bitorder[i];
+		/* LARc, then 4 sub frames of Nc, bc, Mc, xmaxc, xMc */
+		if (b < 36 || (b - 36) % 56 < 17)
+			continue;
+		if (tch_fr_sid_num == ARRAY_SIZE(tch_fr_sid_bits))
+			break;
+		tch_fr_sid_bits[tch_fr_sid_num++] = b + 4;
+	}
+}
+
+/* number of bits of the SID code word (all 0) which are set in the FR frame
+ * in RTP format: a SID frame has less than 2, a frame with less than 16
+ * is treated as SID frame when received (GSM 06.31) */
+int tch_fr_sid_errors(const uint8_t *tch_data)
+{
+	int i, bit, n_errors = 0;
+
+	if (!tch_fr_sid_num)
+		tch_fr_sid_init();
+
+	for (i = 0; i < tch_fr_sid_num; i++) {
+		bit = tch_fr_sid_bits[i];
+		n_errors += (tch_data[bit >> 3] >> (7 - (bit & 7))) & 1;
+	}
+
+	return n_errors;
+}
+
+/* same for a block of 6 bursts of a TCH/H, FACCH is only found at even
+ * alignment */
+enum tch_ul_class tch_hr_classify(const sbit_t *bursts, int odd,
+	int idle_level)
+{
+	int i, steal = 0;
+
+	if (!odd) {
+		for (i=0; i<4; i++)
+			steal -= bursts[i * 116 + 58];
+		for (i=2; i<5; i++)
+			steal -= bursts[i * 116 + 57];
+	}
+
+	if (steal > 0)
+		return TCH_UL_FACCH;
+
+	/* speech is interleaved over the first 4 bursts only */
+	if (sbit_energy(bursts, 464) < 464 * idle_level)
+		return TCH_UL_IDLE;
+
+	return TCH_UL_SPEECH;
+}
+
+/* find the in-band codec id of an AMR frame. All soft bits of the id code
+ * words have the same magnitude, so the nearest code word is the one with
+ * the highest correlation. */
+static int amr_ic_detect(const sbit_t *cB, const sbit_t *ic, int len)
+{
+	int i, j, k, best = 0, id = 0;
+
+	for (i=0; i<4; i++) {
+		for (j=0, k=0; j<len; j++)
+			k += ic[i * len + j] * cB[j];
+		if (i == 0 || k > best) {
+			best = k;
+			id = i;
+		}
+	}
+
+	return id;
+}
+
+int tch_fr_decode(uint8_t *tch_data, sbit_t *bursts, int net_order, int efr,
+	int *n_errors, int *n_bits_total)
 {
 	sbit_t iB[912], cB[456], h;
 	ubit_t conv[185], s[244], w[260], b[65], d[260], p[8];
@@ -623,14 +793,14 @@ int tch_fr_decode(uint8_t *tch_data, sbit_t *bursts, int net_order, int efr)
 	gsm0503_tch_fr_deinterleave(cB, iB);
 
 	if (steal > 0) {
-		rv = _xcch_decode_cB(tch_data, cB);
+		rv = _xcch_decode_cB(tch_data, cB, n_errors, n_bits_total);
 		if (rv)
 			return -1;
 
 		return 23;
 	}
 
-	osmo_conv_decode(&gsm0503_conv_tch_fr, cB, conv);
+	conv_decode_ber(&gsm0503_conv_tch_fr, cB, conv, n_errors, n_bits_total);
 
 	tch_fr_unreorder(d, p, conv);
 
@@ -723,7 +893,8 @@ coding_efr_fr:
 	return 0;
 }
 
-int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd)
+int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
+	int *n_errors, int *n_bits_total)
 {
 	sbit_t iB[912], cB[456], h;
 	ubit_t conv[98], b[112], d[112], p[3];
@@ -752,7 +923,7 @@ int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd)
 
 		gsm0503_tch_fr_deinterleave(cB, iB);
 
-		rv = _xcch_decode_cB(tch_data, cB);
+		rv = _xcch_decode_cB(tch_data, cB, n_errors, n_bits_total);
 		if (rv)
 			return -1;
 
@@ -765,7 +936,7 @@ int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd)
 
 	gsm0503_tch_hr_deinterleave(cB, iB);
 
-	osmo_conv_decode(&gsm0503_conv_tch_hr, cB, conv);
+	conv_decode_ber(&gsm0503_conv_tch_hr, cB, conv, n_errors, n_bits_total);
 
 	tch_hr_unreorder(d, p, conv);
 
@@ -834,29 +1005,13 @@ int tch_hr_encode(ubit_t *bursts, uint8_t *tch_data, int len)
 	return 0;
 }
 
-static float amr_calc_ber(sbit_t *orig, ubit_t *test, int len)
-{
-	int i, err = 0;
-
-	/* count number of wrong bits (sbits with 0-value are omitted) */
-	for (i=0; i<len; i++) {
-		if ((*orig) > 0 && (*test))
-			err++;
-		else if ((*orig) < 0 && !(*test))
-			err++;
-		orig++;
-		test++;
-	}
-
-	return (float)err / (float)len;
-}
-
 int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
-	uint8_t *codec, int codecs, uint8_t *ft, uint8_t *cmr, float *ber)
+	uint8_t *codec, int codecs, uint8_t *ft, uint8_t *cmr, int *n_errors,
+	int *n_bits_total)
 {
 	sbit_t iB[912], cB[456], h;
 	ubit_t test[456], d[244], p[6], conv[250];
-	int i, j, k, best = 0, rv, len, steal = 0, id = 0;
+	int i, rv, len, steal = 0, id = 0;
 
 	for (i=0; i<8; i++) {
 		gsm0503_tch_burst_unmap(&iB[i * 114], &bursts[i * 116], &h,
@@ -867,22 +1022,14 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 	gsm0503_tch_fr_deinterleave(cB, iB);
 
 	if (steal > 0) {
-		rv = _xcch_decode_cB(tch_data, cB);
+		rv = _xcch_decode_cB(tch_data, cB, n_errors, n_bits_total);
 		if (rv)
 			return -1;
 
 		return 23;
 	}
 
-	for (i=0; i<4; i++) {
-		for (j=0, k=0; j<8; j++)
-			k += abs(((int)gsm0503_afs_ic_sbit[i][j]) -
-							((int)cB[j]));
-		if (i == 0 || k < best) {
-			best = k;
-			id = i;
-		}
-	}
+	id = amr_ic_detect(cB, &gsm0503_afs_ic_sbit[0][0], 8);
 
 	/* check if indicated codec fits into range of codecs */
 	if (id >= codecs) {
@@ -904,10 +1051,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 31;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_12_2, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -924,10 +1072,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 26;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_10_2, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -944,10 +1093,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 20;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_7_95, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -964,10 +1114,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 19;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_7_4, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -984,10 +1135,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 17;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_6_7, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1004,10 +1156,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 15;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_5_9, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1024,10 +1177,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 13;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_5_15, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1044,10 +1198,11 @@ int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
 
 		len = 12;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_afs_4_75, conv,
 				test+8);
-			*ber = amr_calc_ber(cB+8, test+8, 448);
+			calc_ber(cB+8, test+8, 448, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1229,11 +1384,11 @@ facch:
 
 int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 	int codec_mode_req, uint8_t *codec, int codecs, uint8_t *ft,
-	uint8_t *cmr, float *ber)
+	uint8_t *cmr, int *n_errors, int *n_bits_total)
 {
 	sbit_t iB[912], cB[456], h;
 	ubit_t test[456], d[244], p[6], conv[135];
-	int i, j, k, best = 0, rv, len, steal = 0, id = 0;
+	int i, rv, len, steal = 0, id = 0;
 
 	/* only unmap the stealing bits */
 	if (!odd) {
@@ -1258,7 +1413,7 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		gsm0503_tch_fr_deinterleave(cB, iB);
 
-		rv = _xcch_decode_cB(tch_data, cB);
+		rv = _xcch_decode_cB(tch_data, cB, n_errors, n_bits_total);
 		if (rv)
 			return -1;
 
@@ -1271,15 +1426,7 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 	gsm0503_tch_hr_deinterleave(cB, iB);
 
-	for (i=0; i<4; i++) {
-		for (j=0, k=0; j<4; j++)
-			k += abs(((int)gsm0503_ahs_ic_sbit[i][j]) -
-							((int)cB[j]));
-		if (i == 0 || k < best) {
-			best = k;
-			id = i;
-		}
-	}
+	id = amr_ic_detect(cB, &gsm0503_ahs_ic_sbit[0][0], 4);
 
 	/* check if indicated codec fits into range of codecs */
 	if (id >= codecs) {
@@ -1304,10 +1451,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 20;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_7_95, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 188);
+			calc_ber(cB+4, test+4, 188, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1327,10 +1475,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 19;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_7_4, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 196);
+			calc_ber(cB+4, test+4, 196, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1350,10 +1499,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 17;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_6_7, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 200);
+			calc_ber(cB+4, test+4, 200, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1373,10 +1523,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 15;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_5_9, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 208);
+			calc_ber(cB+4, test+4, 208, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1396,10 +1547,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 13;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_5_15, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 212);
+			calc_ber(cB+4, test+4, 212, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1419,10 +1571,11 @@ int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 
 		len = 12;
 
-		if (ber) {
+		if (n_errors || n_bits_total) {
 			osmo_conv_encode(&gsm0503_conv_tch_ahs_4_75, conv,
 				test+4);
-			*ber = amr_calc_ber(cB+4, test+4, 212);
+			calc_ber(cB+4, test+4, 212, n_errors,
+				n_bits_total);
 		}
 
 		break;
@@ -1608,13 +1761,47 @@ invalid_length:
  * b(5) = LSB of BS colour code
  */
 
-static int rach_apply_bsic(ubit_t *d, uint8_t bsic)
+static int rach_apply_bsic(ubit_t *d, int len, uint8_t bsic)
 {
 	int i;
 
 	/* Apply it */
 	for (i=0; i<6; i++)
-		d[8+i] ^= ((bsic >> (5-i)) & 1);
+		d[len+i] ^= ((bsic >> (5-i)) & 1);
+
+	return 0;
+}
+
+/* decode an access burst and return the BSIC, its parity was coded with,
+ * instead of checking it against a single one: a burst is decoded once
+ * and then matched against any number of BSIC at no cost */
+int rach_decode_any(struct rach_dec *dec, sbit_t *burst, int ext)
+{
+	const struct osmo_conv_code *code =
+		ext ? &gsm0503_conv_rach_ext : &gsm0503_conv_rach;
+	ubit_t conv[17], recoded[36];
+	uint8_t parity = 0;
+	int i, len = ext ? 11 : 8, corr = 0;
+
+	osmo_conv_decode(code, burst, conv);
+	osmo_conv_encode(code, conv, recoded);
+	calc_ber(burst, recoded, 36, &dec->n_errors, &dec->n_bits_total);
+
+	/* correlation of the soft bits with the decoded code word */
+	for (i=0; i<36; i++)
+		corr += recoded[i] ? -burst[i] : burst[i];
+	dec->corr = corr * 1000 / (36 * 127);
+
+	for (i=0; i<6; i++)
+		parity = (parity << 1) | conv[len+i];
+	dec->bsic = parity
+		^ osmo_crc8gen_compute_bits(&gsm0503_rach_crc6, conv, len);
+
+	/* RA is transmitted LSB first */
+	dec->ra = 0;
+	for (i=0; i<len; i++)
+		dec->ra |= conv[i] << i;
+	dec->ext = ext;
 
 	return 0;
 }
@@ -1626,7 +1813,7 @@ int rach_decode(uint8_t *ra, sbit_t *burst, uint8_t bsic)
 
 	osmo_conv_decode(&gsm0503_conv_rach, burst, conv);
 
-	rach_apply_bsic(conv, bsic);
+	rach_apply_bsic(conv, 8, bsic);
 
 	rv = osmo_crc8gen_check_bits(&gsm0503_rach_crc6, conv, 8, conv+8);
 	if (rv)
@@ -1645,13 +1832,30 @@ int rach_encode(ubit_t *burst, uint8_t *ra, uint8_t bsic)
 
 	osmo_crc8gen_set_bits(&gsm0503_rach_crc6, conv, 8, conv+8);
 
-	rach_apply_bsic(conv, bsic);
+	rach_apply_bsic(conv, 8, bsic);
 
 	osmo_conv_encode(&gsm0503_conv_rach, conv, burst);
 
 	return 0;
 }
 
+int rach_ext_encode(ubit_t *burst, uint16_t ra, uint8_t bsic)
+{
+	ubit_t conv[17];
+	int i;
+
+	for (i=0; i<11; i++)
+		conv[i] = (ra >> i) & 1;
+
+	osmo_crc8gen_set_bits(&gsm0503_rach_crc6, conv, 11, conv+11);
+
+	rach_apply_bsic(conv, 11, bsic);
+
+	osmo_conv_encode(&gsm0503_conv_rach_ext, conv, burst);
+
+	return 0;
+}
+
 
 /*
  * GSM SCH transcoding
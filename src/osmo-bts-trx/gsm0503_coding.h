@@ -1,27 +1,57 @@
 #ifndef _0503_CODING_H
 #define _0503_CODING_H
 
-int xcch_decode(uint8_t *l2_data, sbit_t *bursts);
+/* class of an uplink TCH block, as seen before channel decoding */
+enum tch_ul_class {
+	TCH_UL_SPEECH,
+	TCH_UL_FACCH,
+	TCH_UL_IDLE,		/* no energy, MS does not transmit */
+};
+
+enum tch_ul_class tch_fr_classify(const sbit_t *bursts, int idle_level);
+enum tch_ul_class tch_hr_classify(const sbit_t *bursts, int odd,
+	int idle_level);
+int tch_fr_sid_errors(const uint8_t *tch_data);
+
+int xcch_decode(uint8_t *l2_data, sbit_t *bursts, int *n_errors,
+	int *n_bits_total);
 int xcch_encode(ubit_t *bursts, uint8_t *l2_data);
-int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p);
+int pdtch_decode(uint8_t *l2_data, sbit_t *bursts, uint8_t *usf_p,
+	int *n_errors, int *n_bits_total);
 int pdtch_encode(ubit_t *bursts, uint8_t *l2_data, uint8_t l2_len);
-int tch_fr_decode(uint8_t *tch_data, sbit_t *bursts, int net_order, int efr);
+int tch_fr_decode(uint8_t *tch_data, sbit_t *bursts, int net_order, int efr,
+	int *n_errors, int *n_bits_total);
 int tch_fr_encode(ubit_t *bursts, uint8_t *tch_data, int len, int net_order);
-int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd);
+int tch_hr_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
+	int *n_errors, int *n_bits_total);
 int tch_hr_encode(ubit_t *bursts, uint8_t *tch_data, int len);
 int tch_afs_decode(uint8_t *tch_data, sbit_t *bursts, int codec_mode_req,
-	uint8_t *codec, int codecs, uint8_t *ft, uint8_t *cmr, float *ber);
+	uint8_t *codec, int codecs, uint8_t *ft, uint8_t *cmr, int *n_errors,
+	int *n_bits_total);
 int tch_afs_encode(ubit_t *bursts, uint8_t *tch_data, int len,
 	int codec_mode_req, uint8_t *codec, int codecs, uint8_t ft,
 	uint8_t cmr);
 int tch_ahs_decode(uint8_t *tch_data, sbit_t *bursts, int odd,
 	int codec_mode_req, uint8_t *codec, int codecs, uint8_t *ft, 
-	uint8_t *cmr, float *ber);
+	uint8_t *cmr, int *n_errors, int *n_bits_total);
 int tch_ahs_encode(ubit_t *bursts, uint8_t *tch_data, int len,
 	int codec_mode_req, uint8_t *codec, int codecs, uint8_t ft,
 	uint8_t cmr);
 int rach_decode(uint8_t *ra, sbit_t *burst, uint8_t bsic);
 int rach_encode(ubit_t *burst, uint8_t *ra, uint8_t bsic);
+int rach_ext_encode(ubit_t *burst, uint16_t ra, uint8_t bsic);
+
+/* access burst, decoded without BSIC by rach_decode_any() */
+struct rach_dec {
+	uint16_t ra;		/* 8 or 11 bits */
+	uint8_t ext;		/* 11 bit access burst */
+	uint8_t bsic;		/* BSIC the parity was coded with */
+	int n_errors;		/* bit errors of the 36 coded bits */
+	int n_bits_total;
+	int corr;		/* with the code word, -1000..1000 */
+};
+
+int rach_decode_any(struct rach_dec *dec, sbit_t *burst, int ext);
 int sch_decode(uint8_t *sb_info, sbit_t *burst);
 int sch_encode(ubit_t *burst, uint8_t *sb_info);
 
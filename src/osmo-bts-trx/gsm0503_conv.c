@@ -63,6 +63,21 @@ const struct osmo_conv_code gsm0503_conv_rach = {
 };
 
 
+/* 11 bit access burst: 42 coded bits punctured to the 36 of an 8 bit one */
+static const int conv_rach_ext_puncture[] = {
+	0, 2, 5, 37, 39, 41, -1,
+};
+
+const struct osmo_conv_code gsm0503_conv_rach_ext = {
+	.N = 2,
+	.K = 5,
+	.len = 17,
+	.next_output = conv_xcch_next_output,
+	.next_state  = conv_xcch_next_state,
+	.puncture    = conv_rach_ext_puncture,
+};
+
+
 const struct osmo_conv_code gsm0503_conv_sch = {
 	.N = 2,
 	.K = 5,
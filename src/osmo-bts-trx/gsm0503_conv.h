@@ -5,6 +5,7 @@ extern const struct osmo_conv_code gsm0503_conv_xcch;
 extern const struct osmo_conv_code gsm0503_conv_cs2;
 extern const struct osmo_conv_code gsm0503_conv_cs3;
 extern const struct osmo_conv_code gsm0503_conv_rach;
+extern const struct osmo_conv_code gsm0503_conv_rach_ext;
 extern const struct osmo_conv_code gsm0503_conv_sch;
 extern const struct osmo_conv_code gsm0503_conv_tch_fr;
 extern const struct osmo_conv_code gsm0503_conv_tch_hr;
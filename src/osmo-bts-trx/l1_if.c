@@ -35,10 +35,12 @@
 #include <osmo-bts/amr.h>
 #include <osmo-bts/handover.h>
 #include <osmo-bts/abis.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include "l1_if.h"
 #include "trx_if.h"
 #include "scheduler.h"
+#include "trx_trace.h"
 
 
 static const uint8_t transceiver_chan_types[_GSM_PCHAN_MAX] = {
@@ -147,6 +149,9 @@ int l1if_provision_transceiver_trx(struct trx_l1h *l1h)
 {
 	uint8_t tn;
 
+	/* every change of the config ends up here */
+	trx_trace_config(l1h);
+
 	if (!transceiver_available)
 		return -EIO;
 
@@ -440,10 +445,16 @@ int l1if_mph_time_ind(struct gsm_bts *bts, uint32_t fn)
 	return l1sap_up(bts->c0, &l1sap);
 }
 
-int l1if_process_meas_res(struct gsm_bts_trx *trx, uint8_t chan_nr, float qta,
-	float ber, float rssi)
+int l1if_process_meas_res(struct gsm_bts_trx *trx, uint8_t chan_nr,
+	const struct trx_ul_meas *m)
 {
+	struct gsm_lchan *lchan = &trx->ts[L1SAP_CHAN2TS(chan_nr)]
+					.lchan[l1sap_chan2ss(chan_nr)];
 	struct osmo_phsap_prim l1sap;
+	int qta;
+
+	/* TA offset in quarter bits, the TOA is given in 1/256 symbols */
+	qta = lchan->rqd_ta * 4 + trx_ul_meas_toa256(m) / 64;
 
 	memset(&l1sap, 0, sizeof(l1sap));
 	osmo_prim_init(&l1sap.oph, SAP_GSM_PH, PRIM_MPH_INFO,
@@ -451,8 +462,8 @@ int l1if_process_meas_res(struct gsm_bts_trx *trx, uint8_t chan_nr, float qta,
 	l1sap.u.info.type = PRIM_INFO_MEAS;
 	l1sap.u.info.u.meas_ind.chan_nr = chan_nr;
 	l1sap.u.info.u.meas_ind.ta_offs_qbits = qta;
-	l1sap.u.info.u.meas_ind.ber10k = (unsigned int) (ber * 100);
-	l1sap.u.info.u.meas_ind.inv_rssi = (uint8_t) (rssi * -1);
+	l1sap.u.info.u.meas_ind.ber10k = trx_ul_meas_ber10k(m);
+	l1sap.u.info.u.meas_ind.inv_rssi = (uint8_t) -trx_ul_meas_rssi(m);
 
 	return l1sap_up(trx, &l1sap);
 }
@@ -517,7 +528,8 @@ int bts_model_l1sap_down(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 					lchan->tch.amr_mr.mode[2].mode,
 					lchan->tch.amr_mr.mode[3].mode,
 					amr_get_initial_mode(lchan),
-					(lchan->ho.active == HANDOVER_ENABLED));
+					(lchan->ho.active == HANDOVER_ENABLED),
+					rsl_lchan_dtx(lchan));
 				/* init lapdm */
 				lchan_init_lapdm(lchan);
 				/* set lchan active */
@@ -545,7 +557,7 @@ int bts_model_l1sap_down(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 					lchan->tch.amr_mr.mode[2].mode,
 					lchan->tch.amr_mr.mode[3].mode,
 					amr_get_initial_mode(lchan),
-					0);
+					0, rsl_lchan_dtx(lchan));
 				break;
 			}
 			if ((chan_nr & 0x80)) {
@@ -583,7 +595,7 @@ int bts_model_l1sap_down(struct gsm_bts_trx *trx, struct osmo_phsap_prim *l1sap)
 
 done:
 	if (msg)
-		msgb_free(msg);
+		bts_msgb_free(msg);
 	return rc;
 }
 
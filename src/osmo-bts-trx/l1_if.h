@@ -1,6 +1,8 @@
 #ifndef L1_IF_H_TRX
 #define L1_IF_H_TRX
 
+#include <string.h>
+
 /* These types define the different channels on a multiframe.
  * Each channel has queues and can be activated individually.
  */
@@ -46,26 +48,106 @@ enum trx_chan_type {
 	_TRX_CHAN_MAX
 };
 
-/* States each channel on a multiframe */
+struct trx_l1h;
+
+typedef int trx_sched_rts_func(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
+	enum trx_chan_type chan);
+typedef ubit_t *trx_sched_dl_func(struct trx_l1h *l1h, uint8_t tn,
+	uint32_t fn, enum trx_chan_type chan, uint8_t bid);
+typedef int trx_sched_ul_func(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
+	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
+	int16_t toa256);
+
+/* What to do at one frame of a multiframe. The functions are NULL, if
+ * nothing is to be done, because the channel is inactive or has no
+ * handler. */
+struct trx_sched_op {
+	trx_sched_rts_func	*rts_fn;	/* only set at bid 0 */
+	trx_sched_dl_func	*dl_fn;
+	trx_sched_ul_func	*ul_fn;
+	uint8_t			dl_chan;
+	uint8_t			dl_bid;
+	uint8_t			ul_chan;
+	uint8_t			ul_bid;
+};
+
+/* longest multiframe period */
+#define TRX_SCHED_PERIOD_MAX	104
+
+/* Quality of the bursts of one uplink block. All values are integer, so
+ * they are summed up per burst and only divided once per block. */
+struct trx_ul_meas {
+	uint8_t			num;		/* number of received bursts */
+	int8_t			rssi_min;	/* lowest RSSI value (dBm) */
+	int16_t			rssi_sum;	/* sum of RSSI values (dBm) */
+	int32_t			toa256_sum;	/* sum of TOA (1/256 symbol) */
+	uint16_t		ber_errors;	/* bit errors of decoded block */
+	uint16_t		ber_bits;	/* bits checked of decoded block */
+};
+
+static inline void trx_ul_meas_reset(struct trx_ul_meas *m)
+{
+	memset(m, 0, sizeof(*m));
+}
+
+static inline void trx_ul_meas_burst(struct trx_ul_meas *m, int8_t rssi,
+	int16_t toa256)
+{
+	/* ignore inserted dummy bursts of lost frames */
+	if (rssi < -127)
+		return;
+	if (!m->num || rssi < m->rssi_min)
+		m->rssi_min = rssi;
+	m->rssi_sum += rssi;
+	m->toa256_sum += toa256;
+	m->num++;
+}
+
+static inline void trx_ul_meas_ber(struct trx_ul_meas *m, int n_errors,
+	int n_bits_total)
+{
+	m->ber_errors = n_errors;
+	m->ber_bits = n_bits_total;
+}
+
+static inline int8_t trx_ul_meas_rssi(const struct trx_ul_meas *m)
+{
+	return m->num ? m->rssi_sum / m->num : -128;
+}
+
+static inline int16_t trx_ul_meas_toa256(const struct trx_ul_meas *m)
+{
+	return m->num ? m->toa256_sum / m->num : 0;
+}
+
+static inline uint16_t trx_ul_meas_ber10k(const struct trx_ul_meas *m)
+{
+	return m->ber_bits ? (uint32_t) m->ber_errors * 10000 / m->ber_bits
+			   : 0;
+}
+
+/* States each channel on a multiframe
+ * The fields that are used for every burst come first, so that the burst
+ * processing only touches the first cache line of a channel state. */
 struct trx_chan_state {
 	/* scheduler */
 	uint8_t			active;		/* Channel is active */
+	uint8_t			ul_mask;	/* mask of received bursts */
+	uint8_t			ul_erased;	/* mask of lost bursts */
+	uint8_t			lost;		/* (SACCH) loss detection */
+	uint8_t			ho_rach_detect;	/* if rach detection is on */
+	uint8_t			ul_encr_algo;	/* A5/x encry algo uplink */
+	uint8_t			dl_encr_algo;	/* A5/x encry algo downlink */
+	uint8_t			rsl_cmode, tch_mode; /* mode for TCH channels */
+	uint32_t		ul_first_fn;	/* fn of first burst */
 	ubit_t			*dl_bursts;	/* burst buffer for TX */
 	sbit_t			*ul_bursts;	/* burst buffer for RX */
-	uint32_t		ul_first_fn;	/* fn of first burst */
-	uint8_t			ul_mask;	/* mask of received bursts */
-
-	/* RSSI / TOA */
-	uint8_t			rssi_num;	/* number of RSSI values */
-	float			rssi_sum;	/* sum of RSSI values */
-	uint8_t			toa_num;	/* number of TOA values */
-	float			toa_sum;	/* sum of TOA values */
 
-	/* loss detection */
-	uint8_t			lost;		/* (SACCH) loss detection */
+	/* RSSI / TOA / BER of the current block */
+	struct trx_ul_meas	ul_meas;
 
-	/* mode */
-	uint8_t			rsl_cmode, tch_mode; /* mode for TCH channels */
+	/* number of lost bursts since activation */
+	uint32_t		ul_erased_num;
 
 	/* AMR */
 	uint8_t			codec[4];	/* 4 possible codecs for amr */
@@ -82,9 +164,16 @@ struct trx_chan_state {
 	uint8_t			dl_ongoing_facch; /* FACCH/H on downlink */
 	uint8_t			ul_ongoing_facch; /* FACCH/H on uplink */
 
+	/* DTX */
+	uint8_t			dtx;		/* enabled by BSC, RSL_CMOD_DTX* */
+	uint8_t			ul_dtx;		/* MS is silent since SID */
+	uint8_t			dl_dtx;		/* RTP is silent since SID */
+	uint8_t			dl_tx_blocks;	/* blocks of the interleaver
+						 * still to be transmitted */
+	uint8_t			dl_mute;	/* current block is muted */
+	uint8_t			dl_sid[33];	/* last SID frame from RTP */
+
 	/* encryption */
-	int			ul_encr_algo;	/* A5/x encry algo downlink */
-	int			dl_encr_algo;	/* A5/x encry algo uplink */
 	int			ul_encr_key_len;
 	int			dl_encr_key_len;
 	uint8_t			ul_encr_key[8];
@@ -93,16 +182,13 @@ struct trx_chan_state {
 	/* measurements */
 	struct {
 		uint8_t		clock;		/* cyclic clock counter */
-		int8_t		rssi[32];	/* last RSSI values */
 		int		rssi_count;	/* received RSSI values */
-		int		rssi_valid_count; /* number of stored value */
+		int		rssi_valid_count; /* number of valid values */
+		int8_t		rssi_min;	/* lowest valid RSSI value */
 		int		rssi_got_burst; /* any burst received so far */
-		float		toa_sum;	/* sum of TOA values */
+		int32_t		toa256_sum;	/* sum of TOA values */
 		int		toa_num;	/* number of TOA value */
 	} meas;
-
-	/* handover */
-	uint8_t			ho_rach_detect;	/* if rach detection is on */
 };
 
 struct trx_config {
@@ -141,6 +227,27 @@ struct trx_config {
 	int			slottype_sent[8];
 };
 
+/* uplink TCH blocks by their class */
+struct trx_tch_ul_stats {
+	uint32_t		speech;		/* decoded speech frames */
+	uint32_t		facch;		/* decoded FACCH frames */
+	uint32_t		idle;		/* not decoded, below idle level */
+	uint32_t		idle_weak;	/* of these above half the level */
+	uint32_t		bad;		/* decoding failed */
+	uint32_t		sid;		/* SID frames of decoded speech */
+	uint32_t		suppressed;	/* not sent via RTP (DTX) */
+};
+
+/* access bursts by the result of their detection */
+struct trx_rach_stats {
+	uint32_t		bursts;		/* received access bursts */
+	uint32_t		accepted;	/* forwarded to upper layers */
+	uint32_t		ext;		/* decoded as 11 bit burst */
+	uint32_t		bad;		/* parity not of our BSIC */
+	uint32_t		quality;	/* below quality thresholds */
+	uint32_t		ho_ref;		/* wrong handover reference */
+};
+
 struct trx_l1h {
 	struct llist_head	trx_ctrl_list;
 
@@ -157,10 +264,20 @@ struct trx_l1h {
 	uint32_t		mf_last_fn[8];	/* last received frame */
 	uint8_t			mf_period[8];	/* period of multiframe */
 	struct trx_sched_frame	*mf_frames[8];	/* pointer to frame layout */
+	/* dispatch table of each TS, compiled from the multiframe and the
+	 * active channels whenever one of them changes */
+	struct trx_sched_op	mf_ops[8][TRX_SCHED_PERIOD_MAX];
 
 	/* Channel states for all channels on all timeslots */
+	uint64_t		active_mask[8];	/* active (and auto active)
+						 * channels of each TS */
 	struct trx_chan_state	chan_states[8][_TRX_CHAN_MAX];
+	void			*burst_pool;	/* pool for burst buffers */
 	struct llist_head	dl_prims[8];	/* Queue primitves for TX */
+	uint32_t		ul_erased_num;	/* number of lost bursts */
+	struct trx_tch_ul_stats	tch_ul_stats;
+	uint32_t		tch_dl_muted;	/* blocks not sent (DTX) */
+	struct trx_rach_stats	rach_stats;
 	uint8_t			ho_rach_detect[8][8];
 };
 
@@ -171,7 +288,7 @@ int check_transceiver_availability(struct gsm_bts *bts, int avail);
 int l1if_provision_transceiver_trx(struct trx_l1h *l1h);
 int l1if_provision_transceiver(struct gsm_bts *bts);
 int l1if_mph_time_ind(struct gsm_bts *bts, uint32_t fn);
-int l1if_process_meas_res(struct gsm_bts_trx *trx, uint8_t chan_nr, float qta,
-        float ber, float rssi);
+int l1if_process_meas_res(struct gsm_bts_trx *trx, uint8_t chan_nr,
+	const struct trx_ul_meas *m);
 
 #endif /* L1_IF_H_TRX */
@@ -91,15 +91,17 @@ static int ms_power_diff(struct trx_l1h *l1h, struct gsm_lchan *lchan,
 }
 
 static int ms_power_val(struct trx_l1h *l1h, struct gsm_lchan *lchan,
-	uint8_t chan_nr, struct trx_chan_state *chan_state, int8_t rssi)
+	uint8_t chan_nr, struct trx_chan_state *chan_state,
+	const struct trx_ul_meas *m)
 {
 	/* ignore inserted dummy frames, treat as lost frames */
-	if (rssi < -127)
+	if (!m->num)
 		return 0;
 
-	LOGP(DLOOP, LOGL_DEBUG, "Got RSSI value of %d\n", rssi);
+	LOGP_HOT(DLOOP, LOGL_DEBUG, "Got lowest RSSI value of %d\n",
+		m->rssi_min);
 
-	chan_state->meas.rssi_count++;
+	chan_state->meas.rssi_count += m->num;
 
 	/* check if the current L1 header compares to the current ordered TA */
 //	if ((lchan->meas.l1_info[0] >> 3) != lchan->ms_power)
@@ -107,12 +109,11 @@ static int ms_power_val(struct trx_l1h *l1h, struct gsm_lchan *lchan,
 
 	chan_state->meas.rssi_got_burst = 1;
 
-	/* store and process RSSI */
-	if (chan_state->meas.rssi_valid_count
-					== ARRAY_SIZE(chan_state->meas.rssi))
-		return 0;
-	chan_state->meas.rssi[chan_state->meas.rssi_valid_count++] = rssi;
-	chan_state->meas.rssi_valid_count++;
+	/* keep the lowest RSSI value */
+	if (!chan_state->meas.rssi_valid_count
+	 || m->rssi_min < chan_state->meas.rssi_min)
+		chan_state->meas.rssi_min = m->rssi_min;
+	chan_state->meas.rssi_valid_count += m->num;
 
 	return 0;
 }
@@ -121,7 +122,6 @@ static int ms_power_clock(struct trx_l1h *l1h, struct gsm_lchan *lchan,
 	uint8_t chan_nr, struct trx_chan_state *chan_state)
 {
 	int rssi;
-	int i;
 
 	/* skip every second clock, to prevent oscillating due to roundtrip
 	 * delay */
@@ -151,10 +151,7 @@ static int ms_power_clock(struct trx_l1h *l1h, struct gsm_lchan *lchan,
 	 * power level */
 	if (chan_state->meas.rssi_valid_count == 0)
 		return 0;
-	for (rssi = 999, i = 0; i < chan_state->meas.rssi_valid_count; i++) {
-		if (rssi > chan_state->meas.rssi[i])
-			rssi = chan_state->meas.rssi[i];
-	}
+	rssi = chan_state->meas.rssi_min;
 
 	/* reset valid counter */
 	chan_state->meas.rssi_valid_count = 0;
@@ -177,28 +174,33 @@ static int ms_power_clock(struct trx_l1h *l1h, struct gsm_lchan *lchan,
 int trx_ta_loop = 1;
 
 int ta_val(struct trx_l1h *l1h, struct gsm_lchan *lchan, uint8_t chan_nr,
-	struct trx_chan_state *chan_state, float toa)
+	struct trx_chan_state *chan_state, const struct trx_ul_meas *m)
 {
+	int toa256;
+	float toa;
+
 	/* check if the current L1 header acks to the current ordered TA */
 	if (lchan->meas.l1_info[1] != lchan->rqd_ta)
 		return 0;
 
 	/* sum measurement */
-	chan_state->meas.toa_sum += toa;
-	if (++(chan_state->meas.toa_num) < 16)
+	chan_state->meas.toa256_sum += m->toa256_sum;
+	chan_state->meas.toa_num += m->num;
+	if (chan_state->meas.toa_num < 16)
 		return 0;
 
 	/* complete set */
-	toa = chan_state->meas.toa_sum / chan_state->meas.toa_num;
+	toa256 = chan_state->meas.toa256_sum / chan_state->meas.toa_num;
+	toa = toa256 / 256.0F;
 
-	/* check for change of TOA */
-	if (toa < -0.9F && lchan->rqd_ta > 0) {
+	/* check for change of TOA, 0.9 symbols are 230/256 */
+	if (toa256 < -230 && lchan->rqd_ta > 0) {
 		LOGP(DLOOP, LOGL_INFO, "TOA of trx=%u chan_nr=0x%02x is too "
 			"early (%.2f), now lowering TA from %d to %d\n",
 			l1h->trx->nr, chan_nr, toa, lchan->rqd_ta,
 			lchan->rqd_ta - 1);
 		lchan->rqd_ta--;
-	} else if (toa > 0.9F && lchan->rqd_ta < 63) {
+	} else if (toa256 > 230 && lchan->rqd_ta < 63) {
 		LOGP(DLOOP, LOGL_INFO, "TOA of trx=%u chan_nr=0x%02x is too "
 			"late (%.2f), now raising TA from %d to %d\n",
 			l1h->trx->nr, chan_nr, toa, lchan->rqd_ta,
@@ -210,22 +212,22 @@ int ta_val(struct trx_l1h *l1h, struct gsm_lchan *lchan, uint8_t chan_nr,
 			l1h->trx->nr, chan_nr, toa, lchan->rqd_ta);
 
 	chan_state->meas.toa_num = 0;
-	chan_state->meas.toa_sum = 0;
+	chan_state->meas.toa256_sum = 0;
 
 	return 0;
 }
 
 int trx_loop_sacch_input(struct trx_l1h *l1h, uint8_t chan_nr,
-	struct trx_chan_state *chan_state, int8_t rssi, float toa)
+	struct trx_chan_state *chan_state, const struct trx_ul_meas *m)
 {
 	struct gsm_lchan *lchan = &l1h->trx->ts[L1SAP_CHAN2TS(chan_nr)]
 					.lchan[l1sap_chan2ss(chan_nr)];
 
 	if (trx_ms_power_loop)
-		ms_power_val(l1h, lchan, chan_nr, chan_state, rssi);
+		ms_power_val(l1h, lchan, chan_nr, chan_state, m);
 
 	if (trx_ta_loop)
-		ta_val(l1h, lchan, chan_nr, chan_state, toa);
+		ta_val(l1h, lchan, chan_nr, chan_state, m);
 
 	return 0;
 }
@@ -18,7 +18,7 @@ extern int8_t trx_target_rssi;
 extern int trx_ta_loop;
 
 int trx_loop_sacch_input(struct trx_l1h *l1h, uint8_t chan_nr,
-	struct trx_chan_state *chan_state, int8_t rssi, float toa);
+	struct trx_chan_state *chan_state, const struct trx_ul_meas *m);
 
 int trx_loop_sacch_clock(struct trx_l1h *l1h, uint8_t chan_nr,
         struct trx_chan_state *chan_state);
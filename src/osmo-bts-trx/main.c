@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <string.h>
 #include <getopt.h>
 #include <limits.h>
 #include <sched.h>
@@ -56,6 +57,7 @@
 #include "l1_if.h"
 #include "trx_if.h"
 #include "scheduler.h"
+#include "trx_trace.h"
 
 const int pcu_direct = 0;
 
@@ -65,6 +67,7 @@ static int daemonize = 0;
 static char *gsmtap_ip = 0;
 static int rt_prio = -1;
 static int trx_num = 1;
+static const char *trace_file = NULL;
 char *software_version = "0.0";
 uint8_t abis_mac[6] = { 0, 1, 2, 3, 4, 5 };
 char *bsc_host = "localhost";
@@ -174,6 +177,7 @@ static void print_help()
 		"  -i	--gsmtap-ip	The destination IP used for GSMTAP.\n"
 		"  -r	--realtime PRIO	Set realtime scheduler with given prio\n"
 		"  -I	--local-trx-ip	Local IP for transceiver to connect (default=%s)\n"
+		"  -R	--trace FILE	Record a burst trace of the transceiver interface\n"
 		,trx_num, transceiver_ip);
 }
 
@@ -196,10 +200,11 @@ static void handle_options(int argc, char **argv)
 			{ "gsmtap-ip", 1, 0, 'i' },
 			{ "realtime", 1, 0, 'r' },
 			{ "local-trx-ip", 1, 0, 'I' },
+			{ "trace", 1, 0, 'R' },
 			{ 0, 0, 0, 0 }
 		};
 
-		c = getopt_long(argc, argv, "hc:d:Dc:sTVe:t:i:r:I:",
+		c = getopt_long(argc, argv, "hc:d:Dc:sTVe:t:i:r:I:R:",
 				long_options, &option_idx);
 		if (c == -1)
 			break;
@@ -245,6 +250,9 @@ static void handle_options(int argc, char **argv)
 		case 'I':
 			transceiver_ip = strdup(optarg);
 			break;
+		case 'R':
+			trace_file = optarg;
+			break;
 		default:
 			break;
 		}
@@ -351,9 +359,23 @@ int main(int argc, char **argv)
 			config_file);
 		exit(1);
 	}
+	/* command line and config file may have changed the log levels */
+	bts_log_cache_update();
 	if (!settsc_enabled && !setbsic_enabled)
 		settsc_enabled = setbsic_enabled = 1;
 
+	if (trace_file) {
+		rc = trx_trace_open(bts, trace_file);
+		if (rc < 0) {
+			fprintf(stderr, "Cannot record trace to '%s': %s\n",
+				trace_file, strerror(-rc));
+			exit(1);
+		}
+		/* a trace that is not closed is readable, but as large as
+		 * the chunks allocated for it */
+		atexit(trx_trace_close);
+	}
+
 	write_pid_file("osmo-bts");
 
 	rc = telnet_init(tall_bts_ctx, NULL, 4241);
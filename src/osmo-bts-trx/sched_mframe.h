@@ -0,0 +1,28 @@
+#ifndef TRX_SCHED_MFRAME_H
+#define TRX_SCHED_MFRAME_H
+
+/* The multiframe structures are shared by the scheduler and the virtual
+ * transceiver, which needs to know the uplink channels of each frame. */
+
+/* frame structures */
+struct trx_sched_frame {
+	enum trx_chan_type		dl_chan;
+	uint8_t				dl_bid;
+	enum trx_chan_type		ul_chan;
+	uint8_t				ul_bid;
+};
+
+/* multiframe structure */
+struct trx_sched_multiframe {
+	enum gsm_phys_chan_config	pchan;
+	uint8_t				slotmask;
+	uint8_t				period;
+	struct trx_sched_frame		*frames;
+	const char 			*name;
+};
+
+/* all multiframes, the first one is GSM_PCHAN_NONE */
+extern struct trx_sched_multiframe trx_sched_multiframes[];
+extern const int trx_sched_multiframes_num;
+
+#endif /* TRX_SCHED_MFRAME_H */
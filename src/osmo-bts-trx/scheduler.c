@@ -26,7 +26,9 @@
 
 #include <osmocom/core/msgb.h>
 #include <osmocom/core/talloc.h>
+#include <osmocom/core/utils.h>
 #include <osmocom/core/bits.h>
+#include <osmocom/core/gsmtap.h>
 #include <osmocom/gsm/a5.h>
 
 #include <osmo-bts/gsm_data.h>
@@ -34,11 +36,15 @@
 #include <osmo-bts/rsl.h>
 #include <osmo-bts/l1sap.h>
 #include <osmo-bts/amr.h>
+#include <osmo-bts/gsmtap_export.h>
+#include <osmo-bts/msgb_pool.h>
 
 #include "l1_if.h"
 #include "scheduler.h"
+#include "sched_mframe.h"
 #include "gsm0503_coding.h"
 #include "trx_if.h"
+#include "trx_trace.h"
 #include "loops.h"
 #include "amr.h"
 #include "loops.h"
@@ -64,13 +70,15 @@ uint32_t trx_clock_advance = 20;
 /* advance RTS to give some time for data processing. (especially PCU) */
 uint32_t trx_rts_advance = 5; /* about 20ms */
 
-typedef int trx_sched_rts_func(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
-	enum trx_chan_type chan);
-typedef ubit_t *trx_sched_dl_func(struct trx_l1h *l1h, uint8_t tn,
-	uint32_t fn, enum trx_chan_type chan, uint8_t bid);
-typedef int trx_sched_ul_func(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
-	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+/* thresholds for access bursts, to keep the noise that passes the parity
+ * check away from the upper layers during RACH floods */
+int trx_rach_ext = 0;		/* detect 11 bit access bursts */
+int trx_rach_max_errors = -1;	/* of 36 coded bits, -1 = no limit */
+int trx_rach_min_corr = -1000;	/* correlation with the code word */
+
+/* uplink speech blocks with a lower mean soft bit magnitude are not
+ * decoded, if the BSC enabled uplink DTX, 0 decodes all blocks */
+int trx_tch_idle_level = 0;
 
 static int rts_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan);
@@ -94,19 +102,19 @@ static ubit_t *tx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid);
 static int rx_rach_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+	int16_t toa256);
 static int rx_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+	int16_t toa256);
 static int rx_pdtch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+	int16_t toa256);
 static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+	int16_t toa256);
 static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa);
+	int16_t toa256);
 
 static ubit_t dummy_burst[148] = {
 	0,0,0,
@@ -199,6 +207,25 @@ struct trx_chan_desc trx_chan_desc[_TRX_CHAN_MAX] = {
 };
 
 
+/* the active channels of a TS are kept as bit mask in l1h->active_mask */
+osmo_static_assert(_TRX_CHAN_MAX <= 64, trx_chan_fits_active_mask);
+
+#define CHAN_IS_ACTIVE(l1h, tn, chan) \
+	((l1h)->active_mask[tn] & (1ULL << (chan)))
+
+/* Size of the burst buffer pool of each TRX, it is enough for all channels
+ * of the largest configuration (8 x SDCCH/8). If the pool is exhausted,
+ * talloc falls back to allocate from the heap. */
+#define TRX_BURST_POOL_SIZE	(8 * 16 * 2 * 464)
+
+/* burst buffers are taken from the pool of the TRX, so that they are close
+ * to each other, instead of being scattered over the heap */
+static void *burst_alloc(struct trx_l1h *l1h, size_t size)
+{
+	return talloc_zero_size(l1h->burst_pool ? : tall_bts_ctx, size);
+}
+
+
 /*
  * init / exit
  */
@@ -208,9 +235,18 @@ int trx_sched_init(struct trx_l1h *l1h)
 	uint8_t tn;
 	int i;
 	struct trx_chan_state *chan_state;
+	uint64_t auto_mask = 0;
 
 	LOGP(DL1C, LOGL_NOTICE, "Init scheduler for trx=%u\n", l1h->trx->nr);
 
+	if (!l1h->burst_pool)
+		l1h->burst_pool = talloc_pool(l1h, TRX_BURST_POOL_SIZE);
+
+	for (i = 0; i < _TRX_CHAN_MAX; i++) {
+		if (trx_chan_desc[i].auto_active)
+			auto_mask |= 1ULL << i;
+	}
+
 	/* hack to get bts */
 	bts = l1h->trx->bts;
 
@@ -218,6 +254,8 @@ int trx_sched_init(struct trx_l1h *l1h)
 		l1h->mf_index[tn] = 0;
 		l1h->mf_last_fn[tn] = 0;
 		INIT_LLIST_HEAD(&l1h->dl_prims[tn]);
+		l1h->active_mask[tn] = auto_mask;
+		memset(l1h->mf_ops[tn], 0, sizeof(l1h->mf_ops[tn]));
 		for (i = 0; i < _TRX_CHAN_MAX; i++) {
 			chan_state = &l1h->chan_states[tn][i];
 			chan_state->active = 0;
@@ -257,10 +295,82 @@ void trx_sched_exit(struct trx_l1h *l1h)
 /* close all logical channels and reset timeslots */
 void trx_sched_reset(struct trx_l1h *l1h)
 {
+	trx_trace(TRX_TRACE_RESET, l1h->trx->nr, NULL, 0);
+
 	trx_sched_exit(l1h);
 	trx_sched_init(l1h);
 }
 
+/* write the current state to the trace, as the calls that would set it up
+ * from scratch.  The AMR loop and the measurements of active channels start
+ * from their initial values, when the trace is replayed. */
+void trx_sched_trace_state(struct trx_l1h *l1h)
+{
+	struct trx_chan_state *chan_state;
+	uint8_t nr = l1h->trx->nr;
+	uint8_t tn;
+	int i;
+
+	trx_trace_config(l1h);
+
+	for (tn = 0; tn < 8; tn++) {
+		struct trx_trace_pchan tp;
+
+		if (!l1h->mf_index[tn])
+			continue;
+		tp.tn = tn;
+		tp.pchan = trx_sched_multiframes[l1h->mf_index[tn]].pchan;
+		trx_trace_write(TRX_TRACE_PCHAN, nr, &tp, sizeof(tp));
+
+		for (i = 0; i < _TRX_CHAN_MAX; i++) {
+			struct trx_trace_lchan tl;
+			struct trx_trace_mode tm;
+			uint8_t buf[sizeof(struct trx_trace_cipher) + 8];
+			struct trx_trace_cipher *tc =
+				(struct trx_trace_cipher *) buf;
+
+			chan_state = &l1h->chan_states[tn][i];
+			if (!chan_state->active || trx_chan_desc[i].auto_active)
+				continue;
+			tl.chan_nr = trx_chan_desc[i].chan_nr | tn;
+			tl.link_id = trx_chan_desc[i].link_id;
+			tl.active = 1;
+			trx_trace_write(TRX_TRACE_LCHAN, nr, &tl, sizeof(tl));
+
+			/* mode and cipher are set via the dedicated channel */
+			if (tl.link_id)
+				continue;
+			tm.chan_nr = tl.chan_nr;
+			tm.rsl_cmode = chan_state->rsl_cmode;
+			tm.tch_mode = chan_state->tch_mode;
+			tm.codecs = chan_state->codecs;
+			memcpy(tm.codec, chan_state->codec, 4);
+			tm.initial_id = chan_state->ul_ft;
+			tm.handover = chan_state->ho_rach_detect;
+			tm.dtx = chan_state->dtx;
+			trx_trace_write(TRX_TRACE_MODE, nr, &tm, sizeof(tm));
+
+			tc->chan_nr = tl.chan_nr;
+			if (chan_state->ul_encr_algo) {
+				tc->downlink = 0;
+				tc->algo = chan_state->ul_encr_algo;
+				tc->key_len = chan_state->ul_encr_key_len;
+				memcpy(tc->key, chan_state->ul_encr_key, 8);
+				trx_trace_write(TRX_TRACE_CIPHER, nr, buf,
+					sizeof(*tc) + tc->key_len);
+			}
+			if (chan_state->dl_encr_algo) {
+				tc->downlink = 1;
+				tc->algo = chan_state->dl_encr_algo;
+				tc->key_len = chan_state->dl_encr_key_len;
+				memcpy(tc->key, chan_state->dl_encr_key, 8);
+				trx_trace_write(TRX_TRACE_CIPHER, nr, buf,
+					sizeof(*tc) + tc->key_len);
+			}
+		}
+	}
+}
+
 
 /*
  * data request (from upper layer)
@@ -279,7 +389,7 @@ int trx_sched_ph_data_req(struct trx_l1h *l1h, struct osmo_phsap_prim *l1sap)
 
 	/* ignore empty frame */
 	if (!msgb_l2len(l1sap->oph.msg)) {
-		msgb_free(l1sap->oph.msg);
+		bts_msgb_free(l1sap->oph.msg);
 		return 0;
 	}
 
@@ -301,7 +411,7 @@ int trx_sched_tch_req(struct trx_l1h *l1h, struct osmo_phsap_prim *l1sap)
 
 	/* ignore empty frame */
 	if (!msgb_l2len(l1sap->oph.msg)) {
-		msgb_free(l1sap->oph.msg);
+		bts_msgb_free(l1sap->oph.msg);
 		return 0;
 	}
 
@@ -437,7 +547,7 @@ static int rts_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 static ubit_t *tx_idle_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid)
 {
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr);
 
 	return NULL;
@@ -446,7 +556,7 @@ static ubit_t *tx_idle_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 static ubit_t *tx_fcch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid)
 {
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr);
 
 	return fcch_burst;
@@ -460,7 +570,7 @@ static ubit_t *tx_sch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	struct	gsm_time t;
 	uint8_t t3p, bsic;
 	
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr);
 
 	/* create SB info from GSM time and BSIC */
@@ -510,7 +620,7 @@ wrong_type:
 free_msg:
 			/* unlink and free message */
 			llist_del(&msg->list);
-			msgb_free(msg);
+			bts_msgb_free(msg);
 			return NULL;
 		}
 		switch (l1sap->oph.primitive) {
@@ -534,7 +644,7 @@ free_msg:
 				fn);
 			/* unlink and free message */
 			llist_del(&msg->list);
-			msgb_free(msg);
+			bts_msgb_free(msg);
 			continue;
 		}
 		if (prim_fn > 0)
@@ -562,8 +672,8 @@ found_msg:
 }
 
 static int compose_ph_data_ind(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
-	enum trx_chan_type chan, uint8_t *l2, uint8_t l2_len, float toa,
-	float ber, float rssi)
+	enum trx_chan_type chan, uint8_t *l2, uint8_t l2_len,
+	const struct trx_ul_meas *m)
 {
 	struct msgb *msg;
 	struct osmo_phsap_prim *l1sap;
@@ -577,7 +687,7 @@ static int compose_ph_data_ind(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	l1sap->u.data.chan_nr = chan_nr;
 	l1sap->u.data.link_id = trx_chan_desc[chan].link_id;
 	l1sap->u.data.fn = fn;
-	l1sap->u.data.rssi = (int8_t) (rssi);
+	l1sap->u.data.rssi = trx_ul_meas_rssi(m);
 	msg->l2h = msgb_put(msg, l2_len);
 	if (l2_len)
 		memcpy(msg->l2h, l2, l2_len);
@@ -590,9 +700,7 @@ static int compose_ph_data_ind(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 
 	/* process measurement */
 	if (L1SAP_IS_LINK_SACCH(trx_chan_desc[chan].link_id))
-		l1if_process_meas_res(l1h->trx, chan_nr,
-			(l1h->trx->ts[tn].lchan[l1sap_chan2ss(chan_nr)].rqd_ta + toa) * 4,
-			ber, rssi);
+		l1if_process_meas_res(l1h->trx, chan_nr, m);
 
 	return 0;
 }
@@ -660,7 +768,7 @@ got_msg:
 		LOGP(DL1C, LOGL_FATAL, "Prim not 23 bytes, please FIX! "
 			"(len=%d)\n", msgb_l2len(msg));
 		/* free message */
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		goto no_msg;
 	}
 
@@ -674,7 +782,7 @@ got_msg:
 
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 464);
+		*bursts_p = burst_alloc(l1h, 464);
 		if (!*bursts_p)
 			return NULL;
 	}
@@ -683,7 +791,7 @@ got_msg:
 	xcch_encode(*bursts_p, msg->l2h);
 
 	/* free message */
-	msgb_free(msg);
+	bts_msgb_free(msg);
 
 send_burst:
 	/* compose burst */
@@ -694,7 +802,7 @@ send_burst:
 	memcpy(bits + 87, burst + 58, 58);
 	memset(bits + 145, 0, 3);
 
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	return bits;
@@ -735,7 +843,7 @@ no_msg:
 got_msg:
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 464);
+		*bursts_p = burst_alloc(l1h, 464);
 		if (!*bursts_p)
 			return NULL;
 	}
@@ -748,12 +856,12 @@ got_msg:
 		LOGP(DL1C, LOGL_FATAL, "Prim invalid length, please FIX! "
 			"(len=%d)\n", rc);
 		/* free message */
-		msgb_free(msg);
+		bts_msgb_free(msg);
 		goto no_msg;
 	}
 
 	/* free message */
-	msgb_free(msg);
+	bts_msgb_free(msg);
 
 send_burst:
 	/* compose burst */
@@ -764,7 +872,7 @@ send_burst:
 	memcpy(bits + 87, burst + 58, 58);
 	memset(bits + 145, 0, 3);
 
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	return bits;
@@ -838,7 +946,7 @@ inval_mode1:
 				if (l1sap->oph.primitive == PRIM_TCH) {
 					LOGP(DL1C, LOGL_FATAL, "TCH twice, "
 						"please FIX! ");
-					msgb_free(msg2);
+					bts_msgb_free(msg2);
 				} else
 					msg_facch = msg2;
 			}
@@ -849,7 +957,7 @@ inval_mode1:
 				if (l1sap->oph.primitive != PRIM_TCH) {
 					LOGP(DL1C, LOGL_FATAL, "FACCH twice, "
 						"please FIX! ");
-					msgb_free(msg2);
+					bts_msgb_free(msg2);
 				} else
 					msg_tch = msg2;
 			}
@@ -867,7 +975,7 @@ inval_mode1:
 		LOGP(DL1C, LOGL_FATAL, "Prim not 23 bytes, please FIX! "
 			"(len=%d)\n", msgb_l2len(msg_facch));
 		/* free message */
-		msgb_free(msg_facch);
+		bts_msgb_free(msg_facch);
 		msg_facch = NULL;
 	}
 
@@ -986,7 +1094,7 @@ inval_mode2:
 				len, msgb_l2len(msg_tch));
 free_bad_msg:
 			/* free message */
-			msgb_free(msg_tch);
+			bts_msgb_free(msg_tch);
 			msg_tch = NULL;
 			goto send_frame;
 		}
@@ -1008,7 +1116,7 @@ static ubit_t *tx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 
 	/* send burst, if we already got a frame */
 	if (bid > 0) {
-		if (!*bursts_p)
+		if (!*bursts_p || chan_state->dl_mute)
 			return NULL;
 		goto send_burst;
 	}
@@ -1019,13 +1127,48 @@ static ubit_t *tx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	/* alloc burst memory, if not already,
 	 * otherwise shift buffer by 4 bursts for interleaving */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 928);
+		*bursts_p = burst_alloc(l1h, 928);
 		if (!*bursts_p)
 			return NULL;
 	} else {
 		memcpy(*bursts_p, *bursts_p + 464, 464);
 		memset(*bursts_p + 464, 0, 464);
 	}
+	chan_state->dl_mute = 0;
+	if (chan_state->dl_tx_blocks)
+		chan_state->dl_tx_blocks--;
+
+	/* downlink DTX (GSM 06.31): a SID frame from RTP starts a silence
+	 * period, which ends with the next speech frame. During silence,
+	 * the latest SID is only sent at the SID_UPDATE position, all
+	 * other blocks are not transmitted at all. Only FR is supported,
+	 * and only if the BSC enabled DTX in the downlink. */
+	if (msg_tch && !msg_facch && tch_mode == GSM48_CMODE_SPEECH_V1
+	 && (chan_state->dtx & RSL_CMOD_DTXd)) {
+		if (tch_fr_sid_errors(msg_tch->l2h) < 2) {
+			memcpy(chan_state->dl_sid, msg_tch->l2h, 33);
+			/* the first SID is sent at once */
+			if (chan_state->dl_dtx) {
+				bts_msgb_free(msg_tch);
+				msg_tch = NULL;
+			}
+			chan_state->dl_dtx = 1;
+		} else
+			chan_state->dl_dtx = 0;
+	}
+	if (!msg_tch && !msg_facch && chan_state->dl_dtx) {
+		if (fn % 104 == 52) {
+			tch_fr_encode(*bursts_p, chan_state->dl_sid, 33, 1);
+			chan_state->dl_tx_blocks = 2;
+			goto send_burst;
+		}
+		/* the second half of the last frame is still to be sent */
+		if (chan_state->dl_tx_blocks)
+			goto send_burst;
+		chan_state->dl_mute = 1;
+		l1h->tch_dl_muted++;
+		return NULL;
+	}
 
 	/* no message at all */
 	if (!msg_tch && !msg_facch) {
@@ -1050,12 +1193,13 @@ static ubit_t *tx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 			chan_state->dl_cmr);
 	else
 		tch_fr_encode(*bursts_p, msg_tch->l2h, msgb_l2len(msg_tch), 1);
+	chan_state->dl_tx_blocks = 2;
 
 	/* free message */
 	if (msg_tch)
-		msgb_free(msg_tch);
+		bts_msgb_free(msg_tch);
 	if (msg_facch)
-		msgb_free(msg_facch);
+		bts_msgb_free(msg_facch);
 
 send_burst:
 	/* compose burst */
@@ -1066,7 +1210,7 @@ send_burst:
 	memcpy(bits + 87, burst + 58, 58);
 	memset(bits + 145, 0, 3);
 
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	return bits;
@@ -1097,14 +1241,14 @@ static ubit_t *tx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		LOGP(DL1C, LOGL_ERROR, "%s Cannot transmit FACCH starting on "
 			"even frames, please fix RTS!\n",
 			trx_chan_desc[chan].name);
-		msgb_free(msg_facch);
+		bts_msgb_free(msg_facch);
 		msg_facch = NULL;
 	}
 
 	/* alloc burst memory, if not already,
 	 * otherwise shift buffer by 2 bursts for interleaving */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 696);
+		*bursts_p = burst_alloc(l1h, 696);
 		if (!*bursts_p)
 			return NULL;
 	} else {
@@ -1145,9 +1289,9 @@ static ubit_t *tx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 
 	/* free message */
 	if (msg_tch)
-		msgb_free(msg_tch);
+		bts_msgb_free(msg_tch);
 	if (msg_facch)
-		msgb_free(msg_facch);
+		bts_msgb_free(msg_facch);
 
 send_burst:
 	/* compose burst */
@@ -1158,7 +1302,7 @@ send_burst:
 	memcpy(bits + 87, burst + 58, 58);
 	memset(bits + 145, 0, 3);
 
-	LOGP(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Transmitting %s fn=%u ts=%u trx=%u burst=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	return bits;
@@ -1169,40 +1313,92 @@ send_burst:
  * RX on uplink (indication to upper layer)
  */
 
+/* decode an access burst once and match the result against every
+ * hypothesis: the BSIC of the cell as 8 and 11 bit burst and, on a channel
+ * in handover, the handover reference */
+static int rach_detect(struct trx_l1h *l1h, struct rach_dec *dec,
+	sbit_t *bits, struct gsm_lchan *lchan)
+{
+	struct trx_rach_stats *stats = &l1h->rach_stats;
+	uint8_t bsic = l1h->trx->bts->bsic;
+
+	stats->bursts++;
+
+	rach_decode_any(dec, bits, 0);
+	/* 11 bit bursts are EGPRS packet channel requests on the CCCH */
+	if (dec->bsic != bsic && trx_rach_ext && !lchan)
+		rach_decode_any(dec, bits, 1);
+	if (dec->bsic != bsic) {
+		stats->bad++;
+		return -EINVAL;
+	}
+
+	if ((trx_rach_max_errors >= 0 && dec->n_errors > trx_rach_max_errors)
+	 || dec->corr < trx_rach_min_corr) {
+		stats->quality++;
+		return -EINVAL;
+	}
+
+	if (lchan && dec->ra != lchan->ho.ref) {
+		stats->ho_ref++;
+		return -EINVAL;
+	}
+
+	if (dec->ext)
+		stats->ext++;
+
+	return 0;
+}
+
 static int rx_rach_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa)
+	int16_t toa256)
 {
 	uint8_t chan_nr;
 	struct osmo_phsap_prim l1sap;
-	uint8_t ra;
+	struct gsm_lchan *lchan = NULL;
+	struct rach_dec dec;
 	int rc;
 
 	chan_nr = trx_chan_desc[chan].chan_nr | tn;
 
-	LOGP(DL1C, LOGL_NOTICE, "Received Access Burst on %s fn=%u toa=%.2f\n",
-		trx_chan_desc[chan].name, fn, toa);
+	/* access bursts on a dedicated channel are handover access */
+	if (chan != TRXC_RACH)
+		lchan = &l1h->trx->ts[tn].lchan[l1sap_chan2ss(chan_nr)];
 
 	/* decode */
-	rc = rach_decode(&ra, bits + 8 + 41, l1h->trx->bts->bsic);
+	rc = rach_detect(l1h, &dec, bits + 8 + 41, lchan);
 	if (rc) {
-		LOGP(DL1C, LOGL_NOTICE, "Received bad AB frame at fn=%u "
-			"(%u/51)\n", fn, fn % 51);
+		LOGP_HOT(DL1C, LOGL_NOTICE, "Received bad AB frame on %s at "
+			"fn=%u (%u/51) toa=%.2f rssi=%d errors=%d corr=%d\n",
+			trx_chan_desc[chan].name, fn, fn % 51, toa256 / 256.0F,
+			rssi, dec.n_errors, dec.corr);
 		return 0;
 	}
 
+	LOGP_HOT(DL1C, LOGL_NOTICE, "Received Access Burst on %s fn=%u "
+		"toa=%.2f rssi=%d ra=0x%02x errors=%d corr=%d\n",
+		trx_chan_desc[chan].name, fn, toa256 / 256.0F, rssi, dec.ra,
+		dec.n_errors, dec.corr);
+
+	/* L1SAP and the PCU interface only carry 8 bit RA */
+	if (dec.ext)
+		return 0;
+
+	l1h->rach_stats.accepted++;
+
 	/* compose primitive */
 	/* generate prim */
 	memset(&l1sap, 0, sizeof(l1sap));
 	osmo_prim_init(&l1sap.oph, SAP_GSM_PH, PRIM_PH_RACH, PRIM_OP_INDICATION,
 		NULL);
 	l1sap.u.rach_ind.chan_nr = chan_nr;
-	l1sap.u.rach_ind.ra = ra;
+	l1sap.u.rach_ind.ra = dec.ra;
 #ifdef TA_TEST
 #warning TIMING ADVANCE TEST-HACK IS ENABLED!!!
-	toa *= 10;
+	toa256 *= 10;
 #endif
-	l1sap.u.rach_ind.acc_delay = (toa >= 0) ? toa : 0;
+	l1sap.u.rach_ind.acc_delay = (toa256 >= 0) ? toa256 / 256 : 0;
 	l1sap.u.rach_ind.fn = fn;
 
 	/* forward primitive */
@@ -1213,29 +1409,28 @@ static int rx_rach_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 
 static int rx_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa)
+	int16_t toa256)
 {
 	struct trx_chan_state *chan_state = &l1h->chan_states[tn][chan];
 	sbit_t *burst, **bursts_p = &chan_state->ul_bursts;
 	uint32_t *first_fn = &chan_state->ul_first_fn;
 	uint8_t *mask = &chan_state->ul_mask;
-	float *rssi_sum = &chan_state->rssi_sum;
-	uint8_t *rssi_num = &chan_state->rssi_num;
-	float *toa_sum = &chan_state->toa_sum;
-	uint8_t *toa_num = &chan_state->toa_num;
+	uint8_t *erased = &chan_state->ul_erased;
+	struct trx_ul_meas *meas = &chan_state->ul_meas;
 	uint8_t l2[23], l2_len;
+	int n_errors = 0, n_bits_total = 0;
 	int rc;
 
 	/* handle rach, if handover rach detection is turned on */
 	if (chan_state->ho_rach_detect == 1)
-		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa);
+		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa256);
 
-	LOGP(DL1C, LOGL_DEBUG, "Data received %s fn=%u ts=%u trx=%u bid=%u\n",
+	LOGP_HOT(DL1C, LOGL_DEBUG, "Data received %s fn=%u ts=%u trx=%u bid=%u\n",
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 464);
+		*bursts_p = burst_alloc(l1h, 464);
 		if (!*bursts_p)
 			return -ENOMEM;
 	}
@@ -1245,34 +1440,35 @@ static int rx_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		memset(*bursts_p, 0, 464);
 		*mask = 0x0;
 		*first_fn = fn;
-		*rssi_sum = 0;
-		*rssi_num = 0;
-		*toa_sum = 0;
-		*toa_num = 0;
+		*erased = 0x0;
+		trx_ul_meas_reset(meas);
 	}
 
-	/* update mask + rssi */
+	/* update mask */
 	*mask |= (1 << bid);
-	*rssi_sum += rssi;
-	(*rssi_num)++;
-	*toa_sum += toa;
-	(*toa_num)++;
 
-	/* copy burst to buffer of 4 bursts */
-	burst = *bursts_p + bid * 116;
-	memcpy(burst, bits + 3, 58);
-	memcpy(burst + 58, bits + 87, 58);
+	/* a lost burst stays zeroed in the buffer (erasure) */
+	if (!bits) {
+		*erased |= (1 << bid);
+	} else {
+		trx_ul_meas_burst(meas, rssi, toa256);
 
-	/* send burst information to loops process */
-	if (L1SAP_IS_LINK_SACCH(trx_chan_desc[chan].link_id)) {
-		trx_loop_sacch_input(l1h, trx_chan_desc[chan].chan_nr | tn,
-			chan_state, rssi, toa);
+		/* copy burst to buffer of 4 bursts */
+		burst = *bursts_p + bid * 116;
+		memcpy(burst, bits + 3, 58);
+		memcpy(burst + 58, bits + 87, 58);
 	}
 
 	/* wait until complete set of bursts */
 	if (bid != 3)
 		return 0;
 
+	/* send block information to loops process */
+	if (L1SAP_IS_LINK_SACCH(trx_chan_desc[chan].link_id)) {
+		trx_loop_sacch_input(l1h, trx_chan_desc[chan].chan_nr | tn,
+			chan_state, meas);
+	}
+
 	/* check for complete set of bursts */
 	if ((*mask & 0xf) != 0xf) {
 		LOGP(DL1C, LOGL_NOTICE, "Received incomplete data frame at "
@@ -1288,8 +1484,12 @@ static int rx_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	}
 	*mask = 0x0;
 
-	/* decode */
-	rc = xcch_decode(l2, *bursts_p);
+	/* decode, unless all bursts are lost */
+	if ((*erased & 0xf) == 0xf)
+		rc = -1;
+	else
+		rc = xcch_decode(l2, *bursts_p, &n_errors, &n_bits_total);
+	trx_ul_meas_ber(meas, n_errors, n_bits_total);
 	if (rc) {
 		LOGP(DL1C, LOGL_NOTICE, "Received bad data frame at fn=%u "
 			"(%u/%u) for %s\n", *first_fn,
@@ -1299,30 +1499,28 @@ static int rx_data_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	} else
 		l2_len = 23;
 
-	return compose_ph_data_ind(l1h, tn, *first_fn, chan, l2, l2_len,
-		*toa_sum / *toa_num, 0, *rssi_sum / *rssi_num);
+	return compose_ph_data_ind(l1h, tn, *first_fn, chan, l2, l2_len, meas);
 }
 
 static int rx_pdtch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa)
+	int16_t toa256)
 {
 	struct trx_chan_state *chan_state = &l1h->chan_states[tn][chan];
 	sbit_t *burst, **bursts_p = &chan_state->ul_bursts;
 	uint8_t *mask = &chan_state->ul_mask;
-	float *rssi_sum = &chan_state->rssi_sum;
-	uint8_t *rssi_num = &chan_state->rssi_num;
-	float *toa_sum = &chan_state->toa_sum;
-	uint8_t *toa_num = &chan_state->toa_num;
+	uint8_t *erased = &chan_state->ul_erased;
+	struct trx_ul_meas *meas = &chan_state->ul_meas;
 	uint8_t l2[54+1];
+	int n_errors = 0, n_bits_total = 0;
 	int rc;
 
-	LOGP(DL1C, LOGL_DEBUG, "PDTCH received %s fn=%u ts=%u trx=%u bid=%u\n", 
+	LOGP_HOT(DL1C, LOGL_DEBUG, "PDTCH received %s fn=%u ts=%u trx=%u bid=%u\n", 
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 464);
+		*bursts_p = burst_alloc(l1h, 464);
 		if (!*bursts_p)
 			return -ENOMEM;
 	}
@@ -1331,23 +1529,24 @@ static int rx_pdtch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	if (bid == 0) {
 		memset(*bursts_p, 0, 464);
 		*mask = 0x0;
-		*rssi_sum = 0;
-		*rssi_num = 0;
-		*toa_sum = 0;
-		*toa_num = 0;
+		*erased = 0x0;
+		trx_ul_meas_reset(meas);
 	}
 
-	/* update mask + rssi */
+	/* update mask */
 	*mask |= (1 << bid);
-	*rssi_sum += rssi;
-	(*rssi_num)++;
-	*toa_sum += toa;
-	(*toa_num)++;
 
-	/* copy burst to buffer of 4 bursts */
-	burst = *bursts_p + bid * 116;
-	memcpy(burst, bits + 3, 58);
-	memcpy(burst + 58, bits + 87, 58);
+	/* a lost burst stays zeroed in the buffer (erasure) */
+	if (!bits) {
+		*erased |= (1 << bid);
+	} else {
+		trx_ul_meas_burst(meas, rssi, toa256);
+
+		/* copy burst to buffer of 4 bursts */
+		burst = *bursts_p + bid * 116;
+		memcpy(burst, bits + 3, 58);
+		memcpy(burst + 58, bits + 87, 58);
+	}
 
 	/* wait until complete set of bursts */
 	if (bid != 3)
@@ -1362,8 +1561,13 @@ static int rx_pdtch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	}
 	*mask = 0x0;
 
-	/* decode */
-	rc = pdtch_decode(l2 + 1, *bursts_p, NULL);
+	/* decode, unless all bursts are lost */
+	if ((*erased & 0xf) == 0xf)
+		rc = -1;
+	else
+		rc = pdtch_decode(l2 + 1, *bursts_p, NULL, &n_errors,
+			&n_bits_total);
+	trx_ul_meas_ber(meas, n_errors, n_bits_total);
 	if (rc <= 0) {
 		LOGP(DL1C, LOGL_NOTICE, "Received bad PDTCH block ending at "
 			"fn=%u (%u/%u) for %s\n", fn, fn % l1h->mf_period[tn],
@@ -1374,32 +1578,79 @@ static int rx_pdtch_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	l2[0] = 7; /* valid frame */
 
 	return compose_ph_data_ind(l1h, tn, (fn + 2715648 - 3) % 2715648, chan,
-		l2, rc + 1, *toa_sum / *toa_num, 0, *rssi_sum / *rssi_num);
+		l2, rc + 1, meas);
+}
+
+/* track the DTX state of the MS with each decoded speech frame: a SID
+ * frame (GSM 06.31: less than 16 errors in the SID code word) starts a
+ * silence period, any other speech frame ends it. Without uplink DTX
+ * enabled by the BSC, the MS never has a silence period. */
+static void tch_ul_dtx_update(struct trx_l1h *l1h,
+	struct trx_chan_state *chan_state, const uint8_t *tch_data, int rc)
+{
+	if (chan_state->rsl_cmode != RSL_CMOD_SPD_SPEECH
+	 || !(chan_state->dtx & RSL_CMOD_DTXu) || rc < 4 || rc == 23)
+		return;
+
+	/* only FR SID frames are detected */
+	if (chan_state->tch_mode == GSM48_CMODE_SPEECH_V1 && rc == 33
+	 && tch_fr_sid_errors(tch_data) < 16) {
+		l1h->tch_ul_stats.sid++;
+		chan_state->ul_dtx = 1;
+		return;
+	}
+
+	chan_state->ul_dtx = 0;
+}
+
+/* the idle level applies to speech with uplink DTX only, so that no data
+ * or signalling block and no weak speech of a MS without DTX is lost */
+static int tch_ul_idle_level(struct trx_chan_state *chan_state)
+{
+	if (chan_state->rsl_cmode != RSL_CMOD_SPD_SPEECH
+	 || !(chan_state->dtx & RSL_CMOD_DTXu))
+		return 0;
+
+	return trx_tch_idle_level;
+}
+
+/* count a decoded uplink TCH block */
+static void tch_ul_count(struct trx_l1h *l1h, enum tch_ul_class cls, int rc)
+{
+	if (rc < 4)
+		l1h->tch_ul_stats.bad++;
+	else if (cls == TCH_UL_FACCH)
+		l1h->tch_ul_stats.facch++;
+	else
+		l1h->tch_ul_stats.speech++;
 }
 
 static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa)
+	int16_t toa256)
 {
 	struct trx_chan_state *chan_state = &l1h->chan_states[tn][chan];
 	sbit_t *burst, **bursts_p = &chan_state->ul_bursts;
 	uint8_t *mask = &chan_state->ul_mask;
+	uint8_t *erased = &chan_state->ul_erased;
+	struct trx_ul_meas *meas = &chan_state->ul_meas;
 	uint8_t rsl_cmode = chan_state->rsl_cmode;
 	uint8_t tch_mode = chan_state->tch_mode;
 	uint8_t tch_data[128]; /* just to be safe */
-	int rc, amr = 0;
-	float ber;
+	enum tch_ul_class cls = TCH_UL_SPEECH;
+	int n_errors = 0, n_bits_total = 0;
+	int rc, amr = 0, idle_level;
 
 	/* handle rach, if handover rach detection is turned on */
 	if (chan_state->ho_rach_detect == 1)
-		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa);
+		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa256);
 
-	LOGP(DL1C, LOGL_DEBUG, "TCH/F received %s fn=%u ts=%u trx=%u bid=%u\n", 
+	LOGP_HOT(DL1C, LOGL_DEBUG, "TCH/F received %s fn=%u ts=%u trx=%u bid=%u\n", 
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 928);
+		*bursts_p = burst_alloc(l1h, 928);
 		if (!*bursts_p)
 			return -ENOMEM;
 	}
@@ -1408,15 +1659,26 @@ static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	if (bid == 0) {
 		memset(*bursts_p + 464, 0, 464);
 		*mask = 0x0;
+		/* the upper 4 bits are the lost bursts of the previous
+		 * frame, which are still in the interleaving buffer */
+		*erased = (*erased << 4) & 0xf0;
+		trx_ul_meas_reset(meas);
 	}
 
 	/* update mask */
 	*mask |= (1 << bid);
 
-	/* copy burst to end of buffer of 8 bursts */
-	burst = *bursts_p + bid * 116 + 464;
-	memcpy(burst, bits + 3, 58);
-	memcpy(burst + 58, bits + 87, 58);
+	/* a lost burst stays zeroed in the buffer (erasure) */
+	if (!bits) {
+		*erased |= (1 << bid);
+	} else {
+		trx_ul_meas_burst(meas, rssi, toa256);
+
+		/* copy burst to end of buffer of 8 bursts */
+		burst = *bursts_p + bid * 116 + 464;
+		memcpy(burst, bits + 3, 58);
+		memcpy(burst + 58, bits + 87, 58);
+	}
 
 	/* wait until complete set of bursts */
 	if (bid != 3)
@@ -1431,15 +1693,36 @@ static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	}
 	*mask = 0x0;
 
+	/* all bursts of the interleaving buffer are lost */
+	if (*erased == 0xff) {
+		rc = -1;
+		goto shift;
+	}
+
+	/* the MS is silent, don't decode noise */
+	idle_level = tch_ul_idle_level(chan_state);
+	cls = tch_fr_classify(*bursts_p, idle_level);
+	if (cls == TCH_UL_IDLE) {
+		l1h->tch_ul_stats.idle++;
+		/* close to the threshold, this may be weak speech */
+		if (tch_fr_classify(*bursts_p, idle_level / 2)
+		    != TCH_UL_IDLE)
+			l1h->tch_ul_stats.idle_weak++;
+		rc = -1;
+		goto shift;
+	}
+
 	/* decode
 	 * also shift buffer by 4 bursts for interleaving */
 	switch ((rsl_cmode != RSL_CMOD_SPD_SPEECH) ? GSM48_CMODE_SPEECH_V1
 								: tch_mode) {
 	case GSM48_CMODE_SPEECH_V1: /* FR */
-		rc = tch_fr_decode(tch_data, *bursts_p, 1, 0);
+		rc = tch_fr_decode(tch_data, *bursts_p, 1, 0, &n_errors,
+			&n_bits_total);
 		break;
 	case GSM48_CMODE_SPEECH_EFR: /* EFR */
-		rc = tch_fr_decode(tch_data, *bursts_p, 1, 1);
+		rc = tch_fr_decode(tch_data, *bursts_p, 1, 1, &n_errors,
+			&n_bits_total);
 		break;
 	case GSM48_CMODE_SPEECH_AMR: /* AMR */
 		/* the first FN 0,8,17 defines that CMI is included in frame,
@@ -1449,11 +1732,11 @@ static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		rc = tch_afs_decode(tch_data + 2, *bursts_p,
 			(((fn + 26 - 7) % 26) >> 2) & 1, chan_state->codec,
 			chan_state->codecs, &chan_state->ul_ft,
-			&chan_state->ul_cmr, &ber);
-		if (rc)
+			&chan_state->ul_cmr, &n_errors, &n_bits_total);
+		if (rc && n_bits_total)
 			trx_loop_amr_input(l1h,
 				trx_chan_desc[chan].chan_nr | tn, chan_state,
-				ber);
+				(float) n_errors / n_bits_total);
 		amr = 2; /* we store tch_data + 2 header bytes */
 		/* only good speech frames get rtp header */
 		if (rc != 23 && rc >= 4) {
@@ -1467,7 +1750,26 @@ static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 			tch_mode);
 		return -EINVAL;
 	}
+	tch_ul_count(l1h, cls, rc);
+	tch_ul_dtx_update(l1h, chan_state, tch_data, rc);
+shift:
 	memcpy(*bursts_p, *bursts_p + 464, 464);
+
+	/* process measurement of each decoded TCH block, not only SACCH, an
+	 * idle or lost block has no BER and its TOA is noise */
+	if (cls != TCH_UL_IDLE && *erased != 0xff) {
+		trx_ul_meas_ber(meas, n_errors, n_bits_total);
+		l1if_process_meas_res(l1h->trx,
+			trx_chan_desc[chan].chan_nr | tn, meas);
+	}
+
+	/* the MS did not transmit, or we received garbage during its
+	 * silence period: no BFI, but nothing is sent via RTP at all */
+	if (cls == TCH_UL_IDLE || (rc < 4 && chan_state->ul_dtx)) {
+		l1h->tch_ul_stats.suppressed++;
+		rc = 0;
+		goto send;
+	}
 	if (rc < 0) {
 		LOGP(DL1C, LOGL_NOTICE, "Received bad TCH frame ending at "
 			"fn=%u for %s\n", fn, trx_chan_desc[chan].name);
@@ -1483,7 +1785,7 @@ static int rx_tchf_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	/* FACCH */
 	if (rc == 23) {
 		compose_ph_data_ind(l1h, tn, (fn + 2715648 - 7) % 2715648, chan,
-			tch_data + amr, 23, 0, 0, 0);
+			tch_data + amr, 23, meas);
 bfi:
 		if (rsl_cmode == RSL_CMOD_SPD_SPEECH) {
 			/* indicate bad frame */
@@ -1516,34 +1818,38 @@ bfi:
 	if (rsl_cmode != RSL_CMOD_SPD_SPEECH)
 		return 0;
 
-	/* TCH or BFI */
+send:
+	/* TCH, BFI or nothing (DTX) */
 	return compose_tch_ind(l1h, tn, (fn + 2715648 - 7) % 2715648, chan,
 		tch_data, rc);
 }
 
 static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	enum trx_chan_type chan, uint8_t bid, sbit_t *bits, int8_t rssi,
-	float toa)
+	int16_t toa256)
 {
 	struct trx_chan_state *chan_state = &l1h->chan_states[tn][chan];
 	sbit_t *burst, **bursts_p = &chan_state->ul_bursts;
 	uint8_t *mask = &chan_state->ul_mask;
+	uint8_t *erased = &chan_state->ul_erased;
+	struct trx_ul_meas *meas = &chan_state->ul_meas;
 	uint8_t rsl_cmode = chan_state->rsl_cmode;
 	uint8_t tch_mode = chan_state->tch_mode;
 	uint8_t tch_data[128]; /* just to be safe */
-	int rc, amr = 0;
-	float ber;
+	enum tch_ul_class cls = TCH_UL_SPEECH;
+	int n_errors = 0, n_bits_total = 0;
+	int rc, amr = 0, odd, idle_level;
 
 	/* handle rach, if handover rach detection is turned on */
 	if (chan_state->ho_rach_detect == 1)
-		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa);
+		return rx_rach_fn(l1h, tn, fn, chan, bid, bits, rssi, toa256);
 
-	LOGP(DL1C, LOGL_DEBUG, "TCH/H received %s fn=%u ts=%u trx=%u bid=%u\n", 
+	LOGP_HOT(DL1C, LOGL_DEBUG, "TCH/H received %s fn=%u ts=%u trx=%u bid=%u\n", 
 		trx_chan_desc[chan].name, fn, tn, l1h->trx->nr, bid);
 
 	/* alloc burst memory, if not already */
 	if (!*bursts_p) {
-		*bursts_p = talloc_zero_size(tall_bts_ctx, 696);
+		*bursts_p = burst_alloc(l1h, 696);
 		if (!*bursts_p)
 			return -ENOMEM;
 	}
@@ -1552,15 +1858,26 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 	if (bid == 0) {
 		memset(*bursts_p + 464, 0, 232);
 		*mask = 0x0;
+		/* bits 2..5 are the lost bursts of the previous frames,
+		 * which are still in the interleaving buffer */
+		*erased = (*erased << 2) & 0x3c;
+		trx_ul_meas_reset(meas);
 	}
 
 	/* update mask */
 	*mask |= (1 << bid);
 
-	/* copy burst to end of buffer of 6 bursts */
-	burst = *bursts_p + bid * 116 + 464;
-	memcpy(burst, bits + 3, 58);
-	memcpy(burst + 58, bits + 87, 58);
+	/* a lost burst stays zeroed in the buffer (erasure) */
+	if (!bits) {
+		*erased |= (1 << bid);
+	} else {
+		trx_ul_meas_burst(meas, rssi, toa256);
+
+		/* copy burst to end of buffer of 6 bursts */
+		burst = *bursts_p + bid * 116 + 464;
+		memcpy(burst, bits + 3, 58);
+		memcpy(burst + 58, bits + 87, 58);
+	}
 
 	/* wait until complete set of bursts */
 	if (bid != 1)
@@ -1583,6 +1900,25 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		goto bfi;
 	}
 
+	/* all bursts of the interleaving buffer are lost */
+	if (*erased == 0x3f) {
+		rc = -1;
+		goto shift;
+	}
+
+	/* the MS is silent, don't decode noise */
+	odd = (((fn + 26 - 10) % 26) >> 2) & 1;
+	idle_level = tch_ul_idle_level(chan_state);
+	cls = tch_hr_classify(*bursts_p, odd, idle_level);
+	if (cls == TCH_UL_IDLE) {
+		l1h->tch_ul_stats.idle++;
+		if (tch_hr_classify(*bursts_p, odd, idle_level / 2)
+		    != TCH_UL_IDLE)
+			l1h->tch_ul_stats.idle_weak++;
+		rc = -1;
+		goto shift;
+	}
+
 	/* decode
 	 * also shift buffer by 4 bursts for interleaving */
 	switch ((rsl_cmode != RSL_CMOD_SPD_SPEECH) ? GSM48_CMODE_SPEECH_V1
@@ -1593,7 +1929,8 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		 * Even FN ending at: 10,11,19,20,2,3
 		 */
 		rc = tch_hr_decode(tch_data, *bursts_p,
-			(((fn + 26 - 10) % 26) >> 2) & 1);
+			(((fn + 26 - 10) % 26) >> 2) & 1, &n_errors,
+			&n_bits_total);
 		break;
 	case GSM48_CMODE_SPEECH_AMR: /* AMR */
 		/* the first FN 0,8,17 or 1,9,18 defines that CMI is included
@@ -1604,11 +1941,11 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 			(((fn + 26 - 10) % 26) >> 2) & 1,
 			(((fn + 26 - 10) % 26) >> 2) & 1, chan_state->codec,
 			chan_state->codecs, &chan_state->ul_ft,
-			&chan_state->ul_cmr, &ber);
-		if (rc)
+			&chan_state->ul_cmr, &n_errors, &n_bits_total);
+		if (rc && n_bits_total)
 			trx_loop_amr_input(l1h,
 				trx_chan_desc[chan].chan_nr | tn, chan_state,
-				ber);
+				(float) n_errors / n_bits_total);
 		amr = 2; /* we store tch_data + 2 two */
 		/* only good speech frames get rtp header */
 		if (rc != 23 && rc >= 4) {
@@ -1622,8 +1959,27 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 			tch_mode);
 		return -EINVAL;
 	}
+	tch_ul_count(l1h, cls, rc);
+	tch_ul_dtx_update(l1h, chan_state, tch_data, rc);
+shift:
 	memcpy(*bursts_p, *bursts_p + 232, 232);
 	memcpy(*bursts_p + 232, *bursts_p + 464, 232);
+
+	/* process measurement of each decoded TCH block, not only SACCH, an
+	 * idle or lost block has no BER and its TOA is noise */
+	if (cls != TCH_UL_IDLE && *erased != 0x3f) {
+		trx_ul_meas_ber(meas, n_errors, n_bits_total);
+		l1if_process_meas_res(l1h->trx,
+			trx_chan_desc[chan].chan_nr | tn, meas);
+	}
+
+	/* the MS did not transmit, or we received garbage during its
+	 * silence period: no BFI, but nothing is sent via RTP at all */
+	if (cls == TCH_UL_IDLE || (rc < 4 && chan_state->ul_dtx)) {
+		l1h->tch_ul_stats.suppressed++;
+		rc = 0;
+		goto send;
+	}
 	if (rc < 0) {
 		LOGP(DL1C, LOGL_NOTICE, "Received bad TCH frame ending at "
 			"fn=%u for %s\n", fn, trx_chan_desc[chan].name);
@@ -1641,7 +1997,7 @@ static int rx_tchh_fn(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
 		chan_state->ul_ongoing_facch = 1;
 		compose_ph_data_ind(l1h, tn,
 			(fn + 2715648 - 10 - ((fn % 26) >= 19)) % 2715648, chan,
-			tch_data + amr, 23, 0, 0, 0); 
+			tch_data + amr, 23, meas);
 bfi:
 		if (rsl_cmode == RSL_CMOD_SPD_SPEECH) {
 			/* indicate bad frame */
@@ -1671,7 +2027,8 @@ bfi:
 	if (rsl_cmode != RSL_CMOD_SPD_SPEECH)
 		return 0;
 
-	/* TCH or BFI */
+send:
+	/* TCH, BFI or nothing (DTX) */
 	/* Note on FN 19 or 20: If we received the last burst of a frame,
 	 * it actually starts at FN 8 or 9. A burst starting there, overlaps
 	 * with the slot 12, so an extra FN must be substracted to get correct
@@ -1684,757 +2041,44 @@ bfi:
 
 
 /*
- * multiframe structure
+ * scheduler functions
  */
 
-/* frame structures */
-struct trx_sched_frame {
-	enum trx_chan_type		dl_chan;
-	uint8_t				dl_bid;
-	enum trx_chan_type		ul_chan;
-	uint8_t				ul_bid;
-};
-
-static struct trx_sched_frame frame_bcch[51] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_BCCH,	0,	TRXC_RACH,	0 }, { TRXC_BCCH,	1,	TRXC_RACH,	0 }, { TRXC_BCCH,	2,	TRXC_RACH,	0 }, { TRXC_BCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 }, { TRXC_CCCH,	1,	TRXC_RACH,	0 }, { TRXC_CCCH,	2,	TRXC_RACH,	0 }, { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_IDLE,	0,	TRXC_RACH,	0 },
-};
-
-static struct trx_sched_frame frame_bcch_sdcch4[102] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      {	TRXC_FCCH,	0,	TRXC_SDCCH4_3,	0 },
-      {	TRXC_SCH,	0,	TRXC_SDCCH4_3,	1 },
-      { TRXC_BCCH,	0,	TRXC_SDCCH4_3,	2 },
-      { TRXC_BCCH,	1,	TRXC_SDCCH4_3,	3 },
-      { TRXC_BCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_BCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_SACCH4_2,	0 },
-      { TRXC_CCCH,	1,	TRXC_SACCH4_2,	1 },
-      { TRXC_CCCH,	2,	TRXC_SACCH4_2,	2 },
-      { TRXC_CCCH,	3,	TRXC_SACCH4_2,	3 },
-      {	TRXC_FCCH,	0,	TRXC_SACCH4_3,	0 },
-      {	TRXC_SCH,	0,	TRXC_SACCH4_3,	1 },
-      { TRXC_CCCH,	0,	TRXC_SACCH4_3,	2 },
-      { TRXC_CCCH,	1,	TRXC_SACCH4_3,	3 },
-      { TRXC_CCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	1,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	3,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	3,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_3,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_3,	1,	TRXC_SDCCH4_0,	0 },
-      { TRXC_SDCCH4_3,	2,	TRXC_SDCCH4_0,	1 },
-      { TRXC_SDCCH4_3,	3,	TRXC_SDCCH4_0,	2 },
-      {	TRXC_FCCH,	0,	TRXC_SDCCH4_0,	3 },
-      {	TRXC_SCH,	0,	TRXC_SDCCH4_1,	0 },
-      { TRXC_SACCH4_0,	0,	TRXC_SDCCH4_1,	1 },
-      { TRXC_SACCH4_0,	1,	TRXC_SDCCH4_1,	2 },
-      { TRXC_SACCH4_0,	2,	TRXC_SDCCH4_1,	3 },
-      { TRXC_SACCH4_0,	3,	TRXC_RACH,	0 },
-      { TRXC_SACCH4_1,	0,	TRXC_RACH,	0 },
-      { TRXC_SACCH4_1,	1,	TRXC_SDCCH4_2,	0 },
-      { TRXC_SACCH4_1,	2,	TRXC_SDCCH4_2,	1 },
-      { TRXC_SACCH4_1,	3,	TRXC_SDCCH4_2,	2 },
-      {	TRXC_IDLE,	0,	TRXC_SDCCH4_2,	3 },
-
-      {	TRXC_FCCH,	0,	TRXC_SDCCH4_3,	0 },
-      {	TRXC_SCH,	0,	TRXC_SDCCH4_3,	1 },
-      { TRXC_BCCH,	0,	TRXC_SDCCH4_3,	2 },
-      { TRXC_BCCH,	1,	TRXC_SDCCH4_3,	3 },
-      { TRXC_BCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_BCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_SACCH4_0,	0 },
-      { TRXC_CCCH,	1,	TRXC_SACCH4_0,	1 },
-      { TRXC_CCCH,	2,	TRXC_SACCH4_0,	2 },
-      { TRXC_CCCH,	3,	TRXC_SACCH4_0,	3 },
-      {	TRXC_FCCH,	0,	TRXC_SACCH4_1,	0 },
-      {	TRXC_SCH,	0,	TRXC_SACCH4_1,	1 },
-      { TRXC_CCCH,	0,	TRXC_SACCH4_1,	2 },
-      { TRXC_CCCH,	1,	TRXC_SACCH4_1,	3 },
-      { TRXC_CCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	0,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	1,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	2,	TRXC_RACH,	0 },
-      { TRXC_CCCH,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_0,	3,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_1,	3,	TRXC_RACH,	0 },
-      {	TRXC_FCCH,	0,	TRXC_RACH,	0 },
-      {	TRXC_SCH,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	1,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	2,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_2,	3,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_3,	0,	TRXC_RACH,	0 },
-      { TRXC_SDCCH4_3,	1,	TRXC_SDCCH4_0,	0 },
-      { TRXC_SDCCH4_3,	2,	TRXC_SDCCH4_0,	1 },
-      { TRXC_SDCCH4_3,	3,	TRXC_SDCCH4_0,	2 },
-      {	TRXC_FCCH,	0,	TRXC_SDCCH4_0,	3 },
-      {	TRXC_SCH,	0,	TRXC_SDCCH4_1,	0 },
-      { TRXC_SACCH4_2,	0,	TRXC_SDCCH4_1,	1 },
-      { TRXC_SACCH4_2,	1,	TRXC_SDCCH4_1,	2 },
-      { TRXC_SACCH4_2,	2,	TRXC_SDCCH4_1,	3 },
-      { TRXC_SACCH4_2,	3,	TRXC_RACH,	0 },
-      { TRXC_SACCH4_3,	0,	TRXC_RACH,	0 },
-      { TRXC_SACCH4_3,	1,	TRXC_SDCCH4_2,	0 },
-      { TRXC_SACCH4_3,	2,	TRXC_SDCCH4_2,	1 },
-      { TRXC_SACCH4_3,	3,	TRXC_SDCCH4_2,	2 },
-      {	TRXC_IDLE,	0,	TRXC_SDCCH4_2,	3 },
-};
-
-static struct trx_sched_frame frame_sdcch8[102] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_SDCCH8_0,	0,	TRXC_SACCH8_5,	0 },
-      { TRXC_SDCCH8_0,	1,	TRXC_SACCH8_5,	1 },
-      { TRXC_SDCCH8_0,	2,	TRXC_SACCH8_5,	2 },
-      { TRXC_SDCCH8_0,	3,	TRXC_SACCH8_5,	3 },
-      { TRXC_SDCCH8_1,	0,	TRXC_SACCH8_6,	0 },
-      { TRXC_SDCCH8_1,	1,	TRXC_SACCH8_6,	1 },
-      { TRXC_SDCCH8_1,	2,	TRXC_SACCH8_6,	2 },
-      { TRXC_SDCCH8_1,	3,	TRXC_SACCH8_6,	3 },
-      { TRXC_SDCCH8_2,	0,	TRXC_SACCH8_7,	0 },
-      { TRXC_SDCCH8_2,	1,	TRXC_SACCH8_7,	1 },
-      { TRXC_SDCCH8_2,	2,	TRXC_SACCH8_7,	2 },
-      { TRXC_SDCCH8_2,	3,	TRXC_SACCH8_7,	3 },
-      { TRXC_SDCCH8_3,	0,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	1,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	2,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	3,	TRXC_SDCCH8_0,	0 },
-      { TRXC_SDCCH8_4,	0,	TRXC_SDCCH8_0,	1 },
-      { TRXC_SDCCH8_4,	1,	TRXC_SDCCH8_0,	2 },
-      { TRXC_SDCCH8_4,	2,	TRXC_SDCCH8_0,	3 },
-      { TRXC_SDCCH8_4,	3,	TRXC_SDCCH8_1,	0 },
-      { TRXC_SDCCH8_5,	0,	TRXC_SDCCH8_1,	1 },
-      { TRXC_SDCCH8_5,	1,	TRXC_SDCCH8_1,	2 },
-      { TRXC_SDCCH8_5,	2,	TRXC_SDCCH8_1,	3 },
-      { TRXC_SDCCH8_5,	3,	TRXC_SDCCH8_2,	0 },
-      { TRXC_SDCCH8_6,	0,	TRXC_SDCCH8_2,	1 },
-      { TRXC_SDCCH8_6,	1,	TRXC_SDCCH8_2,	2 },
-      { TRXC_SDCCH8_6,	2,	TRXC_SDCCH8_2,	3 },
-      { TRXC_SDCCH8_6,	3,	TRXC_SDCCH8_3,	0 },
-      { TRXC_SDCCH8_7,	0,	TRXC_SDCCH8_3,	1 },
-      { TRXC_SDCCH8_7,	1,	TRXC_SDCCH8_3,	2 },
-      { TRXC_SDCCH8_7,	2,	TRXC_SDCCH8_3,	3 },
-      { TRXC_SDCCH8_7,	3,	TRXC_SDCCH8_4,	0 },
-      { TRXC_SACCH8_0,	0,	TRXC_SDCCH8_4,	1 },
-      { TRXC_SACCH8_0,	1,	TRXC_SDCCH8_4,	2 },
-      { TRXC_SACCH8_0,	2,	TRXC_SDCCH8_4,	3 },
-      { TRXC_SACCH8_0,	3,	TRXC_SDCCH8_5,	0 },
-      { TRXC_SACCH8_1,	0,	TRXC_SDCCH8_5,	1 },
-      { TRXC_SACCH8_1,	1,	TRXC_SDCCH8_5,	2 },
-      { TRXC_SACCH8_1,	2,	TRXC_SDCCH8_5,	3 },
-      { TRXC_SACCH8_1,	3,	TRXC_SDCCH8_6,	0 },
-      { TRXC_SACCH8_2,	0,	TRXC_SDCCH8_6,	1 },
-      { TRXC_SACCH8_2,	1,	TRXC_SDCCH8_6,	2 },
-      { TRXC_SACCH8_2,	2,	TRXC_SDCCH8_6,	3 },
-      { TRXC_SACCH8_2,	3,	TRXC_SDCCH8_7,	0 },
-      { TRXC_SACCH8_3,	0,	TRXC_SDCCH8_7,	1 },
-      { TRXC_SACCH8_3,	1,	TRXC_SDCCH8_7,	2 },
-      { TRXC_SACCH8_3,	2,	TRXC_SDCCH8_7,	3 },
-      { TRXC_SACCH8_3,	3,	TRXC_SACCH8_0,	0 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_0,	1 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_0,	2 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_0,	3 },
-
-      { TRXC_SDCCH8_0,	0,	TRXC_SACCH8_1,	0 },
-      { TRXC_SDCCH8_0,	1,	TRXC_SACCH8_1,	1 },
-      { TRXC_SDCCH8_0,	2,	TRXC_SACCH8_1,	2 },
-      { TRXC_SDCCH8_0,	3,	TRXC_SACCH8_1,	3 },
-      { TRXC_SDCCH8_1,	0,	TRXC_SACCH8_2,	0 },
-      { TRXC_SDCCH8_1,	1,	TRXC_SACCH8_2,	1 },
-      { TRXC_SDCCH8_1,	2,	TRXC_SACCH8_2,	2 },
-      { TRXC_SDCCH8_1,	3,	TRXC_SACCH8_2,	3 },
-      { TRXC_SDCCH8_2,	0,	TRXC_SACCH8_3,	0 },
-      { TRXC_SDCCH8_2,	1,	TRXC_SACCH8_3,	1 },
-      { TRXC_SDCCH8_2,	2,	TRXC_SACCH8_3,	2 },
-      { TRXC_SDCCH8_2,	3,	TRXC_SACCH8_3,	3 },
-      { TRXC_SDCCH8_3,	0,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	1,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	2,	TRXC_IDLE,	0 },
-      { TRXC_SDCCH8_3,	3,	TRXC_SDCCH8_0,	0 },
-      { TRXC_SDCCH8_4,	0,	TRXC_SDCCH8_0,	1 },
-      { TRXC_SDCCH8_4,	1,	TRXC_SDCCH8_0,	2 },
-      { TRXC_SDCCH8_4,	2,	TRXC_SDCCH8_0,	3 },
-      { TRXC_SDCCH8_4,	3,	TRXC_SDCCH8_1,	0 },
-      { TRXC_SDCCH8_5,	0,	TRXC_SDCCH8_1,	1 },
-      { TRXC_SDCCH8_5,	1,	TRXC_SDCCH8_1,	2 },
-      { TRXC_SDCCH8_5,	2,	TRXC_SDCCH8_1,	3 },
-      { TRXC_SDCCH8_5,	3,	TRXC_SDCCH8_2,	0 },
-      { TRXC_SDCCH8_6,	0,	TRXC_SDCCH8_2,	1 },
-      { TRXC_SDCCH8_6,	1,	TRXC_SDCCH8_2,	2 },
-      { TRXC_SDCCH8_6,	2,	TRXC_SDCCH8_2,	3 },
-      { TRXC_SDCCH8_6,	3,	TRXC_SDCCH8_3,	0 },
-      { TRXC_SDCCH8_7,	0,	TRXC_SDCCH8_3,	1 },
-      { TRXC_SDCCH8_7,	1,	TRXC_SDCCH8_3,	2 },
-      { TRXC_SDCCH8_7,	2,	TRXC_SDCCH8_3,	3 },
-      { TRXC_SDCCH8_7,	3,	TRXC_SDCCH8_4,	0 },
-      { TRXC_SACCH8_4,	0,	TRXC_SDCCH8_4,	1 },
-      { TRXC_SACCH8_4,	1,	TRXC_SDCCH8_4,	2 },
-      { TRXC_SACCH8_4,	2,	TRXC_SDCCH8_4,	3 },
-      { TRXC_SACCH8_4,	3,	TRXC_SDCCH8_5,	0 },
-      { TRXC_SACCH8_5,	0,	TRXC_SDCCH8_5,	1 },
-      { TRXC_SACCH8_5,	1,	TRXC_SDCCH8_5,	2 },
-      { TRXC_SACCH8_5,	2,	TRXC_SDCCH8_5,	3 },
-      { TRXC_SACCH8_5,	3,	TRXC_SDCCH8_6,	0 },
-      { TRXC_SACCH8_6,	0,	TRXC_SDCCH8_6,	1 },
-      { TRXC_SACCH8_6,	1,	TRXC_SDCCH8_6,	2 },
-      { TRXC_SACCH8_6,	2,	TRXC_SDCCH8_6,	3 },
-      { TRXC_SACCH8_6,	3,	TRXC_SDCCH8_7,	0 },
-      { TRXC_SACCH8_7,	0,	TRXC_SDCCH8_7,	1 },
-      { TRXC_SACCH8_7,	1,	TRXC_SDCCH8_7,	2 },
-      { TRXC_SACCH8_7,	2,	TRXC_SDCCH8_7,	3 },
-      { TRXC_SACCH8_7,	3,	TRXC_SACCH8_4,	0 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_4,	1 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_4,	2 },
-      { TRXC_IDLE,	0,	TRXC_SACCH8_4,	3 },
-};
-
-static struct trx_sched_frame frame_tchf_ts0[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-};
-
-static struct trx_sched_frame frame_tchf_ts1[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-};
-
-static struct trx_sched_frame frame_tchf_ts2[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-};
-
-static struct trx_sched_frame frame_tchf_ts3[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-};
-
-static struct trx_sched_frame frame_tchf_ts4[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-};
-
-static struct trx_sched_frame frame_tchf_ts5[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-};
-
-static struct trx_sched_frame frame_tchf_ts6[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-};
-
-static struct trx_sched_frame frame_tchf_ts7[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	1,	TRXC_SACCHTF,	1 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	2,	TRXC_SACCHTF,	2 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	3,	TRXC_SACCHTF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_TCHF,	0,	TRXC_TCHF,	0 }, { TRXC_TCHF,	1,	TRXC_TCHF,	1 }, { TRXC_TCHF,	2,	TRXC_TCHF,	2 }, { TRXC_TCHF,	3,	TRXC_TCHF,	3 },
-      { TRXC_SACCHTF,	0,	TRXC_SACCHTF,	0 },
-};
-
-static struct trx_sched_frame frame_tchh_ts01[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	0,	TRXC_SACCHTH_0,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	0,	TRXC_SACCHTH_1,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	1,	TRXC_SACCHTH_0,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	1,	TRXC_SACCHTH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	2,	TRXC_SACCHTH_0,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	2,	TRXC_SACCHTH_1,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	3,	TRXC_SACCHTH_0,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	3,	TRXC_SACCHTH_1,	3 },
-};
-
-static struct trx_sched_frame frame_tchh_ts23[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	3,	TRXC_SACCHTH_0,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	3,	TRXC_SACCHTH_1,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	0,	TRXC_SACCHTH_0,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	0,	TRXC_SACCHTH_1,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	1,	TRXC_SACCHTH_0,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	1,	TRXC_SACCHTH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	2,	TRXC_SACCHTH_0,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	2,	TRXC_SACCHTH_1,	2 },
-};
-
-static struct trx_sched_frame frame_tchh_ts45[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	2,	TRXC_SACCHTH_0,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	2,	TRXC_SACCHTH_1,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	3,	TRXC_SACCHTH_0,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	3,	TRXC_SACCHTH_1,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	0,	TRXC_SACCHTH_0,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	0,	TRXC_SACCHTH_1,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	1,	TRXC_SACCHTH_0,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	1,	TRXC_SACCHTH_1,	1 },
-};
-
-static struct trx_sched_frame frame_tchh_ts67[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	1,	TRXC_SACCHTH_0,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	1,	TRXC_SACCHTH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	2,	TRXC_SACCHTH_0,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	2,	TRXC_SACCHTH_1,	2 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	3,	TRXC_SACCHTH_0,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	3,	TRXC_SACCHTH_1,	3 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_0,	0,	TRXC_SACCHTH_0,	0 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_TCHH_0,	0,	TRXC_TCHH_0,	0 }, { TRXC_TCHH_1,	0,	TRXC_TCHH_1,	0 }, { TRXC_TCHH_0,	1,	TRXC_TCHH_0,	1 }, { TRXC_TCHH_1,	1,	TRXC_TCHH_1,	1 },
-      { TRXC_SACCHTH_1,	0,	TRXC_SACCHTH_1,	0 },
-};
+/* compile the dispatch table of a TS, so that the burst processing needs no
+ * lookup of channel description and state */
+static void trx_sched_compile(struct trx_l1h *l1h, uint8_t tn)
+{
+	struct trx_sched_frame *frame;
+	struct trx_chan_desc *desc;
+	struct trx_sched_op *op;
+	int i;
 
-static struct trx_sched_frame frame_pdch[104] = {
-/*	dl_chan		dl_bid	ul_chan		ul_bid */
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PTCCH,	0,	TRXC_PTCCH,	0 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PTCCH,	1,	TRXC_PTCCH,	1 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PTCCH,	2,	TRXC_PTCCH,	2 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PTCCH,	3,	TRXC_PTCCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_PDTCH,	0,	TRXC_PDTCH,	0 }, { TRXC_PDTCH,	1,	TRXC_PDTCH,	1 }, { TRXC_PDTCH,	2,	TRXC_PDTCH,	2 }, { TRXC_PDTCH,	3,	TRXC_PDTCH,	3 },
-      { TRXC_IDLE,	0,	TRXC_IDLE,	0 },
-};
+	memset(l1h->mf_ops[tn], 0, sizeof(l1h->mf_ops[tn]));
 
-/* multiframe structure */
-struct trx_sched_multiframe {
-	enum gsm_phys_chan_config	pchan;
-	uint8_t				slotmask;
-	uint8_t				period;
-	struct trx_sched_frame		*frames;
-	const char 			*name;
-};
+	if (!l1h->mf_index[tn])
+		return;
 
-static struct trx_sched_multiframe trx_sched_multiframes[] = {
-	{ GSM_PCHAN_NONE,		0xff,	0,	NULL,			"NONE"},
-	{ GSM_PCHAN_CCCH,		0xff,	51,	frame_bcch,		"BCCH+CCCH" },
-	{ GSM_PCHAN_CCCH_SDCCH4,	0xff,	102,	frame_bcch_sdcch4,	"BCCH+CCCH+SDCCH/4+SACCH/4" },
-	{ GSM_PCHAN_SDCCH8_SACCH8C,	0xff,	102,	frame_sdcch8,		"SDCCH/8+SACCH/8" },
-	{ GSM_PCHAN_TCH_F,		0x01,	104,	frame_tchf_ts0,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x02,	104,	frame_tchf_ts1,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x04,	104,	frame_tchf_ts2,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x08,	104,	frame_tchf_ts3,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x10,	104,	frame_tchf_ts4,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x20,	104,	frame_tchf_ts5,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x40,	104,	frame_tchf_ts6,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_F,		0x80,	104,	frame_tchf_ts7,		"TCH/F+SACCH" },
-	{ GSM_PCHAN_TCH_H,		0x03,	104,	frame_tchh_ts01,	"TCH/H+SACCH" },
-	{ GSM_PCHAN_TCH_H,		0x0c,	104,	frame_tchh_ts23,	"TCH/H+SACCH" },
-	{ GSM_PCHAN_TCH_H,		0x30,	104,	frame_tchh_ts45,	"TCH/H+SACCH" },
-	{ GSM_PCHAN_TCH_H,		0xc0,	104,	frame_tchh_ts67,	"TCH/H+SACCH" },
-	{ GSM_PCHAN_PDCH,		0xff,	104,	frame_pdch,		"PDCH" },
-};
+	for (i = 0; i < l1h->mf_period[tn]; i++) {
+		frame = l1h->mf_frames[tn] + i;
+		op = &l1h->mf_ops[tn][i];
 
+		op->dl_chan = frame->dl_chan;
+		op->dl_bid = frame->dl_bid;
+		op->ul_chan = frame->ul_chan;
+		op->ul_bid = frame->ul_bid;
 
-/*
- * scheduler functions
- */
+		if (CHAN_IS_ACTIVE(l1h, tn, frame->dl_chan)) {
+			desc = &trx_chan_desc[frame->dl_chan];
+			op->dl_fn = desc->dl_fn;
+			if (frame->dl_bid == 0)
+				op->rts_fn = desc->rts_fn;
+		}
+		if (CHAN_IS_ACTIVE(l1h, tn, frame->ul_chan)) {
+			desc = &trx_chan_desc[frame->ul_chan];
+			op->ul_fn = desc->ul_fn;
+		}
+	}
+}
 
 /* set multiframe scheduler to given pchan */
 int trx_sched_set_pchan(struct trx_l1h *l1h, uint8_t tn,
@@ -2442,16 +2086,24 @@ int trx_sched_set_pchan(struct trx_l1h *l1h, uint8_t tn,
 {
 	int i;
 
+	if (trx_trace_on) {
+		struct trx_trace_pchan tp = { tn, pchan };
+
+		trx_trace_write(TRX_TRACE_PCHAN, l1h->trx->nr, &tp,
+			sizeof(tp));
+	}
+
 	/* ignore disabled slots */
 	if (!(l1h->config.slotmask & (1 << tn)))
 		return -ENOTSUP;
 
-	for (i = 0; i < ARRAY_SIZE(trx_sched_multiframes); i++) {
+	for (i = 0; i < trx_sched_multiframes_num; i++) {
 		if (trx_sched_multiframes[i].pchan == pchan
 		 && (trx_sched_multiframes[i].slotmask & (1 << tn))) {
 			l1h->mf_index[tn] = i;
 			l1h->mf_period[tn] = trx_sched_multiframes[i].period;
 			l1h->mf_frames[tn] = trx_sched_multiframes[i].frames;
+			trx_sched_compile(l1h, tn);
 			LOGP(DL1C, LOGL_NOTICE, "Configuring multiframe with "
 				"%s trx=%d ts=%d\n",
 				trx_sched_multiframes[i].name,
@@ -2476,6 +2128,13 @@ int trx_sched_set_lchan(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t link_id,
 	int rc = -EINVAL;
 	struct trx_chan_state *chan_state;
 
+	if (trx_trace_on) {
+		struct trx_trace_lchan tl = { chan_nr, link_id, active };
+
+		trx_trace_write(TRX_TRACE_LCHAN, l1h->trx->nr, &tl,
+			sizeof(tl));
+	}
+
 	/* look for all matching chan_nr/link_id */
 	for (i = 0; i < _TRX_CHAN_MAX; i++) {
 		/* skip if pchan type does not match pdch flag */
@@ -2492,12 +2151,31 @@ int trx_sched_set_lchan(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t link_id,
 			LOGP(DL1C, LOGL_NOTICE, "%s %s on trx=%d ts=%d\n",
 				(active) ? "Activating" : "Deactivating",
 				trx_chan_desc[i].name, l1h->trx->nr, tn);
-			if (active)
+			if (active) {
+				/* keep the burst buffers, they are reused, but
+				 * nothing of the previous call must be sent or
+				 * decoded: zero soft bits are erasures */
+				ubit_t *dl_bursts = chan_state->dl_bursts;
+				sbit_t *ul_bursts = chan_state->ul_bursts;
+
 				memset(chan_state, 0, sizeof(*chan_state));
+				if (dl_bursts)
+					memset(dl_bursts, 0,
+						talloc_get_size(dl_bursts));
+				if (ul_bursts)
+					memset(ul_bursts, 0,
+						talloc_get_size(ul_bursts));
+				chan_state->dl_bursts = dl_bursts;
+				chan_state->ul_bursts = ul_bursts;
+				l1h->active_mask[tn] |= 1ULL << i;
+			} else if (!trx_chan_desc[i].auto_active)
+				l1h->active_mask[tn] &= ~(1ULL << i);
 			chan_state->active = active;
 		}
 	}
 
+	trx_sched_compile(l1h, tn);
+
 	/* disable handover detection (on deactivation) */
 	if (l1h->ho_rach_detect[tn][ss]) {
 		l1h->ho_rach_detect[tn][ss] = 0;
@@ -2510,7 +2188,8 @@ int trx_sched_set_lchan(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t link_id,
 /* setting all logical channels given attributes to active/inactive */
 int trx_sched_set_mode(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t rsl_cmode,
 	uint8_t tch_mode, int codecs, uint8_t codec0, uint8_t codec1,
-	uint8_t codec2, uint8_t codec3, uint8_t initial_id, uint8_t handover)
+	uint8_t codec2, uint8_t codec3, uint8_t initial_id, uint8_t handover,
+	uint8_t dtx)
 {
 	uint8_t tn = L1SAP_CHAN2TS(chan_nr);
 	uint8_t ss = l1sap_chan2ss(chan_nr);
@@ -2518,6 +2197,15 @@ int trx_sched_set_mode(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t rsl_cmode,
 	int rc = -EINVAL;
 	struct trx_chan_state *chan_state;
 
+	if (trx_trace_on) {
+		struct trx_trace_mode tm = { chan_nr, rsl_cmode, tch_mode,
+			codecs, { codec0, codec1, codec2, codec3 }, initial_id,
+			handover, dtx };
+
+		trx_trace_write(TRX_TRACE_MODE, l1h->trx->nr, &tm,
+			sizeof(tm));
+	}
+
 	/* no mode for PDCH */
 	if (trx_sched_multiframes[l1h->mf_index[tn]].pchan == GSM_PCHAN_PDCH)
 		return 0;
@@ -2534,6 +2222,12 @@ int trx_sched_set_mode(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t rsl_cmode,
 			chan_state->rsl_cmode = rsl_cmode;
 			chan_state->tch_mode = tch_mode;
 			chan_state->ho_rach_detect = handover;
+			chan_state->dtx = dtx;
+			if (!(dtx & RSL_CMOD_DTXd))
+				chan_state->dl_dtx = 0;
+			if (!(dtx & RSL_CMOD_DTXu)
+			 || rsl_cmode != RSL_CMOD_SPD_SPEECH)
+				chan_state->ul_dtx = 0;
 			if (rsl_cmode == RSL_CMOD_SPD_SPEECH
 			 && tch_mode == GSM48_CMODE_SPEECH_AMR) {
 				chan_state->codecs = codecs;
@@ -2577,6 +2271,20 @@ int trx_sched_set_cipher(struct trx_l1h *l1h, uint8_t chan_nr, int downlink,
 	int rc = -EINVAL;
 	struct trx_chan_state *chan_state;
 
+	if (trx_trace_on) {
+		uint8_t buf[sizeof(struct trx_trace_cipher) + 16];
+		struct trx_trace_cipher *tc = (struct trx_trace_cipher *) buf;
+
+		tc->chan_nr = chan_nr;
+		tc->downlink = downlink;
+		tc->algo = algo;
+		tc->key_len = (key_len < 0) ? 0 : (key_len > 16) ? 16 : key_len;
+		if (tc->key_len)
+			memcpy(tc->key, key, tc->key_len);
+		trx_trace_write(TRX_TRACE_CIPHER, l1h->trx->nr, buf,
+			sizeof(*tc) + tc->key_len);
+	}
+
 	/* no cipher for PDCH */
 	if (trx_sched_multiframes[l1h->mf_index[tn]].pchan == GSM_PCHAN_PDCH)
 		return 0;
@@ -2620,69 +2328,62 @@ int trx_sched_set_cipher(struct trx_l1h *l1h, uint8_t chan_nr, int downlink,
 /* process ready-to-send */
 static int trx_sched_rts(struct trx_l1h *l1h, uint8_t tn, uint32_t fn)
 {
-	struct trx_sched_frame *frame;
-	uint8_t offset, period, bid;
-	trx_sched_rts_func *func;
-	enum trx_chan_type chan;
+	const struct trx_sched_op *op;
 
 	/* no multiframe set */
 	if (!l1h->mf_index[tn])
 		return 0;
 
-	/* get frame from multiframe */
-	period = l1h->mf_period[tn];
-	offset = fn % period;
-	frame = l1h->mf_frames[tn] + offset;
-
-	chan = frame->dl_chan;
-	bid = frame->dl_bid;
-	func = trx_chan_desc[frame->dl_chan].rts_fn;
-
-	/* only on bid == 0 */
-	if (bid != 0)
+	/* get operation of frame, the RTS function is only set on bid 0 of
+	 * an active channel */
+	op = &l1h->mf_ops[tn][fn % l1h->mf_period[tn]];
+	if (!op->rts_fn)
 		return 0;
 
-	/* no RTS function */
-	if (!func)
-		return 0;
+	return op->rts_fn(l1h, tn, fn, op->dl_chan);
+}
 
-	/* check if channel is active */
-	if (!trx_chan_desc[chan].auto_active
-	 && !l1h->chan_states[tn][chan].active)
-	 	return -EINVAL;
+const char *trx_sched_chan_name(enum trx_chan_type chan)
+{
+	return trx_chan_desc[chan].name;
+}
 
-	return func(l1h, tn, fn, frame->dl_chan);
+/* GSMTAP burst type of the given channel */
+static uint8_t trx_sched_gsmtap_burst_type(enum trx_chan_type chan)
+{
+	switch (chan) {
+	case TRXC_FCCH:
+		return GSMTAP_BURST_FCCH;
+	case TRXC_SCH:
+		return GSMTAP_BURST_SYNC;
+	case TRXC_RACH:
+		return GSMTAP_BURST_ACCESS;
+	default:
+		return GSMTAP_BURST_NORMAL;
+	}
 }
 
 /* process downlink burst */
 static const ubit_t *trx_sched_dl_burst(struct trx_l1h *l1h, uint8_t tn,
 	uint32_t fn)
 {
-	struct trx_sched_frame *frame;
-	uint8_t offset, period, bid;
-	trx_sched_dl_func *func;
-	enum trx_chan_type chan;
+	const struct trx_sched_op *op;
+	enum trx_chan_type chan = TRXC_IDLE;
+	uint8_t bid = 0;
 	ubit_t *bits = NULL;
 
 	if (!l1h->mf_index[tn])
 		goto no_data;
 
-	/* get frame from multiframe */
-	period = l1h->mf_period[tn];
-	offset = fn % period;
-	frame = l1h->mf_frames[tn] + offset;
-  
-	chan = frame->dl_chan;
-	bid = frame->dl_bid;
-	func = trx_chan_desc[chan].dl_fn;
-
-	/* check if channel is active */
-	if (!trx_chan_desc[chan].auto_active
-	 && !l1h->chan_states[tn][chan].active)
+	/* get operation of frame, no function if channel is inactive */
+	op = &l1h->mf_ops[tn][fn % l1h->mf_period[tn]];
+	chan = op->dl_chan;
+	bid = op->dl_bid;
+	if (!op->dl_fn)
 	 	goto no_data;
 
 	/* get burst from function */
-	bits = func(l1h, tn, fn, chan, bid);
+	bits = op->dl_fn(l1h, tn, fn, chan, bid);
 
 	/* encrypt */
 	if (bits && l1h->chan_states[tn][chan].dl_encr_algo) {
@@ -2701,21 +2402,27 @@ no_data:
 	/* in case of C0, we need a dummy burst to maintain RF power */
 	if (bits == NULL && l1h->trx == l1h->trx->bts->c0) {
 if (0)		if (chan != TRXC_IDLE) // hack
-		LOGP(DL1C, LOGL_DEBUG, "No burst data for %s fn=%u ts=%u "
+		LOGP_HOT(DL1C, LOGL_DEBUG, "No burst data for %s fn=%u ts=%u "
 			"burst=%d on C0, so filling with dummy burst\n",
 			trx_chan_desc[chan].name, fn, tn, bid);
 		bits = dummy_burst;
 	}
 
+	if (bits && gsmtap_bursts)
+		gsmtap_export_burst(l1h->trx->arfcn, tn, fn,
+			(bits == dummy_burst) ? GSMTAP_BURST_DUMMY
+				: trx_sched_gsmtap_burst_type(chan),
+			0, bits, 148);
+
 	return bits;
 }
 
 /* process uplink burst */
 int trx_sched_ul_burst(struct trx_l1h *l1h, uint8_t tn, uint32_t current_fn,
-	sbit_t *bits, int8_t rssi, float toa)
+	sbit_t *bits, int8_t rssi, int16_t toa256)
 {
-	struct trx_sched_frame *frame;
-	uint8_t offset, period, bid;
+	const struct trx_sched_op *op;
+	uint8_t bid;
 	trx_sched_ul_func *func;
 	enum trx_chan_type chan;
 	uint32_t fn, elapsed;
@@ -2734,21 +2441,12 @@ int trx_sched_ul_burst(struct trx_l1h *l1h, uint8_t tn, uint32_t current_fn,
 		fn = current_fn;
 
 	while (42) {
-		/* get frame from multiframe */
-		period = l1h->mf_period[tn];
-		offset = fn % period;
-		frame = l1h->mf_frames[tn] + offset;
-
-		chan = frame->ul_chan;
-		bid = frame->ul_bid;
-		func = trx_chan_desc[chan].ul_fn;
-
-		/* check if channel is active */
-		if (!trx_chan_desc[chan].auto_active
-		 && !l1h->chan_states[tn][chan].active)
-			goto next_frame;
-
-		/* omit bursts which have no handler, like IDLE bursts */
+		/* get operation of frame, no function if channel is inactive
+		 * or has no handler, like IDLE bursts */
+		op = &l1h->mf_ops[tn][fn % l1h->mf_period[tn]];
+		chan = op->ul_chan;
+		bid = op->ul_bid;
+		func = op->ul_fn;
 		if (!func)
 			goto next_frame;
 
@@ -2770,13 +2468,19 @@ int trx_sched_ul_burst(struct trx_l1h *l1h, uint8_t tn, uint32_t current_fn,
 				}
 			}
 
-			func(l1h, tn, fn, chan, bid, bits, rssi, toa);
+			if (bits && gsmtap_bursts)
+				gsmtap_export_burst(l1h->trx->arfcn
+						| GSMTAP_ARFCN_F_UPLINK, tn, fn,
+					trx_sched_gsmtap_burst_type(chan), rssi,
+					(const uint8_t *) bits, 148);
+
+			func(l1h, tn, fn, chan, bid, bits, rssi, toa256);
 		} else if (chan != TRXC_RACH
 		        && !l1h->chan_states[tn][chan].ho_rach_detect) {
-			sbit_t spare[148];
-
-			memset(spare, 0, 148);
-			func(l1h, tn, fn, chan, bid, spare, -128, 0);
+			/* lost burst, the handler only marks it as erased */
+			l1h->chan_states[tn][chan].ul_erased_num++;
+			l1h->ul_erased_num++;
+			func(l1h, tn, fn, chan, bid, NULL, -128, 0);
 		}
 
 next_frame:
@@ -2801,6 +2505,8 @@ static int trx_sched_fn(uint32_t fn)
 	const ubit_t *bits;
 	uint8_t gain;
 
+	trx_trace(TRX_TRACE_FN, 0, NULL, 0);
+
 	/* send time indication */
 	l1if_mph_time_ind(bts, fn);
 
@@ -3,6 +3,10 @@
 
 extern uint32_t trx_clock_advance;
 extern uint32_t transceiver_last_fn;
+extern int trx_rach_ext;
+extern int trx_rach_max_errors;
+extern int trx_rach_min_corr;
+extern int trx_tch_idle_level;
 
 
 int trx_sched_init(struct trx_l1h *l1h);
@@ -16,7 +20,7 @@ int trx_sched_tch_req(struct trx_l1h *l1h, struct osmo_phsap_prim *l1sap);
 int trx_sched_clock(uint32_t fn);
 
 int trx_sched_ul_burst(struct trx_l1h *l1h, uint8_t tn, uint32_t fn,
-        sbit_t *bits, int8_t rssi, float toa);
+        sbit_t *bits, int8_t rssi, int16_t toa256);
 
 /* set multiframe scheduler to given pchan */
 int trx_sched_set_pchan(struct trx_l1h *l1h, uint8_t tn,
@@ -30,7 +34,7 @@ int trx_sched_set_lchan(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t link_id,
 int trx_sched_set_mode(struct trx_l1h *l1h, uint8_t chan_nr, uint8_t rsl_cmode,
 	uint8_t tch_mode, int codecs, uint8_t codec0, uint8_t codec1,
 	uint8_t codec2, uint8_t codec3, uint8_t initial_codec,
-	uint8_t handover);
+	uint8_t handover, uint8_t dtx);
 
 /* setting cipher on logical channels */
 int trx_sched_set_cipher(struct trx_l1h *l1h, uint8_t chan_nr, int downlink,
@@ -39,4 +43,10 @@ int trx_sched_set_cipher(struct trx_l1h *l1h, uint8_t chan_nr, int downlink,
 /* close all logical channels and reset timeslots */
 void trx_sched_reset(struct trx_l1h *l1h);
 
+/* write the current state to the burst trace */
+void trx_sched_trace_state(struct trx_l1h *l1h);
+
+/* name of a logical channel type */
+const char *trx_sched_chan_name(enum trx_chan_type chan);
+
 #endif /* TRX_SCHEDULER_H */
@@ -40,6 +40,7 @@
 #include "l1_if.h"
 #include "trx_if.h"
 #include "scheduler.h"
+#include "trx_trace.h"
 
 /* enable to print RSSI level graph */
 //#define TOA_RSSI_DEBUG
@@ -134,6 +135,7 @@ static int trx_clk_read_cb(struct osmo_fd *ofd, unsigned int what)
 
 		sscanf(buf, "IND CLOCK %u", &fn);
 		LOGP(DTRX, LOGL_INFO, "Clock indication: fn=%u\n", fn);
+		trx_trace(TRX_TRACE_CLOCK, 0, &fn, sizeof(fn));
 		trx_sched_clock(fn);
 	} else
 		LOGP(DTRX, LOGL_NOTICE, "Unknown message on clock port: %s\n",
@@ -163,6 +165,7 @@ static void trx_ctrl_send(struct trx_l1h *l1h)
 		l1h->trx->nr);
 	/* send command */
 	send(l1h->trx_ofd_ctrl.fd, tcm->cmd, strlen(tcm->cmd)+1, 0);
+	trx_trace(TRX_TRACE_CMD, l1h->trx->nr, tcm->cmd, strlen(tcm->cmd));
 
 	/* start timer */
 	l1h->trx_ctrl_timer.cb = trx_ctrl_timer_cb;
@@ -315,6 +318,7 @@ static int trx_ctrl_read_cb(struct osmo_fd *ofd, unsigned int what)
 	if (len <= 0)
 		return len;
 	buf[len] = '\0';
+	trx_trace(TRX_TRACE_RSP, l1h->trx->nr, buf, strlen(buf));
 
 	if (!strncmp(buf, "RSP ", 4)) {
 		struct trx_ctrl_msg *tcm;
@@ -392,31 +396,20 @@ static int trx_data_read_cb(struct osmo_fd *ofd, unsigned int what)
 	int len;
 	uint8_t tn;
 	int8_t rssi;
-	float toa;
+	int16_t toa256;
 	uint32_t fn;
 	sbit_t bits[148];
-	int i;
 
 	len = recv(ofd->fd, buf, sizeof(buf), 0);
 	if (len <= 0)
 		return len;
-	if (len != 158) {
+	trx_trace(TRX_TRACE_UL, l1h->trx->nr, buf, len);
+	if (len != TRX_IF_UL_LEN) {
 		LOGP(DTRX, LOGL_NOTICE, "Got data message with invalid lenght "
 			"'%d'\n", len);
 		return -EINVAL;
 	}
-	tn = buf[0];
-	fn = (buf[1] << 24) | (buf[2] << 16) | (buf[3] << 8) | buf[4];
-	rssi = -(int8_t)buf[5];
-	toa = ((int16_t)(buf[6] << 8) | buf[7]) / 256.0F;
-
-	/* copy and convert bits {254..0} to sbits {-127..127} */
-	for (i = 0; i < 148; i++) {
-		if (buf[8 + i] == 255)
-			bits[i] = -127;
-		else
-			bits[i] = 127 - buf[8 + i];
-	}
+	trx_if_ul_parse(buf, &tn, &fn, &rssi, &toa256, bits);
 
 	if (tn >= 8) {
 		LOGP(DTRX, LOGL_ERROR, "Illegal TS %d\n", tn);
@@ -427,19 +420,20 @@ static int trx_data_read_cb(struct osmo_fd *ofd, unsigned int what)
 		return -EINVAL;
 	}
 
-	LOGP(DTRX, LOGL_DEBUG, "RX burst tn=%u fn=%u rssi=%d toa=%.2f\n",
-		tn, fn, rssi, toa);
+	LOGP_HOT(DTRX, LOGL_DEBUG, "RX burst tn=%u fn=%u rssi=%d toa=%.2f\n",
+		tn, fn, rssi, toa256 / 256.0F);
 
 #ifdef TOA_RSSI_DEBUG
 	char deb[128];
 
 	sprintf(deb, "|                                0              "
-		"                 | rssi=%4d  toa=%4.2f fn=%u", rssi, toa, fn);
+		"                 | rssi=%4d  toa=%4.2f fn=%u", rssi, toa256 / 256.0F,
+		fn);
 	deb[1 + (128 + rssi) / 4] = '*';
 	fprintf(stderr, "%s\n", deb);
 #endif
 
-	trx_sched_ul_burst(l1h, tn, fn, bits, rssi, toa);
+	trx_sched_ul_burst(l1h, tn, fn, bits, rssi, toa256);
 
 	return 0;
 }
@@ -449,7 +443,7 @@ int trx_if_data(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
 {
 	uint8_t buf[256];
 
-	LOGP(DTRX, LOGL_DEBUG, "TX burst tn=%u fn=%u pwr=%u\n", tn, fn, pwr);
+	LOGP_HOT(DTRX, LOGL_DEBUG, "TX burst tn=%u fn=%u pwr=%u\n", tn, fn, pwr);
 
 	buf[0] = tn;
 	buf[1] = (fn >> 24) & 0xff;
@@ -465,6 +459,7 @@ int trx_if_data(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
 	 * data */
 	if (transceiver_available && llist_empty(&l1h->trx_ctrl_list)) {
 		send(l1h->trx_ofd_data.fd, buf, 154, 0);
+		trx_trace(TRX_TRACE_DL, l1h->trx->nr, buf, 154);
 	} else
 		LOGP(DTRX, LOGL_DEBUG, "Ignoring TX data, transceiver "
 			"offline.\n");
@@ -32,4 +32,27 @@ int trx_if_open(struct trx_l1h *l1h);
 void trx_if_flush(struct trx_l1h *l1h);
 void trx_if_close(struct trx_l1h *l1h);
 
+/* length of an uplink datagram */
+#define TRX_IF_UL_LEN	158
+
+/* get the fields of an uplink datagram */
+static inline void trx_if_ul_parse(const uint8_t *buf, uint8_t *tn,
+	uint32_t *fn, int8_t *rssi, int16_t *toa256, sbit_t *bits)
+{
+	int i;
+
+	*tn = buf[0];
+	*fn = (buf[1] << 24) | (buf[2] << 16) | (buf[3] << 8) | buf[4];
+	*rssi = -(int8_t)buf[5];
+	*toa256 = ((int16_t)(buf[6] << 8) | buf[7]);
+
+	/* copy and convert bits {254..0} to sbits {-127..127} */
+	for (i = 0; i < 148; i++) {
+		if (buf[8 + i] == 255)
+			bits[i] = -127;
+		else
+			bits[i] = 127 - buf[8 + i];
+	}
+}
+
 #endif /* TRX_IF_H */
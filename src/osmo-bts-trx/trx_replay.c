@@ -0,0 +1,244 @@
+/* Replay of burst traces through the OsmoBTS-TRX scheduler */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <osmocom/core/bits.h>
+#include <osmocom/core/utils.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/l1sap.h>
+
+#include "l1_if.h"
+#include "trx_if.h"
+#include "scheduler.h"
+#include "trx_trace.h"
+#include "trx_replay.h"
+
+/* The records of a trace drive the scheduler, as fast as it can process
+ * them, in place of the sockets of trx_if.c.  Clock indications and the frames the scheduler processed
+ * on its own timer go to trx_sched_clock(), uplink datagrams to
+ * trx_sched_ul_burst() and the configuration records to the
+ * trx_sched_set_*() functions that recorded them.  There is neither Abis
+ * nor PCU, so the downlink blocks of the BSC are not part of the replay,
+ * only those the BTS generates itself and the responses of LAPDm. */
+
+static const struct value_string trace_type_names[] = {
+	{ TRX_TRACE_CLOCK,	"clock" },
+	{ TRX_TRACE_UL,		"uplink" },
+	{ TRX_TRACE_DL,		"downlink" },
+	{ TRX_TRACE_CMD,	"command" },
+	{ TRX_TRACE_RSP,	"response" },
+	{ TRX_TRACE_FN,		"frame" },
+	{ TRX_TRACE_CONFIG,	"config" },
+	{ TRX_TRACE_PCHAN,	"pchan" },
+	{ TRX_TRACE_LCHAN,	"lchan" },
+	{ TRX_TRACE_MODE,	"mode" },
+	{ TRX_TRACE_CIPHER,	"cipher" },
+	{ TRX_TRACE_RESET,	"reset" },
+	{ 0, NULL }
+};
+
+/* shortest payload of each record type */
+static const uint16_t trace_min_len[_TRX_TRACE_MAX] = {
+	[TRX_TRACE_CLOCK]	= sizeof(uint32_t),
+	[TRX_TRACE_CONFIG]	= sizeof(struct trx_trace_config),
+	[TRX_TRACE_PCHAN]	= sizeof(struct trx_trace_pchan),
+	[TRX_TRACE_LCHAN]	= sizeof(struct trx_trace_lchan),
+	[TRX_TRACE_MODE]	= sizeof(struct trx_trace_mode),
+	[TRX_TRACE_CIPHER]	= sizeof(struct trx_trace_cipher),
+};
+
+struct trx_replay_stats trx_replay = {
+	.dl_digest = 2166136261u,
+};
+
+void trx_replay_reset(void)
+{
+	memset(&trx_replay, 0, sizeof(trx_replay));
+	trx_replay.dl_digest = 2166136261u;
+}
+
+const char *trx_trace_type_name(uint8_t type)
+{
+	return get_value_string(trace_type_names, type);
+}
+
+static inline uint32_t fnv1a(uint32_t h, uint8_t c)
+{
+	return (h ^ c) * 16777619u;
+}
+
+/* the downlink bursts are summed up in a digest, so that the replays of
+ * two builds can be compared */
+void trx_replay_dl(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
+	const ubit_t *bits)
+{
+	uint32_t h = trx_replay.dl_digest;
+	int i;
+
+	h = fnv1a(h, l1h->trx->nr);
+	h = fnv1a(h, tn);
+	h = fnv1a(h, fn >> 16);
+	h = fnv1a(h, fn >> 8);
+	h = fnv1a(h, fn);
+	h = fnv1a(h, pwr);
+	for (i = 0; i < 148; i++)
+		h = fnv1a(h, bits[i]);
+	trx_replay.dl_digest = h;
+	trx_replay.dl_bursts++;
+}
+
+static void replay_ul(struct trx_l1h *l1h, const uint8_t *buf, int len)
+{
+	uint8_t tn;
+	int8_t rssi;
+	int16_t toa256;
+	uint32_t fn;
+	sbit_t bits[148];
+
+	if (len != TRX_IF_UL_LEN) {
+		trx_replay.invalid++;
+		return;
+	}
+	trx_if_ul_parse(buf, &tn, &fn, &rssi, &toa256, bits);
+	if (tn >= 8 || fn >= 2715648) {
+		trx_replay.invalid++;
+		return;
+	}
+
+	trx_sched_ul_burst(l1h, tn, fn, bits, rssi, toa256);
+}
+
+/* the upper layers activate the lchan together with its channels */
+static void replay_lchan(struct trx_l1h *l1h,
+	const struct trx_trace_lchan *tl)
+{
+	struct gsm_lchan *lchan = &l1h->trx->ts[L1SAP_CHAN2TS(tl->chan_nr)]
+		.lchan[l1sap_chan2ss(tl->chan_nr)];
+
+	trx_sched_set_lchan(l1h, tl->chan_nr, tl->link_id, tl->active);
+
+	if ((tl->chan_nr & 0x80))
+		return;
+	if (tl->active && !tl->link_id && lchan->state != LCHAN_S_ACTIVE) {
+		lchan_init_lapdm(lchan);
+		lchan_set_state(lchan, LCHAN_S_ACTIVE);
+	}
+	if (!tl->active && tl->link_id)
+		lchan_set_state(lchan, LCHAN_S_NONE);
+}
+
+static void replay_mode(struct trx_l1h *l1h, const struct trx_trace_mode *tm)
+{
+	struct gsm_lchan *lchan = &l1h->trx->ts[L1SAP_CHAN2TS(tm->chan_nr)]
+		.lchan[l1sap_chan2ss(tm->chan_nr)];
+
+	lchan->rsl_cmode = tm->rsl_cmode;
+	lchan->tch_mode = tm->tch_mode;
+	trx_sched_set_mode(l1h, tm->chan_nr, tm->rsl_cmode, tm->tch_mode,
+		tm->codecs, tm->codec[0], tm->codec[1], tm->codec[2],
+		tm->codec[3], tm->initial_id, tm->handover, tm->dtx);
+}
+
+/* process the frames up to 'fn', as the clock of the transceiver did */
+static void replay_clock(uint32_t fn)
+{
+	uint32_t last_fn = transceiver_last_fn;
+	int avail = transceiver_available;
+	uint32_t elapsed_fn;
+
+	trx_sched_clock(fn);
+
+	elapsed_fn = (transceiver_last_fn + 2715648 - last_fn) % 2715648;
+	if (!avail || elapsed_fn > 50)
+		trx_replay.frames++;
+	else
+		trx_replay.frames += elapsed_fn;
+}
+
+void trx_replay_record(struct gsm_bts *bts,
+	const struct trx_trace_rec *rec)
+{
+	const struct trx_trace_config *tc;
+	const struct trx_trace_pchan *tp;
+	const struct trx_trace_cipher *tch;
+	struct gsm_bts_trx *trx;
+	struct trx_l1h *l1h;
+	uint32_t fn;
+
+	trx_replay.records[rec->type]++;
+	trx_replay.recorded_us += rec->delta_us;
+
+	trx = gsm_bts_trx_num(bts, rec->trx);
+	if (!trx || rec->len < trace_min_len[rec->type]) {
+		trx_replay.invalid++;
+		return;
+	}
+	l1h = trx_l1h_hdl(trx);
+
+	switch (rec->type) {
+	case TRX_TRACE_CLOCK:
+		memcpy(&fn, rec->data, sizeof(fn));
+		replay_clock(fn);
+		break;
+	case TRX_TRACE_FN:
+		/* frames of a clock indication are already processed, only
+		 * those of the scheduler's timer are left */
+		if (!transceiver_available || rec->fn != transceiver_last_fn)
+			replay_clock(rec->fn);
+		break;
+	case TRX_TRACE_UL:
+		replay_ul(l1h, rec->data, rec->len);
+		break;
+	case TRX_TRACE_CONFIG:
+		tc = (const struct trx_trace_config *) rec->data;
+		l1h->config.poweron = tc->poweron;
+		l1h->config.tsc = tc->tsc;
+		l1h->config.slotmask = tc->slotmask;
+		bts->bsic = tc->bsic;
+		break;
+	case TRX_TRACE_PCHAN:
+		tp = (const struct trx_trace_pchan *) rec->data;
+		trx_sched_set_pchan(l1h, tp->tn, tp->pchan);
+		break;
+	case TRX_TRACE_LCHAN:
+		replay_lchan(l1h, (const struct trx_trace_lchan *) rec->data);
+		break;
+	case TRX_TRACE_MODE:
+		replay_mode(l1h, (const struct trx_trace_mode *) rec->data);
+		break;
+	case TRX_TRACE_CIPHER:
+		tch = (const struct trx_trace_cipher *) rec->data;
+		if (rec->len < sizeof(*tch) + tch->key_len) {
+			trx_replay.invalid++;
+			break;
+		}
+		trx_sched_set_cipher(l1h, tch->chan_nr, tch->downlink,
+			tch->algo, (uint8_t *) tch->key, tch->key_len);
+		break;
+	case TRX_TRACE_RESET:
+		trx_sched_reset(l1h);
+		break;
+	default:
+		/* downlink and control are output of the BTS */
+		break;
+	}
+}
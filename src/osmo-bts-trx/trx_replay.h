@@ -0,0 +1,29 @@
+#ifndef TRX_REPLAY_H
+#define TRX_REPLAY_H
+
+#include <osmocom/core/bits.h>
+
+#include "trx_trace.h"
+
+struct gsm_bts;
+struct trx_l1h;
+
+struct trx_replay_stats {
+	uint32_t	records[_TRX_TRACE_MAX];
+	uint32_t	invalid;
+	uint32_t	frames;
+	uint32_t	dl_bursts;
+	uint32_t	dl_digest;	/* FNV-1a of the downlink bursts */
+	uint64_t	recorded_us;
+};
+
+extern struct trx_replay_stats trx_replay;
+
+void trx_replay_reset(void);
+void trx_replay_record(struct gsm_bts *bts, const struct trx_trace_rec *rec);
+/* add a downlink burst of the scheduler to the digest */
+void trx_replay_dl(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
+	const ubit_t *bits);
+const char *trx_trace_type_name(uint8_t type);
+
+#endif /* TRX_REPLAY_H */
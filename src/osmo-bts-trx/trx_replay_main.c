@@ -0,0 +1,323 @@
+/* Replay of burst traces through the OsmoBTS-TRX scheduler */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/bits.h>
+#include <osmocom/core/utils.h>
+#include <osmocom/core/logging.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/bts_model.h>
+
+#include "l1_if.h"
+#include "trx_if.h"
+#include "scheduler.h"
+#include "trx_trace.h"
+#include "trx_replay.h"
+
+/* The replay takes the place of trx_if.c: nothing is sent to a
+ * transceiver, the records of the trace are fed to the scheduler by
+ * trx_replay_record() and the downlink bursts only end up in a digest. */
+
+const int pcu_direct = 0;
+int quit = 0;
+uint8_t abis_mac[6] = { 0, 1, 2, 3, 4, 5 };
+
+int transceiver_available = 0;
+const char *transceiver_ip = "127.0.0.1";
+int settsc_enabled = 1;
+int setbsic_enabled = 1;
+
+static int log_level = LOGL_NOTICE;
+
+
+/*
+ * the transceiver interface
+ */
+
+/* commands are not sent anywhere, their responses are in the trace */
+int trx_if_cmd_poweroff(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_poweron(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_settsc(struct trx_l1h *l1h, uint8_t tsc)
+{
+	return 0;
+}
+
+int trx_if_cmd_setbsic(struct trx_l1h *l1h, uint8_t bsic)
+{
+	return 0;
+}
+
+int trx_if_cmd_setrxgain(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setpower(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setmaxdly(struct trx_l1h *l1h, int dly)
+{
+	return 0;
+}
+
+int trx_if_cmd_setslot(struct trx_l1h *l1h, uint8_t tn, uint8_t type)
+{
+	return 0;
+}
+
+int trx_if_cmd_rxtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_txtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_handover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+int trx_if_cmd_nohandover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+int trx_if_data(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
+	const ubit_t *bits)
+{
+	trx_replay_dl(l1h, tn, fn, pwr, bits);
+
+	return 0;
+}
+
+int trx_if_open(struct trx_l1h *l1h)
+{
+	INIT_LLIST_HEAD(&l1h->trx_ctrl_list);
+
+	/* enable all slots, until the trace configures them */
+	l1h->config.slotmask = 0xff;
+
+	return 0;
+}
+
+void trx_if_flush(struct trx_l1h *l1h)
+{
+}
+
+void trx_if_close(struct trx_l1h *l1h)
+{
+}
+
+
+/*
+ * the rest of the BTS
+ */
+
+int bts_model_init(struct gsm_bts *bts)
+{
+	struct trx_l1h *l1h;
+	struct gsm_bts_trx *trx;
+
+	llist_for_each_entry(trx, &bts->trx_list, list) {
+		l1h = l1if_open(trx);
+		if (!l1h) {
+			LOGP(DL1C, LOGL_FATAL, "Cannot open L1 Interface\n");
+			return -EIO;
+		}
+
+		trx->role_bts.l1h = l1h;
+		trx->nominal_power = 23;
+
+		l1if_reset(l1h);
+	}
+
+	return 0;
+}
+
+/* dummy, since no direct dsp support */
+uint32_t trx_get_hlayer1(struct gsm_bts_trx *trx)
+{
+	return 0;
+}
+
+
+/*
+ * replay
+ */
+
+static uint64_t clock_us(clockid_t clk)
+{
+	struct timespec ts;
+
+	clock_gettime(clk, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void print_stats(uint64_t wall_us, uint64_t cpu_us)
+{
+	int i;
+
+	printf("records:");
+	for (i = TRX_TRACE_CLOCK; i < _TRX_TRACE_MAX; i++)
+		printf(" %u %s", trx_replay.records[i],
+			trx_trace_type_name(i));
+	printf(", %u invalid\n", trx_replay.invalid);
+	printf("frames: %u, downlink bursts: %u recorded, %u replayed, "
+		"digest %08x\n", trx_replay.frames, trx_replay.records[TRX_TRACE_DL],
+		trx_replay.dl_bursts, trx_replay.dl_digest);
+	printf("recorded: %.3f s, replayed: %.3f s wall, %.3f s CPU",
+		trx_replay.recorded_us / 1e6, wall_us / 1e6, cpu_us / 1e6);
+	if (wall_us)
+		printf(", %.1f frames/s, %.1f times real time",
+			trx_replay.frames * 1e6 / wall_us,
+			(double) trx_replay.recorded_us / wall_us);
+	printf("\n");
+}
+
+static void print_help()
+{
+	printf( "Usage: osmobts-trx-replay [options] TRACE\n"
+		"Some useful options:\n"
+		"  -h	--help		this text\n"
+		"  -d	--debug MASK	Enable debugging (e.g. -d DL1C:DTRX)\n"
+		"  -e	--log-level	Set a global log-level (default=%d)\n"
+		, log_level);
+}
+
+static void handle_options(int argc, char **argv)
+{
+	while (1) {
+		int option_idx = 0, c;
+		static const struct option long_options[] = {
+			{ "help", 0, 0, 'h' },
+			{ "debug", 1, 0, 'd' },
+			{ "log-level", 1, 0, 'e' },
+			{ 0, 0, 0, 0 }
+		};
+
+		c = getopt_long(argc, argv, "hd:e:",
+				long_options, &option_idx);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'h':
+			print_help();
+			exit(0);
+			break;
+		case 'd':
+			log_parse_category_mask(osmo_stderr_target, optarg);
+			break;
+		case 'e':
+			log_level = atoi(optarg);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct trx_trace_reader reader;
+	const struct trx_trace_rec *rec;
+	struct gsm_bts *bts;
+	struct gsm_bts_trx *trx;
+	uint64_t wall_us, cpu_us;
+	void *tall_msgb_ctx;
+	int rc, i;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+	handle_options(argc, argv);
+	log_set_log_level(osmo_stderr_target, log_level);
+	bts_log_cache_update();
+
+	if (optind != argc - 1) {
+		print_help();
+		exit(2);
+	}
+	rc = trx_trace_reader_open(&reader, argv[optind]);
+	if (rc < 0) {
+		fprintf(stderr, "Cannot read trace '%s': %s\n", argv[optind],
+			strerror(-rc));
+		exit(1);
+	}
+
+	bts = gsm_bts_alloc(tall_bts_ctx);
+	if (!bts) {
+		fprintf(stderr, "Failed to create BTS structure\n");
+		exit(1);
+	}
+	for (i = 1; i < reader.hdr->trx_num; i++) {
+		trx = gsm_bts_trx_alloc(bts);
+		if (!trx) {
+			fprintf(stderr, "Failed to TRX structure\n");
+			exit(1);
+		}
+	}
+	if (bts_init(bts) < 0) {
+		fprintf(stderr, "unable to to open bts\n");
+		exit(1);
+	}
+	/* done by the OPSTART of the TRX, RACH goes to this lchan */
+	lchan_init_lapdm(&bts->c0->ts[0].lchan[4]);
+
+	wall_us = clock_us(CLOCK_MONOTONIC);
+	cpu_us = clock_us(CLOCK_PROCESS_CPUTIME_ID);
+
+	while ((rec = trx_trace_reader_next(&reader)))
+		trx_replay_record(bts, rec);
+
+	wall_us = clock_us(CLOCK_MONOTONIC) - wall_us;
+	cpu_us = clock_us(CLOCK_PROCESS_CPUTIME_ID) - cpu_us;
+
+	trx_trace_reader_close(&reader);
+	print_stats(wall_us, cpu_us);
+
+	exit(0);
+}
@@ -0,0 +1,279 @@
+/* Recording and reading burst traces of the transceiver interface */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/bits.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+
+#include "l1_if.h"
+#include "scheduler.h"
+#include "trx_trace.h"
+
+/* the file grows by this size, each time it is full */
+#define TRX_TRACE_CHUNK		(16 << 20)
+
+int trx_trace_on = 0;
+
+static struct {
+	int		fd;
+	char		*path;
+	uint8_t		*map;
+	size_t		size;		/* allocated and mapped */
+	size_t		len;		/* used by records */
+	uint64_t	last_us;	/* time of the previous record */
+	uint32_t	records;
+} trace = { .fd = -1 };
+
+static uint64_t trace_now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* make room for 'need' more bytes and map the whole file again */
+static int trace_grow(size_t need)
+{
+	size_t size = trace.size;
+	void *map;
+	int rc;
+
+	while (size < trace.len + need)
+		size += TRX_TRACE_CHUNK;
+
+	/* allocate the blocks, so that a full disk fails here and not with
+	 * SIGBUS when writing to the mapping */
+	rc = posix_fallocate(trace.fd, trace.size, size - trace.size);
+	if (rc)
+		return -rc;
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, trace.fd,
+		0);
+	if (map == MAP_FAILED)
+		return -errno;
+	if (trace.map)
+		munmap(trace.map, trace.size);
+	trace.map = map;
+	trace.size = size;
+
+	return 0;
+}
+
+void trx_trace_write(uint8_t type, uint8_t trx, const void *data,
+	unsigned int len)
+{
+	struct trx_trace_rec *rec;
+	size_t rec_len = (sizeof(*rec) + len + 3) & ~3;
+	uint64_t now_us;
+	int rc;
+
+	if (trace.len + rec_len > trace.size) {
+		rc = trace_grow(rec_len);
+		if (rc < 0) {
+			LOGP(DTRX, LOGL_ERROR, "Stopping trace '%s': %s\n",
+				trace.path, strerror(-rc));
+			trx_trace_close();
+			return;
+		}
+	}
+
+	now_us = trace_now_us();
+	rec = (struct trx_trace_rec *) (trace.map + trace.len);
+	rec->type = type;
+	rec->trx = trx;
+	rec->len = len;
+	rec->fn = transceiver_last_fn;
+	rec->delta_us = now_us - trace.last_us;
+	if (len)
+		memcpy(rec->data, data, len);
+
+	trace.last_us = now_us;
+	trace.len += rec_len;
+	trace.records++;
+}
+
+void trx_trace_config(struct trx_l1h *l1h)
+{
+	struct trx_trace_config config;
+
+	if (!trx_trace_on)
+		return;
+
+	config.poweron = l1h->config.poweron;
+	/* the scheduler codes the RACH with the BSIC of the BTS */
+	config.bsic = l1h->trx->bts->bsic;
+	config.tsc = l1h->config.tsc;
+	config.slotmask = l1h->config.slotmask;
+	trx_trace_write(TRX_TRACE_CONFIG, l1h->trx->nr, &config,
+		sizeof(config));
+}
+
+int trx_trace_open(struct gsm_bts *bts, const char *path)
+{
+	struct trx_trace_hdr *hdr;
+	struct gsm_bts_trx *trx;
+	struct timeval tv;
+	int rc;
+
+	trx_trace_close();
+
+	trace.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (trace.fd < 0)
+		return -errno;
+	trace.map = NULL;
+	trace.size = 0;
+	trace.len = 0;
+	trace.records = 0;
+	rc = trace_grow(sizeof(*hdr));
+	if (rc < 0) {
+		close(trace.fd);
+		trace.fd = -1;
+		return rc;
+	}
+	trace.path = talloc_strdup(tall_bts_ctx, path);
+
+	gettimeofday(&tv, NULL);
+	hdr = (struct trx_trace_hdr *) trace.map;
+	hdr->magic = TRX_TRACE_MAGIC;
+	hdr->version = TRX_TRACE_VERSION;
+	hdr->trx_num = bts->num_trx;
+	hdr->sec = tv.tv_sec;
+	hdr->usec = tv.tv_usec;
+	trace.len = sizeof(*hdr);
+	trace.last_us = trace_now_us();
+	trx_trace_on = 1;
+
+	/* a trace may start at any time, so it begins with the current
+	 * state of each scheduler */
+	llist_for_each_entry(trx, &bts->trx_list, list)
+		trx_sched_trace_state(trx_l1h_hdl(trx));
+
+	LOGP(DTRX, LOGL_NOTICE, "Recording trace to '%s'\n", path);
+
+	return 0;
+}
+
+void trx_trace_close(void)
+{
+	if (!trx_trace_on)
+		return;
+	trx_trace_on = 0;
+
+	munmap(trace.map, trace.size);
+	trace.map = NULL;
+	/* drop the unused part of the last chunk */
+	if (ftruncate(trace.fd, trace.len) < 0)
+		LOGP(DTRX, LOGL_ERROR, "Failed to truncate trace '%s': %s\n",
+			trace.path, strerror(errno));
+	close(trace.fd);
+	trace.fd = -1;
+
+	LOGP(DTRX, LOGL_NOTICE, "Trace '%s' closed after %u records, "
+		"%lu bytes\n", trace.path, trace.records,
+		(unsigned long) trace.len);
+	talloc_free(trace.path);
+	trace.path = NULL;
+}
+
+const char *trx_trace_path(void)
+{
+	return trx_trace_on ? trace.path : NULL;
+}
+
+int trx_trace_reader_open(struct trx_trace_reader *r, const char *path)
+{
+	struct stat st;
+	void *map;
+	int fd, rc;
+
+	memset(r, 0, sizeof(*r));
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -errno;
+	if (fstat(fd, &st) < 0) {
+		rc = -errno;
+		close(fd);
+		return rc;
+	}
+	if (st.st_size < sizeof(struct trx_trace_hdr)) {
+		close(fd);
+		return -EINVAL;
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	rc = -errno;
+	close(fd);
+	if (map == MAP_FAILED)
+		return rc;
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+	r->map = map;
+	r->size = st.st_size;
+	r->hdr = map;
+	r->pos = sizeof(*r->hdr);
+	if (r->hdr->magic == TRX_TRACE_MAGIC_SWAPPED) {
+		LOGP(DTRX, LOGL_ERROR, "Trace '%s' was recorded on a host of "
+			"the other byte order\n", path);
+		trx_trace_reader_close(r);
+		return -EINVAL;
+	}
+	if (r->hdr->magic != TRX_TRACE_MAGIC
+	 || r->hdr->version != TRX_TRACE_VERSION) {
+		LOGP(DTRX, LOGL_ERROR, "Trace '%s' is no trace of version %u\n",
+			path, TRX_TRACE_VERSION);
+		trx_trace_reader_close(r);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+const struct trx_trace_rec *trx_trace_reader_next(struct trx_trace_reader *r)
+{
+	const struct trx_trace_rec *rec;
+
+	if (r->pos + sizeof(*rec) > r->size)
+		return NULL;
+	rec = (const struct trx_trace_rec *) (r->map + r->pos);
+	if (rec->type == TRX_TRACE_END || rec->type >= _TRX_TRACE_MAX
+	 || r->pos + sizeof(*rec) + rec->len > r->size)
+		return NULL;
+	r->pos += (sizeof(*rec) + rec->len + 3) & ~3;
+
+	return rec;
+}
+
+void trx_trace_reader_close(struct trx_trace_reader *r)
+{
+	if (r->map)
+		munmap((void *) r->map, r->size);
+	memset(r, 0, sizeof(*r));
+}
@@ -0,0 +1,120 @@
+#ifndef TRX_TRACE_H
+#define TRX_TRACE_H
+
+/* A burst trace records everything that enters or leaves the scheduler:
+ * the datagrams and control messages of the transceiver interface, the
+ * frames processed and the configuration of the scheduler by the upper
+ * layers.  It starts with a header, followed by records, each aligned to
+ * 4 bytes.  All values are in the byte order of the recording host, the
+ * magic tells it, so a trace is only read on a host of the same byte order.
+ * The version changes with the layout of any record.  The file is zero
+ * filled beyond the last record, so a trace of a crashed process ends at
+ * the first record of type TRX_TRACE_END. */
+
+#define TRX_TRACE_MAGIC		0x54585254	/* "TRXT" */
+#define TRX_TRACE_MAGIC_SWAPPED	0x54525854	/* of the other byte order */
+#define TRX_TRACE_VERSION	2
+
+enum trx_trace_type {
+	TRX_TRACE_END = 0,
+	TRX_TRACE_CLOCK,	/* IND CLOCK, uint32_t fn */
+	TRX_TRACE_UL,		/* uplink datagram as received */
+	TRX_TRACE_DL,		/* downlink datagram as sent */
+	TRX_TRACE_CMD,		/* control command, string */
+	TRX_TRACE_RSP,		/* control response, string */
+	TRX_TRACE_FN,		/* frame rec->fn processed by scheduler */
+	TRX_TRACE_CONFIG,	/* struct trx_trace_config */
+	TRX_TRACE_PCHAN,	/* struct trx_trace_pchan */
+	TRX_TRACE_LCHAN,	/* struct trx_trace_lchan */
+	TRX_TRACE_MODE,		/* struct trx_trace_mode */
+	TRX_TRACE_CIPHER,	/* struct trx_trace_cipher */
+	TRX_TRACE_RESET,	/* scheduler of the TRX was reset */
+	_TRX_TRACE_MAX
+};
+
+struct trx_trace_hdr {
+	uint32_t		magic;
+	uint16_t		version;
+	uint16_t		trx_num;	/* number of TRX of the BTS */
+	uint32_t		sec, usec;	/* time of day at start */
+};
+
+struct trx_trace_rec {
+	uint8_t			type;
+	uint8_t			trx;
+	uint16_t		len;		/* of data[] */
+	uint32_t		fn;		/* last fn of scheduler */
+	uint32_t		delta_us;	/* since the previous record */
+	uint8_t			data[0];
+};
+
+struct trx_trace_config {
+	uint8_t			poweron;
+	uint8_t			bsic;
+	uint8_t			tsc;
+	uint8_t			slotmask;
+};
+
+struct trx_trace_pchan {
+	uint8_t			tn;
+	uint8_t			pchan;
+};
+
+struct trx_trace_lchan {
+	uint8_t			chan_nr;
+	uint8_t			link_id;
+	uint8_t			active;
+};
+
+struct trx_trace_mode {
+	uint8_t			chan_nr;
+	uint8_t			rsl_cmode;
+	uint8_t			tch_mode;
+	uint8_t			codecs;
+	uint8_t			codec[4];
+	uint8_t			initial_id;
+	uint8_t			handover;
+	uint8_t			dtx;		/* RSL_CMOD_DTXu/d */
+};
+
+struct trx_trace_cipher {
+	uint8_t			chan_nr;
+	uint8_t			downlink;
+	int8_t			algo;
+	uint8_t			key_len;
+	uint8_t			key[0];
+};
+
+struct gsm_bts;
+struct trx_l1h;
+
+/* set while a trace is recorded, so that the hooks cost a single test */
+extern int trx_trace_on;
+
+int trx_trace_open(struct gsm_bts *bts, const char *path);
+void trx_trace_close(void);
+const char *trx_trace_path(void);
+void trx_trace_write(uint8_t type, uint8_t trx, const void *data,
+	unsigned int len);
+void trx_trace_config(struct trx_l1h *l1h);
+
+static inline void trx_trace(uint8_t type, uint8_t trx, const void *data,
+	unsigned int len)
+{
+	if (trx_trace_on)
+		trx_trace_write(type, trx, data, len);
+}
+
+/* reading a trace */
+struct trx_trace_reader {
+	const uint8_t		*map;
+	size_t			size;
+	size_t			pos;
+	const struct trx_trace_hdr *hdr;
+};
+
+int trx_trace_reader_open(struct trx_trace_reader *r, const char *path);
+const struct trx_trace_rec *trx_trace_reader_next(struct trx_trace_reader *r);
+void trx_trace_reader_close(struct trx_trace_reader *r);
+
+#endif /* TRX_TRACE_H */
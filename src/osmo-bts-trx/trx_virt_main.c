@@ -0,0 +1,1166 @@
+/* Virtual transceiver and fake MS load generator for OsmoBTS-TRX */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <getopt.h>
+#include <time.h>
+#include <math.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <netinet/in.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/utils.h>
+#include <osmocom/core/select.h>
+#include <osmocom/core/timer.h>
+#include <osmocom/core/logging.h>
+#include <osmocom/core/socket.h>
+#include <osmocom/core/bits.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/l1sap.h>
+
+#include "l1_if.h"
+#include "sched_mframe.h"
+#include "gsm0503_coding.h"
+
+/* The virtual transceiver takes the place of OsmoTRX: it binds the clock,
+ * control and data ports of up to VTRX_MAX_TRX transceivers, acknowledges
+ * every control command and sends a clock indication for every TDMA
+ * frame.  The clock can be sped up, so that the BTS can be driven at a
+ * multiple of the real load.
+ *
+ * The mobile stations are uplink burst generators: there is no layer 3,
+ * so they don't follow assignments of the BSC.  Instead, a fraction of the
+ * dedicated channels of the configured timeslots is occupied by an MS,
+ * which sends LAPDm fill frames on SDCCH and SACCH, speech frames of
+ * random content on TCH and dummy blocks on PDTCH.  All other MSs send
+ * access bursts on the RACH.  The bursts are channel coded like the BTS
+ * does it for the downlink and get white noise and a timing offset. */
+
+#define VTRX_MAX_TRX		8
+#define VTRX_HYPERFRAME		2715648
+#define VTRX_FRAME_NS		4615385
+/* frames emulated in one timer expiry at most, if we are late */
+#define VTRX_MAX_CATCHUP	8
+/* access bursts that wait for a RACH slot at most */
+#define VTRX_MAX_RACH_PENDING	100.0
+#define VTRX_NOISE_TABLE	4096
+/* amplitude of a soft bit without noise */
+#define VTRX_SBIT_AMPL		64
+
+enum vtrx_codec {
+	VTRX_CODEC_FR,
+	VTRX_CODEC_EFR,
+	VTRX_CODEC_AMR,
+};
+
+/* the classes of uplink channels, the frame error rate is counted for */
+enum vtrx_class {
+	VTRX_CL_RACH,
+	VTRX_CL_XCCH,
+	VTRX_CL_TCHF,
+	VTRX_CL_TCHH,
+	VTRX_CL_PDTCH,
+	_NUM_VTRX_CL
+};
+
+static const char *vtrx_class_names[_NUM_VTRX_CL] = {
+	[VTRX_CL_RACH]	= "RACH",
+	[VTRX_CL_XCCH]	= "SDCCH/SACCH",
+	[VTRX_CL_TCHF]	= "TCH/F",
+	[VTRX_CL_TCHH]	= "TCH/H",
+	[VTRX_CL_PDTCH]	= "PDTCH",
+};
+
+/* the uplink of a logical channel */
+struct vtrx_subch {
+	int busy;		/* an MS occupies the channel */
+	uint32_t blocks;	/* blocks sent since the MS arrived */
+	ubit_t bursts[928];	/* interleaving buffer of the encoder */
+	sbit_t soft[928];	/* the same, as the BTS receives it */
+};
+
+struct vtrx_trx_stats {
+	uint32_t ul_bursts;
+	uint32_t dl_bursts;
+	uint32_t dl_late;	/* bursts, that arrived after their frame */
+	int32_t dl_min_slack;	/* frames between arrival and transmission */
+	uint32_t ctrl_cmds;
+	uint32_t malformed;
+};
+
+struct vtrx_trx {
+	struct vtrx_hdl *vtrx;
+	uint8_t nr;
+
+	struct osmo_fd ctrl_ofd;
+	struct osmo_fd data_ofd;
+
+	/* multiframe of each timeslot, as configured by SETSLOT */
+	const struct trx_sched_multiframe *mf[8];
+	struct vtrx_subch subch[8][_TRX_CHAN_MAX];
+
+	struct vtrx_trx_stats stats;
+};
+
+struct vtrx_fer {
+	uint32_t blocks;
+	uint32_t errors;
+};
+
+struct vtrx_hdl {
+	struct osmo_fd clk_ofd;
+	struct vtrx_trx trx[VTRX_MAX_TRX];
+	unsigned int num_trx;
+
+	int poweron;
+	uint8_t bsic;
+
+	/* the emulated clock */
+	struct osmo_timer_list timer;
+	struct timespec start;
+	uint64_t frame_ns;
+	uint64_t frames_done;
+	uint32_t fn;
+	uint32_t frames;
+	uint32_t late_frames;	/* frames skipped, as we were too late */
+
+	/* MSs, that occupy a channel, the others do random access */
+	unsigned int ms_dedicated;
+	double rach_pending;
+	uint32_t rach_sent;
+
+	struct vtrx_fer fer[_NUM_VTRX_CL];
+
+	/* CPU time at the start of the run */
+	struct timespec cpu_start;
+	struct rusage ru_start;
+	unsigned long bts_ticks_start;
+};
+
+static const char *transceiver_ip = "127.0.0.1";
+static uint16_t base_port = 5700;
+static unsigned int num_trx = 1;
+static double speed = 1.0;
+static uint32_t max_frames = 0;
+static unsigned int num_ms = 1000;
+static double access_rate = 10.0;	/* per MS and hour */
+static double load = 1.0;
+static enum vtrx_codec codec = VTRX_CODEC_FR;
+static double snr = INFINITY;
+static double toa_offset = 0.0, toa_jitter = 0.0;	/* in symbols */
+static int8_t rssi = -60;
+static int check_fer = 0;
+static pid_t bts_pid = 0;
+static uint32_t rnd_state = 1;
+static int dump_stats = 0;
+
+static int16_t noise_table[VTRX_NOISE_TABLE];
+
+/* AMR is sent with 12.2 kbits/s only, it must be the only mode of the
+ * active codec set of the BTS */
+static uint8_t amr_codecs[1] = { 7 };
+
+static const uint8_t sdcch_fill[GSM_MACBLOCK_LEN] = {
+	0x01, 0x03, 0x01, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b
+};
+
+/* L1 header (power, timing advance) and a fill frame */
+static const uint8_t sacch_fill[GSM_MACBLOCK_LEN] = {
+	0x05, 0x00, 0x01, 0x03, 0x01, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b
+};
+
+/* packet uplink dummy control block, CS-1 */
+static const uint8_t pdtch_dummy[GSM_MACBLOCK_LEN] = {
+	0x40, 0x20, 0x00, 0x00, 0x00, 0x00, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b
+};
+
+/* xorshift, so that runs are reproducible with the same seed */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+	return rnd_state;
+}
+
+/* uniform in [0, 1) */
+static double rnd_uniform(void)
+{
+	return (rnd() >> 8) / 16777216.0;
+}
+
+/* noise samples in units of soft bits, drawing them from a table is good
+ * enough for load testing and much cheaper than doing it per bit */
+static void noise_init(void)
+{
+	double sigma, u1, u2;
+	int i;
+
+	if (isinf(snr))
+		return;
+
+	sigma = VTRX_SBIT_AMPL * pow(10.0, -snr / 20.0);
+	for (i = 0; i < VTRX_NOISE_TABLE; i++) {
+		u1 = rnd_uniform() + 1.0 / 33554432.0;
+		u2 = rnd_uniform();
+		noise_table[i] = lrint(sigma * sqrt(-2.0 * log(u1))
+			* cos(2.0 * M_PI * u2));
+	}
+}
+
+static enum trx_chan_type chan_owner(enum trx_chan_type chan)
+{
+	switch (chan) {
+	case TRXC_SACCHTF:
+		return TRXC_TCHF;
+	case TRXC_SACCHTH_0:
+	case TRXC_SACCHTH_1:
+		return TRXC_TCHH_0 + chan - TRXC_SACCHTH_0;
+	case TRXC_SACCH4_0:
+	case TRXC_SACCH4_1:
+	case TRXC_SACCH4_2:
+	case TRXC_SACCH4_3:
+		return TRXC_SDCCH4_0 + chan - TRXC_SACCH4_0;
+	case TRXC_SACCH8_0:
+	case TRXC_SACCH8_1:
+	case TRXC_SACCH8_2:
+	case TRXC_SACCH8_3:
+	case TRXC_SACCH8_4:
+	case TRXC_SACCH8_5:
+	case TRXC_SACCH8_6:
+	case TRXC_SACCH8_7:
+		return TRXC_SDCCH8_0 + chan - TRXC_SACCH8_0;
+	default:
+		return chan;
+	}
+}
+
+static enum vtrx_class chan_class(enum trx_chan_type chan)
+{
+	switch (chan) {
+	case TRXC_RACH:
+		return VTRX_CL_RACH;
+	case TRXC_TCHF:
+		return VTRX_CL_TCHF;
+	case TRXC_TCHH_0:
+	case TRXC_TCHH_1:
+		return VTRX_CL_TCHH;
+	case TRXC_PDTCH:
+		return VTRX_CL_PDTCH;
+	default:
+		return VTRX_CL_XCCH;
+	}
+}
+
+static int chan_is_sacch(enum trx_chan_type chan)
+{
+	return chan >= TRXC_SACCHTF && chan <= TRXC_SACCH8_7;
+}
+
+/* the multiframe for a transceiver slot type of SETSLOT */
+static const struct trx_sched_multiframe *mf_find(int type, uint8_t tn)
+{
+	enum gsm_phys_chan_config pchan;
+	int i;
+
+	switch (type) {
+	case 1:
+		pchan = GSM_PCHAN_TCH_F;
+		break;
+	case 2:
+		pchan = GSM_PCHAN_TCH_H;
+		break;
+	case 4:
+		pchan = GSM_PCHAN_CCCH;
+		break;
+	case 5:
+		pchan = GSM_PCHAN_CCCH_SDCCH4;
+		break;
+	case 7:
+		pchan = GSM_PCHAN_SDCCH8_SACCH8C;
+		break;
+	case 13:
+		pchan = GSM_PCHAN_PDCH;
+		break;
+	default:
+		return NULL;
+	}
+
+	for (i = 0; i < trx_sched_multiframes_num; i++) {
+		if (trx_sched_multiframes[i].pchan == pchan
+		 && (trx_sched_multiframes[i].slotmask & (1 << tn)))
+			return &trx_sched_multiframes[i];
+	}
+
+	return NULL;
+}
+
+/* place the MSs on the dedicated channels of all timeslots, so that the
+ * given fraction of them is occupied, the rest of the MSs is idle */
+static void vtrx_assign(struct vtrx_hdl *vtrx)
+{
+	uint8_t seen[_TRX_CHAN_MAX];
+	double acc = 0.0;
+	unsigned int used = 0;
+	int i, tn, n;
+
+	for (i = 0; i < vtrx->num_trx; i++) {
+		struct vtrx_trx *trx = &vtrx->trx[i];
+
+		for (tn = 0; tn < 8; tn++) {
+			const struct trx_sched_multiframe *mf = trx->mf[tn];
+			int busy[_TRX_CHAN_MAX];
+
+			memset(busy, 0, sizeof(busy));
+			memset(seen, 0, sizeof(seen));
+			for (n = 0; mf && n < mf->period; n++) {
+				enum trx_chan_type chan = mf->frames[n].ul_chan;
+
+				if (chan == TRXC_IDLE || chan == TRXC_RACH
+				 || chan == TRXC_PTCCH || chan_is_sacch(chan)
+				 || seen[chan])
+					continue;
+				seen[chan] = 1;
+
+				acc += load;
+				if (acc >= 1.0 && used < num_ms) {
+					acc -= 1.0;
+					busy[chan] = 1;
+					used++;
+				}
+			}
+
+			for (n = 0; n < _TRX_CHAN_MAX; n++) {
+				struct vtrx_subch *sc = &trx->subch[tn][n];
+				int b = busy[chan_owner(n)];
+
+				if (sc->busy == b)
+					continue;
+				memset(sc, 0, sizeof(*sc));
+				sc->busy = b;
+			}
+		}
+	}
+
+	vtrx->ms_dedicated = used;
+	LOGP(DTRX, LOGL_INFO, "%u MSs on dedicated channels, %u MSs idle\n",
+		used, num_ms - used);
+}
+
+/*
+ * uplink
+ */
+
+static void vtrx_send_burst(struct vtrx_hdl *vtrx, struct vtrx_trx *trx,
+	uint8_t tn, uint32_t fn, const ubit_t *bits, sbit_t *sbits)
+{
+	uint8_t buf[158];
+	int16_t toa256;
+	int i, s;
+
+	toa256 = lrint((toa_offset + toa_jitter * (2.0 * rnd_uniform() - 1.0))
+		* 256.0);
+
+	buf[0] = tn;
+	buf[1] = fn >> 24;
+	buf[2] = fn >> 16;
+	buf[3] = fn >> 8;
+	buf[4] = fn;
+	buf[5] = -rssi;
+	buf[6] = toa256 >> 8;
+	buf[7] = toa256;
+	for (i = 0; i < 148; i++) {
+		s = bits[i] ? -VTRX_SBIT_AMPL : VTRX_SBIT_AMPL;
+		if (!isinf(snr))
+			s += noise_table[rnd() % VTRX_NOISE_TABLE];
+		if (s > 127)
+			s = 127;
+		else if (s < -127)
+			s = -127;
+		sbits[i] = s;
+		/* soft bits {-127..127} to {254..0} */
+		buf[8 + i] = 127 - s;
+	}
+	memset(buf + 156, 0, 2);
+
+	if (send(trx->data_ofd.fd, buf, sizeof(buf), 0) < 0)
+		return;
+	trx->stats.ul_bursts++;
+}
+
+static void vtrx_rach_burst(struct vtrx_hdl *vtrx, struct vtrx_trx *trx,
+	uint8_t tn, uint32_t fn)
+{
+	struct vtrx_fer *fer = &vtrx->fer[VTRX_CL_RACH];
+	ubit_t bits[148];
+	sbit_t sbits[148];
+	uint8_t ra, ra_rx;
+
+	/* the synchronization sequence is not checked by the BTS */
+	memset(bits, 0, sizeof(bits));
+	ra = rnd();
+	rach_encode(bits + 8 + 41, &ra, vtrx->bsic);
+	vtrx_send_burst(vtrx, trx, tn, fn, bits, sbits);
+	vtrx->rach_sent++;
+
+	if (!check_fer)
+		return;
+	fer->blocks++;
+	if (rach_decode(&ra_rx, sbits + 8 + 41, vtrx->bsic) || ra_rx != ra)
+		fer->errors++;
+}
+
+/* encode the next block of a channel at its first burst */
+static void vtrx_block_encode(struct vtrx_subch *sc, enum trx_chan_type chan,
+	uint32_t fn)
+{
+	uint8_t data[33];
+	int i;
+
+	switch (chan_class(chan)) {
+	case VTRX_CL_TCHF:
+		memcpy(sc->bursts, sc->bursts + 464, 464);
+		memset(sc->bursts + 464, 0, 464);
+		for (i = 0; i < sizeof(data); i++)
+			data[i] = rnd();
+		switch (codec) {
+		case VTRX_CODEC_FR:
+			data[0] = 0xd0 | (data[0] & 0x0f);
+			tch_fr_encode(sc->bursts, data, 33, 1);
+			break;
+		case VTRX_CODEC_EFR:
+			data[0] = 0xc0 | (data[0] & 0x0f);
+			tch_fr_encode(sc->bursts, data, 31, 1);
+			break;
+		case VTRX_CODEC_AMR:
+			/* the uplink carries the CMI in the blocks starting
+			 * at FN 4, 13 and 21, the downlink in the others */
+			tch_afs_encode(sc->bursts, data, 31,
+				!((((fn + 4) % 26) >> 2) & 1), amr_codecs,
+				ARRAY_SIZE(amr_codecs), 0, 0);
+			break;
+		}
+		break;
+	case VTRX_CL_TCHH:
+		memcpy(sc->bursts, sc->bursts + 232, 232);
+		memset(sc->bursts + 232, 0, 232);
+		for (i = 0; i < 15; i++)
+			data[i] = rnd();
+		data[0] = 0x00;
+		tch_hr_encode(sc->bursts, data, 15);
+		break;
+	case VTRX_CL_PDTCH:
+		pdtch_encode(sc->bursts, (uint8_t *) pdtch_dummy,
+			GSM_MACBLOCK_LEN);
+		break;
+	default:
+		xcch_encode(sc->bursts, (uint8_t *) (chan_is_sacch(chan) ?
+			sacch_fill : sdcch_fill));
+		break;
+	}
+
+	sc->blocks++;
+}
+
+/* decode a block like the BTS, once all of its bursts are received */
+static void vtrx_block_check(struct vtrx_hdl *vtrx, struct vtrx_subch *sc,
+	enum trx_chan_type chan, uint32_t fn, uint8_t bid)
+{
+	enum vtrx_class cl = chan_class(chan);
+	struct vtrx_fer *fer = &vtrx->fer[cl];
+	uint8_t data[54], usf, ft, cmr;
+	int rc, n_errors, n_bits_total, error;
+
+	switch (cl) {
+	case VTRX_CL_TCHF:
+		if (bid != 3)
+			return;
+		if (codec == VTRX_CODEC_AMR) {
+			rc = tch_afs_decode(data, sc->soft,
+				(((fn + 26 - 7) % 26) >> 2) & 1, amr_codecs,
+				ARRAY_SIZE(amr_codecs), &ft, &cmr, &n_errors,
+				&n_bits_total);
+			error = rc < 4 || rc == GSM_MACBLOCK_LEN;
+		} else {
+			rc = tch_fr_decode(data, sc->soft, 1,
+				codec == VTRX_CODEC_EFR, &n_errors,
+				&n_bits_total);
+			error = rc != (codec == VTRX_CODEC_EFR ? 31 : 33);
+		}
+		memcpy(sc->soft, sc->soft + 464, 464);
+		/* the first block is interleaved with nothing */
+		if (sc->blocks < 2)
+			return;
+		break;
+	case VTRX_CL_TCHH:
+		if (bid != 1)
+			return;
+		rc = tch_hr_decode(data, sc->soft,
+			(((fn + 26 - 10) % 26) >> 2) & 1, &n_errors,
+			&n_bits_total);
+		error = rc != 15;
+		memcpy(sc->soft, sc->soft + 232, 232);
+		memcpy(sc->soft + 232, sc->soft + 464, 232);
+		if (sc->blocks < 3)
+			return;
+		break;
+	case VTRX_CL_PDTCH:
+		if (bid != 3)
+			return;
+		rc = pdtch_decode(data, sc->soft, &usf, &n_errors,
+			&n_bits_total);
+		error = rc != GSM_MACBLOCK_LEN;
+		break;
+	default:
+		if (bid != 3)
+			return;
+		rc = xcch_decode(data, sc->soft, &n_errors, &n_bits_total);
+		error = rc != 0;
+		break;
+	}
+
+	fer->blocks++;
+	if (error)
+		fer->errors++;
+}
+
+static void vtrx_block_burst(struct vtrx_hdl *vtrx, struct vtrx_trx *trx,
+	uint8_t tn, uint32_t fn, enum trx_chan_type chan, uint8_t bid)
+{
+	struct vtrx_subch *sc = &trx->subch[tn][chan];
+	enum vtrx_class cl = chan_class(chan);
+	ubit_t bits[148], *burst;
+	sbit_t sbits[148], *soft;
+
+	if (bid == 0)
+		vtrx_block_encode(sc, chan, fn);
+
+	/* compose burst, the training sequence is not checked by the BTS */
+	burst = sc->bursts + bid * 116;
+	memset(bits, 0, sizeof(bits));
+	memcpy(bits + 3, burst, 58);
+	memcpy(bits + 87, burst + 58, 58);
+
+	vtrx_send_burst(vtrx, trx, tn, fn, bits, sbits);
+
+	if (!check_fer)
+		return;
+
+	/* store the burst like the BTS, TCH bursts go behind the ones of
+	 * the previous block */
+	if (cl == VTRX_CL_TCHF || cl == VTRX_CL_TCHH) {
+		if (bid == 0)
+			memset(sc->soft + 464, 0, (cl == VTRX_CL_TCHF) ? 464 : 232);
+		soft = sc->soft + 464 + bid * 116;
+	} else
+		soft = sc->soft + bid * 116;
+	memcpy(soft, sbits + 3, 58);
+	memcpy(soft + 58, sbits + 87, 58);
+
+	vtrx_block_check(vtrx, sc, chan, fn, bid);
+}
+
+static void vtrx_ul_burst(struct vtrx_hdl *vtrx, struct vtrx_trx *trx,
+	uint8_t tn, uint32_t fn)
+{
+	const struct trx_sched_multiframe *mf = trx->mf[tn];
+	const struct trx_sched_frame *frame;
+	enum trx_chan_type chan;
+
+	if (!mf || !mf->period)
+		return;
+
+	frame = &mf->frames[fn % mf->period];
+	chan = frame->ul_chan;
+
+	switch (chan) {
+	case TRXC_IDLE:
+	case TRXC_PTCCH:
+		return;
+	case TRXC_RACH:
+		if (vtrx->rach_pending < 1.0)
+			return;
+		vtrx->rach_pending -= 1.0;
+		vtrx_rach_burst(vtrx, trx, tn, fn);
+		return;
+	default:
+		if (!trx->subch[tn][chan].busy)
+			return;
+		vtrx_block_burst(vtrx, trx, tn, fn, chan, frame->ul_bid);
+		return;
+	}
+}
+
+/* the uplink of all TRXs and the clock indication of one frame */
+static void vtrx_frame(struct vtrx_hdl *vtrx, uint32_t fn)
+{
+	char buf[32];
+	int i, tn, len;
+
+	if (vtrx->poweron) {
+		/* access bursts of the idle MSs, per frame */
+		vtrx->rach_pending += (num_ms - vtrx->ms_dedicated)
+			* access_rate / 3600.0 * (VTRX_FRAME_NS / 1e9);
+		if (vtrx->rach_pending > VTRX_MAX_RACH_PENDING)
+			vtrx->rach_pending = VTRX_MAX_RACH_PENDING;
+
+		for (i = 0; i < vtrx->num_trx; i++) {
+			for (tn = 0; tn < 8; tn++)
+				vtrx_ul_burst(vtrx, &vtrx->trx[i], tn, fn);
+		}
+	}
+
+	len = snprintf(buf, sizeof(buf), "IND CLOCK %u", fn);
+	send(vtrx->clk_ofd.fd, buf, len + 1, 0);
+
+	vtrx->frames++;
+}
+
+static uint64_t elapsed_ns(const struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000000000ULL
+		+ now.tv_nsec - start->tv_nsec;
+}
+
+/* emulate all frames, that are due, and schedule the next one */
+static void vtrx_timer_cb(void *data)
+{
+	struct vtrx_hdl *vtrx = data;
+	uint64_t due, next_ns, ns;
+
+	ns = elapsed_ns(&vtrx->start);
+	due = ns / vtrx->frame_ns + 1;
+	if (due > vtrx->frames_done + VTRX_MAX_CATCHUP) {
+		/* drop the frames, we can't keep up with */
+		vtrx->late_frames += due - vtrx->frames_done
+			- VTRX_MAX_CATCHUP;
+		vtrx->fn = (vtrx->fn + due - vtrx->frames_done
+			- VTRX_MAX_CATCHUP) % VTRX_HYPERFRAME;
+		vtrx->frames_done = due - VTRX_MAX_CATCHUP;
+	}
+
+	while (vtrx->frames_done < due) {
+		vtrx_frame(vtrx, vtrx->fn);
+		vtrx->fn = (vtrx->fn + 1) % VTRX_HYPERFRAME;
+		vtrx->frames_done++;
+	}
+
+	if (max_frames && vtrx->frames >= max_frames) {
+		dump_stats = -1;
+		return;
+	}
+
+	next_ns = vtrx->frames_done * vtrx->frame_ns;
+	ns = elapsed_ns(&vtrx->start);
+	ns = next_ns > ns ? next_ns - ns : 0;
+	osmo_timer_schedule(&vtrx->timer, ns / 1000000000ULL,
+		(ns % 1000000000ULL) / 1000);
+}
+
+/*
+ * downlink
+ */
+
+static int data_read_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct vtrx_trx *trx = ofd->data;
+	struct vtrx_hdl *vtrx = trx->vtrx;
+	uint8_t buf[256];
+	uint32_t fn;
+	int32_t slack;
+	int len;
+
+	len = recv(ofd->fd, buf, sizeof(buf), MSG_DONTWAIT);
+	if (len <= 0)
+		return 0;
+	if (len != 154 || buf[0] >= 8) {
+		trx->stats.malformed++;
+		return 0;
+	}
+	fn = (buf[1] << 24) | (buf[2] << 16) | (buf[3] << 8) | buf[4];
+	if (fn >= VTRX_HYPERFRAME) {
+		trx->stats.malformed++;
+		return 0;
+	}
+
+	/* the burst must be there, before its frame is on the air, the
+	 * last frame emulated is vtrx->fn - 1 */
+	slack = (fn + VTRX_HYPERFRAME - vtrx->fn + 1) % VTRX_HYPERFRAME;
+	if (slack >= VTRX_HYPERFRAME / 2)
+		slack -= VTRX_HYPERFRAME;
+	if (!trx->stats.dl_bursts || slack < trx->stats.dl_min_slack)
+		trx->stats.dl_min_slack = slack;
+	if (slack <= 0)
+		trx->stats.dl_late++;
+	trx->stats.dl_bursts++;
+
+	return 0;
+}
+
+/*
+ * control
+ */
+
+static int vtrx_ctrl_cmd(struct vtrx_trx *trx, const char *cmd,
+	const char *params)
+{
+	struct vtrx_hdl *vtrx = trx->vtrx;
+	int tn, type;
+
+	if (!strcmp(cmd, "POWERON")) {
+		vtrx->poweron = 1;
+		return 0;
+	}
+	if (!strcmp(cmd, "POWEROFF")) {
+		vtrx->poweron = 0;
+		return 0;
+	}
+	if (!strcmp(cmd, "SETBSIC")) {
+		vtrx->bsic = atoi(params);
+		return 0;
+	}
+	if (!strcmp(cmd, "SETSLOT")) {
+		if (sscanf(params, "%d %d", &tn, &type) != 2
+		 || tn < 0 || tn >= 8)
+			return -EINVAL;
+		trx->mf[tn] = mf_find(type, tn);
+		LOGP(DTRX, LOGL_NOTICE, "trx=%u ts=%d is %s\n", trx->nr, tn,
+			trx->mf[tn] ? trx->mf[tn]->name : "NONE");
+		vtrx_assign(vtrx);
+		return 0;
+	}
+	if (!strcmp(cmd, "SETTSC") || !strcmp(cmd, "RXTUNE")
+	 || !strcmp(cmd, "TXTUNE") || !strcmp(cmd, "SETRXGAIN")
+	 || !strcmp(cmd, "SETPOWER") || !strcmp(cmd, "SETMAXDLY")
+	 || !strcmp(cmd, "HANDOVER") || !strcmp(cmd, "NOHANDOVER"))
+		return 0;
+
+	return -ENOTSUP;
+}
+
+static int ctrl_read_cb(struct osmo_fd *ofd, unsigned int what)
+{
+	struct vtrx_trx *trx = ofd->data;
+	char buf[1500], rsp[1600];
+	char *cmd, *params;
+	int len, rc;
+
+	len = recv(ofd->fd, buf, sizeof(buf) - 1, MSG_DONTWAIT);
+	if (len <= 0)
+		return 0;
+	buf[len] = '\0';
+
+	if (strncmp(buf, "CMD ", 4)) {
+		trx->stats.malformed++;
+		return 0;
+	}
+	cmd = buf + 4;
+	params = strchr(cmd, ' ');
+	if (params)
+		*params++ = '\0';
+	else
+		params = "";
+
+	LOGP(DTRX, LOGL_INFO, "trx=%u command '%s%s%s'\n", trx->nr, cmd,
+		*params ? " " : "", params);
+	rc = vtrx_ctrl_cmd(trx, cmd, params);
+	trx->stats.ctrl_cmds++;
+
+	/* the BTS matches the response by the command name */
+	len = snprintf(rsp, sizeof(rsp), "RSP %s %d%s%s", cmd, rc ? 1 : 0,
+		*params ? " " : "", params);
+	send(ofd->fd, rsp, len + 1, 0);
+
+	return 0;
+}
+
+/* bind a port and connect to the one of the BTS, which is 100 above */
+static int vtrx_udp_open(struct osmo_fd *ofd, uint16_t port, void *data,
+	int (*cb)(struct osmo_fd *fd, unsigned int what))
+{
+	struct sockaddr_storage sas;
+	struct sockaddr *sa = (struct sockaddr *) &sas;
+	socklen_t sa_len = sizeof(sas);
+	int rc;
+
+	ofd->cb = cb;
+	ofd->data = data;
+	ofd->when = BSC_FD_READ;
+	rc = osmo_sock_init_ofd(ofd, AF_UNSPEC, SOCK_DGRAM, 0, transceiver_ip,
+		port, OSMO_SOCK_F_BIND);
+	if (rc < 0)
+		return rc;
+
+	rc = getsockname(ofd->fd, sa, &sa_len);
+	if (rc)
+		return -errno;
+	if (sa->sa_family == AF_INET) {
+		struct sockaddr_in *sin = (struct sockaddr_in *) sa;
+		sin->sin_port = htons(ntohs(sin->sin_port) + 100);
+	} else if (sa->sa_family == AF_INET6) {
+		struct sockaddr_in6 *sin6 = (struct sockaddr_in6 *) sa;
+		sin6->sin6_port = htons(ntohs(sin6->sin6_port) + 100);
+	} else
+		return -EINVAL;
+
+	if (connect(ofd->fd, sa, sa_len))
+		return -errno;
+
+	return 0;
+}
+
+/*
+ * statistics
+ */
+
+/* CPU time of the BTS process in clock ticks, 0 if unknown */
+static unsigned long bts_cpu_ticks(void)
+{
+	char path[64], buf[1024], *p;
+	unsigned long utime, stime;
+	FILE *f;
+
+	if (!bts_pid)
+		return 0;
+
+	snprintf(path, sizeof(path), "/proc/%d/stat", (int) bts_pid);
+	f = fopen(path, "r");
+	if (!f)
+		return 0;
+	p = fgets(buf, sizeof(buf), f);
+	fclose(f);
+	if (!p)
+		return 0;
+
+	/* the command may contain blanks, skip it */
+	p = strrchr(buf, ')');
+	if (!p || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u "
+			 "%*u %lu %lu", &utime, &stime) != 2)
+		return 0;
+
+	return utime + stime;
+}
+
+static double rusage_sec(const struct rusage *ru)
+{
+	return ru->ru_utime.tv_sec + ru->ru_utime.tv_usec / 1e6
+		+ ru->ru_stime.tv_sec + ru->ru_stime.tv_usec / 1e6;
+}
+
+static void vtrx_stats_start(struct vtrx_hdl *vtrx)
+{
+	clock_gettime(CLOCK_MONOTONIC, &vtrx->cpu_start);
+	getrusage(RUSAGE_SELF, &vtrx->ru_start);
+	vtrx->bts_ticks_start = bts_cpu_ticks();
+}
+
+static void vtrx_dump_stats(struct vtrx_hdl *vtrx)
+{
+	struct rusage ru;
+	double wall, own, bts = -1.0;
+	int i;
+
+	wall = elapsed_ns(&vtrx->cpu_start) / 1e9;
+	if (wall <= 0.0)
+		return;
+	getrusage(RUSAGE_SELF, &ru);
+	own = rusage_sec(&ru) - rusage_sec(&vtrx->ru_start);
+	if (bts_pid)
+		bts = (bts_cpu_ticks() - vtrx->bts_ticks_start)
+			/ (double) sysconf(_SC_CLK_TCK);
+
+	LOGP(DTRX, LOGL_NOTICE, "%u frames (%u late) in %.1fs, %.2f times "
+		"real time, %u access bursts, own CPU %.1f%%\n", vtrx->frames,
+		vtrx->late_frames, wall,
+		vtrx->frames * (VTRX_FRAME_NS / 1e9) / wall, vtrx->rach_sent,
+		100.0 * own / wall);
+
+	/* the BTS serves all TRXs in one thread, so its CPU time can only be
+	 * shared out evenly */
+	if (bts >= 0.0)
+		LOGP(DTRX, LOGL_NOTICE, "BTS CPU %.1f%%, %.1f%% per TRX, "
+			"%.1fus per TRX and frame\n", 100.0 * bts / wall,
+			100.0 * bts / wall / vtrx->num_trx,
+			vtrx->frames ? 1e6 * bts / vtrx->frames
+				/ vtrx->num_trx : 0.0);
+
+	for (i = 0; i < vtrx->num_trx; i++) {
+		struct vtrx_trx_stats *st = &vtrx->trx[i].stats;
+
+		LOGP(DTRX, LOGL_NOTICE, "trx=%d: %u UL bursts, %u DL bursts, "
+			"%u DL bursts late (deadline missed), min slack %d "
+			"frames, %u commands, %u malformed\n", i,
+			st->ul_bursts, st->dl_bursts, st->dl_late,
+			st->dl_min_slack, st->ctrl_cmds, st->malformed);
+	}
+
+	if (!check_fer)
+		return;
+	for (i = 0; i < _NUM_VTRX_CL; i++) {
+		struct vtrx_fer *fer = &vtrx->fer[i];
+
+		if (!fer->blocks)
+			continue;
+		LOGP(DTRX, LOGL_NOTICE, "%s: %u blocks, %u errors, FER %.2f%%\n",
+			vtrx_class_names[i], fer->blocks, fer->errors,
+			100.0 * fer->errors / fer->blocks);
+	}
+}
+
+static void signal_handler(int signal)
+{
+	if (signal == SIGUSR1)
+		dump_stats = 1;
+}
+
+static void print_help()
+{
+	printf( "Some useful options:\n"
+		"  -h	--help		this text\n"
+		"  -d	--debug MASK	Enable debugging (e.g. -d DTRX)\n"
+		"  -i	--local-ip IP	Bind to IP, the BTS must use the same\n"
+		"  -b	--base-port PORT	Base port of the clock (default 5700)\n"
+		"  -t	--trx NUM	Number of transceivers (default 1)\n"
+		"  -s	--speed FACTOR	Run the TDMA clock FACTOR times faster\n"
+		"  -n	--frames NUM	Exit after NUM frames\n"
+		"  -m	--ms NUM	Number of mobile stations (default 1000)\n"
+		"  -a	--access-rate NUM	Access bursts per idle MS and "
+			"hour (default 10)\n"
+		"  -l	--load FRACTION	Occupied dedicated channels "
+			"(default 1.0)\n"
+		"  -c	--codec fr|efr|amr	Codec of TCH/F (default fr, "
+			"AMR is 12.2k only)\n"
+		"  -N	--snr DB	Add white noise at DB signal to noise "
+			"ratio\n"
+		"  -o	--toa SYMBOLS	Timing offset of the bursts\n"
+		"  -j	--toa-jitter SYMBOLS	Uniform jitter of the timing "
+			"offset\n"
+		"  -r	--rssi DBM	RSSI of the bursts (default -60)\n"
+		"  -f	--fer		Decode the bursts, like the BTS does, "
+			"to count the FER\n"
+		"  -p	--bts-pid PID	Measure the CPU time of the BTS\n"
+		"  -S	--seed NUM	Seed of the random numbers\n"
+		);
+}
+
+static void handle_options(int argc, char **argv)
+{
+	while (1) {
+		int option_idx = 0, c;
+		static const struct option long_options[] = {
+			{ "help", 0, 0, 'h' },
+			{ "debug", 1, 0, 'd' },
+			{ "local-ip", 1, 0, 'i' },
+			{ "base-port", 1, 0, 'b' },
+			{ "trx", 1, 0, 't' },
+			{ "speed", 1, 0, 's' },
+			{ "frames", 1, 0, 'n' },
+			{ "ms", 1, 0, 'm' },
+			{ "access-rate", 1, 0, 'a' },
+			{ "load", 1, 0, 'l' },
+			{ "codec", 1, 0, 'c' },
+			{ "snr", 1, 0, 'N' },
+			{ "toa", 1, 0, 'o' },
+			{ "toa-jitter", 1, 0, 'j' },
+			{ "rssi", 1, 0, 'r' },
+			{ "fer", 0, 0, 'f' },
+			{ "bts-pid", 1, 0, 'p' },
+			{ "seed", 1, 0, 'S' },
+			{ 0, 0, 0, 0 }
+		};
+
+		c = getopt_long(argc, argv, "hd:i:b:t:s:n:m:a:l:c:N:o:j:r:fp:S:",
+				long_options, &option_idx);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'h':
+			print_help();
+			exit(0);
+			break;
+		case 'd':
+			log_parse_category_mask(osmo_stderr_target, optarg);
+			break;
+		case 'i':
+			transceiver_ip = optarg;
+			break;
+		case 'b':
+			base_port = atoi(optarg);
+			break;
+		case 't':
+			num_trx = atoi(optarg);
+			if (num_trx < 1 || num_trx > VTRX_MAX_TRX) {
+				fprintf(stderr, "Invalid number of TRX\n");
+				exit(2);
+			}
+			break;
+		case 's':
+			speed = atof(optarg);
+			if (speed <= 0) {
+				fprintf(stderr, "Invalid speed factor\n");
+				exit(2);
+			}
+			break;
+		case 'n':
+			max_frames = strtoul(optarg, NULL, 10);
+			break;
+		case 'm':
+			num_ms = strtoul(optarg, NULL, 10);
+			break;
+		case 'a':
+			access_rate = atof(optarg);
+			break;
+		case 'l':
+			load = atof(optarg);
+			if (load < 0.0 || load > 1.0) {
+				fprintf(stderr, "Invalid load\n");
+				exit(2);
+			}
+			break;
+		case 'c':
+			if (!strcmp(optarg, "fr"))
+				codec = VTRX_CODEC_FR;
+			else if (!strcmp(optarg, "efr"))
+				codec = VTRX_CODEC_EFR;
+			else if (!strcmp(optarg, "amr"))
+				codec = VTRX_CODEC_AMR;
+			else {
+				fprintf(stderr, "Invalid codec\n");
+				exit(2);
+			}
+			break;
+		case 'N':
+			snr = atof(optarg);
+			break;
+		case 'o':
+			toa_offset = atof(optarg);
+			break;
+		case 'j':
+			toa_jitter = atof(optarg);
+			break;
+		case 'r':
+			rssi = atoi(optarg);
+			break;
+		case 'f':
+			check_fer = 1;
+			break;
+		case 'p':
+			bts_pid = atoi(optarg);
+			break;
+		case 'S':
+			rnd_state = strtoul(optarg, NULL, 10);
+			if (!rnd_state)
+				rnd_state = 1;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct vtrx_hdl *vtrx;
+	int rc, i;
+
+	bts_log_init(NULL);
+	handle_options(argc, argv);
+	signal(SIGUSR1, &signal_handler);
+
+	noise_init();
+
+	vtrx = talloc_zero(NULL, struct vtrx_hdl);
+	vtrx->num_trx = num_trx;
+
+	rc = vtrx_udp_open(&vtrx->clk_ofd, base_port, vtrx, NULL);
+	if (rc < 0) {
+		fprintf(stderr, "Failed to open clock socket\n");
+		exit(1);
+	}
+
+	for (i = 0; i < vtrx->num_trx; i++) {
+		struct vtrx_trx *trx = &vtrx->trx[i];
+
+		trx->vtrx = vtrx;
+		trx->nr = i;
+		rc = vtrx_udp_open(&trx->ctrl_ofd, base_port + (i << 1) + 1,
+			trx, ctrl_read_cb);
+		if (rc < 0) {
+			fprintf(stderr, "Failed to open control socket\n");
+			exit(1);
+		}
+		rc = vtrx_udp_open(&trx->data_ofd, base_port + (i << 1) + 2,
+			trx, data_read_cb);
+		if (rc < 0) {
+			fprintf(stderr, "Failed to open data socket\n");
+			exit(1);
+		}
+	}
+
+	/* start the TDMA clock */
+	vtrx->frame_ns = VTRX_FRAME_NS / speed;
+	if (!vtrx->frame_ns)
+		vtrx->frame_ns = 1;
+	clock_gettime(CLOCK_MONOTONIC, &vtrx->start);
+	vtrx_stats_start(vtrx);
+	vtrx->timer.cb = vtrx_timer_cb;
+	vtrx->timer.data = vtrx;
+	osmo_timer_schedule(&vtrx->timer, 0, 0);
+
+	LOGP(DTRX, LOGL_NOTICE, "Emulating %u TRX with %u MSs at %.2f times "
+		"real time\n", vtrx->num_trx, num_ms, speed);
+
+	while (1) {
+		rc = osmo_select_main(0);
+		if (rc < 0) {
+			perror("select");
+			exit(1);
+		}
+		if (dump_stats) {
+			vtrx_dump_stats(vtrx);
+			if (dump_stats < 0)
+				break;
+			dump_stats = 0;
+		}
+	}
+	exit(0);
+}
@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <stdint.h>
 #include <ctype.h>
+#include <string.h>
 
 #include <arpa/inet.h>
 
@@ -43,6 +44,7 @@
 #include "l1_if.h"
 #include "scheduler.h"
 #include "trx_if.h"
+#include "trx_trace.h"
 #include "loops.h"
 
 static struct gsm_bts *vty_bts;
@@ -54,6 +56,7 @@ DEFUN(show_transceiver, show_transceiver_cmd, "show transceiver",
 	struct gsm_bts_trx *trx;
 	struct trx_l1h *l1h;
 	uint8_t tn;
+	int i;
 
 	if (!transceiver_available) {
 		vty_out(vty, "transceiver is not connected%s", VTY_NEWLINE);
@@ -61,6 +64,9 @@ DEFUN(show_transceiver, show_transceiver_cmd, "show transceiver",
 		vty_out(vty, "transceiver is connected, current fn=%u%s",
 			transceiver_last_fn, VTY_NEWLINE);
 	}
+	if (trx_trace_path())
+		vty_out(vty, "recording trace to '%s'%s", trx_trace_path(),
+			VTY_NEWLINE);
 
 	llist_for_each_entry(trx, &bts->trx_list, list) {
 		l1h = trx_l1h_hdl(trx);
@@ -112,11 +118,72 @@ DEFUN(show_transceiver, show_transceiver_cmd, "show transceiver",
 				vty_out(vty, " slot #%d: undefined%s", tn,
 					VTY_NEWLINE);
 		}
+		vty_out(vty, " uplink TCH blocks: %u speech, %u FACCH, "
+			"%u bad, %u idle not decoded (%u of them above half "
+			"the idle level)%s", l1h->tch_ul_stats.speech,
+			l1h->tch_ul_stats.facch, l1h->tch_ul_stats.bad,
+			l1h->tch_ul_stats.idle, l1h->tch_ul_stats.idle_weak,
+			VTY_NEWLINE);
+		vty_out(vty, " uplink DTX: %u SID frames, %u frames not sent "
+			"via RTP%s", l1h->tch_ul_stats.sid,
+			l1h->tch_ul_stats.suppressed, VTY_NEWLINE);
+		vty_out(vty, " downlink DTX: %u TCH blocks not transmitted%s",
+			l1h->tch_dl_muted, VTY_NEWLINE);
+		vty_out(vty, " lost uplink bursts: %u%s", l1h->ul_erased_num,
+			VTY_NEWLINE);
+		vty_out(vty, " access bursts: %u received, %u accepted, "
+			"%u 11 bit, %u bad parity, %u low quality, "
+			"%u wrong handover ref%s", l1h->rach_stats.bursts,
+			l1h->rach_stats.accepted, l1h->rach_stats.ext,
+			l1h->rach_stats.bad, l1h->rach_stats.quality,
+			l1h->rach_stats.ho_ref, VTY_NEWLINE);
+		for (tn = 0; tn < 8; tn++) {
+			for (i = 0; i < _TRX_CHAN_MAX; i++) {
+				struct trx_chan_state *chan_state =
+					&l1h->chan_states[tn][i];
+
+				if (!chan_state->active
+				 || !chan_state->ul_erased_num)
+					continue;
+				vty_out(vty, "  slot #%d %s: %u%s", tn,
+					trx_sched_chan_name(i),
+					chan_state->ul_erased_num,
+					VTY_NEWLINE);
+			}
+		}
 	}
 
 	return CMD_SUCCESS;
 }
 
+DEFUN(trx_trace_start, trx_trace_start_cmd,
+	"trx-trace start FILE",
+	"Burst trace of the transceiver interface\n"
+	"Start recording, replacing the current trace\n"
+	"File to record to\n")
+{
+	int rc;
+
+	rc = trx_trace_open(vty_bts, argv[0]);
+	if (rc < 0) {
+		vty_out(vty, "%% Cannot record to '%s': %s%s", argv[0],
+			strerror(-rc), VTY_NEWLINE);
+		return CMD_WARNING;
+	}
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(trx_trace_stop, trx_trace_stop_cmd,
+	"trx-trace stop",
+	"Burst trace of the transceiver interface\n"
+	"Stop recording\n")
+{
+	trx_trace_close();
+
+	return CMD_SUCCESS;
+}
+
 DEFUN(cfg_bts_fn_advance, cfg_bts_fn_advance_cmd,
 	"fn-advance <0-30>",
 	"Set the number of frames to be transmitted in advance of current FN\n"
@@ -208,6 +275,75 @@ DEFUN(cfg_bts_no_setbsic, cfg_bts_no_setbsic_cmd,
 	return CMD_SUCCESS;
 }
 
+#define RACH_STR "Detection of access bursts\n"
+
+DEFUN(cfg_bts_rach_ext, cfg_bts_rach_ext_cmd,
+	"rach extended",
+	RACH_STR "Also detect 11 bit access bursts (EGPRS)\n")
+{
+	trx_rach_ext = 1;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_ext, cfg_bts_no_rach_ext_cmd,
+	"no rach extended",
+	NO_STR RACH_STR "Only detect 8 bit access bursts\n")
+{
+	trx_rach_ext = 0;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_rach_max_errors, cfg_bts_rach_max_errors_cmd,
+	"rach max-bit-errors <0-36>",
+	RACH_STR "Drop access bursts with more bit errors\n"
+	"Bit errors of the 36 coded bits\n")
+{
+	trx_rach_max_errors = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_max_errors, cfg_bts_no_rach_max_errors_cmd,
+	"no rach max-bit-errors",
+	NO_STR RACH_STR "Accept access bursts with any number of bit errors\n")
+{
+	trx_rach_max_errors = -1;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_rach_min_corr, cfg_bts_rach_min_corr_cmd,
+	"rach min-correlation <0-1000>",
+	RACH_STR "Drop access bursts that correlate less with the code word\n"
+	"Correlation of the soft bits in 1/1000\n")
+{
+	trx_rach_min_corr = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_no_rach_min_corr, cfg_bts_no_rach_min_corr_cmd,
+	"no rach min-correlation",
+	NO_STR RACH_STR "Accept access bursts of any correlation\n")
+{
+	trx_rach_min_corr = -1000;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_bts_tch_idle_level, cfg_bts_tch_idle_level_cmd,
+	"uplink-idle-level <0-127>",
+	"Do not decode uplink speech blocks of a lower energy during "
+	"uplink DTX, as the MS is silent\n"
+	"Mean magnitude of the soft bits of a block (0 = decode all)\n")
+{
+	trx_tch_idle_level = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
 DEFUN(cfg_trx_rxgain, cfg_trx_rxgain_cmd,
 	"rxgain <0-50>",
 	"Set the receiver gain in dB\n"
@@ -348,6 +484,17 @@ void bts_model_config_write_bts(struct vty *vty, struct gsm_bts *bts)
 		vty_out(vty, " settsc%s", VTY_NEWLINE);
 	if (setbsic_enabled)
 		vty_out(vty, " setbsic%s", VTY_NEWLINE);
+	if (trx_rach_ext)
+		vty_out(vty, " rach extended%s", VTY_NEWLINE);
+	if (trx_rach_max_errors >= 0)
+		vty_out(vty, " rach max-bit-errors %d%s", trx_rach_max_errors,
+			VTY_NEWLINE);
+	if (trx_rach_min_corr >= 0)
+		vty_out(vty, " rach min-correlation %d%s", trx_rach_min_corr,
+			VTY_NEWLINE);
+	if (trx_tch_idle_level)
+		vty_out(vty, " uplink-idle-level %d%s", trx_tch_idle_level,
+			VTY_NEWLINE);
 }
 
 void bts_model_config_write_trx(struct vty *vty, struct gsm_bts_trx *trx)
@@ -383,6 +530,8 @@ int bts_model_vty_init(struct gsm_bts *bts)
 	vty_bts = bts;
 
 	install_element_ve(&show_transceiver_cmd);
+	install_element(ENABLE_NODE, &trx_trace_start_cmd);
+	install_element(ENABLE_NODE, &trx_trace_stop_cmd);
 
 	install_element(BTS_NODE, &cfg_bts_fn_advance_cmd);
 	install_element(BTS_NODE, &cfg_bts_ms_power_loop_cmd);
@@ -393,6 +542,13 @@ int bts_model_vty_init(struct gsm_bts *bts)
 	install_element(BTS_NODE, &cfg_bts_setbsic_cmd);
 	install_element(BTS_NODE, &cfg_bts_no_settsc_cmd);
 	install_element(BTS_NODE, &cfg_bts_no_setbsic_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_ext_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_ext_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_max_errors_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_max_errors_cmd);
+	install_element(BTS_NODE, &cfg_bts_rach_min_corr_cmd);
+	install_element(BTS_NODE, &cfg_bts_no_rach_min_corr_cmd);
+	install_element(BTS_NODE, &cfg_bts_tch_idle_level_cmd);
 
 	install_element(TRX_NODE, &cfg_trx_rxgain_cmd);
 	install_element(TRX_NODE, &cfg_trx_power_cmd);
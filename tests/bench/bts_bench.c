@@ -0,0 +1,1303 @@
+/* Microbenchmarks of the channel coding and the TRX scheduler */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <sched.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/bits.h>
+#include <osmocom/core/logging.h>
+#include <osmocom/gsm/a5.h>
+#include <osmocom/gsm/protocol/gsm_08_58.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/paging.h>
+
+/* dequeue_prim() and trx_sched_fn() are static, so the scheduler is built
+ * as part of the benchmark instead of being linked to it */
+#include "../../src/osmo-bts-trx/scheduler.c"
+
+/* the same for the framer and the transmit path of the Abis link */
+#include "../../src/common/abis.c"
+
+#include "../../src/osmo-bts-trx/trx_if.h"
+#include "../../src/osmo-bts-trx/gsm0503_coding.h"
+#include "../../src/osmo-bts-trx/gsm0503_interleaving.h"
+
+const int pcu_direct = 0;
+int quit = 0;
+uint8_t abis_mac[6] = { 0, 1, 2, 3, 4, 5 };
+
+int transceiver_available = 0;
+const char *transceiver_ip = "127.0.0.1";
+int settsc_enabled = 1;
+int setbsic_enabled = 1;
+
+/* results end up here, so that the compiler cannot drop the work */
+static volatile int sink;
+
+static struct {
+	int		cpu;
+	unsigned int	samples;
+	unsigned int	warmup;
+	unsigned int	min_ms;
+	unsigned int	num_trx;
+	const char	*filter;
+	const char	*label;
+	const char	*output;
+	const char	*abis_file;
+} opts = {
+	.cpu = -1,
+	.samples = 11,
+	.warmup = 2,
+	.min_ms = 20,
+	.num_trx = 1,
+};
+
+
+/*
+ * the transceiver interface
+ */
+
+int trx_if_cmd_poweroff(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_poweron(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_settsc(struct trx_l1h *l1h, uint8_t tsc)
+{
+	return 0;
+}
+
+int trx_if_cmd_setbsic(struct trx_l1h *l1h, uint8_t bsic)
+{
+	return 0;
+}
+
+int trx_if_cmd_setrxgain(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setpower(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setmaxdly(struct trx_l1h *l1h, int dly)
+{
+	return 0;
+}
+
+int trx_if_cmd_setslot(struct trx_l1h *l1h, uint8_t tn, uint8_t type)
+{
+	return 0;
+}
+
+int trx_if_cmd_rxtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_txtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_handover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+int trx_if_cmd_nohandover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+int trx_if_data(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
+	const ubit_t *bits)
+{
+	sink += bits[3];
+
+	return 0;
+}
+
+int trx_if_open(struct trx_l1h *l1h)
+{
+	INIT_LLIST_HEAD(&l1h->trx_ctrl_list);
+	l1h->config.slotmask = 0xff;
+
+	return 0;
+}
+
+void trx_if_flush(struct trx_l1h *l1h)
+{
+}
+
+void trx_if_close(struct trx_l1h *l1h)
+{
+}
+
+int bts_model_init(struct gsm_bts *bts)
+{
+	struct trx_l1h *l1h;
+	struct gsm_bts_trx *trx;
+
+	llist_for_each_entry(trx, &bts->trx_list, list) {
+		l1h = l1if_open(trx);
+		if (!l1h)
+			return -EIO;
+
+		trx->role_bts.l1h = l1h;
+		trx->nominal_power = 23;
+
+		l1if_reset(l1h);
+	}
+
+	return 0;
+}
+
+uint32_t trx_get_hlayer1(struct gsm_bts_trx *trx)
+{
+	return 0;
+}
+
+
+/*
+ * channel coding
+ */
+
+static uint8_t l2_data[54] = {
+	0x03, 0x03, 0x0d, 0x06, 0x0d, 0x00, 0x6d, 0x00, 0x1a, 0x51,
+	0x30, 0x99, 0x11, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b, 0x2b, 0x2b, 0x2b,
+};
+
+/* speech frames with a valid header for each codec */
+static uint8_t tch_fr[33] = { 0xd0 };
+static uint8_t tch_efr[31] = { 0xc0 };
+static uint8_t tch_hr[15] = { 0x00 };
+static uint8_t tch_amr[31];
+
+static uint8_t amr_afs_codec[1] = { 7 };	/* 12.2 */
+static uint8_t amr_ahs_codec[1] = { 5 };	/* 7.95 */
+
+static ubit_t bursts_u[116 * 8];
+
+/* encoded blocks for each decoder, as soft bits */
+static sbit_t xcch_s[116 * 4], cs1_s[116 * 4], cs4_s[116 * 4];
+static sbit_t fr_s[116 * 8], efr_s[116 * 8], hr_s[116 * 8];
+static sbit_t afs_s[116 * 8], ahs_s[116 * 8];
+static sbit_t rach_s[36], sch_s[78];
+
+static void ubits2sbits(const ubit_t *ubits, sbit_t *sbits, int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++)
+		sbits[i] = ubits[i] ? -127 : 127;
+}
+
+static void coding_setup(void)
+{
+	uint8_t ra = 0x23, sb_info[4] = { 0x7a, 0x5e, 0x00, 0x00 };
+	ubit_t burst[116 * 8];
+	int i;
+
+	for (i = 1; i < sizeof(tch_fr); i++)
+		tch_fr[i] = i * 37;
+	for (i = 1; i < sizeof(tch_efr); i++)
+		tch_efr[i] = i * 41;
+	for (i = 1; i < sizeof(tch_hr); i++)
+		tch_hr[i] = i * 43;
+	for (i = 0; i < sizeof(tch_amr); i++)
+		tch_amr[i] = i * 47;
+
+	xcch_encode(burst, l2_data);
+	ubits2sbits(burst, xcch_s, 116 * 4);
+	pdtch_encode(burst, l2_data, 23);
+	ubits2sbits(burst, cs1_s, 116 * 4);
+	pdtch_encode(burst, l2_data, 54);
+	ubits2sbits(burst, cs4_s, 116 * 4);
+
+	memset(burst, 0, sizeof(burst));
+	tch_fr_encode(burst, tch_fr, 33, 1);
+	ubits2sbits(burst, fr_s, 116 * 8);
+	tch_fr_encode(burst, tch_efr, 31, 1);
+	ubits2sbits(burst, efr_s, 116 * 8);
+	memset(burst, 0, sizeof(burst));
+	tch_hr_encode(burst, tch_hr, 15);
+	ubits2sbits(burst, hr_s, 116 * 8);
+	memset(burst, 0, sizeof(burst));
+	tch_afs_encode(burst, tch_amr, 31, 0, amr_afs_codec, 1, 0, 0);
+	ubits2sbits(burst, afs_s, 116 * 8);
+	memset(burst, 0, sizeof(burst));
+	tch_ahs_encode(burst, tch_amr, 20, 0, amr_ahs_codec, 1, 0, 0);
+	ubits2sbits(burst, ahs_s, 116 * 8);
+
+	rach_encode(burst, &ra, 63);
+	ubits2sbits(burst, rach_s, 36);
+	sch_encode(burst, sb_info);
+	ubits2sbits(burst, sch_s, 78);
+}
+
+static void bench_xcch_encode(unsigned int n)
+{
+	while (n--)
+		xcch_encode(bursts_u, l2_data);
+	sink += bursts_u[0];
+}
+
+static void bench_xcch_decode(unsigned int n)
+{
+	uint8_t data[23];
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += xcch_decode(data, xcch_s, &n_errors, &n_bits);
+}
+
+static void bench_pdtch_encode_cs1(unsigned int n)
+{
+	while (n--)
+		sink += pdtch_encode(bursts_u, l2_data, 23);
+}
+
+static void bench_pdtch_decode_cs1(unsigned int n)
+{
+	uint8_t data[54], usf;
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += pdtch_decode(data, cs1_s, &usf, &n_errors, &n_bits);
+}
+
+static void bench_pdtch_encode_cs4(unsigned int n)
+{
+	while (n--)
+		sink += pdtch_encode(bursts_u, l2_data, 54);
+}
+
+static void bench_pdtch_decode_cs4(unsigned int n)
+{
+	uint8_t data[54], usf;
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += pdtch_decode(data, cs4_s, &usf, &n_errors, &n_bits);
+}
+
+static void bench_tch_fr_encode(unsigned int n)
+{
+	while (n--)
+		sink += tch_fr_encode(bursts_u, tch_fr, 33, 1);
+}
+
+static void bench_tch_fr_decode(unsigned int n)
+{
+	uint8_t data[33];
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += tch_fr_decode(data, fr_s, 1, 0, &n_errors, &n_bits);
+}
+
+static void bench_tch_efr_encode(unsigned int n)
+{
+	while (n--)
+		sink += tch_fr_encode(bursts_u, tch_efr, 31, 1);
+}
+
+static void bench_tch_efr_decode(unsigned int n)
+{
+	uint8_t data[33];
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += tch_fr_decode(data, efr_s, 1, 1, &n_errors, &n_bits);
+}
+
+static void bench_tch_fr_classify(unsigned int n)
+{
+	while (n--)
+		sink += tch_fr_classify(fr_s, 4);
+}
+
+static void bench_tch_hr_encode(unsigned int n)
+{
+	while (n--)
+		sink += tch_hr_encode(bursts_u, tch_hr, 15);
+}
+
+static void bench_tch_hr_decode(unsigned int n)
+{
+	uint8_t data[33];
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += tch_hr_decode(data, hr_s, 0, &n_errors, &n_bits);
+}
+
+static void bench_tch_hr_classify(unsigned int n)
+{
+	while (n--)
+		sink += tch_hr_classify(hr_s, 0, 4);
+}
+
+static void bench_tch_afs_encode(unsigned int n)
+{
+	while (n--)
+		sink += tch_afs_encode(bursts_u, tch_amr, 31, 0,
+			amr_afs_codec, 1, 0, 0);
+}
+
+static void bench_tch_afs_decode(unsigned int n)
+{
+	uint8_t data[33], ft, cmr;
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += tch_afs_decode(data, afs_s, 0, amr_afs_codec, 1,
+			&ft, &cmr, &n_errors, &n_bits);
+}
+
+static void bench_tch_ahs_encode(unsigned int n)
+{
+	while (n--)
+		sink += tch_ahs_encode(bursts_u, tch_amr, 20, 0,
+			amr_ahs_codec, 1, 0, 0);
+}
+
+static void bench_tch_ahs_decode(unsigned int n)
+{
+	uint8_t data[33], ft, cmr;
+	int n_errors, n_bits;
+
+	while (n--)
+		sink += tch_ahs_decode(data, ahs_s, 0, 0, amr_ahs_codec, 1,
+			&ft, &cmr, &n_errors, &n_bits);
+}
+
+static void bench_rach_encode(unsigned int n)
+{
+	uint8_t ra = 0x23;
+
+	while (n--)
+		sink += rach_encode(bursts_u, &ra, 63);
+}
+
+static void bench_rach_decode(unsigned int n)
+{
+	uint8_t ra;
+
+	while (n--)
+		sink += rach_decode(&ra, rach_s, 63);
+}
+
+static void bench_sch_encode(unsigned int n)
+{
+	uint8_t sb_info[4] = { 0x7a, 0x5e, 0x00, 0x00 };
+
+	while (n--)
+		sink += sch_encode(bursts_u, sb_info);
+}
+
+static void bench_sch_decode(unsigned int n)
+{
+	uint8_t sb_info[4];
+
+	while (n--)
+		sink += sch_decode(sb_info, sch_s);
+}
+
+
+/*
+ * interleaving
+ */
+
+static ubit_t cB_u[456], iB_u[912];
+static sbit_t cB_s[456], iB_s[912];
+
+static void bench_xcch_interleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_xcch_interleave(cB_u, iB_u);
+	sink += iB_u[0];
+}
+
+static void bench_xcch_deinterleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_xcch_deinterleave(cB_s, iB_s);
+	sink += cB_s[0];
+}
+
+static void bench_tch_fr_interleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_tch_fr_interleave(cB_u, iB_u);
+	sink += iB_u[0];
+}
+
+static void bench_tch_fr_deinterleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_tch_fr_deinterleave(cB_s, iB_s);
+	sink += cB_s[0];
+}
+
+static void bench_tch_hr_interleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_tch_hr_interleave(cB_u, iB_u);
+	sink += iB_u[0];
+}
+
+static void bench_tch_hr_deinterleave(unsigned int n)
+{
+	while (n--)
+		gsm0503_tch_hr_deinterleave(cB_s, iB_s);
+	sink += cB_s[0];
+}
+
+
+/*
+ * ciphering, one burst of keystream as the scheduler generates it
+ */
+
+static uint8_t a5_key[8] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0 };
+
+static void bench_a5(int algo, unsigned int n)
+{
+	ubit_t ks[114];
+	uint32_t fn = 0;
+
+	while (n--)
+		osmo_a5(algo, a5_key, fn++ % 2715648, ks, NULL);
+	sink += ks[0];
+}
+
+static void bench_a5_1(unsigned int n)
+{
+	bench_a5(1, n);
+}
+
+static void bench_a5_2(unsigned int n)
+{
+	bench_a5(2, n);
+}
+
+
+/*
+ * scheduler and common part
+ */
+
+static struct gsm_bts *bench_bts;
+
+/* activate an lchan, as the RSL CHAN ACT of the BSC would */
+static void sched_activate(struct gsm_bts_trx *trx, uint8_t chan_nr, int tch)
+{
+	struct trx_l1h *l1h = trx_l1h_hdl(trx);
+	struct gsm_lchan *lchan = &trx->ts[L1SAP_CHAN2TS(chan_nr)]
+		.lchan[l1sap_chan2ss(chan_nr)];
+
+	lchan->rsl_cmode = tch ? RSL_CMOD_SPD_SPEECH : RSL_CMOD_SPD_SIGN;
+	lchan->tch_mode = tch ? GSM48_CMODE_SPEECH_V1 : GSM48_CMODE_SIGN;
+	trx_sched_set_lchan(l1h, chan_nr, 0x00, 1);
+	trx_sched_set_lchan(l1h, chan_nr, 0x40, 1);
+	trx_sched_set_mode(l1h, chan_nr, lchan->rsl_cmode, lchan->tch_mode,
+		0, 0, 0, 0, 0, 0, 0, 0);
+	lchan_init_lapdm(lchan);
+	lchan_set_state(lchan, LCHAN_S_ACTIVE);
+}
+
+/* every TRX is fully loaded: the C0 carries a combined CCCH and an
+ * SDCCH/8, all other timeslots are TCH/F in a call */
+static int sched_setup(void)
+{
+	struct gsm_bts_trx *trx;
+	struct trx_l1h *l1h;
+	enum gsm_phys_chan_config pchan;
+	uint8_t tn, ss;
+	int i;
+
+	bench_bts = gsm_bts_alloc(tall_bts_ctx);
+	if (!bench_bts)
+		return -ENOMEM;
+	for (i = 1; i < opts.num_trx; i++) {
+		if (!gsm_bts_trx_alloc(bench_bts))
+			return -ENOMEM;
+	}
+	if (bts_init(bench_bts) < 0)
+		return -EIO;
+	lchan_init_lapdm(&bench_bts->c0->ts[0].lchan[4]);
+
+	llist_for_each_entry(trx, &bench_bts->trx_list, list) {
+		l1h = trx_l1h_hdl(trx);
+		l1h->config.poweron = 1;
+		for (tn = 0; tn < 8; tn++) {
+			if (trx == bench_bts->c0 && tn == 0)
+				pchan = GSM_PCHAN_CCCH_SDCCH4;
+			else if (trx == bench_bts->c0 && tn == 1)
+				pchan = GSM_PCHAN_SDCCH8_SACCH8C;
+			else
+				pchan = GSM_PCHAN_TCH_F;
+			trx->ts[tn].pchan = pchan;
+			trx_sched_set_pchan(l1h, tn, pchan);
+			switch (pchan) {
+			case GSM_PCHAN_CCCH_SDCCH4:
+				for (ss = 0; ss < 4; ss++)
+					sched_activate(trx,
+						0x20 | (ss << 3) | tn, 0);
+				break;
+			case GSM_PCHAN_SDCCH8_SACCH8C:
+				for (ss = 0; ss < 8; ss++)
+					sched_activate(trx,
+						0x40 | (ss << 3) | tn, 0);
+				break;
+			default:
+				sched_activate(trx, 0x08 | tn, 1);
+				break;
+			}
+		}
+	}
+
+	/* the call on TS 3 of C0 uses uplink DTX */
+	trx_tch_idle_level = 4;
+	trx_sched_set_mode(trx_l1h_hdl(bench_bts->c0), 0x08 | 3,
+		RSL_CMOD_SPD_SPEECH, GSM48_CMODE_SPEECH_V1, 0, 0, 0, 0, 0, 0,
+		0, RSL_CMOD_DTXu);
+
+	return 0;
+}
+
+static uint32_t sched_fn;
+
+static void bench_trx_sched_fn(unsigned int n)
+{
+	while (n--) {
+		sched_fn = (sched_fn + 1) % 2715648;
+		trx_sched_fn(sched_fn);
+	}
+}
+
+static uint32_t ul_burst_fn;
+
+/* uplink bursts of a TCH/F in a call, including its SACCH */
+static void bench_trx_sched_ul_tchf(unsigned int n)
+{
+	struct trx_l1h *l1h = trx_l1h_hdl(bench_bts->c0);
+	sbit_t bits[148];
+
+	memset(bits, 0, sizeof(bits));
+	memcpy(bits + 3, fr_s, 58);
+	memcpy(bits + 87, fr_s + 58, 58);
+	while (n--) {
+		ul_burst_fn = (ul_burst_fn + 1) % 2715648;
+		trx_sched_ul_burst(l1h, 2, ul_burst_fn, bits, -60, 0);
+	}
+}
+
+static uint32_t ul_dtx_burst_fn;
+
+/* the same with uplink DTX at 50% voice activity: the MS talks for 8
+ * multiframes and is silent for the next 8, but keeps sending its SACCH.
+ * Silent blocks are neither decoded nor sent via RTP. */
+static void bench_trx_sched_ul_tchf_dtx(unsigned int n)
+{
+	struct trx_l1h *l1h = trx_l1h_hdl(bench_bts->c0);
+	sbit_t bits[148], silence[148];
+	int talking;
+
+	memset(bits, 0, sizeof(bits));
+	memcpy(bits + 3, fr_s, 58);
+	memcpy(bits + 87, fr_s + 58, 58);
+	memset(silence, 0, sizeof(silence));
+	while (n--) {
+		ul_dtx_burst_fn = (ul_dtx_burst_fn + 1) % 2715648;
+		talking = !((ul_dtx_burst_fn / (26 * 8)) & 1);
+		trx_sched_ul_burst(l1h, 3, ul_dtx_burst_fn,
+			(talking || ul_dtx_burst_fn % 26 == 12) ? bits
+								 : silence,
+			-60, 0);
+	}
+}
+
+/* a timeslot queue of its own, so that the scheduler does not interfere */
+static struct trx_l1h dq_l1h;
+static struct msgb *dq_msg;
+
+static struct msgb *dq_alloc(uint32_t fn)
+{
+	struct msgb *msg = l1sap_msgb_alloc(GSM_MACBLOCK_LEN);
+	struct osmo_phsap_prim *l1sap = msgb_l1sap_prim(msg);
+
+	osmo_prim_init(&l1sap->oph, SAP_GSM_PH, PRIM_PH_DATA,
+		PRIM_OP_REQUEST, msg);
+	l1sap->u.data.chan_nr = 0x08;
+	l1sap->u.data.link_id = 0x00;
+	l1sap->u.data.fn = fn;
+
+	return msg;
+}
+
+/* 'depth' prims for later frames are queued ahead of the one that is due,
+ * as with a BSC that sends ahead of time */
+static void dq_setup(int depth)
+{
+	struct msgb *msg;
+	int i;
+
+	if (!dq_l1h.trx) {
+		dq_l1h.trx = bench_bts->c0;
+		INIT_LLIST_HEAD(&dq_l1h.dl_prims[0]);
+		dq_msg = dq_alloc(100);
+	}
+	while (!llist_empty(&dq_l1h.dl_prims[0])) {
+		msg = llist_entry(dq_l1h.dl_prims[0].next, struct msgb, list);
+		llist_del(&msg->list);
+		msgb_free(msg);
+	}
+	for (i = 0; i < depth; i++)
+		msgb_enqueue(&dq_l1h.dl_prims[0], dq_alloc(101 + i));
+}
+
+static void bench_dequeue_prim(unsigned int n)
+{
+	while (n--) {
+		llist_add_tail(&dq_msg->list, &dq_l1h.dl_prims[0]);
+		sink += dequeue_prim(&dq_l1h, 0, 100, TRXC_TCHF) == dq_msg;
+	}
+}
+
+static void bench_dequeue_prim_q1(unsigned int n)
+{
+	dq_setup(0);
+	bench_dequeue_prim(n);
+}
+
+static void bench_dequeue_prim_q8(unsigned int n)
+{
+	dq_setup(8);
+	bench_dequeue_prim(n);
+}
+
+static const uint8_t paging_ilv[] = {
+	0x08, 0x59, 0x51, 0x30, 0x99, 0x00, 0x00, 0x00, 0x19
+};
+
+static void bench_paging(unsigned int n, int identities)
+{
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bench_bts);
+	uint8_t out_buf[GSM_MACBLOCK_LEN];
+	struct gsm_time g_time;
+	int i;
+
+	memset(&g_time, 0, sizeof(g_time));
+	g_time.t3 = 6;
+	while (n--) {
+		for (i = 0; i < identities; i++)
+			paging_add_identity(btsb->paging_state, 0,
+				paging_ilv, 0);
+		sink += paging_gen_msg(btsb->paging_state, out_buf, &g_time);
+	}
+}
+
+static void bench_paging_gen_msg_empty(unsigned int n)
+{
+	bench_paging(n, 0);
+}
+
+static void bench_paging_gen_msg_2imsi(unsigned int n)
+{
+	bench_paging(n, 2);
+}
+
+
+/*
+ * Abis: replay of the RSL stream of the BSC
+ */
+
+/* the RSL link of C0, the BSC side of the connection is a socket pair */
+static struct ipabis_link abis_link;
+static int abis_peer = -1;
+
+/* what the BSC sends, a sequence of IPA messages */
+static uint8_t *abis_stream;
+static unsigned int abis_stream_len;
+static unsigned int abis_stream_msgs;
+
+static const uint8_t imm_ass_info[23] = {
+	0x2d, 0x06, 0x3f, 0x03, 0x0c, 0xe3, 0x69, 0x23, 0xbc, 0x02, 0x00,
+	0x01, 0x00, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+	0x2b,
+};
+
+static void stream_add(const uint8_t *rsl, unsigned int len, uint8_t proto)
+{
+	uint8_t *p = abis_stream + abis_stream_len;
+
+	p[0] = len >> 8;
+	p[1] = len;
+	p[2] = proto;
+	memcpy(p + 3, rsl, len);
+	abis_stream_len += 3 + len;
+	abis_stream_msgs++;
+}
+
+/* Without a capture, the stream of a busy cell is made up: per PING of
+ * the BSC there are 16 PAGING COMMANDs and 12 IMMEDIATE ASSIGN COMMANDs
+ * on the CCCH.  It is long enough to not fit in one read. */
+static int abis_stream_default(void)
+{
+	uint8_t rsl[64];
+	unsigned int len, i;
+
+	abis_stream = talloc_size(tall_bts_ctx, 8 * 29 * 64);
+	if (!abis_stream)
+		return -ENOMEM;
+
+	for (i = 0; i < 8 * 29; i++) {
+		len = 0;
+		if (i % 29 == 28) {
+			rsl[len++] = IPAC_MSGT_PING;
+			stream_add(rsl, len, IPAC_PROTO_IPACCESS);
+			continue;
+		}
+		rsl[len++] = ABIS_RSL_MDISC_COM_CHAN;
+		rsl[len++] = (i % 29) & 1 && i % 29 < 24
+			? RSL_MT_IMMEDIATE_ASSIGN_CMD : RSL_MT_PAGING_CMD;
+		rsl[len++] = RSL_IE_CHAN_NR;
+		rsl[len++] = RSL_CHAN_PCH_AGCH;
+		if (rsl[1] == RSL_MT_PAGING_CMD) {
+			rsl[len++] = RSL_IE_PAGING_GROUP;
+			rsl[len++] = i % 8;
+			rsl[len++] = RSL_IE_MS_IDENTITY;
+			memcpy(rsl + len, paging_ilv, sizeof(paging_ilv));
+			len += sizeof(paging_ilv);
+		} else {
+			rsl[len++] = RSL_IE_FULL_IMM_ASS_INFO;
+			rsl[len++] = sizeof(imm_ass_info);
+			memcpy(rsl + len, imm_ass_info, sizeof(imm_ass_info));
+			len += sizeof(imm_ass_info);
+		}
+		stream_add(rsl, len, IPAC_PROTO_RSL);
+	}
+
+	return 0;
+}
+
+/* a capture is the raw TCP payload of the RSL link from the BSC, e.g.
+ * saved by wireshark with "Follow TCP Stream" */
+static int abis_stream_load(const char *path)
+{
+	struct stat st;
+	unsigned int pos, len;
+	int fd, rc;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -errno;
+	if (fstat(fd, &st) < 0 || st.st_size == 0) {
+		close(fd);
+		return -EINVAL;
+	}
+	abis_stream = talloc_size(tall_bts_ctx, st.st_size);
+	rc = read(fd, abis_stream, st.st_size);
+	close(fd);
+	if (rc != st.st_size)
+		return -EIO;
+
+	/* count the messages, a partial one at the end is cut off */
+	for (pos = 0; pos + 3 <= st.st_size; pos += len) {
+		len = 3 + ((abis_stream[pos] << 8) | abis_stream[pos + 1]);
+		if (pos + len > st.st_size)
+			break;
+		abis_stream_msgs++;
+	}
+	abis_stream_len = pos;
+	if (!abis_stream_msgs)
+		return -EINVAL;
+
+	return 0;
+}
+
+static int abis_setup(void)
+{
+	int sv[2], rc;
+
+	if (opts.abis_file)
+		rc = abis_stream_load(opts.abis_file);
+	else
+		rc = abis_stream_default();
+	if (rc < 0)
+		return rc;
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+		return -errno;
+	fcntl(sv[0], F_SETFL, O_NONBLOCK);
+	fcntl(sv[1], F_SETFL, O_NONBLOCK);
+
+	INIT_LLIST_HEAD(&abis_link.tx_queue);
+	abis_link.trx = bench_bts->c0;
+	abis_link.bfd.fd = sv[0];
+	abis_link.bfd.data = &abis_link;
+	abis_link.state = LINK_STATE_CONNECT;
+	bench_bts->c0->rsl_link = &abis_link;
+	abis_peer = sv[1];
+
+	return 0;
+}
+
+/* send what is queued and drop it at the BSC side */
+static void abis_flush(void)
+{
+	uint8_t buf[4096];
+
+	while (!llist_empty(&abis_link.tx_queue)) {
+		if (abis_sock_write(&abis_link) < 0)
+			break;
+		while (read(abis_peer, buf, sizeof(buf)) > 0)
+			;
+	}
+}
+
+static void bench_abis_rx_replay(unsigned int n)
+{
+	struct gsm_bts_role_bts *btsb = bts_role_bts(bench_bts);
+	unsigned int pos, len;
+	struct msgb *msg;
+	int avail;
+
+	while (n--) {
+		/* as the TCP stack would hand it over, in segments */
+		for (pos = 0; pos < abis_stream_len; pos += len) {
+			len = abis_stream_len - pos;
+			if (len > 1448)
+				len = 1448;
+			if (write(abis_peer, abis_stream + pos, len) != len)
+				return;
+			do {
+				if (abis_sock_read(&abis_link) < 0)
+					return;
+				if (ioctl(abis_link.bfd.fd, FIONREAD,
+					  &avail) < 0)
+					return;
+			} while (avail > 0);
+		}
+
+		/* responses of the BTS, and the AGCH of the scheduler */
+		abis_flush();
+		while ((msg = msgb_dequeue(&btsb->agch_queue)))
+			msgb_free(msg);
+	}
+}
+
+/* 32 uplink RSL messages of the size of a MEASurement RESult are queued
+ * and then written, as after a TDMA frame with many calls */
+static void bench_abis_tx_writev(unsigned int n)
+{
+	struct msgb *msg;
+	int i;
+
+	while (n--) {
+		for (i = 0; i < 32; i++) {
+			msg = abis_msgb_alloc(0);
+			if (!msg)
+				return;
+			memset(msgb_put(msg, 40), i, 40);
+			abis_push_ipa(msg, IPAC_PROTO_RSL);
+			abis_tx(&abis_link, msg);
+		}
+		abis_flush();
+	}
+}
+
+static const unsigned int abis_tx_msgs = 32;
+
+
+/*
+ * harness
+ */
+
+struct bench {
+	const char *name;
+	const char *unit;		/* what a single operation is */
+	void (*run)(unsigned int n);
+	int per_trx;			/* one call processes every TRX */
+	int debug_log;			/* with all debug messages logged */
+	const unsigned int *ops;	/* operations per call, if not one */
+};
+
+#define BENCH(name, unit)	{ #name, unit, bench_##name, 0, 0, NULL }
+/* the same, but with a log target that formats every debug message */
+#define BENCH_LOG(name, unit)	{ #name "_log", unit, bench_##name, 0, 1, NULL }
+
+static const struct bench benches[] = {
+	BENCH(xcch_encode,		"block"),
+	BENCH(xcch_decode,		"block"),
+	BENCH(pdtch_encode_cs1,		"block"),
+	BENCH(pdtch_decode_cs1,		"block"),
+	BENCH(pdtch_encode_cs4,		"block"),
+	BENCH(pdtch_decode_cs4,		"block"),
+	BENCH(tch_fr_encode,		"block"),
+	BENCH(tch_fr_decode,		"block"),
+	BENCH(tch_efr_encode,		"block"),
+	BENCH(tch_efr_decode,		"block"),
+	BENCH(tch_fr_classify,		"block"),
+	BENCH(tch_hr_encode,		"block"),
+	BENCH(tch_hr_decode,		"block"),
+	BENCH(tch_hr_classify,		"block"),
+	BENCH(tch_afs_encode,		"block"),
+	BENCH(tch_afs_decode,		"block"),
+	BENCH(tch_ahs_encode,		"block"),
+	BENCH(tch_ahs_decode,		"block"),
+	BENCH(rach_encode,		"block"),
+	BENCH(rach_decode,		"block"),
+	BENCH(sch_encode,		"block"),
+	BENCH(sch_decode,		"block"),
+	BENCH(xcch_interleave,		"block"),
+	BENCH(xcch_deinterleave,	"block"),
+	BENCH(tch_fr_interleave,	"block"),
+	BENCH(tch_fr_deinterleave,	"block"),
+	BENCH(tch_hr_interleave,	"block"),
+	BENCH(tch_hr_deinterleave,	"block"),
+	BENCH(a5_1,			"burst"),
+	BENCH(a5_2,			"burst"),
+	BENCH(dequeue_prim_q1,		"prim"),
+	BENCH(dequeue_prim_q8,		"prim"),
+	BENCH(paging_gen_msg_empty,	"msg"),
+	BENCH(paging_gen_msg_2imsi,	"msg"),
+	BENCH(trx_sched_ul_tchf,	"burst"),
+	BENCH_LOG(trx_sched_ul_tchf,	"burst"),
+	BENCH(trx_sched_ul_tchf_dtx,	"burst"),
+	{ "abis_rx_replay", "msg", bench_abis_rx_replay, 0, 0,
+	  &abis_stream_msgs },
+	{ "abis_tx_writev", "msg", bench_abis_tx_writev, 0, 0,
+	  &abis_tx_msgs },
+	{ "trx_sched_fn", "trx-frame", bench_trx_sched_fn, 1, 0, NULL },
+	{ "trx_sched_fn_log", "trx-frame", bench_trx_sched_fn, 1, 1, NULL },
+	{ NULL }
+};
+
+/* times in ns per operation */
+struct result {
+	unsigned int	iterations;
+	double		min, median, mean, stddev, max;
+};
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static uint64_t time_run(const struct bench *b, unsigned int n)
+{
+	uint64_t start = now_ns();
+
+	b->run(n);
+	return now_ns() - start;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *) a, y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+/* a log target that throws the formatted messages away, so that only the
+ * cost of the logging code itself is measured */
+static struct log_target *null_target;
+
+static void null_output(struct log_target *target, unsigned int level,
+	const char *string)
+{
+}
+
+static int debug_log_enable(int enable)
+{
+	if (!null_target) {
+		null_target = log_target_create();
+		if (!null_target)
+			return -ENOMEM;
+		null_target->output = null_output;
+		log_set_all_filter(null_target, 1);
+		log_set_log_level(null_target, LOGL_DEBUG);
+	}
+
+	if (enable)
+		log_add_target(null_target);
+	else
+		log_del_target(null_target);
+	bts_log_cache_update();
+
+	return 0;
+}
+
+static void bench_measure(const struct bench *b, struct result *res)
+{
+	uint64_t min_ns = (uint64_t) opts.min_ms * 1000000;
+	unsigned int ops = b->per_trx ? opts.num_trx
+		: (b->ops ? *b->ops : 1);
+	unsigned int n = 1, i;
+	double sample[opts.samples], sum = 0, var = 0;
+
+	/* the iterations of a sample are doubled until it takes long enough
+	 * to be measured, which also warms up caches and branch predictors */
+	while (time_run(b, n) < min_ns && n < (1u << 30))
+		n <<= 1;
+	for (i = 0; i < opts.warmup; i++)
+		time_run(b, n);
+
+	for (i = 0; i < opts.samples; i++) {
+		sample[i] = (double) time_run(b, n) / ((double) n * ops);
+		sum += sample[i];
+	}
+	qsort(sample, opts.samples, sizeof(double), cmp_double);
+
+	res->iterations = n;
+	res->min = sample[0];
+	res->max = sample[opts.samples - 1];
+	res->median = (opts.samples & 1) ? sample[opts.samples / 2]
+		: (sample[opts.samples / 2 - 1] + sample[opts.samples / 2]) / 2;
+	res->mean = sum / opts.samples;
+	for (i = 0; i < opts.samples; i++)
+		var += (sample[i] - res->mean) * (sample[i] - res->mean);
+	res->stddev = opts.samples > 1 ? sqrt(var / (opts.samples - 1)) : 0;
+}
+
+static int pin_cpu(int cpu)
+{
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) < 0)
+		return -errno;
+
+	return 0;
+}
+
+static void json_string(FILE *f, const char *s)
+{
+	fputc('"', f);
+	for (; *s; s++) {
+		if (*s == '"' || *s == '\\')
+			fputc('\\', f);
+		if ((unsigned char) *s >= 0x20)
+			fputc(*s, f);
+	}
+	fputc('"', f);
+}
+
+static void print_help()
+{
+	printf( "Usage: bts_bench [options]\n"
+		"  -h	--help		this text\n"
+		"  -c	--cpu N		Pin to CPU N (default: current CPU)\n"
+		"  -s	--samples N	Samples per benchmark (default=%u)\n"
+		"  -w	--warmup N	Warm-up runs per benchmark (default=%u)\n"
+		"  -m	--min-time MS	Minimum time of a sample (default=%u)\n"
+		"  -t	--trx N		Number of TRX of the scheduler (default=%u)\n"
+		"  -f	--filter STR	Only run benchmarks containing STR\n"
+		"  -l	--label STR	Label of the results, e.g. the commit\n"
+		"  -o	--output FILE	Write JSON to FILE instead of stdout\n"
+		"  -a	--abis FILE	Replay the RSL capture in FILE\n",
+		opts.samples, opts.warmup, opts.min_ms, opts.num_trx);
+}
+
+static void handle_options(int argc, char **argv)
+{
+	while (1) {
+		int option_idx = 0, c;
+		static const struct option long_options[] = {
+			{ "help", 0, 0, 'h' },
+			{ "cpu", 1, 0, 'c' },
+			{ "samples", 1, 0, 's' },
+			{ "warmup", 1, 0, 'w' },
+			{ "min-time", 1, 0, 'm' },
+			{ "trx", 1, 0, 't' },
+			{ "filter", 1, 0, 'f' },
+			{ "label", 1, 0, 'l' },
+			{ "output", 1, 0, 'o' },
+			{ "abis", 1, 0, 'a' },
+			{ 0, 0, 0, 0 }
+		};
+
+		c = getopt_long(argc, argv, "hc:s:w:m:t:f:l:o:a:",
+				long_options, &option_idx);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'h':
+			print_help();
+			exit(0);
+			break;
+		case 'c':
+			opts.cpu = atoi(optarg);
+			break;
+		case 's':
+			opts.samples = atoi(optarg);
+			break;
+		case 'w':
+			opts.warmup = atoi(optarg);
+			break;
+		case 'm':
+			opts.min_ms = atoi(optarg);
+			break;
+		case 't':
+			opts.num_trx = atoi(optarg);
+			break;
+		case 'f':
+			opts.filter = optarg;
+			break;
+		case 'l':
+			opts.label = optarg;
+			break;
+		case 'o':
+			opts.output = optarg;
+			break;
+		case 'a':
+			opts.abis_file = optarg;
+			break;
+		default:
+			exit(2);
+		}
+	}
+
+	if (opts.samples < 1 || opts.num_trx < 1 || opts.num_trx > 255) {
+		print_help();
+		exit(2);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const struct bench *b;
+	struct result res;
+	FILE *out = stdout;
+	void *tall_msgb_ctx;
+	int rc, first = 1;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+	log_set_log_level(osmo_stderr_target, LOGL_FATAL);
+	bts_log_cache_update();
+
+	handle_options(argc, argv);
+
+	if (opts.cpu < 0)
+		opts.cpu = sched_getcpu();
+	rc = pin_cpu(opts.cpu);
+	if (rc < 0) {
+		fprintf(stderr, "Cannot pin to CPU %d: %s\n", opts.cpu,
+			strerror(-rc));
+		exit(1);
+	}
+	if (opts.output) {
+		out = fopen(opts.output, "w");
+		if (!out) {
+			fprintf(stderr, "Cannot open '%s': %s\n", opts.output,
+				strerror(errno));
+			exit(1);
+		}
+	}
+
+	coding_setup();
+	rc = sched_setup();
+	if (rc < 0) {
+		fprintf(stderr, "Cannot set up the scheduler: %s\n",
+			strerror(-rc));
+		exit(1);
+	}
+	rc = abis_setup();
+	if (rc < 0) {
+		fprintf(stderr, "Cannot set up the Abis link: %s\n",
+			strerror(-rc));
+		exit(1);
+	}
+
+	fprintf(out, "{\n\t\"label\": ");
+	json_string(out, opts.label ? opts.label : "");
+	fprintf(out, ",\n\t\"cpu\": %d,\n\t\"samples\": %u,\n"
+		"\t\"num_trx\": %u,\n\t\"benchmarks\": [", opts.cpu,
+		opts.samples, opts.num_trx);
+
+	fprintf(stderr, "%-24s %-9s %10s %10s %10s %8s %12s\n", "benchmark",
+		"op", "min ns", "median ns", "mean ns", "stddev", "ops/s");
+
+	for (b = benches; b->name; b++) {
+		if (opts.filter && !strstr(b->name, opts.filter))
+			continue;
+
+		if (b->debug_log && debug_log_enable(1) < 0) {
+			fprintf(stderr, "Cannot create log target\n");
+			exit(1);
+		}
+		bench_measure(b, &res);
+		if (b->debug_log)
+			debug_log_enable(0);
+
+		fprintf(stderr, "%-24s %-9s %10.1f %10.1f %10.1f %8.1f "
+			"%12.0f\n", b->name, b->unit, res.min, res.median,
+			res.mean, res.stddev, 1e9 / res.median);
+		fprintf(out, "%s\n\t\t{ \"name\": \"%s\", \"unit\": \"%s\", "
+			"\"iterations\": %u, \"min_ns\": %.2f, "
+			"\"median_ns\": %.2f, \"mean_ns\": %.2f, "
+			"\"stddev_ns\": %.2f, \"max_ns\": %.2f, "
+			"\"ops_per_sec\": %.1f }", first ? "" : ",", b->name,
+			b->unit, res.iterations, res.min, res.median, res.mean,
+			res.stddev, res.max, 1e9 / res.median);
+		first = 0;
+	}
+
+	fprintf(out, "\n\t]\n}\n");
+	if (out != stdout)
+		fclose(out);
+
+	exit(0);
+}
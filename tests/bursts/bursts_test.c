@@ -102,7 +102,7 @@ static void test_xcch(uint8_t *l2)
 	memset(bursts_s + 116, 0, 30);
 
 	/* decode */
-	xcch_decode(result, bursts_s);
+	xcch_decode(result, bursts_s, NULL, NULL);
 
 	printd("Decoded: %s\n", osmo_hexdump(result, 23));
 
@@ -141,6 +141,29 @@ static void test_rach(uint8_t bsic, uint8_t ra)
 	printd("\n");
 }
 
+/* decoded once, the BSIC of the parity is returned */
+static void test_rach_any(uint8_t bsic, uint16_t ra, int ext)
+{
+	struct rach_dec dec;
+	uint8_t ra8 = ra;
+	ubit_t bursts_u[36];
+	sbit_t bursts_s[36];
+
+	if (ext)
+		rach_ext_encode(bursts_u, ra, bsic);
+	else
+		rach_encode(bursts_u, &ra8, bsic);
+	ubits2sbits(bursts_u, bursts_s, 36);
+
+	rach_decode_any(&dec, bursts_s, ext);
+
+	ASSERT_TRUE(dec.ra == ra);
+	ASSERT_TRUE(dec.bsic == bsic);
+	ASSERT_TRUE(dec.ext == ext);
+	ASSERT_TRUE(dec.n_errors == 0 && dec.n_bits_total == 36);
+	ASSERT_TRUE(dec.corr == 1000);
+}
+
 static void test_sch(uint8_t *info)
 {
 	uint8_t result[4];
@@ -185,6 +208,11 @@ static void test_fr(uint8_t *speech, int len)
 	memset(bursts_u, 0x23, sizeof(bursts_u));
 	memset(bursts_s, 0, sizeof(bursts_s));
 
+	/* nothing received yet */
+	ASSERT_TRUE(tch_fr_classify(bursts_s, 4) == TCH_UL_IDLE);
+	/* unless the idle detection is off */
+	ASSERT_TRUE(tch_fr_classify(bursts_s, 0) == TCH_UL_SPEECH);
+
 	printd("Encoding: %s\n", osmo_hexdump(speech, len));
 
 	/* encode */
@@ -242,8 +270,12 @@ static void test_fr(uint8_t *speech, int len)
 		(uint8_t)bursts_s[57 + 812], (uint8_t)bursts_s[58 + 812]);
 	printd("%s\n", osmo_hexdump((uint8_t *)bursts_s + 59 + 812, 57));
 
+	/* classify */
+	ASSERT_TRUE(tch_fr_classify(bursts_s, 4) ==
+		((len == 23) ? TCH_UL_FACCH : TCH_UL_SPEECH));
+
 	/* decode */
-	rc = tch_fr_decode(result, bursts_s, 1, len == 31);
+	rc = tch_fr_decode(result, bursts_s, 1, len == 31, NULL, NULL);
 
 	ASSERT_TRUE(rc == len);
 
@@ -254,6 +286,37 @@ static void test_fr(uint8_t *speech, int len)
 	printd("\n");
 }
 
+static void set_bit(uint8_t *data, int bit)
+{
+	data[bit >> 3] |= 1 << (7 - (bit & 7));
+}
+
+static void test_fr_sid(uint8_t *sid, uint8_t *speech)
+{
+	uint8_t frame[33];
+	int sf, i;
+
+	ASSERT_TRUE(tch_fr_sid_errors(sid) == 0);
+	ASSERT_TRUE(tch_fr_sid_errors(speech) >= 16);
+
+	/* the LSBs of the RPE pulses are not part of the code word */
+	memcpy(frame, sid, 33);
+	for (sf = 0; sf < 4; sf++)
+		for (i = 0; i < 13; i++)
+			set_bit(frame, 57 + sf * 56 + i * 3 + 2);
+	ASSERT_TRUE(tch_fr_sid_errors(frame) == 0);
+
+	/* of the other 104 bits, 9 are not protected and not part of it */
+	memcpy(frame, sid, 33);
+	for (sf = 0; sf < 4; sf++) {
+		for (i = 0; i < 13; i++) {
+			set_bit(frame, 57 + sf * 56 + i * 3);
+			set_bit(frame, 57 + sf * 56 + i * 3 + 1);
+		}
+	}
+	ASSERT_TRUE(tch_fr_sid_errors(frame) == 95);
+}
+
 static void test_hr(uint8_t *speech, int len)
 {
 	uint8_t result[23];
@@ -309,8 +372,12 @@ static void test_hr(uint8_t *speech, int len)
 		(uint8_t)bursts_s[57 + 580], (uint8_t)bursts_s[58 + 580]);
 	printd("%s\n", osmo_hexdump((uint8_t *)bursts_s + 59 + 580, 57));
 
+	/* classify */
+	ASSERT_TRUE(tch_hr_classify(bursts_s, 0, 4) ==
+		((len == 23) ? TCH_UL_FACCH : TCH_UL_SPEECH));
+
 	/* decode */
-	rc = tch_hr_decode(result, bursts_s, 0);
+	rc = tch_hr_decode(result, bursts_s, 0, NULL, NULL);
 
 	ASSERT_TRUE(rc == len);
 
@@ -375,7 +442,7 @@ static void test_pdtch(uint8_t *l2, int len)
 	printd("%s\n", osmo_hexdump((uint8_t *)bursts_s + 59 + 348, 57));
 
 	/* decode */
-	rc = pdtch_decode(result, bursts_s, NULL);
+	rc = pdtch_decode(result, bursts_s, NULL, NULL, NULL);
 
 	ASSERT_TRUE(rc == len);
 
@@ -417,6 +484,13 @@ uint8_t test_macblock[][54] = {
 };
 
 uint8_t test_speech_fr[33];
+/* FR SID frame (GSM 06.12) with comfort noise parameters, the RPE pulses
+ * are all 0 */
+uint8_t test_sid_fr[33] = {
+	0xda, 0xa7, 0xa3, 0x65, 0xda, 0x50, 0x0f, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x50, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x0f, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x50, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
 uint8_t test_speech_efr[31];
 uint8_t test_speech_hr[15];
 
@@ -431,7 +505,10 @@ int main(int argc, char **argv)
 		test_rach(0x3f, i);
 		test_rach(0x00, i);
 		test_rach(0x1a, i);
+		test_rach_any(i & 0x3f, i, 0);
 	}
+	for (i = 0; i < 2048; i += 7)
+		test_rach_any(i & 0x3f, i, 1);
 
 	for (i = 0; i < sizeof(test_l2) / sizeof(test_l2[0]); i++)
 		test_sch(test_l2[i]);
@@ -440,6 +517,8 @@ int main(int argc, char **argv)
 		test_speech_fr[i] = i;
 	test_speech_fr[0] = 0xd0;
 	test_fr(test_speech_fr, sizeof(test_speech_fr));
+	test_fr(test_sid_fr, sizeof(test_sid_fr));
+	test_fr_sid(test_sid_fr, test_speech_fr);
 
 	for (i = 0; i < sizeof(test_speech_efr); i++)
 		test_speech_efr[i] = i;
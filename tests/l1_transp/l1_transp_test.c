@@ -0,0 +1,185 @@
+/* testing the sysmoBTS L1 transport against FIFOs as DSP message queues */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/select.h>
+#include <osmocom/core/utils.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/msgb_pool.h>
+
+#include "femtobts.h"
+#include "l1_if.h"
+#include "l1_transp.h"
+
+#ifdef HW_SYSMOBTS_V1
+#define DSP2ARM_NAME	"gsml1_dsp2arm"
+#define ARM2DSP_NAME	"gsml1_arm2dsp"
+#else
+#define DSP2ARM_NAME	"gsml1_sig_dsp2arm"
+#define ARM2DSP_NAME	"gsml1_sig_arm2dsp"
+#endif
+
+static char dir[] = "/tmp/l1_transp_test.XXXXXX";
+static char dsp2arm[PATH_MAX], arm2dsp[PATH_MAX];
+
+/* the DSP side of the message queues */
+static int dsp_wr_fd, dsp_rd_fd;
+
+static LLIST_HEAD(rx_prims);
+static int num_rx_prims = 0;
+
+int l1if_handle_l1prim(int wq, struct femtol1_hdl *fl1h, struct msgb *msg)
+{
+	OSMO_ASSERT(wq == MQ_L1_WRITE);
+	msgb_enqueue(&rx_prims, msg);
+	num_rx_prims++;
+
+	return 0;
+}
+
+int l1if_handle_sysprim(struct femtol1_hdl *fl1h, struct msgb *msg)
+{
+	OSMO_ASSERT(0);
+	return 0;
+}
+
+static void dsp_open(void)
+{
+	OSMO_ASSERT(mkdtemp(dir));
+	snprintf(dsp2arm, sizeof(dsp2arm), "%s/%s", dir, DSP2ARM_NAME);
+	snprintf(arm2dsp, sizeof(arm2dsp), "%s/%s", dir, ARM2DSP_NAME);
+	OSMO_ASSERT(mkfifo(dsp2arm, 0600) == 0);
+	OSMO_ASSERT(mkfifo(arm2dsp, 0600) == 0);
+
+	/* opening a FIFO for reading and writing doesn't block, so the
+	 * transport can open its ends afterwards */
+	dsp_wr_fd = open(dsp2arm, O_RDWR);
+	OSMO_ASSERT(dsp_wr_fd >= 0);
+	dsp_rd_fd = open(arm2dsp, O_RDWR | O_NONBLOCK);
+	OSMO_ASSERT(dsp_rd_fd >= 0);
+
+	l1if_msgq_dir = dir;
+}
+
+static void dsp_close(void)
+{
+	close(dsp_wr_fd);
+	close(dsp_rd_fd);
+	unlink(dsp2arm);
+	unlink(arm2dsp);
+	rmdir(dir);
+}
+
+static void test_read(struct femtol1_hdl *hdl)
+{
+	GsmL1_Prim_t prim;
+	struct msgb *msg;
+	int i, loops = 0;
+
+	printf("Testing reading primitives.\n");
+
+	for (i = 0; i < 20; i++) {
+		memset(&prim, i, sizeof(prim));
+		OSMO_ASSERT(write(dsp_wr_fd, &prim, sizeof(prim)) ==
+			sizeof(prim));
+	}
+
+	while (num_rx_prims < 20 && loops++ < 100)
+		osmo_select_main(1);
+	OSMO_ASSERT(num_rx_prims == 20);
+
+	/* the batch grew, while the queue was full */
+	OSMO_ASSERT(hdl->read_batch[MQ_L1_READ] > 1);
+	OSMO_ASSERT(loops < 20);
+
+	for (i = 0; i < 20; i++) {
+		msg = msgb_dequeue(&rx_prims);
+		OSMO_ASSERT(msg);
+		OSMO_ASSERT(msgb_l1len(msg) == sizeof(prim));
+		OSMO_ASSERT(msg->l1h[0] == i);
+		OSMO_ASSERT(msg->l1h[sizeof(prim) - 1] == i);
+		/* room for the l1sap header */
+		OSMO_ASSERT(msgb_headroom(msg) >= 128);
+		bts_msgb_free(msg);
+	}
+}
+
+static void test_write(struct femtol1_hdl *hdl)
+{
+	struct osmo_wqueue *wq = &hdl->write_q[MQ_L1_WRITE];
+	static const unsigned int lens[] = { 10, 200, 37, 1, 64 };
+	uint8_t buf[1024];
+	struct msgb *msg;
+	unsigned int i, total = 0;
+	int rc, pos;
+
+	printf("Testing writing primitives of different length.\n");
+
+	for (i = 0; i < ARRAY_SIZE(lens); i++) {
+		msg = msgb_alloc(256, "test");
+		msg->l1h = msgb_put(msg, lens[i]);
+		memset(msg->l1h, 0xa0 + i, lens[i]);
+		OSMO_ASSERT(osmo_wqueue_enqueue(wq, msg) == 0);
+		total += lens[i];
+	}
+
+	osmo_select_main(1);
+	OSMO_ASSERT(llist_empty(&wq->msg_queue));
+	OSMO_ASSERT(wq->current_length == 0);
+
+	rc = read(dsp_rd_fd, buf, sizeof(buf));
+	OSMO_ASSERT(rc == total);
+	for (i = 0, pos = 0; i < ARRAY_SIZE(lens); pos += lens[i++]) {
+		OSMO_ASSERT(buf[pos] == 0xa0 + i);
+		OSMO_ASSERT(buf[pos + lens[i] - 1] == 0xa0 + i);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct femtol1_hdl *hdl;
+	void *tall_msgb_ctx;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+
+	hdl = talloc_zero(tall_bts_ctx, struct femtol1_hdl);
+	dsp_open();
+	OSMO_ASSERT(l1if_transport_open(MQ_L1_WRITE, hdl) == 0);
+
+	test_read(hdl);
+	test_write(hdl);
+
+	l1if_transport_close(MQ_L1_WRITE, hdl);
+	dsp_close();
+	printf("Success\n");
+
+	return 0;
+}
@@ -0,0 +1,245 @@
+/* testing a channel activation and a PH-DATA round trip via the emulated L1 */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <osmocom/core/utils.h>
+#include <osmocom/gsm/protocol/gsm_04_08.h>
+
+#include <sysmocom/femtobts/superfemto.h>
+#include <sysmocom/femtobts/gsml1prim.h>
+#include <sysmocom/femtobts/gsml1const.h>
+#include <sysmocom/femtobts/gsml1types.h>
+
+#include "l1_fwd.h"
+
+/* the emulator runs for about two seconds at this speed */
+#define EMU_SPEED	"20"
+#define EMU_FRAMES	"8000"
+
+#define TEST_TN		1
+#define TEST_HLAYER2	0x00010100
+
+static const uint8_t fill_frame[GSM_MACBLOCK_LEN] = {
+	0x03, 0x03, 0x01, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B,
+	0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B,
+	0x2B, 0x2B, 0x2B
+};
+
+static pid_t emu_pid;
+static int l1_fd;
+
+static void emu_start(const char *path)
+{
+	emu_pid = fork();
+	OSMO_ASSERT(emu_pid >= 0);
+	if (!emu_pid) {
+		execl(path, path, "-s", EMU_SPEED, "-n", EMU_FRAMES, NULL);
+		perror("exec");
+		_exit(1);
+	}
+}
+
+static int emu_wait(void)
+{
+	int status;
+
+	OSMO_ASSERT(waitpid(emu_pid, &status, 0) == emu_pid);
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* the L1 queue of the emulator, all of our primitives go there */
+static void l1_open(void)
+{
+	struct sockaddr_in sin;
+
+	l1_fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	OSMO_ASSERT(l1_fd >= 0);
+
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_port = htons(L1FWD_L1_PORT);
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	OSMO_ASSERT(connect(l1_fd, (struct sockaddr *) &sin,
+			    sizeof(sin)) == 0);
+}
+
+static int l1_send(GsmL1_Prim_t *prim)
+{
+	return send(l1_fd, prim, sizeof(*prim), 0);
+}
+
+/* wait up to 'timeout' ms for a primitive 'id' and skip all others, the
+ * MPH-TIME.ind of every frame in particular */
+static int l1_recv(GsmL1_Prim_t *prim, GsmL1_PrimId_t id, int timeout)
+{
+	struct pollfd pfd = { .fd = l1_fd, .events = POLLIN };
+	int rc;
+
+	while (poll(&pfd, 1, timeout) > 0) {
+		memset(prim, 0, sizeof(*prim));
+		rc = recv(l1_fd, prim, sizeof(*prim), 0);
+		if (rc < 0)
+			continue;
+		if (prim->id == id)
+			return 0;
+	}
+
+	return -1;
+}
+
+static void test_activate(void)
+{
+	GsmL1_Prim_t prim;
+	int i;
+
+	printf("Testing the activation of a channel.\n");
+
+	/* retry, until the emulator has bound its sockets, sending is
+	 * refused until then */
+	for (i = 0; i < 50; i++) {
+		memset(&prim, 0, sizeof(prim));
+		prim.id = GsmL1_PrimId_MphInitReq;
+		if (l1_send(&prim) < 0) {
+			usleep(100000);
+			continue;
+		}
+		if (l1_recv(&prim, GsmL1_PrimId_MphInitCnf, 100) == 0)
+			break;
+	}
+	OSMO_ASSERT(i < 50);
+	OSMO_ASSERT(prim.u.mphInitCnf.status == GsmL1_Status_Success);
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_MphConnectReq;
+	prim.u.mphConnectReq.u8Tn = TEST_TN;
+	prim.u.mphConnectReq.logChComb = GsmL1_LogChComb_VII;
+	OSMO_ASSERT(l1_send(&prim) == sizeof(prim));
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_MphConnectCnf, 1000) == 0);
+	OSMO_ASSERT(prim.u.mphConnectCnf.u8Tn == TEST_TN);
+	OSMO_ASSERT(prim.u.mphConnectCnf.status == GsmL1_Status_Success);
+
+	/* the SDCCH/8 on subslot 0 in both directions */
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_MphActivateReq;
+	prim.u.mphActivateReq.u8Tn = TEST_TN;
+	prim.u.mphActivateReq.sapi = GsmL1_Sapi_Sdcch;
+	prim.u.mphActivateReq.subCh = GsmL1_SubCh_0;
+	prim.u.mphActivateReq.dir = GsmL1_Dir_TxDownlink | GsmL1_Dir_RxUplink;
+	prim.u.mphActivateReq.hLayer2 = TEST_HLAYER2;
+	prim.u.mphActivateReq.hLayer3 = TEST_HLAYER2;
+	OSMO_ASSERT(l1_send(&prim) == sizeof(prim));
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_MphActivateCnf, 1000) == 0);
+	OSMO_ASSERT(prim.u.mphActivateCnf.hLayer3 == TEST_HLAYER2);
+	OSMO_ASSERT(prim.u.mphActivateCnf.u8Tn == TEST_TN);
+	OSMO_ASSERT(prim.u.mphActivateCnf.sapi == GsmL1_Sapi_Sdcch);
+	OSMO_ASSERT(prim.u.mphActivateCnf.status == GsmL1_Status_Success);
+}
+
+static void test_data(void)
+{
+	GsmL1_Prim_t prim;
+	GsmL1_PhReadyToSendInd_t rts_ind;
+	GsmL1_PhDataInd_t *data_ind = &prim.u.phDataInd;
+	GsmL1_PhDataReq_t *data_req = &prim.u.phDataReq;
+
+	printf("Testing a PH-DATA round trip.\n");
+
+	/* the SDCCH/8 subslot 0 starts the 51 multiframe */
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_PhReadyToSendInd, 1000) == 0);
+	rts_ind = prim.u.phReadyToSendInd;
+	OSMO_ASSERT(rts_ind.u8Tn == TEST_TN);
+	OSMO_ASSERT(rts_ind.sapi == GsmL1_Sapi_Sdcch);
+	OSMO_ASSERT(rts_ind.subCh == GsmL1_SubCh_0);
+	OSMO_ASSERT(rts_ind.u32Fn % 51 == 0);
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_PhDataReq;
+	data_req->hLayer1 = rts_ind.hLayer1;
+	data_req->u8Tn = rts_ind.u8Tn;
+	data_req->u32Fn = rts_ind.u32Fn;
+	data_req->sapi = rts_ind.sapi;
+	data_req->subCh = rts_ind.subCh;
+	data_req->u8BlockNbr = rts_ind.u8BlockNbr;
+	memcpy(data_req->msgUnitParam.u8Buffer, fill_frame, GSM_MACBLOCK_LEN);
+	data_req->msgUnitParam.u8Size = GSM_MACBLOCK_LEN;
+	OSMO_ASSERT(l1_send(&prim) == sizeof(prim));
+
+	/* the uplink block of the same channel */
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_PhDataInd, 1000) == 0);
+	OSMO_ASSERT(data_ind->hLayer2 == TEST_HLAYER2);
+	OSMO_ASSERT(data_ind->u8Tn == TEST_TN);
+	OSMO_ASSERT(data_ind->sapi == GsmL1_Sapi_Sdcch);
+	OSMO_ASSERT(data_ind->subCh == GsmL1_SubCh_0);
+	OSMO_ASSERT(data_ind->u32Fn % 51 == 0);
+	OSMO_ASSERT(data_ind->msgUnitParam.u8Size == GSM_MACBLOCK_LEN);
+	OSMO_ASSERT(!memcmp(data_ind->msgUnitParam.u8Buffer, fill_frame,
+			    GSM_MACBLOCK_LEN));
+}
+
+static void test_deactivate(void)
+{
+	GsmL1_Prim_t prim;
+
+	printf("Testing the deactivation of a channel.\n");
+
+	memset(&prim, 0, sizeof(prim));
+	prim.id = GsmL1_PrimId_MphDeactivateReq;
+	prim.u.mphDeactivateReq.u8Tn = TEST_TN;
+	prim.u.mphDeactivateReq.sapi = GsmL1_Sapi_Sdcch;
+	prim.u.mphDeactivateReq.subCh = GsmL1_SubCh_0;
+	prim.u.mphDeactivateReq.dir = GsmL1_Dir_TxDownlink | GsmL1_Dir_RxUplink;
+	prim.u.mphDeactivateReq.hLayer3 = TEST_HLAYER2;
+	OSMO_ASSERT(l1_send(&prim) == sizeof(prim));
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_MphDeactivateCnf, 1000) == 0);
+	OSMO_ASSERT(prim.u.mphDeactivateCnf.hLayer3 == TEST_HLAYER2);
+	OSMO_ASSERT(prim.u.mphDeactivateCnf.status == GsmL1_Status_Success);
+
+	/* the emulator has dropped the channel before confirming it */
+	OSMO_ASSERT(l1_recv(&prim, GsmL1_PrimId_PhReadyToSendInd, 100) < 0);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s PATH-TO-SYSMOBTS-L1EMU\n", argv[0]);
+		return 2;
+	}
+
+	emu_start(argv[1]);
+	l1_open();
+
+	test_activate();
+	test_data();
+	test_deactivate();
+
+	/* the emulator prints its statistics, when its frames are done */
+	OSMO_ASSERT(emu_wait() == 0);
+	close(l1_fd);
+	printf("Success\n");
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+/* testing the uplink measurement processing */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <osmocom/core/talloc.h>
+
+#include <osmo-bts/bts.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/measurement.h>
+
+#include <unistd.h>
+
+static struct gsm_bts *bts;
+static struct gsm_bts_role_bts *btsb;
+static struct gsm_bts_trx *trx;
+int pcu_direct = 0;
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+static struct gsm_lchan *setup_lchan(int tn, int nr,
+	enum gsm_phys_chan_config pchan, enum gsm_chan_t type)
+{
+	struct gsm_lchan *lchan = &trx->ts[tn].lchan[nr];
+
+	trx->ts[tn].pchan = pchan;
+	lchan->type = type;
+	lchan->state = LCHAN_S_ACTIVE;
+	lchan_meas_reset(lchan);
+
+	return lchan;
+}
+
+static void add_meas(struct gsm_lchan *lchan, int num, uint8_t inv_rssi,
+	uint16_t ber10k)
+{
+	struct bts_ul_meas ulm;
+	int i;
+
+	memset(&ulm, 0, sizeof(ulm));
+	ulm.inv_rssi = inv_rssi;
+	ulm.ber10k = ber10k;
+	ulm.is_sub = 1;
+
+	for (i = 0; i < num; i++)
+		ASSERT_TRUE(lchan_new_ul_meas(lchan, &ulm) == 0);
+}
+
+static void test_meas_schedule(void)
+{
+	struct gsm_lchan *lchan;
+	uint32_t fn;
+
+	printf("Testing that only the scheduled period end computes.\n");
+
+	lchan = setup_lchan(2, 0, GSM_PCHAN_TCH_F, GSM_LCHAN_TCH_F);
+	add_meas(lchan, 4, 80, 0);
+
+	/* TCH/F on TS 2 ends its period at fn % 104 == 25 */
+	for (fn = 0; fn < 25; fn++)
+		trx_meas_check_compute(trx, fn);
+	ASSERT_TRUE(!(lchan->meas.flags & LC_UL_M_F_RES_VALID));
+	ASSERT_TRUE(lchan->meas.num_ul_meas == 4);
+
+	trx_meas_check_compute(trx, 25);
+	ASSERT_TRUE(lchan->meas.flags & LC_UL_M_F_RES_VALID);
+	ASSERT_TRUE(lchan->meas.num_ul_meas == 0);
+	ASSERT_TRUE(lchan->meas.res.rxlev_full == 30);
+	ASSERT_TRUE(lchan->meas.res.rxqual_full == 0);
+
+	lchan->meas.flags &= ~LC_UL_M_F_RES_VALID;
+	lchan->state = LCHAN_S_NONE;
+}
+
+static void test_meas_averaging(void)
+{
+	struct gsm_lchan *lchan;
+
+	printf("Testing averaging over two periods.\n");
+
+	btsb->meas.avg_periods = 2;
+	lchan = setup_lchan(2, 0, GSM_PCHAN_TCH_F, GSM_LCHAN_TCH_F);
+
+	add_meas(lchan, 4, 80, 0);
+	trx_meas_check_compute(trx, 104 + 25);
+	ASSERT_TRUE(lchan->meas.res.rxlev_full == 30);
+
+	/* (80 + 90) / 2 = 85 */
+	add_meas(lchan, 4, 90, 200);
+	trx_meas_check_compute(trx, 2 * 104 + 25);
+	ASSERT_TRUE(lchan->meas.res.rxlev_full == 25);
+	ASSERT_TRUE(lchan->meas.res.rxqual_full == 3);
+
+	/* the first period falls out of the window */
+	add_meas(lchan, 4, 90, 200);
+	trx_meas_check_compute(trx, 3 * 104 + 25);
+	ASSERT_TRUE(lchan->meas.res.rxlev_full == 20);
+	ASSERT_TRUE(lchan->meas.res.rxqual_full == 4);
+
+	btsb->meas.avg_periods = 1;
+	lchan->state = LCHAN_S_NONE;
+}
+
+static void test_meas_sdcch8(void)
+{
+	struct gsm_lchan *lchan;
+
+	printf("Testing SDCCH/8 period end.\n");
+
+	lchan = setup_lchan(1, 3, GSM_PCHAN_SDCCH8_SACCH8C, GSM_LCHAN_SDCCH);
+	add_meas(lchan, 4, 100, 0);
+
+	trx_meas_check_compute(trx, 36);
+	ASSERT_TRUE(!(lchan->meas.flags & LC_UL_M_F_RES_VALID));
+
+	trx_meas_check_compute(trx, 102 + 11);
+	ASSERT_TRUE(lchan->meas.flags & LC_UL_M_F_RES_VALID);
+	ASSERT_TRUE(lchan->meas.res.rxlev_full == 10);
+
+	lchan->state = LCHAN_S_NONE;
+}
+
+int main(int argc, char **argv)
+{
+	void *tall_msgb_ctx;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+
+	bts = gsm_bts_alloc(tall_bts_ctx);
+	trx = gsm_bts_trx_alloc(bts);
+	if (bts_init(bts) < 0) {
+		fprintf(stderr, "unable to to open bts\n");
+		exit(1);
+	}
+
+	btsb = bts_role_bts(bts);
+	test_meas_schedule();
+	test_meas_averaging();
+	test_meas_sdcch8();
+	printf("Success\n");
+
+	return 0;
+}
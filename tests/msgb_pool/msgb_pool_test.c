@@ -0,0 +1,175 @@
+/* testing the msgb pools */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+
+#include <osmo-bts/msgb_pool.h>
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+static void test_recycle(void)
+{
+	struct msgb_pool *pool = &msgb_pools[0];
+	struct msgb *msg, *msg2;
+
+	printf("Testing that a freed msgb is reused.\n");
+
+	msg = bts_msgb_alloc(23, "test");
+	ASSERT_TRUE(msg);
+	ASSERT_TRUE(pool->num_used == 1);
+	ASSERT_TRUE(pool->stats.allocated == 1);
+	memset(msgb_put(msg, 23), 0x2b, 23);
+	msg->l2h = msg->data;
+	msg->dst = msg;
+	msg->cb[0] = 42;
+
+	bts_msgb_free(msg);
+	ASSERT_TRUE(pool->num_used == 0);
+	ASSERT_TRUE(pool->num_free == 1);
+
+	msg2 = bts_msgb_alloc_headroom(64, 16, "test2");
+	ASSERT_TRUE(msg2 == msg);
+	ASSERT_TRUE(pool->stats.recycled == 1);
+	ASSERT_TRUE(pool->num_free == 0);
+	ASSERT_TRUE(msg2->len == 0);
+	ASSERT_TRUE(msgb_headroom(msg2) == 16);
+	ASSERT_TRUE(msg2->data[0] == 0);
+	ASSERT_TRUE(msg2->l2h == NULL);
+	ASSERT_TRUE(msg2->dst == NULL);
+	ASSERT_TRUE(msg2->cb[0] == 0);
+
+	bts_msgb_free(msg2);
+}
+
+static void test_plain_free(void)
+{
+	struct msgb_pool *pool = &msgb_pools[0];
+	unsigned int num_free = pool->num_free;
+	struct msgb *msg;
+
+	printf("Testing that msgb_free() really frees.\n");
+
+	msg = bts_msgb_alloc(23, "test");
+	ASSERT_TRUE(pool->num_free == num_free - 1);
+	msgb_free(msg);
+	ASSERT_TRUE(pool->num_used == 0);
+	ASSERT_TRUE(pool->num_free == num_free - 1);
+	ASSERT_TRUE(pool->stats.released == 1);
+
+	/* a msgb not from a pool is just freed */
+	msg = msgb_alloc(pool->size, "test");
+	bts_msgb_free(msg);
+	ASSERT_TRUE(pool->num_free == num_free - 1);
+}
+
+static void test_size_class(void)
+{
+	struct msgb *msg;
+
+	printf("Testing the size classes.\n");
+
+	msg = bts_msgb_alloc(300, "test");
+	ASSERT_TRUE(msg->data_len == msgb_pools[1].size);
+	ASSERT_TRUE(msgb_pools[1].num_used == 1);
+	bts_msgb_free(msg);
+
+	/* too large for any pool */
+	msg = bts_msgb_alloc_headroom(900 + 132, 132, "test");
+	ASSERT_TRUE(msg->data_len == 900 + 132);
+	bts_msgb_free(msg);
+	ASSERT_TRUE(msgb_pools[1].num_free == 1);
+}
+
+static void test_watermark(void)
+{
+	struct msgb_pool *pool = &msgb_pools[0];
+	struct msgb *msgs[300];
+	int i;
+
+	printf("Testing the watermark and the free list limit.\n");
+
+	for (i = 0; i < 300; i++)
+		msgs[i] = bts_msgb_alloc(32, "test");
+	ASSERT_TRUE(pool->high_watermark == 300);
+
+	for (i = 0; i < 300; i++)
+		bts_msgb_free(msgs[i]);
+	ASSERT_TRUE(pool->num_used == 0);
+	ASSERT_TRUE(pool->num_free == pool->max_free);
+	ASSERT_TRUE(pool->stats.released == 1 + 300 - pool->max_free);
+}
+
+static void test_add(void)
+{
+	struct msgb_pool *pool;
+	struct msgb *msg;
+
+	printf("Testing an added pool.\n");
+
+	ASSERT_TRUE(msgb_pool_add(700, 8, 4) == 0);
+	ASSERT_TRUE(msgb_pools_num == 3);
+	pool = &msgb_pools[2];
+	ASSERT_TRUE(pool->num_free == 4);
+	ASSERT_TRUE(pool->stats.allocated == 4);
+
+	/* the same size again only raises the limit */
+	ASSERT_TRUE(msgb_pool_add(700, 16, 0) == 0);
+	ASSERT_TRUE(msgb_pools_num == 3);
+	ASSERT_TRUE(pool->max_free == 16);
+
+	msg = bts_msgb_alloc_headroom(650, 128, "test");
+	ASSERT_TRUE(msg->data_len == 700);
+	ASSERT_TRUE(pool->stats.recycled == 1);
+	ASSERT_TRUE(pool->num_used == 1);
+	bts_msgb_free(msg);
+	ASSERT_TRUE(pool->num_free == 4);
+
+	/* others still go to their pool */
+	msg = bts_msgb_alloc(300, "test");
+	ASSERT_TRUE(msg->data_len == msgb_pools[1].size);
+	bts_msgb_free(msg);
+	msg = bts_msgb_alloc(1000, "test");
+	ASSERT_TRUE(msg->data_len == 1000);
+	bts_msgb_free(msg);
+}
+
+int main(int argc, char **argv)
+{
+	void *tall_msgb_ctx;
+
+	tall_msgb_ctx = talloc_named_const(NULL, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	test_recycle();
+	test_plain_free();
+	test_size_class();
+	test_watermark();
+	test_add();
+	printf("Success\n");
+
+	return 0;
+}
@@ -0,0 +1,294 @@
+/* testing the admission control of access bursts under synthetic floods */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <osmocom/core/talloc.h>
+#include <osmocom/gsm/sysinfo.h>
+#include <osmocom/gsm/protocol/gsm_04_08.h>
+
+#include <osmo-bts/bts.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/rach_adm.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct gsm_bts *bts;
+static struct gsm_bts_role_bts *btsb;
+int pcu_direct = 0;
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+/* frames per second, rounded */
+#define FRAMES_SEC	217
+
+static uint32_t fn;
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+	rnd_state = rnd_state * 1103515245 + 12345;
+	return (rnd_state >> 16) & 0x7fff;
+}
+
+/* random RA of a non-emergency establishment cause */
+static uint8_t rnd_ra(void)
+{
+	uint8_t ra;
+
+	do {
+		ra = rnd() & 0xff;
+	} while ((ra & 0xe0) == 0xa0);
+
+	return ra;
+}
+
+/* the first frame of a flood starts the admission control again */
+static void reset(void)
+{
+	memset(&btsb->rach_adm, 0, sizeof(btsb->rach_adm));
+	fn = 0;
+	rnd_state = 1;
+}
+
+/* run 'secs' seconds with 'rate' access bursts per second on average,
+ * each repeated 'repeat' times 8 frames apart, returns the number of
+ * admitted bursts */
+static unsigned int flood(unsigned int secs, unsigned int rate,
+	unsigned int repeat)
+{
+	unsigned int admitted = 0, i;
+	uint32_t end = fn + secs * FRAMES_SEC;
+	struct {
+		uint8_t ra;
+		uint32_t fn;
+		unsigned int left;
+	} rep[64];
+	unsigned int num_rep = 0;
+
+	while (fn < end) {
+		fn++;
+		rach_adm_tick(bts, fn);
+
+		/* repetitions of earlier bursts */
+		for (i = 0; i < num_rep; ) {
+			if (rep[i].fn != fn) {
+				i++;
+				continue;
+			}
+			if (rach_adm_check(bts, rep[i].ra, fn)
+			    == RACH_ADM_ACCEPT)
+				admitted++;
+			if (--rep[i].left) {
+				rep[i++].fn = fn + 8;
+				continue;
+			}
+			rep[i] = rep[--num_rep];
+		}
+
+		if (rnd() % FRAMES_SEC >= rate)
+			continue;
+		rep[num_rep].ra = rnd_ra();
+		if (rach_adm_check(bts, rep[num_rep].ra, fn) == RACH_ADM_ACCEPT)
+			admitted++;
+		rep[num_rep].fn = fn + 8;
+		rep[num_rep].left = repeat;
+		if (repeat && num_rep < 63)
+			num_rep++;
+	}
+
+	return admitted;
+}
+
+static void test_duplicate(void)
+{
+	printf("Testing duplicate suppression.\n");
+
+	reset();
+	btsb->rach_adm.dup_window = 100;
+
+	ASSERT_TRUE(rach_adm_check(bts, 0x0a, 10) == RACH_ADM_ACCEPT);
+	ASSERT_TRUE(rach_adm_check(bts, 0x0b, 12) == RACH_ADM_ACCEPT);
+	ASSERT_TRUE(rach_adm_check(bts, 0x0a, 60) == RACH_ADM_DUPLICATE);
+	/* the window starts again with each repetition */
+	ASSERT_TRUE(rach_adm_check(bts, 0x0a, 150) == RACH_ADM_DUPLICATE);
+	ASSERT_TRUE(rach_adm_check(bts, 0x0b, 150) == RACH_ADM_ACCEPT);
+	ASSERT_TRUE(rach_adm_check(bts, 0x0a, 250) == RACH_ADM_ACCEPT);
+
+	/* across the end of the hyperframe */
+	ASSERT_TRUE(rach_adm_check(bts, 0x0c, 2715600) == RACH_ADM_ACCEPT);
+	ASSERT_TRUE(rach_adm_check(bts, 0x0c, 20) == RACH_ADM_DUPLICATE);
+
+	/* emergency calls are never dropped */
+	ASSERT_TRUE(rach_adm_check(bts, 0xa5, 300) == RACH_ADM_ACCEPT);
+	ASSERT_TRUE(rach_adm_check(bts, 0xa5, 301) == RACH_ADM_ACCEPT);
+
+	ASSERT_TRUE(btsb->rach_adm.stats.received == 10);
+	ASSERT_TRUE(btsb->rach_adm.stats.duplicate == 3);
+	ASSERT_TRUE(btsb->rach_adm.stats.emergency == 2);
+
+	/* a flood of bursts, each sent 4 times */
+	reset();
+	flood(10, 20, 3);
+	printf("repeated: received %u, duplicate %u\n",
+		btsb->rach_adm.stats.received, btsb->rach_adm.stats.duplicate);
+	reset();
+	btsb->rach_adm.dup_window = 50;
+	flood(10, 20, 3);
+	printf("suppressed: received %u, duplicate %u\n",
+		btsb->rach_adm.stats.received, btsb->rach_adm.stats.duplicate);
+	ASSERT_TRUE(btsb->rach_adm.stats.duplicate * 4 >=
+		btsb->rach_adm.stats.received * 2);
+}
+
+static void test_rate_limit(void)
+{
+	unsigned int admitted;
+
+	printf("Testing the rate limit.\n");
+
+	/* below the limit everything passes */
+	reset();
+	btsb->rach_adm.rate_limit = 20;
+	admitted = flood(10, 10, 0);
+	printf("10/s at 20/s: received %u, admitted %u\n",
+		btsb->rach_adm.stats.received, admitted);
+	ASSERT_TRUE(admitted == btsb->rach_adm.stats.received);
+
+	/* a flood is cut to the limit, plus the initial bucket */
+	reset();
+	btsb->rach_adm.rate_limit = 20;
+	admitted = flood(10, 200, 0);
+	printf("200/s at 20/s: received %u, admitted %u\n",
+		btsb->rach_adm.stats.received, admitted);
+	ASSERT_TRUE(admitted <= 10 * 20 + 20);
+	ASSERT_TRUE(admitted >= 10 * 20);
+
+	/* emergency calls pass the limit */
+	ASSERT_TRUE(rach_adm_check(bts, 0x12, fn) == RACH_ADM_RATE_LIMIT);
+	ASSERT_TRUE(rach_adm_check(bts, 0xa1, fn) == RACH_ADM_ACCEPT);
+}
+
+static void set_si(int si, unsigned int offset, uint8_t t2, uint8_t t3)
+{
+	struct gsm48_rach_control *rc;
+
+	memset(bts->si_buf[si], 0x2b, sizeof(sysinfo_buf_t));
+	rc = (void *) (bts->si_buf[si] + offset);
+	rc->t2 = t2;
+	rc->t3 = t3;
+	bts->si_valid |= (1 << si);
+	rach_adm_si_update(bts, si);
+}
+
+static struct gsm48_rach_control *si3_rach(void)
+{
+	return (void *) (bts->si_buf[SYSINFO_TYPE_3] +
+		offsetof(struct gsm48_system_information_type_3,
+			 rach_control));
+}
+
+static void test_barring(void)
+{
+	struct gsm48_system_information_type_4 *si4;
+	unsigned int i;
+
+	printf("Testing access class barring.\n");
+
+	reset();
+	btsb->rach_adm.bar_high = 40;
+	btsb->rach_adm.bar_low = 10;
+
+	/* the BSC bars ACC7 and emergency calls */
+	set_si(SYSINFO_TYPE_3,
+		offsetof(struct gsm48_system_information_type_3,
+			 rach_control), 0x04, 0x80);
+	set_si(SYSINFO_TYPE_4,
+		offsetof(struct gsm48_system_information_type_4,
+			 rach_control), 0x04, 0x80);
+	ASSERT_TRUE(si3_rach()->t3 == 0x80);
+
+	/* a flood raises the barring step by step */
+	for (i = 0; i < 6; i++) {
+		flood(1, 100, 0);
+		printf("flood second %u: load %u, level %u, SI3 %02x %02x\n",
+			i, btsb->rach_adm.load, btsb->rach_adm.level,
+			si3_rach()->t2, si3_rach()->t3);
+	}
+	ASSERT_TRUE(btsb->rach_adm.level == RACH_ADM_MAX_LEVEL);
+	ASSERT_TRUE(si3_rach()->t2 == 0x04);
+	ASSERT_TRUE(si3_rach()->t3 == 0xff);
+	si4 = (void *) bts->si_buf[SYSINFO_TYPE_4];
+	ASSERT_TRUE(si4->rach_control.t3 == 0xff);
+
+	/* a new SI from the BSC is barred as well */
+	set_si(SYSINFO_TYPE_3,
+		offsetof(struct gsm48_system_information_type_3,
+			 rach_control), 0x00, 0x01);
+	ASSERT_TRUE(si3_rach()->t3 == 0xff);
+
+	/* in between both thresholds nothing changes */
+	flood(10, 20, 0);
+	ASSERT_TRUE(btsb->rach_adm.level == RACH_ADM_MAX_LEVEL);
+
+	/* the barring is lifted after the flood */
+	for (i = 0; i < RACH_ADM_MAX_LEVEL + 1; i++) {
+		flood(RACH_ADM_HOLD, 2, 0);
+		printf("quiet %us: load %u, level %u, SI3 %02x %02x\n",
+			(i + 1) * RACH_ADM_HOLD, btsb->rach_adm.load,
+			btsb->rach_adm.level, si3_rach()->t2,
+			si3_rach()->t3);
+	}
+	ASSERT_TRUE(btsb->rach_adm.level == 0);
+	ASSERT_TRUE(si3_rach()->t2 == 0x00);
+	ASSERT_TRUE(si3_rach()->t3 == 0x01);
+	ASSERT_TRUE(si4->rach_control.t2 == 0x04);
+	ASSERT_TRUE(si4->rach_control.t3 == 0x80);
+	ASSERT_TRUE(btsb->rach_adm.stats.bar_changes == 2 * RACH_ADM_MAX_LEVEL);
+}
+
+int main(int argc, char **argv)
+{
+	void *tall_msgb_ctx;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+
+	bts = gsm_bts_alloc(tall_bts_ctx);
+	if (bts_init(bts) < 0) {
+		fprintf(stderr, "unable to to open bts\n");
+		exit(1);
+	}
+
+	btsb = bts_role_bts(bts);
+	test_duplicate();
+	test_rate_limit();
+	test_barring();
+	printf("Success\n");
+
+	return 0;
+}
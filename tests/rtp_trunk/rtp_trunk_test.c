@@ -0,0 +1,345 @@
+/* testing the multiplexed RTP trunk against a local peer */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/select.h>
+
+#include <osmo-bts/logging.h>
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/rtp_trunk.h>
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+int pcu_direct = 0;
+
+static struct gsm_bts *bts;
+static struct gsm_bts_trx *trx;
+static int peer_fd;
+static uint16_t peer_port;
+
+/* the stand-in for the BSC/MGW side of the trunk */
+static void peer_open(void)
+{
+	struct sockaddr_in sin;
+	socklen_t sin_len = sizeof(sin);
+
+	peer_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	ASSERT_TRUE(peer_fd >= 0);
+
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	ASSERT_TRUE(bind(peer_fd, (struct sockaddr *) &sin, sizeof(sin)) == 0);
+	ASSERT_TRUE(getsockname(peer_fd, (struct sockaddr *) &sin,
+		&sin_len) == 0);
+	peer_port = ntohs(sin.sin_port);
+}
+
+static int peer_recv(uint8_t *buf, unsigned int len)
+{
+	return recv(peer_fd, buf, len, MSG_DONTWAIT);
+}
+
+static void peer_send(struct gsm_lchan *lchan, const uint8_t *buf,
+	unsigned int len)
+{
+	struct sockaddr_in sin;
+
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	sin.sin_port = htons(lchan->abis_ip.bound_port);
+	ASSERT_TRUE(sendto(peer_fd, buf, len, 0, (struct sockaddr *) &sin,
+		sizeof(sin)) == len);
+}
+
+static void test_setup(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	struct gsm_lchan *lchan2 = &trx->ts[2].lchan[0];
+	struct gsm_lchan *lchan3 = &trx->ts[3].lchan[0];
+
+	printf("Testing that calls to one peer share a trunk.\n");
+
+	ASSERT_TRUE(rtp_trunk_call_add(lchan1, INADDR_LOOPBACK, peer_port,
+		1) == 0);
+	ASSERT_TRUE(rtp_trunk_call_add(lchan2, INADDR_LOOPBACK, peer_port,
+		2) == 0);
+	ASSERT_TRUE(lchan1->abis_ip.bound_port != 0);
+	ASSERT_TRUE(lchan1->abis_ip.bound_port == lchan2->abis_ip.bound_port);
+	ASSERT_TRUE(lchan1->abis_ip.connect_port == peer_port);
+
+	/* CID is in use */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, INADDR_LOOPBACK, peer_port,
+		2) == -EBUSY);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan3) == -ENODEV);
+
+	/* a MDCX to a CID in use keeps the call */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan1, INADDR_LOOPBACK, peer_port,
+		2) == -EBUSY);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan1) == 1);
+
+	/* moving the only call of a trunk to another CID keeps the trunk */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, INADDR_LOOPBACK, peer_port + 1,
+		3) == 0);
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, INADDR_LOOPBACK, peer_port + 1,
+		4) == 0);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan3) == 4);
+	ASSERT_TRUE(lchan3->abis_ip.bound_port != 0);
+	rtp_trunk_call_del(lchan3);
+
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan1) == 1);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan2) == 2);
+}
+
+static void test_uplink(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	struct gsm_lchan *lchan2 = &trx->ts[2].lchan[0];
+	uint8_t frame1[33], frame2[33], buf[256];
+	uint8_t fn1, fn2;
+	int rc;
+
+	printf("Testing the uplink of two calls in one packet.\n");
+
+	memset(frame1, 0xd1, sizeof(frame1));
+	memset(frame2, 0xd2, sizeof(frame2));
+
+	ASSERT_TRUE(rtp_trunk_send(lchan1, frame1, sizeof(frame1)) == 0);
+	ASSERT_TRUE(rtp_trunk_send(lchan2, frame2, sizeof(frame2)) == 0);
+	ASSERT_TRUE(peer_recv(buf, sizeof(buf)) < 0);
+	rtp_trunk_flush();
+
+	rc = peer_recv(buf, sizeof(buf));
+	ASSERT_TRUE(rc == RTP_TRUNK_HDR_LEN + 2 * (RTP_TRUNK_FRAME_HDR_LEN + 33));
+	ASSERT_TRUE(buf[0] == RTP_TRUNK_VERSION);
+	ASSERT_TRUE(buf[2] == 1);
+	ASSERT_TRUE(buf[3] == 0x83); /* marker, GSM */
+	ASSERT_TRUE(buf[5] == 33);
+	ASSERT_TRUE(!memcmp(buf + 6, frame1, 33));
+	ASSERT_TRUE(buf[39] == 2);
+	ASSERT_TRUE(buf[40] == 0x83);
+	ASSERT_TRUE(!memcmp(buf + 43, frame2, 33));
+	fn1 = buf[4];
+	fn2 = buf[41];
+
+	/* the first call is silent for one frame (DTX) */
+	ASSERT_TRUE(rtp_trunk_send(lchan1, NULL, 0) == 0);
+	ASSERT_TRUE(rtp_trunk_send(lchan2, frame2, sizeof(frame2)) == 0);
+	rtp_trunk_flush();
+	rc = peer_recv(buf, sizeof(buf));
+	ASSERT_TRUE(rc == RTP_TRUNK_HDR_LEN + RTP_TRUNK_FRAME_HDR_LEN + 33);
+	ASSERT_TRUE(buf[2] == 2);
+	ASSERT_TRUE(buf[3] == 0x03);
+	ASSERT_TRUE(buf[4] == (uint8_t) (fn2 + 1));
+
+	/* the talkspurt after the gap has the marker bit set */
+	ASSERT_TRUE(rtp_trunk_send(lchan1, frame1, sizeof(frame1)) == 0);
+	rtp_trunk_flush();
+	rc = peer_recv(buf, sizeof(buf));
+	ASSERT_TRUE(rc == RTP_TRUNK_HDR_LEN + RTP_TRUNK_FRAME_HDR_LEN + 33);
+	ASSERT_TRUE(buf[2] == 1);
+	ASSERT_TRUE(buf[3] == 0x83);
+	ASSERT_TRUE(buf[4] == (uint8_t) (fn1 + 2));
+
+	/* nothing queued, nothing sent */
+	rtp_trunk_flush();
+	ASSERT_TRUE(peer_recv(buf, sizeof(buf)) < 0);
+}
+
+static void test_batch(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	uint8_t frame[33], buf[256];
+	int rc;
+
+	printf("Testing several frames of a call in one packet.\n");
+
+	memset(frame, 0xd3, sizeof(frame));
+	rtp_trunk_batch = 2;
+
+	ASSERT_TRUE(rtp_trunk_send(lchan1, frame, sizeof(frame)) == 0);
+	rtp_trunk_flush();
+	ASSERT_TRUE(peer_recv(buf, sizeof(buf)) < 0);
+	ASSERT_TRUE(rtp_trunk_send(lchan1, frame, sizeof(frame)) == 0);
+	rtp_trunk_flush();
+
+	rc = peer_recv(buf, sizeof(buf));
+	ASSERT_TRUE(rc == RTP_TRUNK_HDR_LEN + 2 * (RTP_TRUNK_FRAME_HDR_LEN + 33));
+	ASSERT_TRUE(buf[2] == 1 && buf[39] == 1);
+	ASSERT_TRUE(buf[40] == 0x03);
+	ASSERT_TRUE(buf[41] == (uint8_t) (buf[4] + 1));
+
+	rtp_trunk_batch = 1;
+}
+
+static void test_downlink(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	struct gsm_lchan *lchan2 = &trx->ts[2].lchan[0];
+	uint8_t buf[256];
+	struct msgb *msg;
+	unsigned int len = 0;
+
+	printf("Testing the downlink from the peer.\n");
+
+	buf[len++] = RTP_TRUNK_VERSION;
+	buf[len++] = 0;
+	/* frame for the second call */
+	buf[len++] = 2;
+	buf[len++] = 0x03;
+	buf[len++] = 0;
+	buf[len++] = 33;
+	memset(buf + len, 0xd4, 33);
+	len += 33;
+	/* frame for an unknown call */
+	buf[len++] = 9;
+	buf[len++] = 0x03;
+	buf[len++] = 0;
+	buf[len++] = 1;
+	buf[len++] = 0xd5;
+
+	peer_send(lchan1, buf, len);
+	osmo_select_main(1);
+
+	ASSERT_TRUE(llist_empty(&lchan1->dl_tch_queue));
+	msg = msgb_dequeue(&lchan2->dl_tch_queue);
+	ASSERT_TRUE(msg);
+	ASSERT_TRUE(msg->len == 33);
+	ASSERT_TRUE(msg->data[0] == 0xd4);
+	msgb_free(msg);
+
+	/* truncated frame */
+	buf[5] = 40;
+	peer_send(lchan1, buf, 6 + 33);
+	osmo_select_main(1);
+	ASSERT_TRUE(llist_empty(&lchan2->dl_tch_queue));
+}
+
+static void test_pending(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	struct gsm_lchan *lchan3 = &trx->ts[3].lchan[0];
+	uint8_t frame[33], buf[256];
+	int rc;
+
+	printf("Testing a call whose peer is known later.\n");
+
+	memset(frame, 0xd7, sizeof(frame));
+
+	/* CRCX without remote IP/port */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, 0, 0, 5) == 0);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan3) == 5);
+	ASSERT_TRUE(lchan3->abis_ip.bound_port == 0);
+	ASSERT_TRUE(rtp_trunk_send(lchan3, frame, sizeof(frame)) == 0);
+	rtp_trunk_flush();
+	ASSERT_TRUE(peer_recv(buf, sizeof(buf)) < 0);
+
+	/* MDCX with remote IP/port */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, INADDR_LOOPBACK, peer_port,
+		5) == 0);
+	ASSERT_TRUE(lchan3->abis_ip.bound_port == lchan1->abis_ip.bound_port);
+	ASSERT_TRUE(rtp_trunk_send(lchan3, frame, sizeof(frame)) == 0);
+	rtp_trunk_flush();
+	rc = peer_recv(buf, sizeof(buf));
+	ASSERT_TRUE(rc == RTP_TRUNK_HDR_LEN + RTP_TRUNK_FRAME_HDR_LEN + 33);
+	ASSERT_TRUE(buf[2] == 5);
+
+	rtp_trunk_call_del(lchan3);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan3) == -ENODEV);
+
+	/* released before the peer was known */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan3, 0, 0, 5) == 0);
+	rtp_trunk_call_del(lchan3);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan3) == -ENODEV);
+}
+
+static void test_release(void)
+{
+	struct gsm_lchan *lchan1 = &trx->ts[1].lchan[0];
+	struct gsm_lchan *lchan2 = &trx->ts[2].lchan[0];
+	uint8_t frame[33];
+
+	printf("Testing the release of the calls.\n");
+
+	memset(frame, 0xd6, sizeof(frame));
+
+	rtp_trunk_call_del(lchan1);
+	ASSERT_TRUE(rtp_trunk_send(lchan1, frame, sizeof(frame)) == -ENODEV);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan2) == 2);
+
+	/* CID is free again */
+	ASSERT_TRUE(rtp_trunk_call_add(lchan1, INADDR_LOOPBACK, peer_port,
+		1) == 0);
+	rtp_trunk_call_del(lchan1);
+	rtp_trunk_call_del(lchan2);
+	ASSERT_TRUE(rtp_trunk_call_cid(lchan2) == -ENODEV);
+}
+
+int main(int argc, char **argv)
+{
+	void *tall_msgb_ctx;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+
+	bts = gsm_bts_alloc(tall_bts_ctx);
+	if (!bts) {
+		fprintf(stderr, "Failed to create BTS structure\n");
+		exit(1);
+	}
+	trx = gsm_bts_trx_alloc(bts);
+	if (!trx) {
+		fprintf(stderr, "Failed to TRX structure\n");
+		exit(1);
+	}
+	if (bts_init(bts) < 0) {
+		fprintf(stderr, "unable to to open bts\n");
+		exit(1);
+	}
+
+	peer_open();
+
+	test_setup();
+	test_uplink();
+	test_batch();
+	test_downlink();
+	test_pending();
+	test_release();
+	printf("Success\n");
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef NIBBLE_REF_H
+#define NIBBLE_REF_H
+
+#include <stdint.h>
+
+/* the byte wise nibble shifts, which copy to another buffer */
+static void ref_nibble_shift_right(uint8_t *out, const uint8_t *in,
+				   unsigned int num_nibbles)
+{
+	unsigned int i;
+	unsigned int num_whole_bytes = num_nibbles / 2;
+
+	out[0] = (in[0] >> 4);
+	for (i = 1; i < num_whole_bytes; i++)
+		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
+	i = num_whole_bytes;
+	if (num_nibbles & 1)
+		out[i] = ((in[i-1] & 0xF) << 4) | (in[i] >> 4);
+	else
+		out[i] = (in[i-1] & 0xF) << 4;
+}
+
+static void ref_nibble_shift_left_unal(uint8_t *out, const uint8_t *in,
+				       unsigned int num_nibbles)
+{
+	unsigned int i;
+	unsigned int num_whole_bytes = num_nibbles / 2;
+
+	for (i = 0; i < num_whole_bytes; i++)
+		out[i] = ((in[i] & 0xF) << 4) | (in[i+1] >> 4);
+	i = num_whole_bytes;
+	if (num_nibbles & 1)
+		out[i] = (in[i] & 0xF) << 4;
+}
+
+#endif /* NIBBLE_REF_H */
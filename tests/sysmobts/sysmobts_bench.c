@@ -0,0 +1,99 @@
+/* Benchmark of the conversion of TCH frames of the sysmoBTS L1 to RTP */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils.h"
+#include "nibble_ref.h"
+
+#include <osmocom/core/bits.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* frames/s of the conversion of uplink frames from L1 format to RTP, as
+ * done by the former copying and the in place code */
+#define BENCH_FRAMES	200000
+
+static double bench_rate(struct timespec *start)
+{
+	struct timespec end;
+	double sec;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	sec = (end.tv_sec - start->tv_sec) +
+		(end.tv_nsec - start->tv_nsec) / 1e9;
+
+	return sec > 0 ? BENCH_FRAMES / sec : 0;
+}
+
+static void bench_codec(const char *name, unsigned int l1_len,
+			unsigned int nibbles, int right)
+{
+	uint8_t l1[64], rtp[64];
+	struct timespec start;
+	double copy, in_place;
+	unsigned int i;
+
+	memset(l1, 0x5a, sizeof(l1));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_FRAMES; i++) {
+		uint8_t *buf = malloc(l1_len + 1);
+		osmo_revbytebits_buf(l1, l1_len);
+		if (!nibbles)
+			memcpy(buf, l1, l1_len);
+		else if (right)
+			ref_nibble_shift_right(buf, l1, nibbles);
+		else
+			ref_nibble_shift_left_unal(buf, l1, nibbles);
+		memcpy(rtp, buf, l1_len);
+		free(buf);
+	}
+	copy = bench_rate(&start);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_FRAMES; i++) {
+		sysmobts_revbytebits_buf(l1, l1_len);
+		if (!nibbles)
+			continue;
+		if (right)
+			osmo_nibble_shift_right(l1, l1, nibbles);
+		else
+			osmo_nibble_shift_left_unal(l1, l1, nibbles);
+	}
+	in_place = bench_rate(&start);
+
+	printf("%-4s L1->RTP: %10.0f frames/s copying, "
+		"%10.0f frames/s in place\n", name, copy, in_place);
+}
+
+static void bench_tch(void)
+{
+	bench_codec("FR", 33, 260 / 4, 1);
+	bench_codec("HR", 14, 0, 0);
+	bench_codec("EFR", 31, 244 / 4, 1);
+	/* AMR 12.2: IF2 frame of 32 bytes */
+	bench_codec("AMR", 32, 32 * 2 - 1, 0);
+}
+
+int main(int argc, char **argv)
+{
+	bench_tch();
+	return 0;
+}
@@ -21,8 +21,14 @@
 
 #include "femtobts.h"
 #include "utils.h"
+#include "l1_fwd.h"
+#include "nibble_ref.h"
+
+#include <osmocom/core/bits.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static int direct_map[][3] = {
 	{ GSM_BAND_850,		GsmL1_FreqBand_850,	128	},
@@ -114,9 +120,97 @@ static void test_sysmobts_auto_band(void)
 	}
 }
 
+static void test_nibble_shift(void)
+{
+	uint8_t in[64], ref[64], out[64];
+	unsigned int i, n;
+
+	printf("Testing the in place nibble shifts.\n");
+
+	for (i = 0; i < sizeof(in); i++)
+		in[i] = i * 37 + 11;
+
+	for (n = 2; n < 2 * (sizeof(in) - 1); n++) {
+		memset(ref, 0, sizeof(ref));
+		ref_nibble_shift_right(ref, in, n);
+		memcpy(out, in, sizeof(out));
+		osmo_nibble_shift_right(out, out, n);
+		OSMO_ASSERT(!memcmp(out, ref, n / 2 + 1));
+
+		memset(ref, 0, sizeof(ref));
+		ref_nibble_shift_left_unal(ref, in, n);
+		memcpy(out, in, sizeof(out));
+		osmo_nibble_shift_left_unal(out, out, n);
+		OSMO_ASSERT(!memcmp(out, ref, (n + 1) / 2));
+	}
+
+	/* FR: 260 bits as in the L1 primitive, and back */
+	memcpy(out, in, sizeof(out));
+	osmo_nibble_shift_right(out, out, 260 / 4);
+	osmo_nibble_shift_left_unal(out, out, 260 / 4);
+	OSMO_ASSERT(!memcmp(out, in, 32));
+	OSMO_ASSERT(out[32] == (in[32] & 0xf0));
+}
+
+static void test_revbits(void)
+{
+	uint8_t buf[256], ref[256];
+	unsigned int i;
+
+	printf("Testing the bit reversal.\n");
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = ref[i] = i;
+	osmo_revbytebits_buf(ref, sizeof(ref));
+	sysmobts_revbytebits_buf(buf, sizeof(buf));
+	OSMO_ASSERT(!memcmp(buf, ref, sizeof(buf)));
+}
+
+static void test_fwd_mux(void)
+{
+	uint8_t buf[64], prim1[20], prim2[30], queue;
+	const uint8_t *data;
+	unsigned int data_len, offset = 0;
+	int len;
+
+	printf("Testing the multiplexed l1fwd framing.\n");
+
+	memset(prim1, 0x11, sizeof(prim1));
+	memset(prim2, 0x22, sizeof(prim2));
+
+	len = l1fwd_mux_put(buf, 0, sizeof(buf), 1, prim1, sizeof(prim1));
+	OSMO_ASSERT(len == L1FWD_MUX_HDR_LEN + sizeof(prim1));
+	len = l1fwd_mux_put(buf, len, sizeof(buf), 0, prim2, sizeof(prim2));
+	OSMO_ASSERT(len == 2 * L1FWD_MUX_HDR_LEN + sizeof(prim1) + sizeof(prim2));
+	/* the datagram is full */
+	OSMO_ASSERT(l1fwd_mux_put(buf, len, sizeof(buf), 0, prim2,
+				  sizeof(prim2)) == -ENOSPC);
+
+	OSMO_ASSERT(l1fwd_mux_get(buf, len, &offset, &queue, &data,
+				  &data_len) == 1);
+	OSMO_ASSERT(queue == 1 && data_len == sizeof(prim1));
+	OSMO_ASSERT(!memcmp(data, prim1, sizeof(prim1)));
+	OSMO_ASSERT(l1fwd_mux_get(buf, len, &offset, &queue, &data,
+				  &data_len) == 1);
+	OSMO_ASSERT(queue == 0 && data_len == sizeof(prim2));
+	OSMO_ASSERT(!memcmp(data, prim2, sizeof(prim2)));
+	OSMO_ASSERT(l1fwd_mux_get(buf, len, &offset, &queue, &data,
+				  &data_len) == 0);
+
+	/* a truncated primitive */
+	offset = 0;
+	OSMO_ASSERT(l1fwd_mux_get(buf, len - 1, &offset, &queue, &data,
+				  &data_len) == 1);
+	OSMO_ASSERT(l1fwd_mux_get(buf, len - 1, &offset, &queue, &data,
+				  &data_len) == -EINVAL);
+}
+
 int main(int argc, char **argv)
 {
 	printf("Testing sysmobts routines\n");
 	test_sysmobts_auto_band();
+	test_nibble_shift();
+	test_revbits();
+	test_fwd_mux();
 	return 0;
 }
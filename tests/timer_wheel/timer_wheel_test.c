@@ -0,0 +1,208 @@
+/* testing the timer wheel */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <osmocom/core/utils.h>
+#include <osmocom/core/timer.h>
+
+#include <osmo-bts/timer_wheel.h>
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+#define NUM_ACT		1000
+#define ACT_TIMEOUT	30
+
+struct test_act {
+	struct timer_wheel_entry timeout;
+	int expired_at;
+};
+
+static struct timer_wheel wheel;
+static struct test_act acts[NUM_ACT];
+static int num_expired;
+
+static void act_timeout(void *data)
+{
+	struct test_act *act = data;
+
+	act->expired_at = wheel.now;
+	num_expired++;
+}
+
+static void act_setup(struct test_act *act)
+{
+	memset(act, 0, sizeof(*act));
+	act->timeout.cb = act_timeout;
+	act->timeout.data = act;
+	act->expired_at = -1;
+}
+
+static void test_expire(void)
+{
+	static const unsigned int ticks[] = { 0, 1, 5, 63, 64, 200 };
+	unsigned int i;
+
+	printf("Testing the expiry of entries.\n");
+
+	timer_wheel_init(&wheel, 1000);
+	num_expired = 0;
+
+	for (i = 0; i < ARRAY_SIZE(ticks); i++) {
+		act_setup(&acts[i]);
+		timer_wheel_add(&wheel, &acts[i].timeout, ticks[i]);
+	}
+	ASSERT_TRUE(wheel.pending == ARRAY_SIZE(ticks));
+	ASSERT_TRUE(osmo_timer_pending(&wheel.timer));
+
+	while (num_expired < ARRAY_SIZE(ticks))
+		timer_wheel_tick(&wheel);
+
+	/* each expires in the tick after the requested number of ticks */
+	for (i = 0; i < ARRAY_SIZE(ticks); i++)
+		ASSERT_TRUE(acts[i].expired_at == ticks[i] + 1);
+	ASSERT_TRUE(wheel.pending == 0);
+	ASSERT_TRUE(!osmo_timer_pending(&wheel.timer));
+}
+
+static void test_readd(void)
+{
+	printf("Testing the rescheduling of an entry.\n");
+
+	timer_wheel_init(&wheel, 100);
+	num_expired = 0;
+
+	act_setup(&acts[0]);
+	timer_wheel_add(&wheel, &acts[0].timeout, 3);
+	timer_wheel_tick(&wheel);
+	timer_wheel_add(&wheel, &acts[0].timeout, 3);
+	ASSERT_TRUE(wheel.pending == 1);
+
+	while (num_expired == 0)
+		timer_wheel_tick(&wheel);
+	ASSERT_TRUE(acts[0].expired_at == 5);
+	ASSERT_TRUE(num_expired == 1);
+
+	/* removing an expired entry does no harm */
+	timer_wheel_del(&wheel, &acts[0].timeout);
+	ASSERT_TRUE(wheel.pending == 0);
+}
+
+static struct timer_wheel_entry *victim;
+
+static void del_victim(void *data)
+{
+	num_expired++;
+	timer_wheel_del(&wheel, victim);
+}
+
+static void test_cb_del(void)
+{
+	struct timer_wheel_entry first;
+
+	printf("Testing the removal of an entry from a call-back.\n");
+
+	timer_wheel_init(&wheel, 1000);
+	num_expired = 0;
+
+	memset(&first, 0, sizeof(first));
+	first.cb = del_victim;
+	act_setup(&acts[0]);
+	victim = &acts[0].timeout;
+
+	/* both expire in the same tick, the first removes the second */
+	timer_wheel_add(&wheel, &first, 2);
+	timer_wheel_add(&wheel, victim, 2);
+	timer_wheel_tick(&wheel);
+	timer_wheel_tick(&wheel);
+	timer_wheel_tick(&wheel);
+
+	ASSERT_TRUE(num_expired == 1);
+	ASSERT_TRUE(acts[0].expired_at == -1);
+	ASSERT_TRUE(wheel.pending == 0);
+}
+
+/* mass channel activation: 1000 requests are outstanding at the same
+ * time, all but a few are confirmed before their timeout */
+static void test_load(void)
+{
+	struct timespec start, end;
+	unsigned int i, t;
+
+	printf("Testing %d outstanding activations.\n", NUM_ACT);
+
+	timer_wheel_init(&wheel, 1000);
+	num_expired = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < NUM_ACT; i++) {
+		act_setup(&acts[i]);
+		timer_wheel_add(&wheel, &acts[i].timeout, ACT_TIMEOUT);
+	}
+	ASSERT_TRUE(wheel.pending == NUM_ACT);
+
+	/* the confirms arrive spread over the first ten ticks, every
+	 * 100th activation is never confirmed */
+	for (t = 0; t < 10; t++) {
+		for (i = t; i < NUM_ACT; i += 10) {
+			if (i % 100 == 99)
+				continue;
+			timer_wheel_del(&wheel, &acts[i].timeout);
+		}
+		timer_wheel_tick(&wheel);
+	}
+	ASSERT_TRUE(wheel.pending == NUM_ACT / 100);
+	ASSERT_TRUE(num_expired == 0);
+
+	while (wheel.pending)
+		timer_wheel_tick(&wheel);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	ASSERT_TRUE(num_expired == NUM_ACT / 100);
+	for (i = 0; i < NUM_ACT; i++) {
+		if (i % 100 == 99) {
+			ASSERT_TRUE(acts[i].expired_at == ACT_TIMEOUT + 1);
+		} else {
+			ASSERT_TRUE(acts[i].expired_at == -1);
+		}
+	}
+
+	fprintf(stderr, "%d activations: %ld us\n", NUM_ACT,
+		(end.tv_sec - start.tv_sec) * 1000000
+		+ (end.tv_nsec - start.tv_nsec) / 1000);
+}
+
+int main(int argc, char **argv)
+{
+	test_expire();
+	test_readd();
+	test_cb_del();
+	test_load();
+	printf("Success\n");
+
+	return 0;
+}
@@ -0,0 +1,400 @@
+/* testing the recording, reading and replay of burst traces */
+
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/msgb.h>
+#include <osmocom/core/bits.h>
+#include <osmocom/gsm/protocol/gsm_04_08.h>
+#include <osmocom/gsm/protocol/gsm_08_58.h>
+
+#include <osmo-bts/gsm_data.h>
+#include <osmo-bts/logging.h>
+#include <osmo-bts/bts.h>
+#include <osmo-bts/l1sap.h>
+
+#include "../../src/osmo-bts-trx/l1_if.h"
+#include "../../src/osmo-bts-trx/trx_if.h"
+#include "../../src/osmo-bts-trx/scheduler.h"
+#include "../../src/osmo-bts-trx/trx_trace.h"
+#include "../../src/osmo-bts-trx/trx_replay.h"
+
+const int pcu_direct = 0;
+int quit = 0;
+uint8_t abis_mac[6] = { 0, 1, 2, 3, 4, 5 };
+
+int transceiver_available = 0;
+const char *transceiver_ip = "127.0.0.1";
+int settsc_enabled = 1;
+int setbsic_enabled = 1;
+
+#define ASSERT_TRUE(rc) \
+	if (!(rc)) { \
+		printf("Assert failed in %s:%d.\n",  \
+		       __FILE__, __LINE__);          \
+		abort();			     \
+	}
+
+#define TRACE_FILE	"trx_trace_test.trace"
+#define TRACE_FN	1000
+/* two SACCH periods of the TCH */
+#define TRACE_FRAMES	208
+
+static struct gsm_bts *bts;
+
+
+/*
+ * the transceiver interface
+ */
+
+int trx_if_cmd_poweroff(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_poweron(struct trx_l1h *l1h)
+{
+	return 0;
+}
+
+int trx_if_cmd_settsc(struct trx_l1h *l1h, uint8_t tsc)
+{
+	return 0;
+}
+
+int trx_if_cmd_setbsic(struct trx_l1h *l1h, uint8_t bsic)
+{
+	return 0;
+}
+
+int trx_if_cmd_setrxgain(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setpower(struct trx_l1h *l1h, int db)
+{
+	return 0;
+}
+
+int trx_if_cmd_setmaxdly(struct trx_l1h *l1h, int dly)
+{
+	return 0;
+}
+
+int trx_if_cmd_setslot(struct trx_l1h *l1h, uint8_t tn, uint8_t type)
+{
+	return 0;
+}
+
+int trx_if_cmd_rxtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_txtune(struct trx_l1h *l1h, uint16_t arfcn)
+{
+	return 0;
+}
+
+int trx_if_cmd_handover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+int trx_if_cmd_nohandover(struct trx_l1h *l1h, uint8_t tn, uint8_t ss)
+{
+	return 0;
+}
+
+/* the bursts are recorded as trx_if.c does, both the recording and the
+ * replay sum them up in the digest */
+int trx_if_data(struct trx_l1h *l1h, uint8_t tn, uint32_t fn, uint8_t pwr,
+	const ubit_t *bits)
+{
+	uint8_t buf[154];
+
+	buf[0] = tn;
+	buf[1] = (fn >> 24) & 0xff;
+	buf[2] = (fn >> 16) & 0xff;
+	buf[3] = (fn >>  8) & 0xff;
+	buf[4] = (fn >>  0) & 0xff;
+	buf[5] = pwr;
+	memcpy(buf + 6, bits, 148);
+	trx_trace(TRX_TRACE_DL, l1h->trx->nr, buf, sizeof(buf));
+
+	trx_replay_dl(l1h, tn, fn, pwr, bits);
+
+	return 0;
+}
+
+int trx_if_open(struct trx_l1h *l1h)
+{
+	INIT_LLIST_HEAD(&l1h->trx_ctrl_list);
+	l1h->config.slotmask = 0xff;
+
+	return 0;
+}
+
+void trx_if_flush(struct trx_l1h *l1h)
+{
+}
+
+void trx_if_close(struct trx_l1h *l1h)
+{
+}
+
+int bts_model_init(struct gsm_bts *bts)
+{
+	struct trx_l1h *l1h;
+	struct gsm_bts_trx *trx;
+
+	llist_for_each_entry(trx, &bts->trx_list, list) {
+		l1h = l1if_open(trx);
+		if (!l1h)
+			return -EIO;
+
+		trx->role_bts.l1h = l1h;
+		trx->nominal_power = 23;
+
+		l1if_reset(l1h);
+	}
+
+	return 0;
+}
+
+uint32_t trx_get_hlayer1(struct gsm_bts_trx *trx)
+{
+	return 0;
+}
+
+
+/*
+ * the tests
+ */
+
+/* activate an lchan, as the RSL CHAN ACT of the BSC would */
+static void activate(struct gsm_bts_trx *trx, uint8_t chan_nr, int tch)
+{
+	struct trx_l1h *l1h = trx_l1h_hdl(trx);
+	struct gsm_lchan *lchan = &trx->ts[L1SAP_CHAN2TS(chan_nr)]
+		.lchan[l1sap_chan2ss(chan_nr)];
+
+	lchan->rsl_cmode = tch ? RSL_CMOD_SPD_SPEECH : RSL_CMOD_SPD_SIGN;
+	lchan->tch_mode = tch ? GSM48_CMODE_SPEECH_V1 : GSM48_CMODE_SIGN;
+	trx_sched_set_lchan(l1h, chan_nr, 0x00, 1);
+	trx_sched_set_lchan(l1h, chan_nr, 0x40, 1);
+	trx_sched_set_mode(l1h, chan_nr, lchan->rsl_cmode, lchan->tch_mode,
+		0, 0, 0, 0, 0, 0, 0, 0);
+	lchan_init_lapdm(lchan);
+	lchan_set_state(lchan, LCHAN_S_ACTIVE);
+}
+
+/* an uplink datagram of noise, as trx_if.c receives it */
+static void uplink(struct trx_l1h *l1h, uint8_t tn, uint32_t fn)
+{
+	uint8_t buf[TRX_IF_UL_LEN];
+	int8_t rssi;
+	int16_t toa256;
+	sbit_t bits[148];
+
+	memset(buf, 0, sizeof(buf));
+	buf[0] = tn;
+	buf[1] = (fn >> 24) & 0xff;
+	buf[2] = (fn >> 16) & 0xff;
+	buf[3] = (fn >>  8) & 0xff;
+	buf[4] = (fn >>  0) & 0xff;
+	buf[5] = 100;
+	memset(buf + 8, 127, 148);
+	trx_trace(TRX_TRACE_UL, l1h->trx->nr, buf, sizeof(buf));
+
+	trx_if_ul_parse(buf, &tn, &fn, &rssi, &toa256, bits);
+	trx_sched_ul_burst(l1h, tn, fn, bits, rssi, toa256);
+}
+
+static uint32_t rec_dl_bursts, rec_dl_digest;
+
+static void test_record(void)
+{
+	struct gsm_bts_trx *trx = bts->c0;
+	struct trx_l1h *l1h = trx_l1h_hdl(trx);
+	uint32_t fn;
+	int i;
+
+	printf("Recording %d frames.\n", TRACE_FRAMES);
+
+	l1h->config.poweron = 1;
+	ASSERT_TRUE(trx_trace_open(bts, TRACE_FILE) == 0);
+	ASSERT_TRUE(trx_trace_on);
+
+	/* an SDCCH on the combined CCCH and a TCH/F in a call */
+	trx->ts[0].pchan = GSM_PCHAN_CCCH_SDCCH4;
+	trx_sched_set_pchan(l1h, 0, GSM_PCHAN_CCCH_SDCCH4);
+	trx->ts[1].pchan = GSM_PCHAN_TCH_F;
+	trx_sched_set_pchan(l1h, 1, GSM_PCHAN_TCH_F);
+	activate(trx, 0x20, 0);
+	activate(trx, 0x09, 1);
+
+	trx_replay_reset();
+	for (i = 0; i < TRACE_FRAMES; i++) {
+		fn = TRACE_FN + i;
+		trx_trace(TRX_TRACE_CLOCK, 0, &fn, sizeof(fn));
+		trx_sched_clock(fn);
+		/* on a timeslot without a channel, so that the downlink
+		 * does not depend on it */
+		if (i % 26 == 0)
+			uplink(l1h, 7, fn);
+	}
+
+	trx_trace_close();
+	ASSERT_TRUE(!trx_trace_on);
+
+	rec_dl_bursts = trx_replay.dl_bursts;
+	rec_dl_digest = trx_replay.dl_digest;
+	/* the C0 sends a burst on every timeslot */
+	ASSERT_TRUE(rec_dl_bursts == 8 * TRACE_FRAMES);
+}
+
+static void test_read(void)
+{
+	struct trx_trace_reader reader;
+	const struct trx_trace_rec *rec;
+	uint32_t records[_TRX_TRACE_MAX];
+	uint32_t last_fn = 0;
+
+	printf("Reading the trace back.\n");
+
+	memset(records, 0, sizeof(records));
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == 0);
+	ASSERT_TRUE(reader.hdr->trx_num == 1);
+	while ((rec = trx_trace_reader_next(&reader))) {
+		ASSERT_TRUE(rec->trx == 0);
+		records[rec->type]++;
+		last_fn = rec->fn;
+	}
+	/* the trace ends with the last record */
+	ASSERT_TRUE(reader.pos == reader.size);
+	trx_trace_reader_close(&reader);
+
+	ASSERT_TRUE(records[TRX_TRACE_CLOCK] == TRACE_FRAMES);
+	ASSERT_TRUE(records[TRX_TRACE_FN] == TRACE_FRAMES);
+	ASSERT_TRUE(records[TRX_TRACE_UL] == TRACE_FRAMES / 26);
+	ASSERT_TRUE(records[TRX_TRACE_DL] == rec_dl_bursts);
+	ASSERT_TRUE(records[TRX_TRACE_CONFIG] >= 1);
+	ASSERT_TRUE(records[TRX_TRACE_PCHAN] == 2);
+	ASSERT_TRUE(records[TRX_TRACE_LCHAN] == 4);
+	ASSERT_TRUE(records[TRX_TRACE_MODE] == 2);
+	ASSERT_TRUE(records[TRX_TRACE_CIPHER] == 0);
+	ASSERT_TRUE(records[TRX_TRACE_RESET] == 0);
+	ASSERT_TRUE(last_fn == TRACE_FN + TRACE_FRAMES - 1);
+}
+
+static void test_replay(void)
+{
+	struct trx_trace_reader reader;
+	const struct trx_trace_rec *rec;
+	struct trx_l1h *l1h = trx_l1h_hdl(bts->c0);
+
+	printf("Replaying the trace.\n");
+
+	/* start from scratch, the trace sets the scheduler up again */
+	trx_sched_reset(l1h);
+	trx_replay_reset();
+
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == 0);
+	while ((rec = trx_trace_reader_next(&reader)))
+		trx_replay_record(bts, rec);
+	trx_trace_reader_close(&reader);
+
+	ASSERT_TRUE(trx_replay.invalid == 0);
+	ASSERT_TRUE(trx_replay.frames == TRACE_FRAMES);
+	ASSERT_TRUE(trx_replay.records[TRX_TRACE_DL] == rec_dl_bursts);
+	ASSERT_TRUE(trx_replay.dl_bursts == rec_dl_bursts);
+	ASSERT_TRUE(trx_replay.dl_digest == rec_dl_digest);
+}
+
+static void write_hdr(uint32_t magic, uint16_t version)
+{
+	struct trx_trace_hdr hdr;
+	FILE *f;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = magic;
+	hdr.version = version;
+	hdr.trx_num = 1;
+	f = fopen(TRACE_FILE, "w");
+	ASSERT_TRUE(f);
+	ASSERT_TRUE(fwrite(&hdr, sizeof(hdr), 1, f) == 1);
+	fclose(f);
+}
+
+static void test_header(void)
+{
+	struct trx_trace_reader reader;
+
+	printf("Testing the header of a trace.\n");
+
+	write_hdr(TRX_TRACE_MAGIC, TRX_TRACE_VERSION);
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == 0);
+	ASSERT_TRUE(trx_trace_reader_next(&reader) == NULL);
+	trx_trace_reader_close(&reader);
+
+	/* recorded on a host of the other byte order */
+	write_hdr(TRX_TRACE_MAGIC_SWAPPED, TRX_TRACE_VERSION << 8);
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == -EINVAL);
+
+	write_hdr(TRX_TRACE_MAGIC, TRX_TRACE_VERSION - 1);
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == -EINVAL);
+
+	write_hdr(0, TRX_TRACE_VERSION);
+	ASSERT_TRUE(trx_trace_reader_open(&reader, TRACE_FILE) == -EINVAL);
+}
+
+int main(int argc, char **argv)
+{
+	void *tall_msgb_ctx;
+
+	tall_bts_ctx = talloc_named_const(NULL, 1, "OsmoBTS context");
+	tall_msgb_ctx = talloc_named_const(tall_bts_ctx, 1, "msgb");
+	msgb_set_talloc_ctx(tall_msgb_ctx);
+
+	bts_log_init(NULL);
+
+	bts = gsm_bts_alloc(tall_bts_ctx);
+	if (bts_init(bts) < 0) {
+		fprintf(stderr, "unable to to open bts\n");
+		exit(1);
+	}
+	/* done by the OPSTART of the TRX, RACH goes to this lchan */
+	lchan_init_lapdm(&bts->c0->ts[0].lchan[4]);
+
+	test_record();
+	test_read();
+	test_replay();
+	test_header();
+	unlink(TRACE_FILE);
+	printf("Success\n");
+
+	return 0;
+}